@@ -0,0 +1,431 @@
+// bit_array.h
+//
+// Defines a growable array of bits stored in 64 bit words.
+//
+// A bit costs one bit instead of the byte a bool takes, and whole words can
+// be read and written so an inner loop can test 64 flags at once.
+//
+#ifndef NGE_CNTR_BIT_ARRAY_H
+#define NGE_CNTR_BIT_ARRAY_H
+
+#include <assert.h>
+
+#include "engine/intdef.h"
+#include "engine/containers/bit_utils.h"
+#include "engine/containers/container_stats.h"
+#include "engine/memory/allocator_guard.h"
+#include "engine/memory/iallocator.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+class BitArray
+{
+  private:
+    // MEMBERS
+    /**
+     * The allocator for the words.
+     */
+    mem::AllocatorGuard<uint64> _allocator;
+
+    /**
+     * The words holding the bits.
+     */
+    uint64* _words;
+
+    /**
+     * The number of bits in the array.
+     */
+    uint32 _size;
+
+    /**
+     * The number of words allocated.
+     */
+    uint32 _capacity;
+
+    // HELPER FUNCTIONS
+    /**
+     * Reallocates the words so at least the given number fit.
+     */
+    void reallocate( uint32 wordCount );
+
+    /**
+     * Clears the bits of the last word past the end of the array.
+     */
+    void clearTail();
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a new empty bit array.
+     */
+    BitArray();
+
+    /**
+     * Constructs a new bit array of the given number of clear bits.
+     */
+    BitArray( uint32 size );
+
+    /**
+     * Constructs a new empty bit array with the given allocator.
+     */
+    BitArray( mem::IAllocator<uint64>* allocator );
+
+    /**
+     * Constructs a new bit array of the given number of clear bits with the
+     * given allocator.
+     */
+    BitArray( mem::IAllocator<uint64>* allocator, uint32 size );
+
+    /**
+     * Constructs a copy of the given bit array.
+     */
+    BitArray( const BitArray& array );
+
+    /**
+     * Moves the bit array to a new instance.
+     */
+    BitArray( BitArray&& array );
+
+    /**
+     * Destructs the bit array.
+     */
+    ~BitArray();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the given bit array.
+     */
+    BitArray& operator=( const BitArray& array );
+
+    /**
+     * Moves the bit array data to this instance.
+     */
+    BitArray& operator=( BitArray&& array );
+
+    /**
+     * Keeps only the bits that are also set in the other array.
+     *
+     * Behavior is undefined when:
+     * the arrays differ in size
+     */
+    BitArray& operator&=( const BitArray& array );
+
+    /**
+     * Sets the bits that are set in the other array.
+     *
+     * Behavior is undefined when:
+     * the arrays differ in size
+     */
+    BitArray& operator|=( const BitArray& array );
+
+    /**
+     * Flips the bits that are set in the other array.
+     *
+     * Behavior is undefined when:
+     * the arrays differ in size
+     */
+    BitArray& operator^=( const BitArray& array );
+
+    /**
+     * Checks if the arrays are the same size with the same bits set.
+     */
+    bool operator==( const BitArray& array ) const;
+
+    /**
+     * Checks if the arrays differ in size or in any bit.
+     */
+    bool operator!=( const BitArray& array ) const;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Checks if the bit is set.
+     *
+     * Behavior is undefined when:
+     * index is out of bounds
+     */
+    bool test( uint32 index ) const;
+
+    /**
+     * Sets the bit.
+     *
+     * Behavior is undefined when:
+     * index is out of bounds
+     */
+    void set( uint32 index );
+
+    /**
+     * Sets the bit to the given value.
+     *
+     * Behavior is undefined when:
+     * index is out of bounds
+     */
+    void set( uint32 index, bool value );
+
+    /**
+     * Clears the bit.
+     *
+     * Behavior is undefined when:
+     * index is out of bounds
+     */
+    void clear( uint32 index );
+
+    /**
+     * Flips the bit.
+     *
+     * Behavior is undefined when:
+     * index is out of bounds
+     */
+    void flip( uint32 index );
+
+    /**
+     * Sets every bit.
+     */
+    void setAll();
+
+    /**
+     * Clears every bit.
+     */
+    void clearAll();
+
+    /**
+     * Flips every bit.
+     */
+    void flipAll();
+
+    /**
+     * Adds a bit with the given value to the end of the array.
+     */
+    void push( bool value );
+
+    /**
+     * Changes the number of bits in the array.
+     *
+     * Added bits are clear.
+     */
+    void resize( uint32 size );
+
+    /**
+     * Makes room for at least the given number of bits so that growing up
+     * to that many does not reallocate.
+     */
+    void reserve( uint32 capacity );
+
+    /**
+     * Gets the word holding bits index * 64 up to index * 64 + 63.
+     *
+     * Behavior is undefined when:
+     * index is not less than the word count
+     */
+    uint64 word( uint32 index ) const;
+
+    /**
+     * Replaces the word holding bits index * 64 up to index * 64 + 63.
+     *
+     * Bits of the last word past the end of the array are ignored.
+     *
+     * Behavior is undefined when:
+     * index is not less than the word count
+     */
+    void setWord( uint32 index, uint64 word );
+
+    /**
+     * Gets the number of set bits.
+     */
+    uint32 count() const;
+
+    /**
+     * Checks if any bit is set.
+     */
+    bool any() const;
+
+    /**
+     * Checks if no bit is set.
+     */
+    bool none() const;
+
+    /**
+     * Checks if every bit is set.
+     */
+    bool all() const;
+
+    /**
+     * Gets the index of the first set bit.
+     *
+     * Returns BitUtils::NOT_FOUND if no bit is set.
+     */
+    uint32 findFirst() const;
+
+    /**
+     * Gets the index of the first set bit after the given index.
+     *
+     * Returns BitUtils::NOT_FOUND if there is none.
+     */
+    uint32 findNext( uint32 index ) const;
+
+    /**
+     * Gets the number of bits in the array.
+     */
+    uint32 size() const;
+
+    /**
+     * Checks if the array holds no bits.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Gets the number of words that hold the bits.
+     */
+    uint32 wordCount() const;
+
+    /**
+     * Gets the memory footprint and occupancy of the array.
+     *
+     * The size and capacity are counted in bits.
+     */
+    ContainerStats stats() const;
+};
+
+// CONSTRUCTORS
+inline
+BitArray::BitArray() : BitArray( nullptr, 0 )
+{
+}
+
+inline
+BitArray::BitArray( uint32 size ) : BitArray( nullptr, size )
+{
+}
+
+inline
+BitArray::BitArray( mem::IAllocator<uint64>* allocator )
+    : BitArray( allocator, 0 )
+{
+}
+
+// OPERATORS
+inline
+bool BitArray::operator!=( const BitArray& array ) const
+{
+    return !( *this == array );
+}
+
+// MEMBER FUNCTIONS
+inline
+bool BitArray::test( uint32 index ) const
+{
+    assert( index < _size );
+    return ( _words[index / BitUtils::WORD_BITS] >>
+             ( index % BitUtils::WORD_BITS ) ) & 1;
+}
+
+inline
+void BitArray::set( uint32 index )
+{
+    assert( index < _size );
+    _words[index / BitUtils::WORD_BITS] |=
+        static_cast<uint64>( 1 ) << ( index % BitUtils::WORD_BITS );
+}
+
+inline
+void BitArray::set( uint32 index, bool value )
+{
+    if ( value )
+    {
+        set( index );
+    }
+    else
+    {
+        clear( index );
+    }
+}
+
+inline
+void BitArray::clear( uint32 index )
+{
+    assert( index < _size );
+    _words[index / BitUtils::WORD_BITS] &=
+        ~( static_cast<uint64>( 1 ) << ( index % BitUtils::WORD_BITS ) );
+}
+
+inline
+void BitArray::flip( uint32 index )
+{
+    assert( index < _size );
+    _words[index / BitUtils::WORD_BITS] ^=
+        static_cast<uint64>( 1 ) << ( index % BitUtils::WORD_BITS );
+}
+
+inline
+uint64 BitArray::word( uint32 index ) const
+{
+    assert( index < wordCount() );
+    return _words[index];
+}
+
+inline
+void BitArray::setWord( uint32 index, uint64 word )
+{
+    assert( index < wordCount() );
+    _words[index] = index == wordCount() - 1
+        ? word & BitUtils::tailMask( _size ) : word;
+}
+
+inline
+uint32 BitArray::count() const
+{
+    return BitUtils::count( _words, wordCount() );
+}
+
+inline
+bool BitArray::none() const
+{
+    return !any();
+}
+
+inline
+bool BitArray::all() const
+{
+    return count() == _size;
+}
+
+inline
+uint32 BitArray::findFirst() const
+{
+    return BitUtils::findNext( _words, wordCount(), 0 );
+}
+
+inline
+uint32 BitArray::findNext( uint32 index ) const
+{
+    return index + 1 < _size
+        ? BitUtils::findNext( _words, wordCount(), index + 1 )
+        : BitUtils::NOT_FOUND;
+}
+
+inline
+uint32 BitArray::size() const
+{
+    return _size;
+}
+
+inline
+bool BitArray::isEmpty() const
+{
+    return _size == 0;
+}
+
+inline
+uint32 BitArray::wordCount() const
+{
+    return BitUtils::wordsFor( _size );
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif
@@ -0,0 +1,172 @@
+// bit_utils.h
+//
+// Defines the word level bit operations shared by the bit containers.
+//
+// Bits are stored in 64 bit words, lowest bit first, so bit i of a set is
+// bit i % 64 of word i / 64. Every bit past the end of a set is kept clear
+// so whole words can be counted and scanned without masking.
+//
+#ifndef NGE_CNTR_BIT_UTILS_H
+#define NGE_CNTR_BIT_UTILS_H
+
+#include <assert.h>
+
+#include "engine/intdef.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace nge
+{
+
+namespace cntr
+{
+
+struct BitUtils
+{
+    // CONSTANTS
+    /**
+     * The number of bits in a word.
+     */
+    static constexpr uint32 WORD_BITS = 64;
+
+    /**
+     * Returned by the find functions when no bit is set.
+     */
+    static constexpr uint32 NOT_FOUND = static_cast<uint32>( -1 );
+
+    // FUNCTIONS
+    /**
+     * Gets the number of words needed to hold the given number of bits.
+     */
+    static constexpr uint32 wordsFor( uint32 bitCount );
+
+    /**
+     * Gets the mask of the bits of the last word that are in a set of the
+     * given number of bits.
+     */
+    static constexpr uint64 tailMask( uint32 bitCount );
+
+    /**
+     * Gets the number of set bits in the word.
+     */
+    static uint32 popcount( uint64 word );
+
+    /**
+     * Gets the index of the lowest set bit in the word.
+     *
+     * Behavior is undefined when:
+     * word is 0
+     */
+    static uint32 lowestBit( uint64 word );
+
+    /**
+     * Gets the number of set bits in the words.
+     */
+    static uint32 count( const uint64* words, uint32 wordCount );
+
+    /**
+     * Gets the index of the first set bit at or after start.
+     *
+     * Returns NOT_FOUND if there is none.
+     */
+    static uint32 findNext( const uint64* words, uint32 wordCount,
+                            uint32 start );
+};
+
+// FUNCTIONS
+inline
+constexpr uint32 BitUtils::wordsFor( uint32 bitCount )
+{
+    return ( bitCount + WORD_BITS - 1 ) / WORD_BITS;
+}
+
+inline
+constexpr uint64 BitUtils::tailMask( uint32 bitCount )
+{
+    return bitCount % WORD_BITS == 0
+        ? ~static_cast<uint64>( 0 )
+        : ( static_cast<uint64>( 1 ) << ( bitCount % WORD_BITS ) ) - 1;
+}
+
+inline
+uint32 BitUtils::popcount( uint64 word )
+{
+#if defined( _MSC_VER ) && defined( _M_X64 )
+    return static_cast<uint32>( __popcnt64( word ) );
+#elif defined( _MSC_VER )
+    word = word - ( ( word >> 1 ) & 0x5555555555555555ull );
+    word = ( word & 0x3333333333333333ull ) +
+           ( ( word >> 2 ) & 0x3333333333333333ull );
+    word = ( word + ( word >> 4 ) ) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<uint32>( ( word * 0x0101010101010101ull ) >> 56 );
+#else
+    return static_cast<uint32>( __builtin_popcountll( word ) );
+#endif
+}
+
+inline
+uint32 BitUtils::lowestBit( uint64 word )
+{
+    assert( word != 0 );
+#if defined( _MSC_VER ) && defined( _M_X64 )
+    unsigned long index;
+    _BitScanForward64( &index, word );
+    return static_cast<uint32>( index );
+#elif defined( _MSC_VER )
+    unsigned long index;
+    if ( _BitScanForward( &index, static_cast<unsigned long>( word ) ) )
+    {
+        return static_cast<uint32>( index );
+    }
+    _BitScanForward( &index, static_cast<unsigned long>( word >> 32 ) );
+    return static_cast<uint32>( index ) + 32;
+#else
+    return static_cast<uint32>( __builtin_ctzll( word ) );
+#endif
+}
+
+inline
+uint32 BitUtils::count( const uint64* words, uint32 wordCount )
+{
+    uint32 total = 0;
+    uint32 i;
+    for ( i = 0; i < wordCount; ++i )
+    {
+        total += popcount( words[i] );
+    }
+
+    return total;
+}
+
+inline
+uint32 BitUtils::findNext( const uint64* words, uint32 wordCount,
+                           uint32 start )
+{
+    uint32 i = start / WORD_BITS;
+    if ( i >= wordCount )
+    {
+        return NOT_FOUND;
+    }
+
+    // drop the bits of the first word that come before start
+    const uint64 kept = ~static_cast<uint64>( 0 ) << ( start % WORD_BITS );
+    uint64 word = words[i] & kept;
+    while ( word == 0 )
+    {
+        if ( ++i == wordCount )
+        {
+            return NOT_FOUND;
+        }
+        word = words[i];
+    }
+
+    return i * WORD_BITS + lowestBit( word );
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif
@@ -0,0 +1,207 @@
+// container_registry.h
+//
+// Defines a debug registry that snapshots the statistics of live containers.
+//
+// Containers are not registered on their own, so the registry costs nothing
+// until something opts in. Code that wants a container to show up in memory
+// reports adds it under a tag, such as "scene" or "render", and removes it
+// before the container is destroyed. A snapshot then gathers the stats() of
+// every registered container, or of those with a given tag, so oversized or
+// underused containers can be found and their capacities tuned.
+//
+// The registry is guarded by a mutex, but snapshots read the containers
+// themselves and so must not race with changes to them.
+//
+#ifndef NGE_CNTR_CONTAINER_REGISTRY_H
+#define NGE_CNTR_CONTAINER_REGISTRY_H
+
+#include <mutex>
+
+#include "engine/intdef.h"
+#include "engine/containers/container_stats.h"
+#include "engine/containers/dynamic_array.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+class ContainerRegistry
+{
+  public:
+    // STRUCTURES
+    /**
+     * Defines the statistics of one registered container.
+     */
+    struct Entry
+    {
+        /**
+         * The tag the container was added with.
+         */
+        const char* tag;
+
+        /**
+         * The registered container.
+         */
+        const void* container;
+
+        /**
+         * The statistics of the container when the snapshot was taken.
+         */
+        ContainerStats stats;
+    };
+
+  private:
+    // TYPES
+    /**
+     * Gets the statistics of a type erased container.
+     */
+    typedef ContainerStats ( *StatsFunction )( const void* container );
+
+    // STRUCTURES
+    /**
+     * Defines a registered container.
+     */
+    struct Record
+    {
+        const char* tag;
+        const void* container;
+        StatsFunction stats;
+    };
+
+    // MEMBERS
+    /**
+     * Guards the records.
+     */
+    mutable std::mutex _mutex;
+
+    /**
+     * The registered containers.
+     */
+    DynamicArray<Record> _records;
+
+    // CONSTRUCTORS
+    /**
+     * Disabled: a registry does not own its containers so cannot be copied.
+     */
+    ContainerRegistry( const ContainerRegistry& registry ) = delete;
+
+    // OPERATORS
+    /**
+     * Disabled: a registry does not own its containers so cannot be copied.
+     */
+    ContainerRegistry& operator=( const ContainerRegistry& registry ) = delete;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the statistics of a container of type C.
+     */
+    template <typename C>
+    static ContainerStats statsOf( const void* container );
+
+    /**
+     * Adds the record of a container.
+     */
+    void addRecord( const char* tag, const void* container,
+                    StatsFunction stats );
+
+    /**
+     * Adds the entry of each record with a matching tag to the given array.
+     *
+     * A null tag matches every record.
+     */
+    void collect( const char* tag, DynamicArray<Entry>* entries ) const;
+
+  public:
+    // GLOBAL FUNCTIONS
+    /**
+     * Gets the registry shared by the whole engine.
+     */
+    static ContainerRegistry& global();
+
+    // CONSTRUCTORS
+    /**
+     * Constructs a new empty registry.
+     */
+    ContainerRegistry();
+
+    /**
+     * Destructs the registry.
+     */
+    ~ContainerRegistry();
+
+    // MEMBER FUNCTIONS
+    /**
+     * Adds the container under the given tag.
+     *
+     * The tag is not copied, so it is usually a string literal.
+     *
+     * Behavior is undefined when:
+     * the container is destroyed before it is removed
+     * the tag is destroyed before the container is removed
+     * C has no stats() function
+     */
+    template <typename C>
+    void add( const char* tag, const C* container );
+
+    /**
+     * Removes the container.
+     *
+     * Returns false if the container was not registered.
+     */
+    bool remove( const void* container );
+
+    /**
+     * Replaces the contents of the array with the statistics of every
+     * registered container.
+     */
+    void snapshot( DynamicArray<Entry>* entries ) const;
+
+    /**
+     * Replaces the contents of the array with the statistics of every
+     * container registered with the given tag.
+     */
+    void snapshot( const char* tag, DynamicArray<Entry>* entries ) const;
+
+    /**
+     * Gets the number of registered containers.
+     */
+    uint32 size() const;
+};
+
+// HELPER FUNCTIONS
+template <typename C>
+inline
+ContainerStats ContainerRegistry::statsOf( const void* container )
+{
+    return static_cast<const C*>( container )->stats();
+}
+
+// MEMBER FUNCTIONS
+template <typename C>
+inline
+void ContainerRegistry::add( const char* tag, const C* container )
+{
+    addRecord( tag, container, &ContainerRegistry::statsOf<C> );
+}
+
+inline
+void ContainerRegistry::snapshot( DynamicArray<Entry>* entries ) const
+{
+    collect( nullptr, entries );
+}
+
+inline
+void ContainerRegistry::snapshot( const char* tag,
+                                  DynamicArray<Entry>* entries ) const
+{
+    assert( tag != nullptr );
+    collect( tag, entries );
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif
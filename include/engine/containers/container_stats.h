@@ -0,0 +1,109 @@
+// container_stats.h
+//
+// Defines the memory footprint and occupancy statistics that every
+// container reports through stats().
+//
+// Byte counts only cover memory the container got from its allocator, so
+// inline storage such as that of a FixedBitset or of a SmallArray that has
+// not spilled reserves no bytes. Fields that do not apply to a container,
+// like the bucket count of an array, are left at zero.
+//
+#ifndef NGE_CNTR_CONTAINER_STATS_H
+#define NGE_CNTR_CONTAINER_STATS_H
+
+#include "engine/intdef.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+struct ContainerStats
+{
+    // MEMBERS
+    /**
+     * The number of items in the container.
+     */
+    uint32 size;
+
+    /**
+     * The number of items that fit without allocating.
+     */
+    uint32 capacity;
+
+    /**
+     * The number of bytes taken up by the items.
+     */
+    uint64 bytesUsed;
+
+    /**
+     * The number of bytes allocated, including any index or bookkeeping.
+     */
+    uint64 bytesReserved;
+
+    /**
+     * The number of entries waiting on a free list.
+     */
+    uint32 freeCount;
+
+    /**
+     * The number of hash buckets or bins.
+     */
+    uint32 bucketCount;
+
+    /**
+     * The longest probe sequence, or chain past its first link, of any
+     * item.
+     */
+    uint32 maxProbeLength;
+
+    // CONSTRUCTORS
+    /**
+     * Constructs statistics of an empty container that allocated nothing.
+     */
+    ContainerStats();
+
+    // MEMBER FUNCTIONS
+    /**
+     * Gets the number of items per bucket, or per unit of capacity for
+     * containers without buckets.
+     *
+     * Returns 0 when there is neither.
+     */
+    float loadFactor() const;
+
+    /**
+     * Gets the number of bytes allocated but not taken up by items.
+     */
+    uint64 bytesWasted() const;
+};
+
+// CONSTRUCTORS
+inline
+ContainerStats::ContainerStats()
+    : size( 0 ), capacity( 0 ), bytesUsed( 0 ), bytesReserved( 0 ),
+      freeCount( 0 ), bucketCount( 0 ), maxProbeLength( 0 )
+{
+}
+
+// MEMBER FUNCTIONS
+inline
+float ContainerStats::loadFactor() const
+{
+    const uint32 slots = bucketCount > 0 ? bucketCount : capacity;
+    return slots > 0
+        ? static_cast<float>( size ) / static_cast<float>( slots ) : 0.0f;
+}
+
+inline
+uint64 ContainerStats::bytesWasted() const
+{
+    return bytesReserved > bytesUsed ? bytesReserved - bytesUsed : 0;
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif
@@ -8,6 +8,10 @@
 //
 // When the array grows or shrinks it gradually copies over the old items to
 // reduce the overhead of resizing.
+//
+// Only the live items are constructed. The rest of the block is raw storage
+// from the allocator, so growing costs one move construction per item and T
+// does not need a default constructor.
 
 #ifndef NGE_CNTR_DYNAMIC_ARRAY_H
 #define NGE_CNTR_DYNAMIC_ARRAY_H
@@ -17,6 +21,7 @@
 #include <stdexcept>
 #include <utility>
 
+#include "engine/containers/container_stats.h"
 #include "engine/memory/allocator_guard.h"
 #include "engine/memory/iallocator.h"
 #include "engine/memory/memory_utils.h"
@@ -177,6 +182,21 @@ class DynamicArray
      */
     void resize(uint32 newCapacity);
 
+    /**
+     * Copies the items of the given array to the start of this array's
+     * block.
+     *
+     * Behavior is undefined when:
+     * this array is not empty
+     * this array's capacity is less than the size of the given array
+     */
+    void copyFrom( const DynamicArray<T>& array );
+
+    /**
+     * Destroys the live items and releases the block.
+     */
+    void release();
+
     /**
      * Shifts the given number of items forward one spot starting at the given
      * index.
@@ -326,6 +346,37 @@ class DynamicArray
      */
     void insertAt( uint32 index, T&& value );
 
+    /**
+     * Constructs a value at the end of the array from the given arguments
+     * and gets it.
+     *
+     * The value is constructed directly in the array's storage.
+     */
+    template <typename... Args>
+    T& emplace( Args&&... args );
+
+    /**
+     * Constructs a value at the front of the array from the given arguments
+     * and gets it.
+     *
+     * The value is constructed directly in the array's storage.
+     */
+    template <typename... Args>
+    T& emplaceFront( Args&&... args );
+
+    /**
+     * Constructs a value at the given index in the array from the given
+     * arguments and gets it.
+     *
+     * The value is constructed directly in the array's storage. If the
+     * constructor throws, the array is left as it was.
+     *
+     * Throws a runtime_error when:
+     * index is out of bounds
+     */
+    template <typename... Args>
+    T& emplaceAt( uint32 index, Args&&... args );
+
     /**
      * Removes the value at the back of the array.
      */
@@ -353,6 +404,14 @@ class DynamicArray
      */
     void clear();
 
+    /**
+     * Grows the array so it can hold at least the given number of items
+     * without reallocating.
+     *
+     * This never reduces the capacity.
+     */
+    void reserve( uint32 capacity );
+
     /**
      * Gets an iterator at the start of the array.
      */
@@ -394,6 +453,16 @@ class DynamicArray
      * Checks if the array is empty.
      */
     bool isEmpty() const;
+
+    /**
+     * Gets the number of items the array can hold without reallocating.
+     */
+    uint32 capacity() const;
+
+    /**
+     * Gets the memory footprint and occupancy of the array.
+     */
+    ContainerStats stats() const;
 };
 
 // CONSTANTS
@@ -407,7 +476,7 @@ DynamicArray<T>::DynamicArray()
     : _allocator(), _values( nullptr ), _first( 0 ), _size( 0 ),
       _capacity( MIN_CAPACITY )
 {
-    _values = _allocator.get( _capacity );
+    _values = _allocator.getRaw( _capacity );
 }
 
 template <typename T>
@@ -416,7 +485,7 @@ DynamicArray<T>::DynamicArray( mem::IAllocator<T>* allocator )
     : _allocator( allocator ), _values( nullptr ), _first( 0 ),
       _size( 0 ), _capacity( MIN_CAPACITY )
 {
-    _values = _allocator.get( _capacity );
+    _values = _allocator.getRaw( _capacity );
 }
 
 template <typename T>
@@ -430,7 +499,7 @@ DynamicArray<T>::DynamicArray( uint32 capacity )
         _capacity <<= 1;
     }
 
-    _values = _allocator.get( _capacity );
+    _values = _allocator.getRaw( _capacity );
 }
 
 template <typename T>
@@ -444,64 +513,27 @@ DynamicArray<T>::DynamicArray( mem::IAllocator<T>* allocator, uint32 capacity )
         _capacity <<= 1;
     }
 
-    _values = _allocator.get( _capacity );
+    _values = _allocator.getRaw( _capacity );
 }
 
 template <typename T>
 DynamicArray<T>::DynamicArray( const DynamicArray<T>& array )
     : _allocator( array._allocator ), _values( nullptr ), _first( 0 ),
-      _size( array._size ), _capacity( array._capacity )
+      _size( 0 ), _capacity( array._capacity )
 {
-    using namespace mem;
-
-    uint32 a;
-    uint32 b;
     if ( array._values != nullptr )
     {
-        _values = _allocator.get( _capacity );
-        a = array._capacity - ( array._first + array._size );
-        b = ( array._first + array._size ) % array._capacity;
-
-        if ( a >= array._size )
-        {
-            MemoryUtils::copy( _values, array._values + array._first,
-                               array._size );
-        }
-        else
-        {
-            MemoryUtils::copy( _values, array._values + array._first, a );
-            MemoryUtils::copy( _values + a, array._values, b );
-        }
+        _values = _allocator.getRaw( _capacity );
+        copyFrom( array );
     }
 }
 
 template <typename T>
 DynamicArray<T>::DynamicArray( DynamicArray<T>&& array )
-    : _allocator( array._allocator ), _values( nullptr ), _first( 0 ),
-      _size( array._size ), _capacity( array._capacity )
+    : _allocator( array._allocator ), _values( array._values ),
+      _first( array._first ), _size( array._size ),
+      _capacity( array._capacity )
 {
-    using namespace mem;
-
-    uint32 a;
-    uint32 b;
-    if ( array._values != nullptr )
-    {
-        _values = _allocator.get( _capacity );
-        a = array._capacity - ( array._first + array._size );
-        b = ( array._first + array._size ) % array._capacity;
-
-        if ( a >= array._size )
-        {
-            MemoryUtils::move( _values, array._values + array._first,
-                               array._size );
-        }
-        else
-        {
-            MemoryUtils::move( _values, array._values + array._first, a );
-            MemoryUtils::move( _values + a, array._values, b );
-        }
-    }
-
     array._allocator = nullptr;
     array._values = nullptr;
     array._first = 0;
@@ -512,12 +544,7 @@ DynamicArray<T>::DynamicArray( DynamicArray<T>&& array )
 template <typename T>
 DynamicArray<T>::~DynamicArray()
 {
-    if ( _values != nullptr )
-    {
-        _allocator.release( _values, _capacity );
-        _values = nullptr;
-    }
-
+    release();
     _allocator = nullptr;
 }
 
@@ -526,37 +553,22 @@ template <typename T>
 DynamicArray<T>& DynamicArray<T>::operator=(
     const cntr::DynamicArray<T>& array )
 {
-    using namespace mem;
-
-    if ( _values != nullptr )
+    if ( this == &array )
     {
-        _allocator.release( _values, _capacity );
-        _values = nullptr;
+        return *this;
     }
 
+    release();
+
     _allocator = array._allocator;
     _first = 0;
-    _size = array._size;
+    _size = 0;
     _capacity = array._capacity;
 
-    uint32 a;
-    uint32 b;
     if ( array._values != nullptr )
     {
-        _values = _allocator.get( _capacity );
-        a = array._capacity - ( array._first + array._size );
-        b = ( array._first + array._size ) % array._capacity;
-
-        if ( a >= array._size )
-        {
-            MemoryUtils::copy( _values, array._values + array._first,
-                               array._size );
-        }
-        else
-        {
-            MemoryUtils::copy( _values, array._values + array._first, a );
-            MemoryUtils::copy( _values + a, array._values, b );
-        }
+        _values = _allocator.getRaw( _capacity );
+        copyFrom( array );
     }
 
     return *this;
@@ -565,34 +577,19 @@ DynamicArray<T>& DynamicArray<T>::operator=(
 template <typename T>
 DynamicArray<T>& DynamicArray<T>::operator=( cntr::DynamicArray<T>&& array )
 {
-    using namespace mem;
+    if ( this == &array )
+    {
+        return *this;
+    }
+
+    release();
 
     _allocator = array._allocator;
-    _values = nullptr;
-    _first = 0;
+    _values = array._values;
+    _first = array._first;
     _size = array._size;
     _capacity = array._capacity;
 
-    uint32 a;
-    uint32 b;
-    if ( array._values != nullptr )
-    {
-        _values = _allocator.get( _capacity );
-        a = array._capacity - ( array._first + array._size );
-        b = ( array._first + array._size ) % array._capacity;
-
-        if ( a >= array._size )
-        {
-            MemoryUtils::move( _values, array._values + array._first,
-                               array._size );
-        }
-        else
-        {
-            MemoryUtils::move( _values, array._values + array._first, a );
-            MemoryUtils::move( _values + a, array._values, b );
-        }
-    }
-
     array._allocator = nullptr;
     array._values = nullptr;
     array._first = 0;
@@ -640,8 +637,8 @@ void DynamicArray<T>::push( const T& value )
         grow();
     }
 
+    new ( _values + wrap( _size ) ) T( value );
     ++_size;
-    ( *this )[_size - 1] = value;
 }
 
 template <typename T>
@@ -653,8 +650,8 @@ void DynamicArray<T>::push( T&& value )
         grow();
     }
 
+    new ( _values + wrap( _size ) ) T( std::move( value ) );
     ++_size;
-    ( *this )[_size - 1] = std::move( value );
 }
 
 template <typename T>
@@ -667,8 +664,8 @@ void DynamicArray<T>::pushFront( const T& value )
     }
 
     _first = (_first > 0) ? _first - 1 : _capacity - 1;
+    new ( _values + _first ) T( value );
     ++_size;
-    ( *this )[0] = value;
 }
 
 template <typename T>
@@ -680,8 +677,8 @@ void DynamicArray<T>::pushFront( T&& value )
     }
 
     _first = (_first > 0) ? _first - 1 : _capacity - 1;
+    new ( _values + _first ) T( std::move( value ) );
     ++_size;
-    ( *this )[0] = std::move( value );
 }
 
 template <typename T>
@@ -697,9 +694,17 @@ void DynamicArray<T>::insertAt( uint32 index, const T& value )
         grow();
     }
 
-    shiftForward( index );
+    if ( index == _size )
+    {
+        new ( _values + wrap( _size ) ) T( value );
+    }
+    else
+    {
+        shiftForward( index );
+        _values[wrap( index )] = value;
+    }
+
     ++_size;
-    ( *this )[index] = value;
 }
 
 template <typename T>
@@ -715,9 +720,96 @@ void DynamicArray<T>::insertAt( uint32 index, T&& value )
         grow();
     }
 
+    if ( index == _size )
+    {
+        new ( _values + wrap( _size ) ) T( std::move( value ) );
+    }
+    else
+    {
+        shiftForward( index );
+        _values[wrap( index )] = std::move( value );
+    }
+
+    ++_size;
+}
+
+template <typename T>
+template <typename... Args>
+inline
+T& DynamicArray<T>::emplace( Args&&... args )
+{
+    if ( shouldGrow() )
+    {
+        grow();
+    }
+
+    T* value = new ( _values + wrap( _size ) )
+        T( std::forward<Args>( args )... );
+    ++_size;
+
+    return *value;
+}
+
+template <typename T>
+template <typename... Args>
+inline
+T& DynamicArray<T>::emplaceFront( Args&&... args )
+{
+    if ( shouldGrow() )
+    {
+        grow();
+    }
+
+    const uint32 first = (_first > 0) ? _first - 1 : _capacity - 1;
+    T* value = new ( _values + first ) T( std::forward<Args>( args )... );
+    _first = first;
+    ++_size;
+
+    return *value;
+}
+
+template <typename T>
+template <typename... Args>
+T& DynamicArray<T>::emplaceAt( uint32 index, Args&&... args )
+{
+    if ( index > _size )
+    {
+        throw std::runtime_error( "Index is out of bounds!" );
+    }
+
+    if ( index == _size )
+    {
+        return emplace( std::forward<Args>( args )... );
+    }
+
+    if ( shouldGrow() )
+    {
+        grow();
+    }
+
+    // the shift leaves a moved from item in the slot so it is replaced
     shiftForward( index );
+    T* value = _values + wrap( index );
+    value->~T();
+    try
+    {
+        new ( value ) T( std::forward<Args>( args )... );
+    }
+    catch ( ... )
+    {
+        // the slot is raw again, so the item that was shifted out of it is
+        // moved back, the rest of the tail follows and the moved from item
+        // left past the end is destroyed
+        new ( value ) T( std::move( _values[wrap( index + 1 )] ) );
+        ++_size;
+        shiftBackward( index + 1 );
+        --_size;
+        _values[wrap( _size )].~T();
+        throw;
+    }
     ++_size;
-    ( *this )[index] = std::move( value );
+
+    return *value;
 }
 
 template <typename T>
@@ -731,6 +823,7 @@ T DynamicArray<T>::pop()
     }
 
     T elem = std::move( ( *this )[_size - 1] );
+    _values[wrap( _size - 1 )].~T();
     --_size;
     return elem;
 }
@@ -746,7 +839,8 @@ T DynamicArray<T>::popFront()
     }
 
     T elem = std::move( ( *this )[0] );
-    ++_first;
+    _values[_first].~T();
+    _first = wrap( 1 );
     --_size;
     return elem;
 }
@@ -768,6 +862,7 @@ T DynamicArray<T>::removeAt( uint32 index )
 
     T elem = std::move( ( *this )[index] );
     shiftBackward( index );
+    _values[wrap( _size - 1 )].~T();
     --_size;
 
     return elem;
@@ -778,7 +873,7 @@ inline
 bool DynamicArray<T>::remove( const T& value )
 {
     uint32 index = indexOf( value );
-    if ( value == static_cast<uint32>( -1 ) )
+    if ( index == static_cast<uint32>( -1 ) )
     {
         return false;
     }
@@ -790,10 +885,31 @@ bool DynamicArray<T>::remove( const T& value )
 template <typename T>
 void DynamicArray<T>::clear()
 {
+    using namespace mem;
+
+    const uint32 head = std::min( _size, _capacity - _first );
+    MemoryUtils::destroy( _values + _first, head );
+    MemoryUtils::destroy( _values, _size - head );
+
     _size = 0;
     _first = 0;
 }
 
+template <typename T>
+void DynamicArray<T>::reserve( uint32 capacity )
+{
+    uint32 newCapacity = _capacity;
+    while ( newCapacity < capacity )
+    {
+        newCapacity <<= 1;
+    }
+
+    if ( newCapacity != _capacity )
+    {
+        resize( newCapacity );
+    }
+}
+
 template <typename T>
 typename DynamicArray<T>::Iterator DynamicArray<T>::begin()
 {
@@ -864,6 +980,27 @@ bool DynamicArray<T>::isEmpty() const
     return _size <= 0;
 }
 
+template <typename T>
+inline
+uint32 DynamicArray<T>::capacity() const
+{
+    return _capacity;
+}
+
+template <typename T>
+inline
+ContainerStats DynamicArray<T>::stats() const
+{
+    ContainerStats stats;
+    stats.size = _size;
+    stats.capacity = _capacity;
+    stats.bytesUsed = static_cast<uint64>( _size ) * sizeof( T );
+    stats.bytesReserved = _values != nullptr
+        ? static_cast<uint64>( _capacity ) * sizeof( T ) : 0;
+
+    return stats;
+}
+
 // HELPER FUNCTIONS
 template <typename T>
 inline
@@ -884,46 +1021,108 @@ void DynamicArray<T>::shrink()
 template <typename T>
 void DynamicArray<T>::resize( uint32 newCapacity )
 {
+    using namespace mem;
+
     assert( _values != nullptr );
     uint32 oldCapacity = _capacity;
     uint32 oldFirst = _first;
     T* oldValues = _values;
 
     _capacity = newCapacity;
-    _values = _allocator.get( _capacity );
+    _values = _allocator.getRaw( _capacity );
     _first = 0;
 
-    uint32 i;
-    for( i = 0; i < _size; ++i)
+    // the items are at most two runs, one up to the end of the old block and
+    // one that wrapped around to its start
+    const uint32 head = std::min( _size, oldCapacity - oldFirst );
+    MemoryUtils::moveConstruct( _values, oldValues + oldFirst, head );
+    MemoryUtils::moveConstruct( _values + head, oldValues, _size - head );
+    MemoryUtils::destroy( oldValues + oldFirst, head );
+    MemoryUtils::destroy( oldValues, _size - head );
+
+    _allocator.releaseRaw( oldValues, oldCapacity );
+}
+
+template <typename T>
+void DynamicArray<T>::copyFrom( const DynamicArray<T>& array )
+{
+    using namespace mem;
+
+    assert( _size == 0 && _first == 0 );
+    assert( _capacity >= array._size );
+
+    const uint32 head = std::min( array._size,
+                                  array._capacity - array._first );
+    MemoryUtils::copyConstruct( _values, array._values + array._first,
+                                head );
+    MemoryUtils::copyConstruct( _values + head, array._values,
+                                array._size - head );
+    _size = array._size;
+}
+
+template <typename T>
+void DynamicArray<T>::release()
+{
+    if ( _values != nullptr )
     {
-        _values[i] = std::move( oldValues[( oldFirst + i ) % oldCapacity] );
+        clear();
+        _allocator.releaseRaw( _values, _capacity );
+        _values = nullptr;
     }
-
-    _allocator.release( oldValues, oldCapacity );
 }
 
 template <typename T>
 inline
 void DynamicArray<T>::shiftForward( uint32 start )
 {
-    assert( start >= 0 && start <= _size );
-    uint32 i;
-    for ( i = _size; i > start; --i )
+    using namespace mem;
+
+    assert( start < _size );
+    assert( _size < _capacity );
+
+    // the slot past the last item is raw storage so the last item is move
+    // constructed into it and the rest are move assigned
+    const uint32 from = wrap( start );
+    const uint32 last = wrap( _size - 1 );
+    new ( _values + wrap( _size ) ) T( std::move( _values[last] ) );
+
+    if ( from <= last )
     {
-        _values[wrap( i )] = std::move( _values[wrap( i - 1 )] );
+        MemoryUtils::moveBackward( _values + from + 1, _values + from,
+                                   last - from );
+        return;
     }
+
+    // the items wrap around the end of the block so shift the run at the
+    // start, carry the last item over the seam, then shift the run at the end
+    MemoryUtils::moveBackward( _values + 1, _values, last );
+    _values[0] = std::move( _values[_capacity - 1] );
+    MemoryUtils::moveBackward( _values + from + 1, _values + from,
+                               _capacity - 1 - from );
 }
 
 template <typename T>
 inline
 void DynamicArray<T>::shiftBackward( uint32 start )
 {
-    assert( start >= 0 && start < _size );
-    uint32 i;
-    for ( i = start; i < _size - 1; ++i )
+    using namespace mem;
+
+    assert( start < _size );
+
+    const uint32 to = wrap( start );
+    const uint32 last = wrap( _size - 1 );
+    if ( to <= last )
     {
-        _values[wrap( i )] = std::move( _values[wrap( i + 1 )] );
+        MemoryUtils::move( _values + to, _values + to + 1, last - to );
+        return;
     }
+
+    // the items wrap around the end of the block so shift the run at the
+    // end, carry the first item over the seam, then shift the run at the
+    // start
+    MemoryUtils::move( _values + to, _values + to + 1, _capacity - 1 - to );
+    _values[_capacity - 1] = std::move( _values[0] );
+    MemoryUtils::move( _values, _values + 1, last );
 }
 
 template <typename T>
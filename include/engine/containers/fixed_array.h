@@ -15,6 +15,7 @@
 #include <engine/port.h>
 
 #include "engine/intdef.h"
+#include "engine/containers/container_stats.h"
 #include "engine/memory/allocator_guard.h"
 #include "engine/memory/memory_utils.h"
 
@@ -349,6 +350,48 @@ class FixedArray
      */
     void insertAt( uint32 index, T&& value );
 
+    /**
+     * Constructs a value at the end of the array from the given arguments
+     * and gets it.
+     *
+     * The value is constructed directly in the array's storage. If the
+     * constructor throws, the array is left as it was.
+     *
+     * Behavior is undefined when:
+     * array is full.
+     */
+    template <typename... Args>
+    T& emplace( Args&&... args );
+
+    /**
+     * Constructs a value at the front of the array from the given arguments
+     * and gets it.
+     *
+     * The value is constructed directly in the array's storage. If the
+     * constructor throws, the array is left as it was.
+     *
+     * Behavior is undefined when:
+     * array is full.
+     */
+    template <typename... Args>
+    T& emplaceFront( Args&&... args );
+
+    /**
+     * Constructs a value at the given index in the array from the given
+     * arguments and gets it.
+     *
+     * The value is constructed directly in the array's storage. If the
+     * constructor throws, the array is left as it was.
+     *
+     * Throws a runtime_error when:
+     * index is out of bounds.
+     *
+     * Behavior is undefined when:
+     * array is full.
+     */
+    template <typename... Args>
+    T& emplaceAt( uint32 index, Args&&... args );
+
     /**
      * Removes the value at the back of the array.
      *
@@ -448,6 +491,13 @@ class FixedArray
      * Checks if the array is full.
      */
     bool isFull() const;
+
+    /**
+     * Gets the memory footprint and occupancy of the array.
+     *
+     * A wrapped array reserves no bytes since it does not own its data.
+     */
+    ContainerStats stats() const;
 };
 
 // CONSTANTS
@@ -673,12 +723,63 @@ void FixedArray<T>::insertAt( uint32 index, T&& value )
     assert( _size < _capacity );
     if ( index > _size )
     {
-        throw new std::runtime_error( "Index is out of bounds! ");
+        throw std::runtime_error( "Index is out of bounds!" );
     }
 
     shiftForward( index );
     ++_size;
-    _values[index] = value;
+    _values[index] = std::move( value );
+}
+
+template <typename T>
+template <typename... Args>
+inline
+T& FixedArray<T>::emplace( Args&&... args )
+{
+    return emplaceAt( _size, std::forward<Args>( args )... );
+}
+
+template <typename T>
+template <typename... Args>
+inline
+T& FixedArray<T>::emplaceFront( Args&&... args )
+{
+    return emplaceAt( 0, std::forward<Args>( args )... );
+}
+
+template <typename T>
+template <typename... Args>
+inline
+T& FixedArray<T>::emplaceAt( uint32 index, Args&&... args )
+{
+    assert( _size < _capacity );
+    if ( index > _size )
+    {
+        throw std::runtime_error( "Index is out of bounds!" );
+    }
+
+    shiftForward( index );
+    ++_size;
+
+    // every slot in the block holds a live item, either default
+    // constructed by the allocator or owned by the wrapped data, so the
+    // item in the slot is replaced
+    T* value = _values + index;
+    value->~T();
+    try
+    {
+        new ( value ) T( std::forward<Args>( args )... );
+    }
+    catch ( ... )
+    {
+        // put a live item back in the slot and undo the shift
+        new ( value ) T();
+        shiftBackward( index );
+        --_size;
+        throw;
+    }
+
+    return *value;
 }
 
 template <typename T>
@@ -836,6 +937,20 @@ bool FixedArray<T>::isFull() const
     return _size >= _capacity;
 }
 
+template <typename T>
+inline
+ContainerStats FixedArray<T>::stats() const
+{
+    ContainerStats stats;
+    stats.size = _size;
+    stats.capacity = _capacity;
+    stats.bytesUsed = static_cast<uint64>( _size ) * sizeof( T );
+    stats.bytesReserved = _values != nullptr && !_isDataExternal
+        ? static_cast<uint64>( _capacity ) * sizeof( T ) : 0;
+
+    return stats;
+}
+
 // HELPER FUNCTIONS
 template <typename T>
 inline
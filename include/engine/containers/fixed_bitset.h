@@ -0,0 +1,501 @@
+// fixed_bitset.h
+//
+// Defines a set of a fixed number of bits stored inline in 64 bit words.
+//
+// A bit costs one bit instead of the byte a bool takes, and whole words can
+// be read and written so an inner loop can test 64 flags at once.
+//
+#ifndef NGE_CNTR_FIXED_BITSET_H
+#define NGE_CNTR_FIXED_BITSET_H
+
+#include <assert.h>
+
+#include "engine/intdef.h"
+#include "engine/containers/bit_utils.h"
+#include "engine/containers/container_stats.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+template <uint32 N>
+class FixedBitset
+{
+    static_assert( N > 0, "A bitset must hold at least one bit." );
+
+  public:
+    // CONSTANTS
+    /**
+     * The number of words that hold the bits.
+     */
+    static constexpr uint32 WORD_COUNT = BitUtils::wordsFor( N );
+
+  private:
+    // MEMBERS
+    /**
+     * The words holding the bits.
+     */
+    uint64 _words[WORD_COUNT];
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a new bitset with every bit clear.
+     */
+    FixedBitset();
+
+    // OPERATORS
+    /**
+     * Keeps only the bits that are also set in the other bitset.
+     */
+    FixedBitset<N>& operator&=( const FixedBitset<N>& bitset );
+
+    /**
+     * Sets the bits that are set in the other bitset.
+     */
+    FixedBitset<N>& operator|=( const FixedBitset<N>& bitset );
+
+    /**
+     * Flips the bits that are set in the other bitset.
+     */
+    FixedBitset<N>& operator^=( const FixedBitset<N>& bitset );
+
+    /**
+     * Gets the bits set in both bitsets.
+     */
+    FixedBitset<N> operator&( const FixedBitset<N>& bitset ) const;
+
+    /**
+     * Gets the bits set in either bitset.
+     */
+    FixedBitset<N> operator|( const FixedBitset<N>& bitset ) const;
+
+    /**
+     * Gets the bits set in exactly one of the bitsets.
+     */
+    FixedBitset<N> operator^( const FixedBitset<N>& bitset ) const;
+
+    /**
+     * Gets a copy of the bitset with every bit flipped.
+     */
+    FixedBitset<N> operator~() const;
+
+    /**
+     * Checks if the same bits are set in both bitsets.
+     */
+    bool operator==( const FixedBitset<N>& bitset ) const;
+
+    /**
+     * Checks if the bitsets differ in any bit.
+     */
+    bool operator!=( const FixedBitset<N>& bitset ) const;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Checks if the bit is set.
+     *
+     * Behavior is undefined when:
+     * index is not less than N
+     */
+    bool test( uint32 index ) const;
+
+    /**
+     * Sets the bit.
+     *
+     * Behavior is undefined when:
+     * index is not less than N
+     */
+    void set( uint32 index );
+
+    /**
+     * Sets the bit to the given value.
+     *
+     * Behavior is undefined when:
+     * index is not less than N
+     */
+    void set( uint32 index, bool value );
+
+    /**
+     * Clears the bit.
+     *
+     * Behavior is undefined when:
+     * index is not less than N
+     */
+    void clear( uint32 index );
+
+    /**
+     * Flips the bit.
+     *
+     * Behavior is undefined when:
+     * index is not less than N
+     */
+    void flip( uint32 index );
+
+    /**
+     * Sets every bit.
+     */
+    void setAll();
+
+    /**
+     * Clears every bit.
+     */
+    void clearAll();
+
+    /**
+     * Gets the word holding bits index * 64 up to index * 64 + 63.
+     *
+     * Behavior is undefined when:
+     * index is not less than WORD_COUNT
+     */
+    uint64 word( uint32 index ) const;
+
+    /**
+     * Replaces the word holding bits index * 64 up to index * 64 + 63.
+     *
+     * Bits of the last word past N are ignored.
+     *
+     * Behavior is undefined when:
+     * index is not less than WORD_COUNT
+     */
+    void setWord( uint32 index, uint64 word );
+
+    /**
+     * Gets the number of set bits.
+     */
+    uint32 count() const;
+
+    /**
+     * Checks if any bit is set.
+     */
+    bool any() const;
+
+    /**
+     * Checks if no bit is set.
+     */
+    bool none() const;
+
+    /**
+     * Checks if every bit is set.
+     */
+    bool all() const;
+
+    /**
+     * Gets the index of the first set bit.
+     *
+     * Returns BitUtils::NOT_FOUND if no bit is set.
+     */
+    uint32 findFirst() const;
+
+    /**
+     * Gets the index of the first set bit after the given index.
+     *
+     * Returns BitUtils::NOT_FOUND if there is none.
+     */
+    uint32 findNext( uint32 index ) const;
+
+    /**
+     * Gets the number of bits in the bitset.
+     */
+    uint32 size() const;
+
+    /**
+     * Gets the number of words that hold the bits.
+     */
+    uint32 wordCount() const;
+
+    /**
+     * Gets the memory footprint and occupancy of the bitset.
+     *
+     * The words are stored inline so no bytes are reserved.
+     */
+    ContainerStats stats() const;
+};
+
+// CONSTANTS
+template <uint32 N>
+constexpr uint32 FixedBitset<N>::WORD_COUNT;
+
+// CONSTRUCTORS
+template <uint32 N>
+inline
+FixedBitset<N>::FixedBitset()
+{
+    clearAll();
+}
+
+// OPERATORS
+template <uint32 N>
+inline
+FixedBitset<N>& FixedBitset<N>::operator&=( const FixedBitset<N>& bitset )
+{
+    uint32 i;
+    for ( i = 0; i < WORD_COUNT; ++i )
+    {
+        _words[i] &= bitset._words[i];
+    }
+
+    return *this;
+}
+
+template <uint32 N>
+inline
+FixedBitset<N>& FixedBitset<N>::operator|=( const FixedBitset<N>& bitset )
+{
+    uint32 i;
+    for ( i = 0; i < WORD_COUNT; ++i )
+    {
+        _words[i] |= bitset._words[i];
+    }
+
+    return *this;
+}
+
+template <uint32 N>
+inline
+FixedBitset<N>& FixedBitset<N>::operator^=( const FixedBitset<N>& bitset )
+{
+    uint32 i;
+    for ( i = 0; i < WORD_COUNT; ++i )
+    {
+        _words[i] ^= bitset._words[i];
+    }
+
+    return *this;
+}
+
+template <uint32 N>
+inline
+FixedBitset<N> FixedBitset<N>::operator&( const FixedBitset<N>& bitset ) const
+{
+    return FixedBitset<N>( *this ) &= bitset;
+}
+
+template <uint32 N>
+inline
+FixedBitset<N> FixedBitset<N>::operator|( const FixedBitset<N>& bitset ) const
+{
+    return FixedBitset<N>( *this ) |= bitset;
+}
+
+template <uint32 N>
+inline
+FixedBitset<N> FixedBitset<N>::operator^( const FixedBitset<N>& bitset ) const
+{
+    return FixedBitset<N>( *this ) ^= bitset;
+}
+
+template <uint32 N>
+inline
+FixedBitset<N> FixedBitset<N>::operator~() const
+{
+    FixedBitset<N> bitset;
+    uint32 i;
+    for ( i = 0; i < WORD_COUNT; ++i )
+    {
+        bitset._words[i] = ~_words[i];
+    }
+    bitset._words[WORD_COUNT - 1] &= BitUtils::tailMask( N );
+
+    return bitset;
+}
+
+template <uint32 N>
+inline
+bool FixedBitset<N>::operator==( const FixedBitset<N>& bitset ) const
+{
+    uint32 i;
+    for ( i = 0; i < WORD_COUNT; ++i )
+    {
+        if ( _words[i] != bitset._words[i] )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <uint32 N>
+inline
+bool FixedBitset<N>::operator!=( const FixedBitset<N>& bitset ) const
+{
+    return !( *this == bitset );
+}
+
+// MEMBER FUNCTIONS
+template <uint32 N>
+inline
+bool FixedBitset<N>::test( uint32 index ) const
+{
+    assert( index < N );
+    return ( _words[index / BitUtils::WORD_BITS] >>
+             ( index % BitUtils::WORD_BITS ) ) & 1;
+}
+
+template <uint32 N>
+inline
+void FixedBitset<N>::set( uint32 index )
+{
+    assert( index < N );
+    _words[index / BitUtils::WORD_BITS] |=
+        static_cast<uint64>( 1 ) << ( index % BitUtils::WORD_BITS );
+}
+
+template <uint32 N>
+inline
+void FixedBitset<N>::set( uint32 index, bool value )
+{
+    if ( value )
+    {
+        set( index );
+    }
+    else
+    {
+        clear( index );
+    }
+}
+
+template <uint32 N>
+inline
+void FixedBitset<N>::clear( uint32 index )
+{
+    assert( index < N );
+    _words[index / BitUtils::WORD_BITS] &=
+        ~( static_cast<uint64>( 1 ) << ( index % BitUtils::WORD_BITS ) );
+}
+
+template <uint32 N>
+inline
+void FixedBitset<N>::flip( uint32 index )
+{
+    assert( index < N );
+    _words[index / BitUtils::WORD_BITS] ^=
+        static_cast<uint64>( 1 ) << ( index % BitUtils::WORD_BITS );
+}
+
+template <uint32 N>
+inline
+void FixedBitset<N>::setAll()
+{
+    uint32 i;
+    for ( i = 0; i < WORD_COUNT; ++i )
+    {
+        _words[i] = ~static_cast<uint64>( 0 );
+    }
+    _words[WORD_COUNT - 1] = BitUtils::tailMask( N );
+}
+
+template <uint32 N>
+inline
+void FixedBitset<N>::clearAll()
+{
+    uint32 i;
+    for ( i = 0; i < WORD_COUNT; ++i )
+    {
+        _words[i] = 0;
+    }
+}
+
+template <uint32 N>
+inline
+uint64 FixedBitset<N>::word( uint32 index ) const
+{
+    assert( index < WORD_COUNT );
+    return _words[index];
+}
+
+template <uint32 N>
+inline
+void FixedBitset<N>::setWord( uint32 index, uint64 word )
+{
+    assert( index < WORD_COUNT );
+    _words[index] = index == WORD_COUNT - 1
+        ? word & BitUtils::tailMask( N ) : word;
+}
+
+template <uint32 N>
+inline
+uint32 FixedBitset<N>::count() const
+{
+    return BitUtils::count( _words, WORD_COUNT );
+}
+
+template <uint32 N>
+inline
+bool FixedBitset<N>::any() const
+{
+    uint32 i;
+    for ( i = 0; i < WORD_COUNT; ++i )
+    {
+        if ( _words[i] != 0 )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <uint32 N>
+inline
+bool FixedBitset<N>::none() const
+{
+    return !any();
+}
+
+template <uint32 N>
+inline
+bool FixedBitset<N>::all() const
+{
+    return count() == N;
+}
+
+template <uint32 N>
+inline
+uint32 FixedBitset<N>::findFirst() const
+{
+    return BitUtils::findNext( _words, WORD_COUNT, 0 );
+}
+
+template <uint32 N>
+inline
+uint32 FixedBitset<N>::findNext( uint32 index ) const
+{
+    return index + 1 < N
+        ? BitUtils::findNext( _words, WORD_COUNT, index + 1 )
+        : BitUtils::NOT_FOUND;
+}
+
+template <uint32 N>
+inline
+uint32 FixedBitset<N>::size() const
+{
+    return N;
+}
+
+template <uint32 N>
+inline
+uint32 FixedBitset<N>::wordCount() const
+{
+    return WORD_COUNT;
+}
+
+template <uint32 N>
+inline
+ContainerStats FixedBitset<N>::stats() const
+{
+    ContainerStats stats;
+    stats.size = N;
+    stats.capacity = N;
+    stats.bytesUsed = WORD_COUNT * sizeof( uint64 );
+
+    return stats;
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif
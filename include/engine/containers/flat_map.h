@@ -0,0 +1,565 @@
+// flat_map.h
+//
+// Defines a map that keeps its pairs sorted by key in a single DynamicArray.
+//
+// Lookups are binary searches over contiguous pairs and there is no index to
+// allocate, so small read-mostly tables take a fraction of the memory of a
+// Map and are faster to scan. Assigning a new key shifts every later pair,
+// so tables that are built once should use assignAll.
+//
+#ifndef NGE_CNTR_FLAT_MAP_H
+#define NGE_CNTR_FLAT_MAP_H
+
+#include <assert.h>
+#include <utility>
+
+#include "engine/intdef.h"
+#include "engine/containers/container_stats.h"
+#include "engine/containers/dynamic_array.h"
+#include "engine/containers/sort_utils.h"
+#include "engine/memory/iallocator.h"
+#include "engine/utility/ordering.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+template <typename K, typename V, typename O = util::Ordering<K>>
+class FlatMap
+{
+  public:
+    // STRUCTURES
+    struct KVPair
+    {
+        K key;
+        V value;
+    };
+
+    // TYPES
+    /**
+     * Iterates the pairs in key order.
+     */
+    typedef typename DynamicArray<KVPair>::ConstIterator ConstIterator;
+
+    // CONSTRUCTORS
+    /**
+     * Constructs a new map.
+     */
+    FlatMap();
+
+    /**
+     * Constructs a new map with the given initial capacity.
+     */
+    FlatMap( uint32 capacity );
+
+    /**
+     * Constructs a new map with the given ordering.
+     */
+    FlatMap( const O& ordering );
+
+    /**
+     * Constructs a new map with the given allocator.
+     */
+    FlatMap( mem::IAllocator<KVPair>* pairAlloc );
+
+    /**
+     * Constructs a new map with the given allocator and initial capacity.
+     */
+    FlatMap( mem::IAllocator<KVPair>* pairAlloc, uint32 capacity );
+
+    /**
+     * Constructs a new map using the given allocator, initial capacity and
+     * ordering.
+     */
+    FlatMap( mem::IAllocator<KVPair>* pairAlloc, uint32 capacity,
+             const O& ordering );
+
+    /**
+     * Constructs a copy of the given map.
+     */
+    FlatMap( const FlatMap<K, V, O>& map );
+
+    /**
+     * Moves the map to a new instance.
+     */
+    FlatMap( FlatMap<K, V, O>&& map );
+
+    /**
+     * Destructs the map.
+     */
+    ~FlatMap();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the given map.
+     */
+    FlatMap<K, V, O>& operator=( const FlatMap<K, V, O>& map );
+
+    /**
+     * Moves the map data to this instance.
+     */
+    FlatMap<K, V, O>& operator=( FlatMap<K, V, O>&& map );
+
+    /**
+     * Gets the pair at the given index in key order.
+     *
+     * Behavior is undefined when:
+     * index is not less than the size of the map.
+     */
+    const KVPair& operator[]( uint32 index ) const;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Assigns a copy of the given value to the given key in the map.
+     *
+     * This will replace any already existing value associated with the key.
+     * Adding a new key moves every pair that is ordered after it.
+     */
+    void assign( const K& key, const V& value );
+
+    /**
+     * Moves the value to the given key in the map.
+     *
+     * This will replace any already existing value associated with the key.
+     * Adding a new key moves every pair that is ordered after it.
+     */
+    void assign( K&& key, V&& value );
+
+    /**
+     * Gets the value associated with the given key.
+     *
+     * Returns nullptr if the key is not in the map. The pointer is
+     * invalidated when the map is modified.
+     */
+    V* lookup( const K& key );
+
+    /**
+     * Gets the value associated with the given key.
+     *
+     * Returns nullptr if the key is not in the map. The pointer is
+     * invalidated when the map is modified.
+     */
+    const V* lookup( const K& key ) const;
+
+    /**
+     * Removes the given key and its associated value from the map.
+     *
+     * The remaining pairs stay in key order.
+     */
+    void remove( const K& key );
+
+    /**
+     * Assigns each of the given pairs to the map.
+     *
+     * The pairs are appended and the whole map is sorted once instead of
+     * inserting each pair in place. Later pairs replace the values of
+     * earlier pairs with the same key.
+     *
+     * Behavior is undefined when:
+     * pairs is nullptr and count is not 0.
+     */
+    void assignAll( const KVPair* pairs, uint32 count );
+
+    /**
+     * Makes room for at least the given number of pairs so that assigning
+     * up to that many does not reallocate.
+     */
+    void reserve( uint32 capacity );
+
+    /**
+     * Checks if the key exists in the map.
+     */
+    bool hasKey( const K& key ) const;
+
+    /**
+     * Gets the index of the given key in key order.
+     *
+     * Returns (uint32)-1 if the key is not in the map.
+     */
+    uint32 indexOf( const K& key ) const;
+
+    /**
+     * Removes all of the items from the map.
+     */
+    void clear();
+
+    /**
+     * Gets the number of items in the map.
+     */
+    uint32 size() const;
+
+    /**
+     * Checks if the map is empty.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Gets the memory footprint and occupancy of the map.
+     */
+    ContainerStats stats() const;
+
+    /**
+     * Gets an iterator for the map.
+     */
+    ConstIterator cbegin() const;
+
+    /**
+     * Gets an iterator for the end of the map.
+     */
+    ConstIterator cend() const;
+
+  private:
+    // TYPES
+    /**
+     * Compares pairs and keys by key with the map's ordering.
+     */
+    struct KeyLess
+    {
+        const O* ordering;
+
+        bool operator()( const KVPair& lhs, const KVPair& rhs ) const;
+
+        bool operator()( const KVPair& lhs, const K& rhs ) const;
+
+        bool operator()( const K& lhs, const KVPair& rhs ) const;
+    };
+
+    // MEMBERS
+    /**
+     * The pairs sorted by key.
+     */
+    DynamicArray<KVPair> _pairs;
+
+    /**
+     * The key ordering.
+     */
+    O _ordering;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the comparison for the pairs.
+     */
+    KeyLess keyLess() const;
+
+    /**
+     * Gets the index of the first pair whose key is not ordered before the
+     * given key.
+     */
+    uint32 lowerBound( const K& key ) const;
+
+    /**
+     * Checks if the pair at the given index holds the given key.
+     *
+     * Behavior is undefined when:
+     * index is not the lower bound of key.
+     */
+    bool holds( uint32 index, const K& key ) const;
+};
+
+// CONSTRUCTORS
+template <typename K, typename V, typename O>
+inline
+FlatMap<K, V, O>::FlatMap() : FlatMap( nullptr, 0, O() )
+{
+}
+
+template <typename K, typename V, typename O>
+inline
+FlatMap<K, V, O>::FlatMap( uint32 capacity )
+    : FlatMap( nullptr, capacity, O() )
+{
+}
+
+template <typename K, typename V, typename O>
+inline
+FlatMap<K, V, O>::FlatMap( const O& ordering )
+    : FlatMap( nullptr, 0, ordering )
+{
+}
+
+template <typename K, typename V, typename O>
+inline
+FlatMap<K, V, O>::FlatMap( mem::IAllocator<KVPair>* pairAlloc )
+    : FlatMap( pairAlloc, 0, O() )
+{
+}
+
+template <typename K, typename V, typename O>
+inline
+FlatMap<K, V, O>::FlatMap( mem::IAllocator<KVPair>* pairAlloc,
+                           uint32 capacity )
+    : FlatMap( pairAlloc, capacity, O() )
+{
+}
+
+template <typename K, typename V, typename O>
+inline
+FlatMap<K, V, O>::FlatMap( mem::IAllocator<KVPair>* pairAlloc,
+                           uint32 capacity, const O& ordering )
+    : _pairs( pairAlloc, capacity ), _ordering( ordering )
+{
+}
+
+template <typename K, typename V, typename O>
+inline
+FlatMap<K, V, O>::FlatMap( const FlatMap<K, V, O>& map )
+    : _pairs( map._pairs ), _ordering( map._ordering )
+{
+}
+
+template <typename K, typename V, typename O>
+inline
+FlatMap<K, V, O>::FlatMap( FlatMap<K, V, O>&& map )
+    : _pairs( std::move( map._pairs ) ),
+      _ordering( std::move( map._ordering ) )
+{
+}
+
+template <typename K, typename V, typename O>
+inline
+FlatMap<K, V, O>::~FlatMap()
+{
+}
+
+// OPERATORS
+template <typename K, typename V, typename O>
+inline
+FlatMap<K, V, O>& FlatMap<K, V, O>::operator=( const FlatMap<K, V, O>& map )
+{
+    _pairs = map._pairs;
+    _ordering = map._ordering;
+
+    return *this;
+}
+
+template <typename K, typename V, typename O>
+inline
+FlatMap<K, V, O>& FlatMap<K, V, O>::operator=( FlatMap<K, V, O>&& map )
+{
+    _pairs = std::move( map._pairs );
+    _ordering = std::move( map._ordering );
+
+    return *this;
+}
+
+template <typename K, typename V, typename O>
+inline
+const typename FlatMap<K, V, O>::KVPair&
+FlatMap<K, V, O>::operator[]( uint32 index ) const
+{
+    return _pairs[index];
+}
+
+// TYPES
+template <typename K, typename V, typename O>
+inline
+bool FlatMap<K, V, O>::KeyLess::operator()( const KVPair& lhs,
+                                            const KVPair& rhs ) const
+{
+    return ordering->less( lhs.key, rhs.key );
+}
+
+template <typename K, typename V, typename O>
+inline
+bool FlatMap<K, V, O>::KeyLess::operator()( const KVPair& lhs,
+                                            const K& rhs ) const
+{
+    return ordering->less( lhs.key, rhs );
+}
+
+template <typename K, typename V, typename O>
+inline
+bool FlatMap<K, V, O>::KeyLess::operator()( const K& lhs,
+                                            const KVPair& rhs ) const
+{
+    return ordering->less( lhs, rhs.key );
+}
+
+// MEMBER FUNCTIONS
+template <typename K, typename V, typename O>
+void FlatMap<K, V, O>::assign( const K& key, const V& value )
+{
+    const uint32 index = lowerBound( key );
+    if ( holds( index, key ) )
+    {
+        _pairs[index].value = value;
+        return;
+    }
+
+    _pairs.emplaceAt( index, KVPair{ key, value } );
+}
+
+template <typename K, typename V, typename O>
+void FlatMap<K, V, O>::assign( K&& key, V&& value )
+{
+    const uint32 index = lowerBound( key );
+    if ( holds( index, key ) )
+    {
+        _pairs[index].value = std::move( value );
+        return;
+    }
+
+    _pairs.emplaceAt( index, KVPair{ std::move( key ), std::move( value ) } );
+}
+
+template <typename K, typename V, typename O>
+inline
+V* FlatMap<K, V, O>::lookup( const K& key )
+{
+    const uint32 index = lowerBound( key );
+    return holds( index, key ) ? &_pairs[index].value : nullptr;
+}
+
+template <typename K, typename V, typename O>
+inline
+const V* FlatMap<K, V, O>::lookup( const K& key ) const
+{
+    const uint32 index = lowerBound( key );
+    return holds( index, key ) ? &_pairs[index].value : nullptr;
+}
+
+template <typename K, typename V, typename O>
+void FlatMap<K, V, O>::remove( const K& key )
+{
+    const uint32 index = lowerBound( key );
+    if ( holds( index, key ) )
+    {
+        _pairs.removeAt( index );
+    }
+}
+
+template <typename K, typename V, typename O>
+void FlatMap<K, V, O>::assignAll( const KVPair* pairs, uint32 count )
+{
+    assert( pairs != nullptr || count == 0 );
+
+    if ( count == 0 )
+    {
+        return;
+    }
+
+    _pairs.reserve( _pairs.size() + count );
+
+    uint32 i;
+    for ( i = 0; i < count; ++i )
+    {
+        _pairs.push( pairs[i] );
+    }
+
+    // the sort is stable so the last pair of each run of equal keys is the
+    // one assigned last
+    SortUtils::stableSort( _pairs, keyLess() );
+
+    uint32 last = 0;
+    for ( i = 1; i < _pairs.size(); ++i )
+    {
+        if ( _ordering.less( _pairs[last].key, _pairs[i].key ) )
+        {
+            ++last;
+        }
+
+        if ( last != i )
+        {
+            _pairs[last] = std::move( _pairs[i] );
+        }
+    }
+
+    while ( _pairs.size() > last + 1 )
+    {
+        _pairs.pop();
+    }
+}
+
+template <typename K, typename V, typename O>
+inline
+void FlatMap<K, V, O>::reserve( uint32 capacity )
+{
+    _pairs.reserve( capacity );
+}
+
+template <typename K, typename V, typename O>
+inline
+bool FlatMap<K, V, O>::hasKey( const K& key ) const
+{
+    return holds( lowerBound( key ), key );
+}
+
+template <typename K, typename V, typename O>
+inline
+uint32 FlatMap<K, V, O>::indexOf( const K& key ) const
+{
+    const uint32 index = lowerBound( key );
+    return holds( index, key ) ? index : static_cast<uint32>( -1 );
+}
+
+template <typename K, typename V, typename O>
+inline
+void FlatMap<K, V, O>::clear()
+{
+    _pairs.clear();
+}
+
+template <typename K, typename V, typename O>
+inline
+uint32 FlatMap<K, V, O>::size() const
+{
+    return _pairs.size();
+}
+
+template <typename K, typename V, typename O>
+inline
+bool FlatMap<K, V, O>::isEmpty() const
+{
+    return _pairs.isEmpty();
+}
+
+template <typename K, typename V, typename O>
+inline
+ContainerStats FlatMap<K, V, O>::stats() const
+{
+    return _pairs.stats();
+}
+
+template <typename K, typename V, typename O>
+inline
+typename FlatMap<K, V, O>::ConstIterator FlatMap<K, V, O>::cbegin() const
+{
+    return _pairs.cbegin();
+}
+
+template <typename K, typename V, typename O>
+inline
+typename FlatMap<K, V, O>::ConstIterator FlatMap<K, V, O>::cend() const
+{
+    return _pairs.cend();
+}
+
+// HELPER FUNCTIONS
+template <typename K, typename V, typename O>
+inline
+typename FlatMap<K, V, O>::KeyLess FlatMap<K, V, O>::keyLess() const
+{
+    return KeyLess{ &_ordering };
+}
+
+template <typename K, typename V, typename O>
+inline
+uint32 FlatMap<K, V, O>::lowerBound( const K& key ) const
+{
+    return SortUtils::lowerBound( _pairs, key, keyLess() );
+}
+
+template <typename K, typename V, typename O>
+inline
+bool FlatMap<K, V, O>::holds( uint32 index, const K& key ) const
+{
+    return index < _pairs.size() && !_ordering.less( key, _pairs[index].key );
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif
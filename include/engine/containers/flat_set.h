@@ -0,0 +1,481 @@
+// flat_set.h
+//
+// Defines a set that keeps its values sorted in a single DynamicArray.
+//
+// Lookups are binary searches over contiguous values and there is no index to
+// allocate, so small read-mostly sets take a fraction of the memory of a Set
+// and are faster to scan. Adding a new value shifts every later value, so
+// sets that are built once should use addAll.
+//
+#ifndef NGE_CNTR_FLAT_SET_H
+#define NGE_CNTR_FLAT_SET_H
+
+#include <assert.h>
+#include <utility>
+
+#include "engine/intdef.h"
+#include "engine/containers/container_stats.h"
+#include "engine/containers/dynamic_array.h"
+#include "engine/containers/sort_utils.h"
+#include "engine/memory/iallocator.h"
+#include "engine/utility/ordering.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+template <typename T, typename O = util::Ordering<T>>
+class FlatSet
+{
+  public:
+    // TYPES
+    /**
+     * Iterates the values in order.
+     */
+    typedef typename DynamicArray<T>::ConstIterator ConstIterator;
+
+    // CONSTRUCTORS
+    /**
+     * Constructs a new set.
+     */
+    FlatSet();
+
+    /**
+     * Constructs a new set with the given initial capacity.
+     */
+    FlatSet( uint32 capacity );
+
+    /**
+     * Constructs a new set with the given ordering.
+     */
+    FlatSet( const O& ordering );
+
+    /**
+     * Constructs a new set with the given allocator.
+     */
+    FlatSet( mem::IAllocator<T>* valueAlloc );
+
+    /**
+     * Constructs a new set with the given allocator and initial capacity.
+     */
+    FlatSet( mem::IAllocator<T>* valueAlloc, uint32 capacity );
+
+    /**
+     * Constructs a new set using the given allocator, initial capacity and
+     * ordering.
+     */
+    FlatSet( mem::IAllocator<T>* valueAlloc, uint32 capacity,
+             const O& ordering );
+
+    /**
+     * Constructs a copy of the given set.
+     */
+    FlatSet( const FlatSet<T, O>& set );
+
+    /**
+     * Moves the set to a new instance.
+     */
+    FlatSet( FlatSet<T, O>&& set );
+
+    /**
+     * Destructs the set.
+     */
+    ~FlatSet();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the given set.
+     */
+    FlatSet<T, O>& operator=( const FlatSet<T, O>& set );
+
+    /**
+     * Moves the set data to this instance.
+     */
+    FlatSet<T, O>& operator=( FlatSet<T, O>&& set );
+
+    /**
+     * Gets the value at the given index in order.
+     *
+     * Behavior is undefined when:
+     * index is not less than the size of the set.
+     */
+    const T& operator[]( uint32 index ) const;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Adds a copy of the given value to the set.
+     *
+     * This will not do anything if the value already exists in the set.
+     * Adding a new value moves every value that is ordered after it.
+     */
+    void add( const T& value );
+
+    /**
+     * Moves the value into the set.
+     *
+     * This will not do anything if the value already exists in the set.
+     * Adding a new value moves every value that is ordered after it.
+     */
+    void add( T&& value );
+
+    /**
+     * Removes the given value from the set.
+     *
+     * The remaining values stay in order.
+     */
+    void remove( const T& value );
+
+    /**
+     * Adds a copy of each of the given values to the set.
+     *
+     * The values are appended and the whole set is sorted once instead of
+     * inserting each value in place. Values already in the set are kept.
+     *
+     * Behavior is undefined when:
+     * values is nullptr and count is not 0.
+     */
+    void addAll( const T* values, uint32 count );
+
+    /**
+     * Makes room for at least the given number of values so that adding up
+     * to that many does not reallocate.
+     */
+    void reserve( uint32 capacity );
+
+    /**
+     * Checks if the value exists in the set.
+     */
+    bool has( const T& value ) const;
+
+    /**
+     * Gets the index of the given value in order.
+     *
+     * Returns (uint32)-1 if the value is not in the set.
+     */
+    uint32 indexOf( const T& value ) const;
+
+    /**
+     * Removes all of the items from the set.
+     */
+    void clear();
+
+    /**
+     * Gets an iterator for the set.
+     */
+    ConstIterator cbegin() const;
+
+    /**
+     * Gets an iterator for the end of the set.
+     */
+    ConstIterator cend() const;
+
+    /**
+     * Gets the number of items in the set.
+     */
+    uint32 size() const;
+
+    /**
+     * Checks if the set is empty.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Gets the memory footprint and occupancy of the set.
+     */
+    ContainerStats stats() const;
+
+  private:
+    // TYPES
+    /**
+     * Compares values with the set's ordering.
+     */
+    struct ValueLess
+    {
+        const O* ordering;
+
+        bool operator()( const T& lhs, const T& rhs ) const;
+    };
+
+    // MEMBERS
+    /**
+     * The sorted values.
+     */
+    DynamicArray<T> _values;
+
+    /**
+     * The value ordering.
+     */
+    O _ordering;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the index of the first value that is not ordered before the
+     * given value.
+     */
+    uint32 lowerBound( const T& value ) const;
+
+    /**
+     * Checks if the value at the given index is the given value.
+     *
+     * Behavior is undefined when:
+     * index is not the lower bound of value.
+     */
+    bool holds( uint32 index, const T& value ) const;
+};
+
+// CONSTRUCTORS
+template <typename T, typename O>
+inline
+FlatSet<T, O>::FlatSet() : FlatSet( nullptr, 0, O() )
+{
+}
+
+template <typename T, typename O>
+inline
+FlatSet<T, O>::FlatSet( uint32 capacity ) : FlatSet( nullptr, capacity, O() )
+{
+}
+
+template <typename T, typename O>
+inline
+FlatSet<T, O>::FlatSet( const O& ordering ) : FlatSet( nullptr, 0, ordering )
+{
+}
+
+template <typename T, typename O>
+inline
+FlatSet<T, O>::FlatSet( mem::IAllocator<T>* valueAlloc )
+    : FlatSet( valueAlloc, 0, O() )
+{
+}
+
+template <typename T, typename O>
+inline
+FlatSet<T, O>::FlatSet( mem::IAllocator<T>* valueAlloc, uint32 capacity )
+    : FlatSet( valueAlloc, capacity, O() )
+{
+}
+
+template <typename T, typename O>
+inline
+FlatSet<T, O>::FlatSet( mem::IAllocator<T>* valueAlloc, uint32 capacity,
+                        const O& ordering )
+    : _values( valueAlloc, capacity ), _ordering( ordering )
+{
+}
+
+template <typename T, typename O>
+inline
+FlatSet<T, O>::FlatSet( const FlatSet<T, O>& set )
+    : _values( set._values ), _ordering( set._ordering )
+{
+}
+
+template <typename T, typename O>
+inline
+FlatSet<T, O>::FlatSet( FlatSet<T, O>&& set )
+    : _values( std::move( set._values ) ),
+      _ordering( std::move( set._ordering ) )
+{
+}
+
+template <typename T, typename O>
+inline
+FlatSet<T, O>::~FlatSet()
+{
+}
+
+// OPERATORS
+template <typename T, typename O>
+inline
+FlatSet<T, O>& FlatSet<T, O>::operator=( const FlatSet<T, O>& set )
+{
+    _values = set._values;
+    _ordering = set._ordering;
+
+    return *this;
+}
+
+template <typename T, typename O>
+inline
+FlatSet<T, O>& FlatSet<T, O>::operator=( FlatSet<T, O>&& set )
+{
+    _values = std::move( set._values );
+    _ordering = std::move( set._ordering );
+
+    return *this;
+}
+
+template <typename T, typename O>
+inline
+const T& FlatSet<T, O>::operator[]( uint32 index ) const
+{
+    return _values[index];
+}
+
+// TYPES
+template <typename T, typename O>
+inline
+bool FlatSet<T, O>::ValueLess::operator()( const T& lhs, const T& rhs ) const
+{
+    return ordering->less( lhs, rhs );
+}
+
+// MEMBER FUNCTIONS
+template <typename T, typename O>
+void FlatSet<T, O>::add( const T& value )
+{
+    const uint32 index = lowerBound( value );
+    if ( !holds( index, value ) )
+    {
+        _values.insertAt( index, value );
+    }
+}
+
+template <typename T, typename O>
+void FlatSet<T, O>::add( T&& value )
+{
+    const uint32 index = lowerBound( value );
+    if ( !holds( index, value ) )
+    {
+        _values.insertAt( index, std::move( value ) );
+    }
+}
+
+template <typename T, typename O>
+void FlatSet<T, O>::remove( const T& value )
+{
+    const uint32 index = lowerBound( value );
+    if ( holds( index, value ) )
+    {
+        _values.removeAt( index );
+    }
+}
+
+template <typename T, typename O>
+void FlatSet<T, O>::addAll( const T* values, uint32 count )
+{
+    assert( values != nullptr || count == 0 );
+
+    if ( count == 0 )
+    {
+        return;
+    }
+
+    _values.reserve( _values.size() + count );
+
+    uint32 i;
+    for ( i = 0; i < count; ++i )
+    {
+        _values.push( values[i] );
+    }
+
+    // the sort is stable so the first value of each run of equal values is
+    // the one that was already in the set
+    SortUtils::stableSort( _values, ValueLess{ &_ordering } );
+
+    uint32 last = 0;
+    for ( i = 1; i < _values.size(); ++i )
+    {
+        if ( _ordering.less( _values[last], _values[i] ) )
+        {
+            ++last;
+            if ( last != i )
+            {
+                _values[last] = std::move( _values[i] );
+            }
+        }
+    }
+
+    while ( _values.size() > last + 1 )
+    {
+        _values.pop();
+    }
+}
+
+template <typename T, typename O>
+inline
+void FlatSet<T, O>::reserve( uint32 capacity )
+{
+    _values.reserve( capacity );
+}
+
+template <typename T, typename O>
+inline
+bool FlatSet<T, O>::has( const T& value ) const
+{
+    return holds( lowerBound( value ), value );
+}
+
+template <typename T, typename O>
+inline
+uint32 FlatSet<T, O>::indexOf( const T& value ) const
+{
+    const uint32 index = lowerBound( value );
+    return holds( index, value ) ? index : static_cast<uint32>( -1 );
+}
+
+template <typename T, typename O>
+inline
+void FlatSet<T, O>::clear()
+{
+    _values.clear();
+}
+
+template <typename T, typename O>
+inline
+typename FlatSet<T, O>::ConstIterator FlatSet<T, O>::cbegin() const
+{
+    return _values.cbegin();
+}
+
+template <typename T, typename O>
+inline
+typename FlatSet<T, O>::ConstIterator FlatSet<T, O>::cend() const
+{
+    return _values.cend();
+}
+
+template <typename T, typename O>
+inline
+uint32 FlatSet<T, O>::size() const
+{
+    return _values.size();
+}
+
+template <typename T, typename O>
+inline
+bool FlatSet<T, O>::isEmpty() const
+{
+    return _values.isEmpty();
+}
+
+template <typename T, typename O>
+inline
+ContainerStats FlatSet<T, O>::stats() const
+{
+    return _values.stats();
+}
+
+// HELPER FUNCTIONS
+template <typename T, typename O>
+inline
+uint32 FlatSet<T, O>::lowerBound( const T& value ) const
+{
+    return SortUtils::lowerBound( _values, value, ValueLess{ &_ordering } );
+}
+
+template <typename T, typename O>
+inline
+bool FlatSet<T, O>::holds( uint32 index, const T& value ) const
+{
+    return index < _values.size() && !_ordering.less( value, _values[index] );
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif
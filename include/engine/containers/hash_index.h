@@ -0,0 +1,707 @@
+// hash_index.h
+//
+// Defines the open addressing index that backs the hashed containers.
+//
+// The index does not store any keys. Each bin holds the position of an item
+// in the dense storage of the owning container along with a control byte.
+// The control byte of a full bin holds the low 7 bits of the item's hash
+// code, which lets an entire group of 16 bins be filtered with a single SSE2
+// compare before any item is touched.
+//
+// Bins are probed a group at a time. Groups are aligned so that a group
+// never wraps around the end of the bin array and a probe sequence stops at
+// the first group that contains an empty bin.
+//
+#ifndef NGE_CNTR_HASH_INDEX_H
+#define NGE_CNTR_HASH_INDEX_H
+
+#include <assert.h>
+#include <utility>
+
+#include "engine/intdef.h"
+#include "engine/memory/allocator_guard.h"
+#include "engine/memory/memory_utils.h"
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || \
+    ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define NGE_CNTR_HASH_INDEX_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace nge
+{
+
+namespace cntr
+{
+
+class HashIndex
+{
+  public:
+    // CONSTANTS
+    /**
+     * Returned by find when no bin matches.
+     */
+    static constexpr uint32 NOT_FOUND = static_cast<uint32>( -1 );
+
+    /**
+     * The number of bins that are checked at once.
+     */
+    static constexpr uint32 GROUP_SIZE = 16;
+
+    /**
+     * The minimum number of bins.
+     */
+    static constexpr uint32 MIN_BINS = 32;
+
+  private:
+    // CONSTANTS
+    /**
+     * The control byte of a bin that has never held an item.
+     */
+    static constexpr uint8 CTRL_EMPTY = 0x80;
+
+    /**
+     * The control byte of a bin whose item was removed.
+     */
+    static constexpr uint8 CTRL_DELETED = 0xFE;
+
+    /**
+     * The threshold percentage of used and deleted bins at which the
+     * index grows.
+     */
+    static constexpr uint32 GROW_THRESHOLD = 87;
+
+    /**
+     * The threshold percentage of used bins at which the index shrinks.
+     */
+    static constexpr uint32 SHRINK_THRESHOLD = 30;
+
+    // MEMBERS
+    /**
+     * The allocator for the bins.
+     *
+     * The item positions and the control bytes share one allocation.
+     */
+    mem::AllocatorGuard<uint32> _alloc;
+
+    /**
+     * The item position stored in each bin.
+     */
+    uint32* _slots;
+
+    /**
+     * The control byte of each bin.
+     *
+     * This points into the same allocation as the slots.
+     */
+    uint8* _ctrl;
+
+    /**
+     * The total number of bins.
+     */
+    uint32 _binCount;
+
+    /**
+     * The number of bins that hold an item.
+     */
+    uint32 _used;
+
+    /**
+     * The number of bins that are marked as deleted.
+     */
+    uint32 _deleted;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the number of uint32 values that are allocated for the given
+     * number of bins.
+     */
+    static uint32 allocationSize( uint32 binCount );
+
+    /**
+     * Gets the fingerprint stored in the control byte for a hash code.
+     */
+    static uint8 fingerprint( uint32 hashCode );
+
+    /**
+     * Gets the index of the lowest set bit.
+     *
+     * Behavior is undefined when:
+     * mask is zero
+     */
+    static uint32 lowestBit( uint32 mask );
+
+    /**
+     * Gets a mask of the bins in the group whose control byte matches.
+     */
+    static uint32 matchByte( const uint8* group, uint8 ctrl );
+
+    /**
+     * Gets a mask of the bins in the group that are empty or deleted.
+     */
+    static uint32 matchFree( const uint8* group );
+
+    /**
+     * Gets the first group that is probed for the given hash code.
+     */
+    uint32 firstGroup( uint32 hashCode ) const;
+
+    /**
+     * Gets the next group that is probed.
+     */
+    uint32 nextGroup( uint32 group, uint32 probes ) const;
+
+    /**
+     * Gets how many groups past its first group the item with the given hash
+     * code in the given bin is.
+     */
+    uint32 probeLength( uint32 bin, uint32 hashCode ) const;
+
+    /**
+     * Allocates the given number of empty bins.
+     */
+    void allocate( uint32 binCount );
+
+    /**
+     * Releases the bins.
+     */
+    void release();
+
+  public:
+    // GLOBAL FUNCTIONS
+    /**
+     * Gets the number of bins needed to hold the given number of items
+     * without growing.
+     */
+    static uint32 binsFor( uint32 capacity );
+
+    // CONSTRUCTORS
+    /**
+     * Constructs a new index.
+     */
+    HashIndex();
+
+    /**
+     * Constructs a new index that can hold the given number of items
+     * without growing.
+     */
+    HashIndex( uint32 capacity );
+
+    /**
+     * Constructs a new index using the given allocator.
+     */
+    HashIndex( mem::IAllocator<uint32>* alloc );
+
+    /**
+     * Constructs a new index using the given allocator that can hold the
+     * given number of items without growing.
+     */
+    HashIndex( mem::IAllocator<uint32>* alloc, uint32 capacity );
+
+    /**
+     * Constructs a copy of the given index.
+     */
+    HashIndex( const HashIndex& index );
+
+    /**
+     * Moves the index to a new instance.
+     */
+    HashIndex( HashIndex&& index );
+
+    /**
+     * Destructs the index.
+     */
+    ~HashIndex();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the given index.
+     */
+    HashIndex& operator=( const HashIndex& index );
+
+    /**
+     * Moves the index to this instance.
+     */
+    HashIndex& operator=( HashIndex&& index );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Finds the bin that holds an item with the given hash code for which
+     * isMatch( itemIndex ) returns true.
+     *
+     * isMatch is only called for bins whose fingerprint matches the hash
+     * code. Returns NOT_FOUND if there is no such bin.
+     */
+    template <typename EQ>
+    uint32 find( uint32 hashCode, EQ isMatch ) const;
+
+    /**
+     * Hints that the first group probed for the given hash code is about to
+     * be read.
+     *
+     * Bulk inserts hash a batch of items first and prefetch each of their
+     * groups so the probes that follow do not wait on memory one at a time.
+     */
+    void prefetch( uint32 hashCode ) const;
+
+    /**
+     * Stores the given item position in a free bin and returns the bin.
+     *
+     * This does not check if the item already exists and it does not grow
+     * the index.
+     *
+     * Behavior is undefined when:
+     * there are no free bins
+     */
+    uint32 insert( uint32 hashCode, uint32 itemIndex );
+
+    /**
+     * Removes the item from the given bin.
+     *
+     * Behavior is undefined when:
+     * bin does not hold an item
+     */
+    void erase( uint32 bin );
+
+    /**
+     * Gets the item position stored in the given bin.
+     */
+    uint32 itemAt( uint32 bin ) const;
+
+    /**
+     * Sets the item position stored in the given bin.
+     *
+     * This is used to patch a bin after its item moved in the dense storage.
+     */
+    void setItemAt( uint32 bin, uint32 itemIndex );
+
+    /**
+     * Rebuilds the index with the given number of bins for the items at
+     * positions [0, count).
+     *
+     * hashOf( itemIndex ) must return the hash code of an item.
+     */
+    template <typename HF>
+    void rehash( uint32 binCount, uint32 count, HF hashOf );
+
+    /**
+     * Checks if the index must grow before another item is inserted.
+     */
+    bool shouldGrow() const;
+
+    /**
+     * Checks if the index should shrink.
+     */
+    bool shouldShrink() const;
+
+    /**
+     * Grows the index so one more item can be inserted.
+     *
+     * If the index is mostly filled with deleted bins this only rebuilds
+     * it at the same size.
+     */
+    template <typename HF>
+    void grow( HF hashOf );
+
+    /**
+     * Halves the number of bins.
+     */
+    template <typename HF>
+    void shrink( HF hashOf );
+
+    /**
+     * Removes all of the items from the index.
+     */
+    void clear();
+
+    /**
+     * Gets the number of items in the index.
+     */
+    uint32 size() const;
+
+    /**
+     * Gets the total number of bins.
+     */
+    uint32 binCount() const;
+
+    /**
+     * Gets the number of bytes allocated for the bins.
+     */
+    uint64 byteCount() const;
+
+    /**
+     * Gets the largest number of groups past its first group that any item
+     * is.
+     *
+     * This walks every bin and calls hashOf( itemIndex ) for each item.
+     */
+    template <typename HF>
+    uint32 maxProbeLength( HF hashOf ) const;
+
+    /**
+     * Gets the mean number of groups past their first group that the items
+     * are.
+     *
+     * This walks every bin and calls hashOf( itemIndex ) for each item.
+     */
+    template <typename HF>
+    float meanProbeLength( HF hashOf ) const;
+};
+
+// HELPER FUNCTIONS
+inline
+uint32 HashIndex::allocationSize( uint32 binCount )
+{
+    // one uint32 per slot followed by one byte of control per bin
+    return binCount + binCount / sizeof( uint32 );
+}
+
+inline
+uint8 HashIndex::fingerprint( uint32 hashCode )
+{
+    return static_cast<uint8>( hashCode & 0x7F );
+}
+
+inline
+uint32 HashIndex::lowestBit( uint32 mask )
+{
+    assert( mask != 0 );
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward( &index, mask );
+    return static_cast<uint32>( index );
+#else
+    return static_cast<uint32>( __builtin_ctz( mask ) );
+#endif
+}
+
+inline
+uint32 HashIndex::matchByte( const uint8* group, uint8 ctrl )
+{
+#ifdef NGE_CNTR_HASH_INDEX_SSE2
+    const __m128i bytes = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>( group ) );
+    return static_cast<uint32>( _mm_movemask_epi8(
+        _mm_cmpeq_epi8( bytes, _mm_set1_epi8( static_cast<char>( ctrl ) ) ) ) );
+#else
+    uint32 mask = 0;
+    uint32 i;
+    for ( i = 0; i < GROUP_SIZE; ++i )
+    {
+        mask |= static_cast<uint32>( group[i] == ctrl ) << i;
+    }
+    return mask;
+#endif
+}
+
+inline
+uint32 HashIndex::matchFree( const uint8* group )
+{
+#ifdef NGE_CNTR_HASH_INDEX_SSE2
+    // empty and deleted are the only control bytes with the high bit set
+    return static_cast<uint32>( _mm_movemask_epi8( _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>( group ) ) ) );
+#else
+    uint32 mask = 0;
+    uint32 i;
+    for ( i = 0; i < GROUP_SIZE; ++i )
+    {
+        mask |= static_cast<uint32>( group[i] >> 7 ) << i;
+    }
+    return mask;
+#endif
+}
+
+inline
+uint32 HashIndex::firstGroup( uint32 hashCode ) const
+{
+    return ( hashCode >> 7 ) & ( _binCount / GROUP_SIZE - 1 );
+}
+
+inline
+uint32 HashIndex::nextGroup( uint32 group, uint32 probes ) const
+{
+    // triangular steps visit every group when the group count is a power
+    // of two
+    return ( group + probes ) & ( _binCount / GROUP_SIZE - 1 );
+}
+
+inline
+uint32 HashIndex::probeLength( uint32 bin, uint32 hashCode ) const
+{
+    uint32 group;
+    uint32 probes;
+    for ( group = firstGroup( hashCode ), probes = 0;
+          group != bin / GROUP_SIZE;
+          group = nextGroup( group, ++probes ) )
+    {
+        assert( probes < _binCount / GROUP_SIZE );
+    }
+
+    return probes;
+}
+
+// GLOBAL FUNCTIONS
+inline
+uint32 HashIndex::binsFor( uint32 capacity )
+{
+    uint32 bins = MIN_BINS;
+    while ( ( static_cast<uint64>( bins ) * GROW_THRESHOLD ) / 100 <=
+            capacity )
+    {
+        bins <<= 1;
+    }
+
+    return bins;
+}
+
+// CONSTRUCTORS
+inline
+HashIndex::HashIndex() : HashIndex( nullptr, 0 )
+{
+}
+
+inline
+HashIndex::HashIndex( uint32 capacity ) : HashIndex( nullptr, capacity )
+{
+}
+
+inline
+HashIndex::HashIndex( mem::IAllocator<uint32>* alloc )
+    : HashIndex( alloc, 0 )
+{
+}
+
+inline
+HashIndex::HashIndex( mem::IAllocator<uint32>* alloc, uint32 capacity )
+    : _alloc( alloc ), _slots( nullptr ), _ctrl( nullptr ), _binCount( 0 ),
+      _used( 0 ), _deleted( 0 )
+{
+    allocate( binsFor( capacity ) );
+}
+
+inline
+HashIndex::HashIndex( const HashIndex& index )
+    : _alloc( index._alloc ), _slots( nullptr ), _ctrl( nullptr ),
+      _binCount( 0 ), _used( 0 ), _deleted( 0 )
+{
+    if ( index._slots != nullptr )
+    {
+        allocate( index._binCount );
+        mem::MemoryUtils::copy( _slots, index._slots,
+                                allocationSize( _binCount ) );
+    }
+    _used = index._used;
+    _deleted = index._deleted;
+}
+
+inline
+HashIndex::HashIndex( HashIndex&& index )
+    : _alloc( index._alloc ), _slots( index._slots ), _ctrl( index._ctrl ),
+      _binCount( index._binCount ), _used( index._used ),
+      _deleted( index._deleted )
+{
+    index._slots = nullptr;
+    index._ctrl = nullptr;
+    index._binCount = 0;
+    index._used = 0;
+    index._deleted = 0;
+}
+
+inline
+HashIndex::~HashIndex()
+{
+    release();
+}
+
+// MEMBER FUNCTIONS
+template <typename EQ>
+uint32 HashIndex::find( uint32 hashCode, EQ isMatch ) const
+{
+    if ( _binCount == 0 )
+    {
+        return NOT_FOUND;
+    }
+
+    const uint8 ctrl = fingerprint( hashCode );
+    uint32 group;
+    uint32 probes;
+    uint32 mask;
+    uint32 bin;
+    for ( group = firstGroup( hashCode ), probes = 0;
+          probes < _binCount / GROUP_SIZE;
+          group = nextGroup( group, ++probes ) )
+    {
+        const uint8* ctrlGroup = _ctrl + group * GROUP_SIZE;
+        for ( mask = matchByte( ctrlGroup, ctrl ); mask != 0;
+              mask &= mask - 1 )
+        {
+            bin = group * GROUP_SIZE + lowestBit( mask );
+            if ( isMatch( _slots[bin] ) )
+            {
+                return bin;
+            }
+        }
+
+        // no probe sequence continues past a group with an empty bin
+        if ( matchByte( ctrlGroup, CTRL_EMPTY ) != 0 )
+        {
+            return NOT_FOUND;
+        }
+    }
+
+    return NOT_FOUND;
+}
+
+inline
+void HashIndex::prefetch( uint32 hashCode ) const
+{
+    if ( _binCount == 0 )
+    {
+        return;
+    }
+
+    const uint8* group = _ctrl + firstGroup( hashCode ) * GROUP_SIZE;
+#if defined( __GNUC__ )
+    __builtin_prefetch( group );
+#elif defined( NGE_CNTR_HASH_INDEX_SSE2 )
+    _mm_prefetch( reinterpret_cast<const char*>( group ), _MM_HINT_T0 );
+#else
+    ( void )group;
+#endif
+}
+
+inline
+uint32 HashIndex::itemAt( uint32 bin ) const
+{
+    assert( bin < _binCount );
+    assert( ( _ctrl[bin] & 0x80 ) == 0 );
+    return _slots[bin];
+}
+
+inline
+void HashIndex::setItemAt( uint32 bin, uint32 itemIndex )
+{
+    assert( bin < _binCount );
+    assert( ( _ctrl[bin] & 0x80 ) == 0 );
+    _slots[bin] = itemIndex;
+}
+
+template <typename HF>
+void HashIndex::rehash( uint32 binCount, uint32 count, HF hashOf )
+{
+    assert( binCount >= MIN_BINS );
+    assert( ( binCount & ( binCount - 1 ) ) == 0 );
+    assert( ( static_cast<uint64>( binCount ) * GROW_THRESHOLD ) / 100 >
+            count );
+
+    release();
+    allocate( binCount );
+
+    uint32 i;
+    for ( i = 0; i < count; ++i )
+    {
+        insert( hashOf( i ), i );
+    }
+}
+
+inline
+bool HashIndex::shouldGrow() const
+{
+    return ( static_cast<uint64>( _used + _deleted + 1 ) * 100 ) >
+        static_cast<uint64>( _binCount ) * GROW_THRESHOLD;
+}
+
+inline
+bool HashIndex::shouldShrink() const
+{
+    return _binCount > MIN_BINS &&
+        ( static_cast<uint64>( _used ) * 100 ) <=
+        static_cast<uint64>( _binCount ) * SHRINK_THRESHOLD;
+}
+
+template <typename HF>
+inline
+void HashIndex::grow( HF hashOf )
+{
+    // only clear out deleted bins if they are what filled the index
+    rehash( ( static_cast<uint64>( _used ) * 100 ) >=
+            static_cast<uint64>( _binCount ) * SHRINK_THRESHOLD ?
+            _binCount << 1 : _binCount, _used, hashOf );
+}
+
+template <typename HF>
+inline
+void HashIndex::shrink( HF hashOf )
+{
+    rehash( _binCount >> 1, _used, hashOf );
+}
+
+inline
+uint32 HashIndex::size() const
+{
+    return _used;
+}
+
+inline
+uint32 HashIndex::binCount() const
+{
+    return _binCount;
+}
+
+inline
+uint64 HashIndex::byteCount() const
+{
+    return _slots != nullptr
+        ? static_cast<uint64>( allocationSize( _binCount ) ) * sizeof( uint32 )
+        : 0;
+}
+
+template <typename HF>
+uint32 HashIndex::maxProbeLength( HF hashOf ) const
+{
+    uint32 longest = 0;
+    uint32 length;
+    uint32 i;
+    for ( i = 0; i < _binCount; ++i )
+    {
+        if ( ( _ctrl[i] & 0x80 ) == 0 )
+        {
+            length = probeLength( i, hashOf( _slots[i] ) );
+            longest = length > longest ? length : longest;
+        }
+    }
+
+    return longest;
+}
+
+template <typename HF>
+float HashIndex::meanProbeLength( HF hashOf ) const
+{
+    if ( _used == 0 )
+    {
+        return 0.0f;
+    }
+
+    uint64 total = 0;
+    uint32 i;
+    for ( i = 0; i < _binCount; ++i )
+    {
+        if ( ( _ctrl[i] & 0x80 ) == 0 )
+        {
+            total += probeLength( i, hashOf( _slots[i] ) );
+        }
+    }
+
+    return static_cast<float>( total ) / static_cast<float>( _used );
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif
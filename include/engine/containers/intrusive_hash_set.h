@@ -0,0 +1,868 @@
+// intrusive_hash_set.h
+//
+// Defines a hashed set whose links live inside the items.
+//
+// An item joins a set by deriving from IntrusiveSetHook. The set only keeps
+// an array of buckets, each the head of a chain of hooks, and a hook knows
+// the link that points at it so an item is removed without hashing or
+// searching its chain. Adding and removing items only allocates when the
+// bucket array grows, which reserve does up front. The set does not own its
+// items and, like the list hooks, the tag tells apart the hooks of an item
+// that is in more than one set.
+//
+// The hash code of an item is computed when it is added and kept in its
+// hook, so an item must not change in a way that changes its hash code or
+// equality while it is in the set.
+//
+#ifndef NGE_CNTR_INTRUSIVE_HASH_SET_H
+#define NGE_CNTR_INTRUSIVE_HASH_SET_H
+
+#include <assert.h>
+#include <type_traits>
+#include <utility>
+
+#include "engine/intdef.h"
+#include "engine/containers/container_stats.h"
+#include "engine/memory/allocator_guard.h"
+#include "engine/memory/iallocator.h"
+#include "engine/memory/memory_utils.h"
+#include "engine/utility/equality.h"
+#include "engine/utility/hasher.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+template <typename T, typename H, typename E, typename Tag>
+class IntrusiveHashSet;
+
+template <typename Tag = void>
+class IntrusiveSetHook
+{
+  private:
+    // FRIENDS
+    template <typename T, typename H, typename E, typename U>
+    friend class IntrusiveHashSet;
+
+    // MEMBERS
+    /**
+     * The next hook in the bucket's chain.
+     */
+    IntrusiveSetHook<Tag>* _next;
+
+    /**
+     * The bucket head or hook link that points at this hook.
+     */
+    IntrusiveSetHook<Tag>** _link;
+
+    /**
+     * The hash code of the item.
+     */
+    uint32 _hashCode;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs an unlinked hook.
+     */
+    IntrusiveSetHook();
+
+    /**
+     * Constructs an unlinked hook.
+     *
+     * Copying an item does not add the copy to the item's set.
+     */
+    IntrusiveSetHook( const IntrusiveSetHook<Tag>& hook );
+
+    /**
+     * Destructs the hook.
+     *
+     * Behavior is undefined when:
+     * the hook is still in a set
+     */
+    ~IntrusiveSetHook();
+
+    // OPERATORS
+    /**
+     * Leaves the hook's links untouched.
+     *
+     * Assigning an item does not change which set it is in.
+     */
+    IntrusiveSetHook<Tag>& operator=( const IntrusiveSetHook<Tag>& hook );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Checks if the hook is in a set.
+     */
+    bool isLinked() const;
+};
+
+template <typename T, typename H = util::Hasher<T>,
+          typename E = util::Equality<T>, typename Tag = void>
+class IntrusiveHashSet
+{
+    static_assert( std::is_base_of<IntrusiveSetHook<Tag>, T>::value,
+                   "Items must derive from the set's hook." );
+
+  public:
+    // TYPES
+    typedef IntrusiveSetHook<Tag> Hook;
+
+    // CLASSES
+    /**
+     * Defines an iterator for the set.
+     */
+    class Iterator
+    {
+      private:
+        // MEMBERS
+        /**
+         * The set that is being iterated.
+         */
+        const IntrusiveHashSet<T, H, E, Tag>* _iterSet;
+
+        /**
+         * The bucket of the current hook.
+         */
+        uint32 _iterBucket;
+
+        /**
+         * The current hook, nullptr at the end.
+         */
+        Hook* _iterHook;
+
+      public:
+        // CONSTRUCTORS
+        /**
+         * Constructs a new iterator.
+         */
+        Iterator();
+
+        /**
+         * Constructs an iterator at the first hook at or after the given
+         * bucket.
+         */
+        Iterator( const IntrusiveHashSet<T, H, E, Tag>* set, uint32 bucket );
+
+        // OPERATORS
+        /**
+         * Moves to the next item.
+         */
+        Iterator& operator++();
+
+        /**
+         * Gets the item at the current position.
+         */
+        T& operator*() const;
+
+        /**
+         * Gets the item at the current position.
+         */
+        T* operator->() const;
+
+        /**
+         * Checks if the other iterator is at the same position.
+         */
+        bool operator==( const Iterator& iter ) const;
+
+        /**
+         * Checks if the other iterator is not at the same position.
+         */
+        bool operator!=( const Iterator& iter ) const;
+    };
+
+    // CONSTANTS
+    /**
+     * The minimum number of buckets.
+     */
+    static constexpr uint32 MIN_BUCKETS = 16;
+
+  private:
+    // MEMBERS
+    /**
+     * The allocator for the buckets.
+     */
+    mem::AllocatorGuard<Hook*> _allocator;
+
+    /**
+     * The head of each bucket's chain.
+     */
+    Hook** _buckets;
+
+    /**
+     * The number of buckets, a power of two.
+     */
+    uint32 _bucketCount;
+
+    /**
+     * The shift that takes a mixed hash code to a bucket.
+     */
+    uint32 _shift;
+
+    /**
+     * The number of items in the set.
+     */
+    uint32 _size;
+
+    /**
+     * The hasher.
+     */
+    H _hasher;
+
+    /**
+     * The item equality.
+     */
+    E _equality;
+
+    // CONSTRUCTORS
+    /**
+     * Disabled: sets cannot be copied since an item is only in one.
+     */
+    IntrusiveHashSet( const IntrusiveHashSet<T, H, E, Tag>& set ) = delete;
+
+    // OPERATORS
+    /**
+     * Disabled: sets cannot be copied since an item is only in one.
+     */
+    IntrusiveHashSet<T, H, E, Tag>& operator=(
+        const IntrusiveHashSet<T, H, E, Tag>& set ) = delete;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the bucket for the hash code.
+     */
+    uint32 bucketOf( uint32 hashCode ) const;
+
+    /**
+     * Gets the hook of the item equal to the value with the given hash.
+     *
+     * Returns nullptr if there is none.
+     */
+    Hook* findHook( uint32 hashCode, const T& value ) const;
+
+    /**
+     * Links the hook in at the head of its bucket.
+     */
+    void link( Hook* hook );
+
+    /**
+     * Moves every hook into a new array of the given number of buckets.
+     */
+    void rebuild( uint32 bucketCount );
+
+    /**
+     * Releases the buckets.
+     */
+    void release();
+
+    /**
+     * Gets the item that owns the hook.
+     */
+    static T& itemOf( Hook* hook );
+
+    /**
+     * Gets the hook of the item.
+     */
+    static Hook* hookOf( T& item );
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a new empty set.
+     *
+     * The buckets are allocated when the first item is added.
+     */
+    IntrusiveHashSet();
+
+    /**
+     * Constructs a new set with room for the given number of items.
+     */
+    IntrusiveHashSet( uint32 capacity );
+
+    /**
+     * Constructs a new empty set with the given allocator.
+     */
+    IntrusiveHashSet( mem::IAllocator<Hook*>* allocator );
+
+    /**
+     * Constructs a new set with the given allocator and room for the given
+     * number of items.
+     */
+    IntrusiveHashSet( mem::IAllocator<Hook*>* allocator, uint32 capacity );
+
+    /**
+     * Moves the items of the set to a new instance.
+     */
+    IntrusiveHashSet( IntrusiveHashSet<T, H, E, Tag>&& set );
+
+    /**
+     * Destructs the set, unlinking any items still in it.
+     */
+    ~IntrusiveHashSet();
+
+    // OPERATORS
+    /**
+     * Unlinks the items of this set and moves the other set's items to this
+     * instance.
+     */
+    IntrusiveHashSet<T, H, E, Tag>& operator=(
+        IntrusiveHashSet<T, H, E, Tag>&& set );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Links the item into the set.
+     *
+     * Returns false without linking the item if an equal item is already in
+     * the set.
+     *
+     * Behavior is undefined when:
+     * the item is already in a set through this hook
+     */
+    bool add( T& item );
+
+    /**
+     * Unlinks the item from the set.
+     *
+     * Behavior is undefined when:
+     * the item is not in this set
+     */
+    void remove( T& item );
+
+    /**
+     * Gets the item in the set that is equal to the value.
+     *
+     * Returns nullptr if there is none.
+     */
+    T* find( const T& value ) const;
+
+    /**
+     * Checks if an item equal to the value is in the set.
+     */
+    bool has( const T& value ) const;
+
+    /**
+     * Makes room for at least the given number of items so that adding up
+     * to that many does not allocate.
+     */
+    void reserve( uint32 capacity );
+
+    /**
+     * Unlinks every item.
+     */
+    void clear();
+
+    /**
+     * Gets an iterator for the set.
+     */
+    Iterator begin() const;
+
+    /**
+     * Gets an iterator for the end of the set.
+     */
+    Iterator end() const;
+
+    /**
+     * Gets the number of items in the set.
+     */
+    uint32 size() const;
+
+    /**
+     * Checks if the set is empty.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Gets the number of buckets.
+     */
+    uint32 bucketCount() const;
+
+    /**
+     * Gets the memory footprint and occupancy of the set.
+     *
+     * Only the buckets are allocated by the set. The used bytes are those
+     * of the buckets that head a chain and the longest probe is the longest
+     * chain past its first hook. This walks every bucket.
+     */
+    ContainerStats stats() const;
+};
+
+// CONSTANTS
+template <typename T, typename H, typename E, typename Tag>
+constexpr uint32 IntrusiveHashSet<T, H, E, Tag>::MIN_BUCKETS;
+
+// HOOK CONSTRUCTORS
+template <typename Tag>
+inline
+IntrusiveSetHook<Tag>::IntrusiveSetHook()
+    : _next( nullptr ), _link( nullptr ), _hashCode( 0 )
+{
+}
+
+template <typename Tag>
+inline
+IntrusiveSetHook<Tag>::IntrusiveSetHook( const IntrusiveSetHook<Tag>& )
+    : _next( nullptr ), _link( nullptr ), _hashCode( 0 )
+{
+}
+
+template <typename Tag>
+inline
+IntrusiveSetHook<Tag>::~IntrusiveSetHook()
+{
+    assert( !isLinked() );
+}
+
+// HOOK OPERATORS
+template <typename Tag>
+inline
+IntrusiveSetHook<Tag>&
+IntrusiveSetHook<Tag>::operator=( const IntrusiveSetHook<Tag>& )
+{
+    return *this;
+}
+
+// HOOK MEMBER FUNCTIONS
+template <typename Tag>
+inline
+bool IntrusiveSetHook<Tag>::isLinked() const
+{
+    return _link != nullptr;
+}
+
+// CONSTRUCTORS
+template <typename T, typename H, typename E, typename Tag>
+inline
+IntrusiveHashSet<T, H, E, Tag>::IntrusiveHashSet()
+    : IntrusiveHashSet( nullptr, 0 )
+{
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+IntrusiveHashSet<T, H, E, Tag>::IntrusiveHashSet( uint32 capacity )
+    : IntrusiveHashSet( nullptr, capacity )
+{
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+IntrusiveHashSet<T, H, E, Tag>::IntrusiveHashSet(
+    mem::IAllocator<Hook*>* allocator )
+    : IntrusiveHashSet( allocator, 0 )
+{
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+IntrusiveHashSet<T, H, E, Tag>::IntrusiveHashSet(
+    mem::IAllocator<Hook*>* allocator, uint32 capacity )
+    : _allocator( allocator ), _buckets( nullptr ), _bucketCount( 0 ),
+      _shift( 32 ), _size( 0 ), _hasher(), _equality()
+{
+    reserve( capacity );
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+IntrusiveHashSet<T, H, E, Tag>::IntrusiveHashSet(
+    IntrusiveHashSet<T, H, E, Tag>&& set )
+    : _allocator( set._allocator ), _buckets( nullptr ), _bucketCount( 0 ),
+      _shift( 32 ), _size( 0 ), _hasher(), _equality()
+{
+    *this = std::move( set );
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+IntrusiveHashSet<T, H, E, Tag>::~IntrusiveHashSet()
+{
+    clear();
+    release();
+}
+
+// OPERATORS
+template <typename T, typename H, typename E, typename Tag>
+IntrusiveHashSet<T, H, E, Tag>& IntrusiveHashSet<T, H, E, Tag>::operator=(
+    IntrusiveHashSet<T, H, E, Tag>&& set )
+{
+    if ( this == &set )
+    {
+        return *this;
+    }
+
+    clear();
+    release();
+
+    // the hooks point into the bucket array so it moves as a whole
+    _allocator = set._allocator;
+    _buckets = set._buckets;
+    _bucketCount = set._bucketCount;
+    _shift = set._shift;
+    _size = set._size;
+    _hasher = std::move( set._hasher );
+    _equality = std::move( set._equality );
+
+    set._buckets = nullptr;
+    set._bucketCount = 0;
+    set._shift = 32;
+    set._size = 0;
+
+    return *this;
+}
+
+// ITERATOR CONSTRUCTORS
+template <typename T, typename H, typename E, typename Tag>
+inline
+IntrusiveHashSet<T, H, E, Tag>::Iterator::Iterator()
+    : _iterSet( nullptr ), _iterBucket( 0 ), _iterHook( nullptr )
+{
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+IntrusiveHashSet<T, H, E, Tag>::Iterator::Iterator(
+    const IntrusiveHashSet<T, H, E, Tag>* set, uint32 bucket )
+    : _iterSet( set ), _iterBucket( bucket ), _iterHook( nullptr )
+{
+    while ( _iterBucket < _iterSet->_bucketCount &&
+            ( _iterHook = _iterSet->_buckets[_iterBucket] ) == nullptr )
+    {
+        ++_iterBucket;
+    }
+}
+
+// ITERATOR OPERATORS
+template <typename T, typename H, typename E, typename Tag>
+inline
+typename IntrusiveHashSet<T, H, E, Tag>::Iterator&
+IntrusiveHashSet<T, H, E, Tag>::Iterator::operator++()
+{
+    _iterHook = _iterHook->_next;
+    while ( _iterHook == nullptr && ++_iterBucket < _iterSet->_bucketCount )
+    {
+        _iterHook = _iterSet->_buckets[_iterBucket];
+    }
+
+    return *this;
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+T& IntrusiveHashSet<T, H, E, Tag>::Iterator::operator*() const
+{
+    return itemOf( _iterHook );
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+T* IntrusiveHashSet<T, H, E, Tag>::Iterator::operator->() const
+{
+    return &itemOf( _iterHook );
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+bool IntrusiveHashSet<T, H, E, Tag>::Iterator::operator==(
+    const Iterator& iter ) const
+{
+    return _iterHook == iter._iterHook;
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+bool IntrusiveHashSet<T, H, E, Tag>::Iterator::operator!=(
+    const Iterator& iter ) const
+{
+    return _iterHook != iter._iterHook;
+}
+
+// MEMBER FUNCTIONS
+template <typename T, typename H, typename E, typename Tag>
+bool IntrusiveHashSet<T, H, E, Tag>::add( T& item )
+{
+    Hook* hook = hookOf( item );
+    assert( !hook->isLinked() );
+
+    const uint32 hashCode = _hasher.hash( item );
+    if ( findHook( hashCode, item ) != nullptr )
+    {
+        return false;
+    }
+
+    if ( _size >= _bucketCount )
+    {
+        rebuild( _bucketCount > 0 ? _bucketCount * 2 : MIN_BUCKETS );
+    }
+
+    hook->_hashCode = hashCode;
+    link( hook );
+    ++_size;
+
+    return true;
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+void IntrusiveHashSet<T, H, E, Tag>::remove( T& item )
+{
+    Hook* hook = hookOf( item );
+    assert( hook->isLinked() );
+    assert( _size > 0 );
+
+    *hook->_link = hook->_next;
+    if ( hook->_next != nullptr )
+    {
+        hook->_next->_link = hook->_link;
+    }
+
+    hook->_next = nullptr;
+    hook->_link = nullptr;
+    --_size;
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+T* IntrusiveHashSet<T, H, E, Tag>::find( const T& value ) const
+{
+    Hook* hook = findHook( _hasher.hash( value ), value );
+    return hook != nullptr ? &itemOf( hook ) : nullptr;
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+bool IntrusiveHashSet<T, H, E, Tag>::has( const T& value ) const
+{
+    return findHook( _hasher.hash( value ), value ) != nullptr;
+}
+
+template <typename T, typename H, typename E, typename Tag>
+void IntrusiveHashSet<T, H, E, Tag>::reserve( uint32 capacity )
+{
+    uint32 bucketCount = _bucketCount > 0 ? _bucketCount : MIN_BUCKETS;
+    while ( bucketCount < capacity )
+    {
+        bucketCount <<= 1;
+    }
+
+    if ( capacity > 0 && bucketCount > _bucketCount )
+    {
+        rebuild( bucketCount );
+    }
+}
+
+template <typename T, typename H, typename E, typename Tag>
+void IntrusiveHashSet<T, H, E, Tag>::clear()
+{
+    uint32 i;
+    for ( i = 0; i < _bucketCount; ++i )
+    {
+        Hook* hook = _buckets[i];
+        while ( hook != nullptr )
+        {
+            Hook* next = hook->_next;
+            hook->_next = nullptr;
+            hook->_link = nullptr;
+            hook = next;
+        }
+
+        _buckets[i] = nullptr;
+    }
+
+    _size = 0;
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+typename IntrusiveHashSet<T, H, E, Tag>::Iterator
+IntrusiveHashSet<T, H, E, Tag>::begin() const
+{
+    return Iterator( this, 0 );
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+typename IntrusiveHashSet<T, H, E, Tag>::Iterator
+IntrusiveHashSet<T, H, E, Tag>::end() const
+{
+    return Iterator( this, _bucketCount );
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+uint32 IntrusiveHashSet<T, H, E, Tag>::size() const
+{
+    return _size;
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+bool IntrusiveHashSet<T, H, E, Tag>::isEmpty() const
+{
+    return _size == 0;
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+uint32 IntrusiveHashSet<T, H, E, Tag>::bucketCount() const
+{
+    return _bucketCount;
+}
+
+template <typename T, typename H, typename E, typename Tag>
+ContainerStats IntrusiveHashSet<T, H, E, Tag>::stats() const
+{
+    ContainerStats stats;
+    stats.size = _size;
+    stats.capacity = _bucketCount;
+    stats.bucketCount = _bucketCount;
+    if ( _buckets == nullptr )
+    {
+        return stats;
+    }
+
+    stats.bytesReserved = static_cast<uint64>( _bucketCount ) *
+        sizeof( Hook* );
+
+    uint32 length;
+    const Hook* hook;
+    uint32 i;
+    for ( i = 0; i < _bucketCount; ++i )
+    {
+        if ( _buckets[i] == nullptr )
+        {
+            continue;
+        }
+
+        stats.bytesUsed += sizeof( Hook* );
+        for ( length = 0, hook = _buckets[i]->_next; hook != nullptr;
+              hook = hook->_next )
+        {
+            ++length;
+        }
+        stats.maxProbeLength = length > stats.maxProbeLength
+            ? length : stats.maxProbeLength;
+    }
+
+    return stats;
+}
+
+// HELPER FUNCTIONS
+template <typename T, typename H, typename E, typename Tag>
+inline
+uint32 IntrusiveHashSet<T, H, E, Tag>::bucketOf( uint32 hashCode ) const
+{
+    // fibonacci hashing spreads weak hash codes over the high bits
+    return ( hashCode * 2654435769u ) >> _shift;
+}
+
+template <typename T, typename H, typename E, typename Tag>
+typename IntrusiveHashSet<T, H, E, Tag>::Hook*
+IntrusiveHashSet<T, H, E, Tag>::findHook( uint32 hashCode,
+                                          const T& value ) const
+{
+    if ( _bucketCount == 0 )
+    {
+        return nullptr;
+    }
+
+    Hook* hook;
+    for ( hook = _buckets[bucketOf( hashCode )]; hook != nullptr;
+          hook = hook->_next )
+    {
+        if ( hook->_hashCode == hashCode &&
+             _equality.equals( itemOf( hook ), value ) )
+        {
+            return hook;
+        }
+    }
+
+    return nullptr;
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+void IntrusiveHashSet<T, H, E, Tag>::link( Hook* hook )
+{
+    Hook** head = _buckets + bucketOf( hook->_hashCode );
+
+    hook->_next = *head;
+    hook->_link = head;
+    if ( *head != nullptr )
+    {
+        ( *head )->_link = &hook->_next;
+    }
+    *head = hook;
+}
+
+template <typename T, typename H, typename E, typename Tag>
+void IntrusiveHashSet<T, H, E, Tag>::rebuild( uint32 bucketCount )
+{
+    assert( ( bucketCount & ( bucketCount - 1 ) ) == 0 );
+    assert( bucketCount >= MIN_BUCKETS );
+
+    Hook** oldBuckets = _buckets;
+    const uint32 oldCount = _bucketCount;
+
+    _buckets = _allocator.get( bucketCount );
+    _bucketCount = bucketCount;
+    mem::MemoryUtils::set( _buckets, static_cast<Hook*>( nullptr ),
+                           bucketCount );
+    for ( _shift = 32; bucketCount > 1; bucketCount >>= 1 )
+    {
+        --_shift;
+    }
+
+    uint32 i;
+    for ( i = 0; i < oldCount; ++i )
+    {
+        Hook* hook = oldBuckets[i];
+        while ( hook != nullptr )
+        {
+            Hook* next = hook->_next;
+            link( hook );
+            hook = next;
+        }
+    }
+
+    if ( oldBuckets != nullptr )
+    {
+        _allocator.release( oldBuckets, oldCount );
+    }
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+void IntrusiveHashSet<T, H, E, Tag>::release()
+{
+    if ( _buckets != nullptr )
+    {
+        _allocator.release( _buckets, _bucketCount );
+    }
+
+    _buckets = nullptr;
+    _bucketCount = 0;
+    _shift = 32;
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+T& IntrusiveHashSet<T, H, E, Tag>::itemOf( Hook* hook )
+{
+    return *static_cast<T*>( hook );
+}
+
+template <typename T, typename H, typename E, typename Tag>
+inline
+typename IntrusiveHashSet<T, H, E, Tag>::Hook*
+IntrusiveHashSet<T, H, E, Tag>::hookOf( T& item )
+{
+    return static_cast<Hook*>( &item );
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif
@@ -0,0 +1,747 @@
+// intrusive_list.h
+//
+// Defines a doubly linked list whose links live inside the items.
+//
+// An item joins a list by deriving from IntrusiveListHook, so linking and
+// unlinking it never allocates and removing it does not search the list.
+// The list does not own its items, it only links them. An item can be in
+// one list per hook it derives from, and the tag tells the hooks apart:
+//
+//     struct Tick;
+//     struct Draw;
+//     class Entity : public IntrusiveListHook<Tick>,
+//                    public IntrusiveListHook<Draw> { ... };
+//
+//     IntrusiveList<Entity, Tick> ticking;
+//     IntrusiveList<Entity, Draw> drawing;
+//
+#ifndef NGE_CNTR_INTRUSIVE_LIST_H
+#define NGE_CNTR_INTRUSIVE_LIST_H
+
+#include <assert.h>
+#include <type_traits>
+#include <utility>
+
+#include "engine/intdef.h"
+#include "engine/containers/container_stats.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+template <typename T, typename Tag>
+class IntrusiveList;
+
+template <typename Tag = void>
+class IntrusiveListHook
+{
+  private:
+    // FRIENDS
+    template <typename T, typename U>
+    friend class IntrusiveList;
+
+    // MEMBERS
+    /**
+     * The previous hook in the list.
+     */
+    IntrusiveListHook<Tag>* _prev;
+
+    /**
+     * The next hook in the list.
+     */
+    IntrusiveListHook<Tag>* _next;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs an unlinked hook.
+     */
+    IntrusiveListHook();
+
+    /**
+     * Constructs an unlinked hook.
+     *
+     * Copying an item does not add the copy to the item's list.
+     */
+    IntrusiveListHook( const IntrusiveListHook<Tag>& hook );
+
+    /**
+     * Destructs the hook.
+     *
+     * Behavior is undefined when:
+     * the hook is still in a list
+     */
+    ~IntrusiveListHook();
+
+    // OPERATORS
+    /**
+     * Leaves the hook's links untouched.
+     *
+     * Assigning an item does not change which list it is in.
+     */
+    IntrusiveListHook<Tag>& operator=( const IntrusiveListHook<Tag>& hook );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Checks if the hook is in a list.
+     */
+    bool isLinked() const;
+};
+
+template <typename T, typename Tag = void>
+class IntrusiveList
+{
+    static_assert( std::is_base_of<IntrusiveListHook<Tag>, T>::value,
+                   "Items must derive from the list's hook." );
+
+  public:
+    // TYPES
+    typedef IntrusiveListHook<Tag> Hook;
+
+  private:
+    // CLASSES
+    /**
+     * Defines an iterator for the list.
+     */
+    template <typename TREF, typename TPTR>
+    class ListIterator
+    {
+      private:
+        // MEMBERS
+        /**
+         * The hook at the current position.
+         */
+        const Hook* _iterHook;
+
+      public:
+        // CONSTRUCTORS
+        /**
+         * Constructs a new iterator.
+         */
+        ListIterator();
+
+        /**
+         * Constructs an iterator at the given hook.
+         */
+        ListIterator( const Hook* hook );
+
+        // OPERATORS
+        /**
+         * Moves to the next item.
+         */
+        ListIterator& operator++();
+
+        /**
+         * Moves to the previous item.
+         */
+        ListIterator& operator--();
+
+        /**
+         * Gets the item at the current position.
+         */
+        TREF operator*() const;
+
+        /**
+         * Gets the item at the current position.
+         */
+        TPTR operator->() const;
+
+        /**
+         * Checks if the other iterator is at the same position.
+         */
+        bool operator==( const ListIterator& iter ) const;
+
+        /**
+         * Checks if the other iterator is not at the same position.
+         */
+        bool operator!=( const ListIterator& iter ) const;
+    };
+
+  public:
+    // TYPES
+    typedef ListIterator<T&, T*> Iterator;
+
+    typedef ListIterator<const T&, const T*> ConstIterator;
+
+  private:
+    // MEMBERS
+    /**
+     * The hook that links the last item to the first.
+     */
+    Hook _root;
+
+    /**
+     * The number of items in the list.
+     */
+    uint32 _size;
+
+    // CONSTRUCTORS
+    /**
+     * Disabled: lists cannot be copied since an item is only in one.
+     */
+    IntrusiveList( const IntrusiveList<T, Tag>& list ) = delete;
+
+    // OPERATORS
+    /**
+     * Disabled: lists cannot be copied since an item is only in one.
+     */
+    IntrusiveList<T, Tag>& operator=( const IntrusiveList<T, Tag>& list ) =
+        delete;
+
+    // HELPER FUNCTIONS
+    /**
+     * Links the hook in before the given hook.
+     */
+    void linkBefore( Hook* position, Hook* hook );
+
+    /**
+     * Gets the item that owns the hook.
+     */
+    static T& itemOf( Hook* hook );
+
+    /**
+     * Gets the hook of the item.
+     */
+    static Hook* hookOf( T& item );
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a new empty list.
+     */
+    IntrusiveList();
+
+    /**
+     * Moves the items of the list to a new instance.
+     */
+    IntrusiveList( IntrusiveList<T, Tag>&& list );
+
+    /**
+     * Destructs the list, unlinking any items still in it.
+     */
+    ~IntrusiveList();
+
+    // OPERATORS
+    /**
+     * Unlinks the items of this list and moves the other list's items to
+     * this instance.
+     */
+    IntrusiveList<T, Tag>& operator=( IntrusiveList<T, Tag>&& list );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Links the item in at the back of the list.
+     *
+     * Behavior is undefined when:
+     * the item is already in a list through this hook
+     */
+    void push( T& item );
+
+    /**
+     * Links the item in at the front of the list.
+     *
+     * Behavior is undefined when:
+     * the item is already in a list through this hook
+     */
+    void pushFront( T& item );
+
+    /**
+     * Links the item in right after the given position.
+     *
+     * Behavior is undefined when:
+     * position is not in this list
+     * the item is already in a list through this hook
+     */
+    void insertAfter( T& position, T& item );
+
+    /**
+     * Links the item in right before the given position.
+     *
+     * Behavior is undefined when:
+     * position is not in this list
+     * the item is already in a list through this hook
+     */
+    void insertBefore( T& position, T& item );
+
+    /**
+     * Unlinks the item at the back of the list and gets it.
+     *
+     * Behavior is undefined when:
+     * the list is empty
+     */
+    T& pop();
+
+    /**
+     * Unlinks the item at the front of the list and gets it.
+     *
+     * Behavior is undefined when:
+     * the list is empty
+     */
+    T& popFront();
+
+    /**
+     * Unlinks the item from the list.
+     *
+     * Behavior is undefined when:
+     * the item is not in this list
+     */
+    void remove( T& item );
+
+    /**
+     * Unlinks every item.
+     */
+    void clear();
+
+    /**
+     * Gets the item at the front of the list.
+     *
+     * Behavior is undefined when:
+     * the list is empty
+     */
+    T& front() const;
+
+    /**
+     * Gets the item at the back of the list.
+     *
+     * Behavior is undefined when:
+     * the list is empty
+     */
+    T& back() const;
+
+    /**
+     * Gets the item after the given one.
+     *
+     * Returns nullptr if the item is the last one.
+     *
+     * Behavior is undefined when:
+     * the item is not in this list
+     */
+    T* next( T& item ) const;
+
+    /**
+     * Gets the item before the given one.
+     *
+     * Returns nullptr if the item is the first one.
+     *
+     * Behavior is undefined when:
+     * the item is not in this list
+     */
+    T* prev( T& item ) const;
+
+    /**
+     * Gets an iterator for the list.
+     */
+    Iterator begin();
+
+    /**
+     * Gets a constant iterator for the list.
+     */
+    ConstIterator cbegin() const;
+
+    /**
+     * Gets an iterator for the end of the list.
+     */
+    Iterator end();
+
+    /**
+     * Gets a constant iterator for the end of the list.
+     */
+    ConstIterator cend() const;
+
+    /**
+     * Gets the number of items in the list.
+     */
+    uint32 size() const;
+
+    /**
+     * Checks if the list is empty.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Gets the occupancy of the list.
+     *
+     * The list allocates nothing so only the size is set.
+     */
+    ContainerStats stats() const;
+};
+
+// HOOK CONSTRUCTORS
+template <typename Tag>
+inline
+IntrusiveListHook<Tag>::IntrusiveListHook()
+    : _prev( nullptr ), _next( nullptr )
+{
+}
+
+template <typename Tag>
+inline
+IntrusiveListHook<Tag>::IntrusiveListHook( const IntrusiveListHook<Tag>& )
+    : _prev( nullptr ), _next( nullptr )
+{
+}
+
+template <typename Tag>
+inline
+IntrusiveListHook<Tag>::~IntrusiveListHook()
+{
+    assert( !isLinked() );
+}
+
+// HOOK OPERATORS
+template <typename Tag>
+inline
+IntrusiveListHook<Tag>&
+IntrusiveListHook<Tag>::operator=( const IntrusiveListHook<Tag>& )
+{
+    return *this;
+}
+
+// HOOK MEMBER FUNCTIONS
+template <typename Tag>
+inline
+bool IntrusiveListHook<Tag>::isLinked() const
+{
+    return _next != nullptr;
+}
+
+// CONSTRUCTORS
+template <typename T, typename Tag>
+inline
+IntrusiveList<T, Tag>::IntrusiveList() : _root(), _size( 0 )
+{
+    _root._prev = &_root;
+    _root._next = &_root;
+}
+
+template <typename T, typename Tag>
+inline
+IntrusiveList<T, Tag>::IntrusiveList( IntrusiveList<T, Tag>&& list )
+    : IntrusiveList()
+{
+    *this = std::move( list );
+}
+
+template <typename T, typename Tag>
+inline
+IntrusiveList<T, Tag>::~IntrusiveList()
+{
+    clear();
+
+    // the root links to itself, which is not a list membership
+    _root._prev = nullptr;
+    _root._next = nullptr;
+}
+
+// OPERATORS
+template <typename T, typename Tag>
+IntrusiveList<T, Tag>&
+IntrusiveList<T, Tag>::operator=( IntrusiveList<T, Tag>&& list )
+{
+    if ( this == &list )
+    {
+        return *this;
+    }
+
+    clear();
+
+    if ( list._size > 0 )
+    {
+        // swap the other root out for this one
+        _root._next = list._root._next;
+        _root._prev = list._root._prev;
+        _root._next->_prev = &_root;
+        _root._prev->_next = &_root;
+        _size = list._size;
+
+        list._root._next = &list._root;
+        list._root._prev = &list._root;
+        list._size = 0;
+    }
+
+    return *this;
+}
+
+// ITERATOR CONSTRUCTORS
+template <typename T, typename Tag>
+template <typename TREF, typename TPTR>
+inline
+IntrusiveList<T, Tag>::ListIterator<TREF, TPTR>::ListIterator()
+    : _iterHook( nullptr )
+{
+}
+
+template <typename T, typename Tag>
+template <typename TREF, typename TPTR>
+inline
+IntrusiveList<T, Tag>::ListIterator<TREF, TPTR>::ListIterator(
+    const Hook* hook )
+    : _iterHook( hook )
+{
+}
+
+// ITERATOR OPERATORS
+template <typename T, typename Tag>
+template <typename TREF, typename TPTR>
+inline
+typename IntrusiveList<T, Tag>::template ListIterator<TREF, TPTR>&
+IntrusiveList<T, Tag>::ListIterator<TREF, TPTR>::operator++()
+{
+    _iterHook = _iterHook->_next;
+
+    return *this;
+}
+
+template <typename T, typename Tag>
+template <typename TREF, typename TPTR>
+inline
+typename IntrusiveList<T, Tag>::template ListIterator<TREF, TPTR>&
+IntrusiveList<T, Tag>::ListIterator<TREF, TPTR>::operator--()
+{
+    _iterHook = _iterHook->_prev;
+
+    return *this;
+}
+
+template <typename T, typename Tag>
+template <typename TREF, typename TPTR>
+inline
+TREF IntrusiveList<T, Tag>::ListIterator<TREF, TPTR>::operator*() const
+{
+    return itemOf( const_cast<Hook*>( _iterHook ) );
+}
+
+template <typename T, typename Tag>
+template <typename TREF, typename TPTR>
+inline
+TPTR IntrusiveList<T, Tag>::ListIterator<TREF, TPTR>::operator->() const
+{
+    return &itemOf( const_cast<Hook*>( _iterHook ) );
+}
+
+template <typename T, typename Tag>
+template <typename TREF, typename TPTR>
+inline
+bool IntrusiveList<T, Tag>::ListIterator<TREF, TPTR>::operator==(
+    const ListIterator& iter ) const
+{
+    return _iterHook == iter._iterHook;
+}
+
+template <typename T, typename Tag>
+template <typename TREF, typename TPTR>
+inline
+bool IntrusiveList<T, Tag>::ListIterator<TREF, TPTR>::operator!=(
+    const ListIterator& iter ) const
+{
+    return _iterHook != iter._iterHook;
+}
+
+// MEMBER FUNCTIONS
+template <typename T, typename Tag>
+inline
+void IntrusiveList<T, Tag>::push( T& item )
+{
+    linkBefore( &_root, hookOf( item ) );
+}
+
+template <typename T, typename Tag>
+inline
+void IntrusiveList<T, Tag>::pushFront( T& item )
+{
+    linkBefore( _root._next, hookOf( item ) );
+}
+
+template <typename T, typename Tag>
+inline
+void IntrusiveList<T, Tag>::insertAfter( T& position, T& item )
+{
+    assert( hookOf( position )->isLinked() );
+    linkBefore( hookOf( position )->_next, hookOf( item ) );
+}
+
+template <typename T, typename Tag>
+inline
+void IntrusiveList<T, Tag>::insertBefore( T& position, T& item )
+{
+    assert( hookOf( position )->isLinked() );
+    linkBefore( hookOf( position ), hookOf( item ) );
+}
+
+template <typename T, typename Tag>
+inline
+T& IntrusiveList<T, Tag>::pop()
+{
+    assert( _size > 0 );
+
+    T& item = itemOf( _root._prev );
+    remove( item );
+
+    return item;
+}
+
+template <typename T, typename Tag>
+inline
+T& IntrusiveList<T, Tag>::popFront()
+{
+    assert( _size > 0 );
+
+    T& item = itemOf( _root._next );
+    remove( item );
+
+    return item;
+}
+
+template <typename T, typename Tag>
+inline
+void IntrusiveList<T, Tag>::remove( T& item )
+{
+    Hook* hook = hookOf( item );
+    assert( hook->isLinked() );
+    assert( _size > 0 );
+
+    hook->_prev->_next = hook->_next;
+    hook->_next->_prev = hook->_prev;
+    hook->_prev = nullptr;
+    hook->_next = nullptr;
+    --_size;
+}
+
+template <typename T, typename Tag>
+void IntrusiveList<T, Tag>::clear()
+{
+    Hook* hook = _root._next;
+    while ( hook != &_root )
+    {
+        Hook* next = hook->_next;
+        hook->_prev = nullptr;
+        hook->_next = nullptr;
+        hook = next;
+    }
+
+    _root._prev = &_root;
+    _root._next = &_root;
+    _size = 0;
+}
+
+template <typename T, typename Tag>
+inline
+T& IntrusiveList<T, Tag>::front() const
+{
+    assert( _size > 0 );
+    return itemOf( _root._next );
+}
+
+template <typename T, typename Tag>
+inline
+T& IntrusiveList<T, Tag>::back() const
+{
+    assert( _size > 0 );
+    return itemOf( _root._prev );
+}
+
+template <typename T, typename Tag>
+inline
+T* IntrusiveList<T, Tag>::next( T& item ) const
+{
+    Hook* next = hookOf( item )->_next;
+    return next != &_root ? &itemOf( next ) : nullptr;
+}
+
+template <typename T, typename Tag>
+inline
+T* IntrusiveList<T, Tag>::prev( T& item ) const
+{
+    Hook* prev = hookOf( item )->_prev;
+    return prev != &_root ? &itemOf( prev ) : nullptr;
+}
+
+template <typename T, typename Tag>
+inline
+typename IntrusiveList<T, Tag>::Iterator IntrusiveList<T, Tag>::begin()
+{
+    return Iterator( _root._next );
+}
+
+template <typename T, typename Tag>
+inline
+typename IntrusiveList<T, Tag>::ConstIterator
+IntrusiveList<T, Tag>::cbegin() const
+{
+    return ConstIterator( _root._next );
+}
+
+template <typename T, typename Tag>
+inline
+typename IntrusiveList<T, Tag>::Iterator IntrusiveList<T, Tag>::end()
+{
+    return Iterator( &_root );
+}
+
+template <typename T, typename Tag>
+inline
+typename IntrusiveList<T, Tag>::ConstIterator
+IntrusiveList<T, Tag>::cend() const
+{
+    return ConstIterator( &_root );
+}
+
+template <typename T, typename Tag>
+inline
+uint32 IntrusiveList<T, Tag>::size() const
+{
+    return _size;
+}
+
+template <typename T, typename Tag>
+inline
+bool IntrusiveList<T, Tag>::isEmpty() const
+{
+    return _size == 0;
+}
+
+template <typename T, typename Tag>
+inline
+ContainerStats IntrusiveList<T, Tag>::stats() const
+{
+    ContainerStats stats;
+    stats.size = _size;
+
+    return stats;
+}
+
+// HELPER FUNCTIONS
+template <typename T, typename Tag>
+inline
+void IntrusiveList<T, Tag>::linkBefore( Hook* position, Hook* hook )
+{
+    assert( !hook->isLinked() );
+
+    hook->_next = position;
+    hook->_prev = position->_prev;
+    position->_prev->_next = hook;
+    position->_prev = hook;
+    ++_size;
+}
+
+template <typename T, typename Tag>
+inline
+T& IntrusiveList<T, Tag>::itemOf( Hook* hook )
+{
+    return *static_cast<T*>( hook );
+}
+
+template <typename T, typename Tag>
+inline
+typename IntrusiveList<T, Tag>::Hook* IntrusiveList<T, Tag>::hookOf( T& item )
+{
+    return static_cast<Hook*>( &item );
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif
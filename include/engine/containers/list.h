@@ -2,6 +2,15 @@
 //
 // Defines a circularly linked list.
 //
+// The nodes live in a single array and link to each other by their position
+// in it. A node keeps its position for as long as it is in the list, so the
+// position doubles as a handle that allows constant time access, insertion
+// and removal around it.
+//
+// After many insertions and removals the nodes end up scattered across the
+// array. Defragmenting moves them back into list order so iteration walks
+// memory sequentially. Since that moves nodes it invalidates handles.
+//
 #ifndef NGE_CNTR_LIST_H
 #define NGE_CNTR_LIST_H
 
@@ -10,6 +19,7 @@
 #include <stdexcept>
 #include <utility>
 
+#include "engine/containers/container_stats.h"
 #include "engine/memory/allocator_guard.h"
 #include "engine/memory/iallocator.h"
 #include "engine/memory/memory_utils.h"
@@ -143,6 +153,12 @@ class List
          * Checks if the other iterator is not at the same position.
          */
         bool operator!=( const ListIterator& iter ) const;
+
+        // MEMBER FUNCTIONS
+        /**
+         * Gets the handle of the current item.
+         */
+        uint32 handle() const;
     };
 
     // CONSTANTS
@@ -151,6 +167,11 @@ class List
      */
     static constexpr uint32 MIN_CAPACITY = 32;
 
+    /**
+     * Marks a node as free in its previous link.
+     */
+    static constexpr uint32 FREE = static_cast<uint32>( -1 );
+
     // MEMBERS
     /**
      * The node allocator.
@@ -162,9 +183,9 @@ class List
      * <p>
      * This array contains both the used and free items. There are two linked
      * lists within the array. The first links all of the items that are in
-     * use. The second includes all items that are free. When the number of
-     * items in use becomes less than 1/4 of the total items then the list
-     * will be reallocated.
+     * use. The second links forward through all items that are free. Nodes
+     * never move while they are in use so their positions can be handed out
+     * as handles.
      */
     Node* _nodes;
 
@@ -206,30 +227,78 @@ class List
     uint32 popFreeNodeAndGetPos();
 
     /**
-     * Inserts the node at the given position.
+     * Links a free node in before the node at the given position and gets
+     * the new node's position.
+     * <p>
+     * This does not change the first node of the list.
+     * <p>
+     * Behavior is undefined when:
+     * the list is empty
      */
-    void insertAtPos( uint32 index, Node& node );
+    uint32 linkBefore( uint32 pos );
 
     /**
-     * Pushes the node at the given index to the free list.
+     * Unlinks the node at the given position and moves it to the free list.
      */
-    void pushFree( uint32 index );
+    void unlink( uint32 pos );
 
     /**
-     * Halves the size of the internal array.
+     * Pushes all of the nodes from the given position to the end of the
+     * internal array to the free list.
+     * <p>
+     * The lowest position will be the first to be reused.
      */
-    void shrink();
+    void pushFreeFrom( uint32 start );
+
+    /**
+     * Copies the items of the given list in order to the start of the
+     * internal array.
+     * <p>
+     * Behavior is undefined when:
+     * this list is not empty
+     * the capacity is less than the size of the given list
+     */
+    void copyFrom( const List<T>& list );
+
+    /**
+     * Links a free node in at the given index and gets its position in the
+     * internal array.
+     *
+     * The value of the node is left for the caller to set.
+     */
+    uint32 insertAtPos( uint32 index );
+
+    /**
+     * Pushes the node at the given index to the free list.
+     */
+    void pushFree( uint32 index );
 
     /**
      * Doubles the size of the internal array.
      */
     void grow();
 
+    /**
+     * Defragments the list and halves the size of the internal array.
+     */
+    void shrink();
+
     /**
      * Resizes the internal array to the specified size.
+     * <p>
+     * The nodes keep their positions so handles remain valid.
+     * <p>
+     * Behavior is undefined when:
+     * size is less than the capacity and a node in use would be cut off
      */
     void resize( uint32 size );
 
+    /**
+     * Swaps the node at the given position into the target position and
+     * relinks both of them.
+     */
+    void swapNodes( uint32 target, uint32 pos );
+
     /**
      * Gets the node at the given index.
      */
@@ -246,14 +315,14 @@ class List
     uint32 getNodePos( uint32 index ) const;
 
     /**
-     * Checks if the internal array should be halved in size.
+     * Checks if the internal array should be doubled in size.
      */
-    bool shouldShrink() const;
+    bool shouldGrow() const;
 
     /**
-     * Checks if the internal array should be doubled in size.
+     * Checks if the internal array is mostly free and should be compacted.
      */
-    bool shouldGrow() const;
+    bool shouldShrink() const;
 
     /**
      * Checks if there is a free node.
@@ -262,6 +331,16 @@ class List
 
   public:
     // TYPES
+    /**
+     * Defines a stable reference to an item in the list.
+     * <p>
+     * A handle stays valid until its item is removed, regardless of any
+     * other insertions or removals through handles. Removing by index may
+     * compact the list and defragmenting always does, both of which
+     * invalidate every handle.
+     */
+    typedef uint32 Handle;
+
     /**
      * Defines an iterator for the list.
      */
@@ -273,6 +352,12 @@ class List
     typedef ListIterator<const List<T>*, const T&, const T&, const T*>
         ConstIterator;
 
+    // CONSTANTS
+    /**
+     * The handle that refers to no item.
+     */
+    static constexpr Handle NULL_HANDLE = static_cast<uint32>( -1 );
+
     // CONSTRUCTORS
     /**
      * Constructs a new list.
@@ -369,18 +454,57 @@ class List
      */
     void insertAt( uint32 index, T&& value );
 
+    /**
+     * Constructs a value at the end of the list from the given arguments
+     * and gets it.
+     *
+     * The value is constructed directly in the node's storage. If the
+     * constructor throws, the list is left as it was.
+     */
+    template <typename... Args>
+    T& emplace( Args&&... args );
+
+    /**
+     * Constructs a value at the front of the list from the given arguments
+     * and gets it.
+     *
+     * The value is constructed directly in the node's storage. If the
+     * constructor throws, the list is left as it was.
+     */
+    template <typename... Args>
+    T& emplaceFront( Args&&... args );
+
+    /**
+     * Constructs a value at the given index in the list from the given
+     * arguments and gets it.
+     *
+     * The value is constructed directly in the node's storage. If the
+     * constructor throws, the list is left as it was.
+     */
+    template <typename... Args>
+    T& emplaceAt( uint32 index, Args&&... args );
+
     /**
      * Removes the value at the back of the array.
+     * <p>
+     * This compacts the list when at least three quarters of the internal
+     * array is free.
      */
     T pop();
 
     /**
      * Removes the value at the front of the array.
+     * <p>
+     * This compacts the list when at least three quarters of the internal
+     * array is free.
      */
     T popFront();
 
     /**
      * Removes the value at the given index in the array.
+     * <p>
+     * This compacts the list when at least three quarters of the internal
+     * array is free.
      */
     T removeAt( uint32 index );
 
@@ -396,6 +520,35 @@ class List
      */
     void clear();
 
+    /**
+     * Moves the nodes into list order at the start of the internal array.
+     * <p>
+     * This runs in linear time and does not allocate. Iterating a
+     * defragmented list walks memory sequentially. All handles are
+     * invalidated.
+     */
+    void defragment();
+
+    /**
+     * Defragments the list and shrinks the internal array to the smallest
+     * capacity that holds the items.
+     * <p>
+     * All handles are invalidated.
+     */
+    void compact();
+
+    /**
+     * Gets the number of items the list can hold without reallocating.
+     */
+    uint32 capacity() const;
+
+    /**
+     * Gets the memory footprint and occupancy of the list.
+     *
+     * Byte counts are of whole nodes, links included.
+     */
+    ContainerStats stats() const;
+
     /**
      * Gets an iterator at the start of the list.
      */
@@ -437,12 +590,116 @@ class List
      * Checks if the array is empty.
      */
     bool isEmpty() const;
+
+    /**
+     * Gets the handle of the first item or NULL_HANDLE if the list is empty.
+     */
+    Handle first() const;
+
+    /**
+     * Gets the handle of the last item or NULL_HANDLE if the list is empty.
+     */
+    Handle last() const;
+
+    /**
+     * Gets the handle of the item after the given one or NULL_HANDLE if it
+     * is the last.
+     * <p>
+     * Behavior is undefined when:
+     * handle is not in the list
+     */
+    Handle next( Handle handle ) const;
+
+    /**
+     * Gets the handle of the item before the given one or NULL_HANDLE if it
+     * is the first.
+     * <p>
+     * Behavior is undefined when:
+     * handle is not in the list
+     */
+    Handle prev( Handle handle ) const;
+
+    /**
+     * Gets the handle of the item at the given index.
+     * <p>
+     * This walks the list so it should only be used to get a starting point.
+     * <p>
+     * Behavior is undefined when:
+     * index is out of bounds
+     */
+    Handle handleAt( uint32 index ) const;
+
+    /**
+     * Gets the item with the given handle.
+     * <p>
+     * Behavior is undefined when:
+     * handle is not in the list
+     */
+    const T& value( Handle handle ) const;
+
+    /**
+     * Gets the item with the given handle.
+     * <p>
+     * Behavior is undefined when:
+     * handle is not in the list
+     */
+    T& value( Handle handle );
+
+    /**
+     * Inserts the value after the item with the given handle and gets the
+     * new item's handle.
+     * <p>
+     * Behavior is undefined when:
+     * handle is not in the list
+     */
+    Handle insertAfter( Handle handle, const T& value );
+
+    /**
+     * Moves the value after the item with the given handle and gets the
+     * new item's handle.
+     * <p>
+     * Behavior is undefined when:
+     * handle is not in the list
+     */
+    Handle insertAfter( Handle handle, T&& value );
+
+    /**
+     * Inserts the value before the item with the given handle and gets the
+     * new item's handle.
+     * <p>
+     * Behavior is undefined when:
+     * handle is not in the list
+     */
+    Handle insertBefore( Handle handle, const T& value );
+
+    /**
+     * Moves the value before the item with the given handle and gets the
+     * new item's handle.
+     * <p>
+     * Behavior is undefined when:
+     * handle is not in the list
+     */
+    Handle insertBefore( Handle handle, T&& value );
+
+    /**
+     * Removes the item with the given handle.
+     * <p>
+     * Behavior is undefined when:
+     * handle is not in the list
+     */
+    T erase( Handle handle );
 };
 
 // CONSTANTS
 template <typename T>
 constexpr uint32 List<T>::MIN_CAPACITY;
 
+template <typename T>
+constexpr uint32 List<T>::FREE;
+
+template <typename T>
+constexpr typename List<T>::Handle List<T>::NULL_HANDLE;
+
 // CONSTRUCTORS
 template <typename T>
 inline
@@ -450,6 +707,7 @@ List<T>::List() : _alloc(), _nodes( nullptr ), _first( 0 ), _count( 0 ),
                   _firstFree( 0 ), _freeCount( 0 ), _capacity( MIN_CAPACITY )
 {
     _nodes = _alloc.get( _capacity );
+    pushFreeFrom( 0 );
 }
 
 template <typename T>
@@ -464,6 +722,7 @@ List<T>::List( uint32 capacity )
     }
 
     _nodes = _alloc.get( _capacity );
+    pushFreeFrom( 0 );
 }
 
 template <typename T>
@@ -473,6 +732,7 @@ List<T>::List( mem::IAllocator<Node>* alloc )
       _firstFree( 0 ), _freeCount( 0 ), _capacity( MIN_CAPACITY )
 {
     _nodes = _alloc.get( _capacity );
+    pushFreeFrom( 0 );
 }
 
 template <typename T>
@@ -487,77 +747,35 @@ List<T>::List( mem::IAllocator<Node>* alloc, uint32 capacity )
     }
 
     _nodes = _alloc.get( _capacity );
+    pushFreeFrom( 0 );
 }
 
 template <typename T>
 inline
 List<T>::List( const List<T>& list )
     : _alloc( list._alloc ), _nodes( nullptr ),
-      _first( 0 ), _count( list._count ),
+      _first( 0 ), _count( 0 ),
       _firstFree( 0 ), _freeCount( 0 ),
       _capacity( MIN_CAPACITY )
 {
-    uint32 i;
-
-    while( _capacity < _count )
+    while( _capacity < list._count )
     {
         _capacity <<= 1;
     }
 
     _nodes = _alloc.get( _capacity );
-
-    if ( list._nodes != nullptr && _count > 0 )
-    {
-        // copy the items in order
-        _nodes[0].value = list[0];
-        _nodes[0].prev = _count - 1;
-        _nodes[0].next = 1 % _count;
-        for ( i = 1; i < _count; ++i )
-        {
-            _nodes[i].value = list[i];
-            _nodes->next = ( i + 1 ) % _count;
-            _nodes->prev = i - 1;
-        }
-    }
+    pushFreeFrom( 0 );
+    copyFrom( list );
 }
 
 template <typename T>
 inline
 List<T>::List( cntr::List<T>&& list )
-    : _alloc( list._alloc ), _nodes( nullptr ),
-      _first( 0 ), _count( list._count ),
-      _firstFree( 0 ), _freeCount( 0 ),
-      _capacity( MIN_CAPACITY )
+    : _alloc( list._alloc ), _nodes( list._nodes ),
+      _first( list._first ), _count( list._count ),
+      _firstFree( list._firstFree ), _freeCount( list._freeCount ),
+      _capacity( list._capacity )
 {
-    uint32 i;
-
-    while( _capacity < _count )
-    {
-        _capacity <<= 1;
-    }
-
-    _nodes = _alloc.get( _capacity );
-
-    if ( list._nodes != nullptr && _count > 0 )
-    {
-        // copy the items in order
-        _nodes[0].value = std::move( list[0] );
-        _nodes[0].prev = _count - 1;
-        _nodes[0].next = 1 % _count;
-        for ( i = 1; i < _count; ++i )
-        {
-            _nodes[i].value = std::move( list[i] );
-            _nodes->next = ( i + 1 ) % _count;
-            _nodes->prev = i - 1;
-        }
-    }
-
-    // release source
-    if ( list._nodes != nullptr )
-    {
-        list._alloc.release( list._nodes, list._capacity );
-    }
-
     list._nodes = nullptr;
     list._first = 0;
     list._count = 0;
@@ -587,7 +805,10 @@ template <typename T>
 inline
 List<T>& List<T>::operator=( const List<T>& list )
 {
-    uint32 i;
+    if ( this == &list )
+    {
+        return *this;
+    }
 
     if ( _nodes != nullptr )
     {
@@ -598,32 +819,19 @@ List<T>& List<T>::operator=( const List<T>& list )
     // create minimally size internal array
     _alloc = list._alloc;
     _first = 0;
-    _count = list._count;
+    _count = 0;
     _firstFree = 0;
     _freeCount = 0;
     _capacity = MIN_CAPACITY;
 
-    while( _capacity < _count )
+    while( _capacity < list._count )
     {
         _capacity <<= 1;
     }
 
     _nodes = _alloc.get( _capacity );
-
-    if ( list._nodes != nullptr && _count > 0 )
-    {
-        // copy the items in order
-        _nodes[0].value = list[0];
-        _nodes[0].prev = _count - 1;
-        _nodes[0].next = 1 % _count;
-
-        for ( i = 1; i < _count; ++i )
-        {
-            _nodes[i].value = list[i];
-            _nodes->next = ( i + 1 ) % _count;
-            _nodes->prev = i - 1;
-        }
-    }
+    pushFreeFrom( 0 );
+    copyFrom( list );
 
     return *this;
 }
@@ -632,49 +840,23 @@ template <typename T>
 inline
 List<T>& List<T>::operator=( cntr::List<T>&& list )
 {
-    uint32 i;
+    if ( this == &list )
+    {
+        return *this;
+    }
 
     if ( _nodes != nullptr )
     {
         _alloc.release( _nodes, _capacity );
-        _nodes = nullptr;
     }
 
-    // create minimally size internal array
     _alloc = list._alloc;
-    _first = 0;
+    _nodes = list._nodes;
+    _first = list._first;
     _count = list._count;
-    _firstFree = 0;
-    _freeCount = 0;
-    _capacity = MIN_CAPACITY;
-
-    while( _capacity < _count )
-    {
-        _capacity <<= 1;
-    }
-
-    _nodes = _alloc.get( _capacity );
-
-    if ( list._nodes != nullptr && _count > 0 )
-    {
-        // copy the items in order
-        _nodes[0].value = std::move( list[0] );
-        _nodes[0].prev = _count - 1;
-        _nodes[0].next = 1 % _count;
-
-        for ( i = 1; i < _count; ++i )
-        {
-            _nodes[i].value = std::move( list[i] );
-            _nodes->next = ( i + 1 ) % _count;
-            _nodes->prev = i - 1;
-        }
-    }
-
-    // release source
-    if ( list._nodes != nullptr )
-    {
-        list._alloc.release( list._nodes, list._capacity );
-    }
+    _firstFree = list._firstFree;
+    _freeCount = list._freeCount;
+    _capacity = list._capacity;
 
     list._nodes = nullptr;
     list._first = 0;
@@ -726,7 +908,7 @@ template <typename T>
 inline
 void List<T>::push( T&& value )
 {
-    insertAt( _count, value );
+    insertAt( _count, std::move( value ) );
 }
 
 template <typename T>
@@ -740,25 +922,63 @@ template <typename T>
 inline
 void List<T>::pushFront( T&& value )
 {
-    insertAt( 0, value );
+    insertAt( 0, std::move( value ) );
 }
 
 template <typename T>
 inline
 void List<T>::insertAt( uint32 index, const T& value )
 {
-    Node node;
-    node.value = value;
-    insertAtPos( index, node );
+    const uint32 pos = insertAtPos( index );
+    _nodes[pos].value = value;
 }
 
 template <typename T>
 inline
 void List<T>::insertAt( uint32 index, T&& value )
 {
-    Node node;
-    node.value = std::move( value );
-    insertAtPos( index, node );
+    const uint32 pos = insertAtPos( index );
+    _nodes[pos].value = std::move( value );
+}
+
+template <typename T>
+template <typename... Args>
+inline
+T& List<T>::emplace( Args&&... args )
+{
+    return emplaceAt( _count, std::forward<Args>( args )... );
+}
+
+template <typename T>
+template <typename... Args>
+inline
+T& List<T>::emplaceFront( Args&&... args )
+{
+    return emplaceAt( 0, std::forward<Args>( args )... );
+}
+
+template <typename T>
+template <typename... Args>
+T& List<T>::emplaceAt( uint32 index, Args&&... args )
+{
+    // the nodes are default constructed by the allocator so the free node's
+    // value is replaced
+    const uint32 pos = insertAtPos( index );
+    T* value = &_nodes[pos].value;
+    value->~T();
+    try
+    {
+        new ( value ) T( std::forward<Args>( args )... );
+    }
+    catch ( ... )
+    {
+        // put a live value back in the node and return it to the free list
+        new ( value ) T();
+        unlink( pos );
+        throw;
+    }
+
+    return *value;
 }
 
 template <typename T>
@@ -778,6 +998,7 @@ T List<T>::popFront()
 }
 
 template <typename T>
+inline
 T List<T>::removeAt( uint32 index )
 {
     assert( _count > 0 );
@@ -788,21 +1009,7 @@ T List<T>::removeAt( uint32 index )
         shrink();
     }
 
-    const uint32 pos = getNodePos( index );
-    const Node& node = _nodes[pos];
-
-    if ( _count > 0 && _first == pos )
-    {
-        _first = node.next;
-    }
-
-    _nodes[node.prev].next = node.next;
-    _nodes[node.next].prev = node.prev;
-
-    pushFree( pos );
-
-    --_count;
-    return node.value;
+    return erase( getNodePos( index ) );
 }
 
 template <typename T>
@@ -827,6 +1034,71 @@ void List<T>::clear()
     _count = 0;
     _firstFree = 0;
     _freeCount = 0;
+
+    if ( _nodes != nullptr )
+    {
+        pushFreeFrom( 0 );
+    }
+}
+
+template <typename T>
+void List<T>::defragment()
+{
+    uint32 i;
+    uint32 pos;
+
+    // put the node at each list index into the matching position, whatever
+    // was there before is either free or further along in the list
+    for ( i = 0, pos = _first; i < _count; ++i, pos = _nodes[i - 1].next )
+    {
+        if ( pos != i )
+        {
+            swapNodes( i, pos );
+        }
+    }
+
+    _first = 0;
+    _firstFree = 0;
+    _freeCount = 0;
+    pushFreeFrom( _count );
+}
+
+template <typename T>
+void List<T>::compact()
+{
+    uint32 capacity = MIN_CAPACITY;
+    while ( capacity < _count )
+    {
+        capacity <<= 1;
+    }
+
+    defragment();
+    if ( capacity < _capacity )
+    {
+        resize( capacity );
+    }
+}
+
+template <typename T>
+inline
+uint32 List<T>::capacity() const
+{
+    return _capacity;
+}
+
+template <typename T>
+inline
+ContainerStats List<T>::stats() const
+{
+    ContainerStats stats;
+    stats.size = _count;
+    stats.capacity = _capacity;
+    stats.bytesUsed = static_cast<uint64>( _count ) * sizeof( Node );
+    stats.bytesReserved = _nodes != nullptr
+        ? static_cast<uint64>( _capacity ) * sizeof( Node ) : 0;
+    stats.freeCount = _freeCount;
+
+    return stats;
 }
 
 template <typename T>
@@ -918,89 +1190,275 @@ bool List<T>::isEmpty() const
     return _count <= 0;
 }
 
+template <typename T>
+inline
+typename List<T>::Handle List<T>::first() const
+{
+    return _count > 0 ? _first : NULL_HANDLE;
+}
+
+template <typename T>
+inline
+typename List<T>::Handle List<T>::last() const
+{
+    return _count > 0 ? _nodes[_first].prev : NULL_HANDLE;
+}
+
+template <typename T>
+inline
+typename List<T>::Handle List<T>::next( Handle handle ) const
+{
+    assert( handle < _capacity && _nodes[handle].prev != FREE );
+
+    const uint32 next = _nodes[handle].next;
+    return next == _first ? NULL_HANDLE : next;
+}
+
+template <typename T>
+inline
+typename List<T>::Handle List<T>::prev( Handle handle ) const
+{
+    assert( handle < _capacity && _nodes[handle].prev != FREE );
+
+    return handle == _first ? NULL_HANDLE : _nodes[handle].prev;
+}
+
+template <typename T>
+inline
+typename List<T>::Handle List<T>::handleAt( uint32 index ) const
+{
+    return getNodePos( index );
+}
+
+template <typename T>
+inline
+const T& List<T>::value( Handle handle ) const
+{
+    assert( handle < _capacity && _nodes[handle].prev != FREE );
+    return _nodes[handle].value;
+}
+
+template <typename T>
+inline
+T& List<T>::value( Handle handle )
+{
+    assert( handle < _capacity && _nodes[handle].prev != FREE );
+    return _nodes[handle].value;
+}
+
+template <typename T>
+inline
+typename List<T>::Handle List<T>::insertAfter( Handle handle,
+                                               const T& value )
+{
+    assert( handle < _capacity && _nodes[handle].prev != FREE );
+
+    // the list is circular so after the last item is before the first
+    const uint32 pos = linkBefore( _nodes[handle].next );
+    _nodes[pos].value = value;
+
+    return pos;
+}
+
+template <typename T>
+inline
+typename List<T>::Handle List<T>::insertAfter( Handle handle, T&& value )
+{
+    assert( handle < _capacity && _nodes[handle].prev != FREE );
+
+    const uint32 pos = linkBefore( _nodes[handle].next );
+    _nodes[pos].value = std::move( value );
+
+    return pos;
+}
+
+template <typename T>
+inline
+typename List<T>::Handle List<T>::insertBefore( Handle handle,
+                                                const T& value )
+{
+    assert( handle < _capacity && _nodes[handle].prev != FREE );
+
+    const uint32 pos = linkBefore( handle );
+    _nodes[pos].value = value;
+    if ( handle == _first )
+    {
+        _first = pos;
+    }
+
+    return pos;
+}
+
+template <typename T>
+inline
+typename List<T>::Handle List<T>::insertBefore( Handle handle, T&& value )
+{
+    assert( handle < _capacity && _nodes[handle].prev != FREE );
+
+    const uint32 pos = linkBefore( handle );
+    _nodes[pos].value = std::move( value );
+    if ( handle == _first )
+    {
+        _first = pos;
+    }
+
+    return pos;
+}
+
+template <typename T>
+inline
+T List<T>::erase( Handle handle )
+{
+    assert( handle < _capacity && _nodes[handle].prev != FREE );
+
+    T value = std::move( _nodes[handle].value );
+    unlink( handle );
+
+    return value;
+}
+
 // HELPER FUNCTIONS
 template <typename T>
+inline
 uint32 List<T>::popFreeNodeAndGetPos()
 {
     assert( _freeCount > 0 );
 
-    uint32 pos = _firstFree;
-    Node& node = _nodes[pos];
+    const uint32 pos = _firstFree;
+    _firstFree = _nodes[pos].next;
+    --_freeCount;
+
+    return pos;
+}
+
+template <typename T>
+uint32 List<T>::insertAtPos( uint32 index )
+{
+    assert( index <= _count );
 
-    if ( --_freeCount <= 0 )
+    if ( _count <= 0 )
     {
-        _firstFree = 0;
+        if ( shouldGrow() )
+        {
+            grow();
+        }
+
+        const uint32 pos = popFreeNodeAndGetPos();
+        _nodes[pos].prev = pos;
+        _nodes[pos].next = pos;
+        _first = pos;
+        ++_count;
+
         return pos;
     }
 
-    _nodes[node.prev].next = node.next;
-    _nodes[node.next].prev = node.prev;
-    _firstFree = node.next;
+    // the list is circular so the end of the list is before the first node
+    if ( index == _count )
+    {
+        return linkBefore( _first );
+    }
+
+    const uint32 pos = linkBefore( getNodePos( index ) );
+    if ( index <= 0 )
+    {
+        _first = pos;
+    }
 
     return pos;
 }
 
 template <typename T>
-void List<T>::insertAtPos( uint32 index, Node& node )
+uint32 List<T>::linkBefore( uint32 target )
 {
-    assert( index <= _count );
+    assert( _count > 0 );
 
     if ( shouldGrow() )
     {
         grow();
     }
 
-    uint32 pos = hasFree() ? popFreeNodeAndGetPos() : _count;
+    const uint32 pos = popFreeNodeAndGetPos();
+    const uint32 prev = _nodes[target].prev;
 
-    // insert node differently depending on position
-    if ( _count > 0 && index == _count )
-    {
-        node.prev = _nodes[_first].prev;
-        node.next = _first;
+    _nodes[pos].prev = prev;
+    _nodes[pos].next = target;
+    _nodes[prev].next = pos;
+    _nodes[target].prev = pos;
+    ++_count;
 
-        _nodes[_nodes[_first].prev].next = pos;
-        _nodes[_first].prev = pos;
-    }
-    else if ( _count <= 0 )
-    {
-        node.prev = pos;
-        node.next = pos;
-    }
-    else
-    {
-        uint32 target = getNodePos( index );
-        node.next = target;
-        node.prev = _nodes[target].prev;
+    return pos;
+}
 
-        _nodes[node.prev].next = pos;
-        _nodes[node.next].prev = pos;
-    }
+template <typename T>
+void List<T>::unlink( uint32 pos )
+{
+    assert( _count > 0 );
 
-    if ( index <= 0 )
+    const Node& node = _nodes[pos];
+    if ( _first == pos )
     {
-        _first = pos;
+        _first = node.next;
     }
 
-    _nodes[pos] = std::move( node );
-    ++_count;
+    _nodes[node.prev].next = node.next;
+    _nodes[node.next].prev = node.prev;
+
+    pushFree( pos );
+    --_count;
 }
 
 template <typename T>
+inline
 void List<T>::pushFree( uint32 index )
 {
-    if ( !hasFree() )
+    // the free list only links forward, the previous link marks the node
+    // as free
+    _nodes[index].prev = FREE;
+    _nodes[index].next = _firstFree;
+    _firstFree = index;
+
+    ++_freeCount;
+}
+
+template <typename T>
+void List<T>::pushFreeFrom( uint32 start )
+{
+    uint32 i;
+    for ( i = _capacity; i > start; --i )
     {
-        _nodes[index].prev = index;
-        _nodes[index].next = index;
-        _firstFree = index;
+        pushFree( i - 1 );
     }
-    else
+}
+
+template <typename T>
+void List<T>::copyFrom( const List<T>& list )
+{
+    assert( _count == 0 );
+    assert( _capacity >= list._count );
+
+    if ( list._nodes == nullptr || list._count <= 0 )
     {
-        _nodes[_firstFree].prev = index;
-        _nodes[_nodes[_firstFree].prev].next = index;
+        return;
     }
 
-    ++_freeCount;
+    // copy the items in order so they are sequential in memory
+    uint32 i;
+    uint32 cur;
+    for ( i = 0, cur = list._first; i < list._count;
+          ++i, cur = list._nodes[cur].next )
+    {
+        _nodes[i].value = list._nodes[cur].value;
+        _nodes[i].prev = ( i > 0 ) ? i - 1 : list._count - 1;
+        _nodes[i].next = ( i + 1 ) % list._count;
+    }
+
+    _first = 0;
+    _count = list._count;
+
+    // the free list is ordered by position so the copied nodes are at its
+    // front
+    _firstFree = _count < _capacity ? _count : 0;
+    _freeCount = _capacity - _count;
 }
 
 template <typename T>
@@ -1014,41 +1472,73 @@ template <typename T>
 inline
 void List<T>::shrink()
 {
+    defragment();
     resize( _capacity >> 1 );
 }
 
 template <typename T>
 void List<T>::resize( uint32 size )
 {
+    assert( size >= _count );
+
     Node* newList = _alloc.get( size );
 
-    // copy only the items that are in use to the new array
     uint32 i;
-    Node* cur = &getNodeAt( 0 );
-    newList[0].value = std::move( cur->value );
-    newList[0].prev = _count - 1;
-    newList[0].next = 1;
-
-    for ( i = 1, cur = &_nodes[cur->next];
-          i < _count - 1;
-          ++i, cur = &_nodes[cur->next] )
+    const uint32 kept = std::min( size, _capacity );
+    for ( i = 0; i < kept; ++i )
     {
-        newList[i].value = std::move( cur->value );
-        newList[i].next = i + 1;
-        newList[i].prev = i - 1;
+        newList[i] = std::move( _nodes[i] );
     }
 
-    newList[_count - 1].value = std::move( cur->value );
-    newList[_count - 1].next = 0;
-    newList[_count - 1].prev = _count - 2;
+    _alloc.release( _nodes, _capacity );
+    _nodes = newList;
 
-    _first = 0;
+    const uint32 oldCapacity = _capacity;
+    _capacity = size;
+    if ( size > oldCapacity )
+    {
+        pushFreeFrom( oldCapacity );
+        return;
+    }
+
+    // the free list may have linked through the cut off nodes so it is
+    // rebuilt, this requires the nodes in use to be at the front
     _firstFree = 0;
     _freeCount = 0;
+    pushFreeFrom( _count );
+}
 
-    _alloc.release( _nodes, _capacity );
-    _capacity = size;
-    _nodes = newList;
+template <typename T>
+void List<T>::swapNodes( uint32 target, uint32 pos )
+{
+    assert( target != pos );
+    assert( _nodes[pos].prev != FREE );
+
+    // links that point at either position have to point at the other one
+    // once the nodes trade places
+    auto remap = [target, pos]( uint32 link ) {
+        return link == target ? pos : ( link == pos ? target : link );
+    };
+
+    const bool targetInUse = _nodes[target].prev != FREE;
+    std::swap( _nodes[target], _nodes[pos] );
+
+    // both nodes' own links are fixed before their neighbors' since the two
+    // may be neighbors of each other
+    Node& moved = _nodes[target];
+    Node& displaced = _nodes[pos];
+    moved.prev = remap( moved.prev );
+    moved.next = remap( moved.next );
+    if ( targetInUse )
+    {
+        displaced.prev = remap( displaced.prev );
+        displaced.next = remap( displaced.next );
+        _nodes[displaced.prev].next = pos;
+        _nodes[displaced.next].prev = pos;
+    }
+
+    _nodes[moved.prev].next = target;
+    _nodes[moved.next].prev = target;
 }
 
 template <typename T>
@@ -1256,6 +1746,15 @@ bool List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::operator!=(
     return _iterList != iter._iterList || _iterPos != iter._iterPos;
 }
 
+// ITERATOR MEMBER FUNCTIONS
+template <typename T>
+template <typename LPTR, typename TREF, typename CTREF, typename TPTR>
+inline
+uint32 List<T>::ListIterator<LPTR, TREF, CTREF, TPTR>::handle() const
+{
+    return _iterIndex;
+}
+
 } // End nspc cntr
 
 } // End nspc nge
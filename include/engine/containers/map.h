@@ -3,13 +3,15 @@
 #ifndef NGE_CNTR_MAP_H
 #define NGE_CNTR_MAP_H
 
-#include <functional>
-#include <engine/utility/hasher.h>
 
 #include "engine/intdef.h"
+#include "engine/containers/container_stats.h"
+#include "engine/containers/dynamic_array.h"
+#include "engine/containers/hash_index.h"
+#include "engine/containers/robin_hood_index.h"
 #include "engine/memory/allocator_guard.h"
-#include "dynamic_array.h"
-#include "list.h"
+#include "engine/utility/equality.h"
+#include "engine/utility/hasher.h"
 
 namespace nge
 {
@@ -17,7 +19,8 @@ namespace nge
 namespace cntr
 {
     
-template <typename K, typename V>
+template <typename K, typename V, typename H = util::Hasher<K>,
+          typename E = util::Equality<K>, typename I = HashIndex>
 class Map
 {
   public:
@@ -56,7 +59,7 @@ class Map
         /**
          * Constructs an iterator for the map with the given index.
          */
-        ConstIterator( const Map<K, V>* map, uint32 index );
+        ConstIterator( const Map<K, V, H, E, I>* map, uint32 index );
 
         /**
          * Constructs a copy of the given iterator.
@@ -130,15 +133,15 @@ class Map
     Map( uint32 capacity );
 
     /**
-     * Constructs a new map with the given hash function.
+     * Constructs a new map with the given hasher.
      */
-    Map( std::function<uint32( const K& )> hashFunc );
+    Map( const H& hasher );
 
     /**
      * Constructs a new map with the given initial capacity that uses
-     * the given hash function.
+     * the given hasher.
      */
-    Map( uint32 capacity, std::function<uint32( const K& )> hashFunc );
+    Map( uint32 capacity, const H& hasher );
 
     /**
      * Constructs a new map with the given allocators.
@@ -152,27 +155,27 @@ class Map
          uint32 capacity );
 
     /**
-     * Constructs a new map with the given allocators and hash function.
+     * Constructs a new map with the given allocators and hasher.
     */
     Map( mem::IAllocator<KVPair>* pairAlloc, mem::IAllocator<uint32>* intAlloc,
-         std::function<uint32( const K& )> hashFunc );
+         const H& hasher );
 
     /**
      * Constructs a new map using the given allocators, initial capacity, and
-     * hash function.
+     * hasher.
     */
-     Map( mem::IAllocator<KVPair>* pairAlloc, mem::IAllocator<uint32>* intAlloc,
-          uint32 capacity, std::function<uint32( const K& )> hashFunc );
+    Map( mem::IAllocator<KVPair>* pairAlloc, mem::IAllocator<uint32>* intAlloc,
+         uint32 capacity, const H& hasher );
 
     /**
      * Constructs a copy of the given map
     */
-    Map( const Map<K, V>& map );
+    Map( const Map<K, V, H, E, I>& map );
 
     /**
      * Moves the map to a new instance.
     */
-    Map( Map<K, V>&& map );
+    Map( Map<K, V, H, E, I>&& map );
 
     /**
      * Destructs the map.
@@ -183,12 +186,12 @@ class Map
     /**
      * Assigns this as a copy of the given map.
     */
-    Map<K, V>& operator=( const Map<K, V>& map );
+    Map<K, V, H, E, I>& operator=( const Map<K, V, H, E, I>& map );
 
     /**
      * Moves the map data to this instance.
     */
-    Map<K, V>& operator=( const Map<K, V>&& map );
+    Map<K, V, H, E, I>& operator=( Map<K, V, H, E, I>&& map );
 
     // MEMBER FUNCTIONS
     /**
@@ -205,16 +208,171 @@ class Map
      */
     void assign( K&& key, V&& value );
 
+    /**
+     * Sets a copy of the given value to the key with the given characters.
+     *
+     * The key is only constructed when it is not already in the map. The
+     * hasher must be able to hash a range of characters and the equality must
+     * be able to compare a key with one.
+     */
+    void assign( const char* key, uint32 length, const V& value );
+
+    /**
+     * Sets a copy of the given value to the given key using the key's
+     * precomputed hash.
+     *
+     * Behavior is undefined when:
+     * hashCode is not the hash the map's hasher computes for key.
+     */
+    void assign( uint32 hashCode, const K& key, const V& value );
+
+    /**
+     * Sets a copy of the given value to the key with the given characters
+     * using the key's precomputed hash, such as one from chash.
+     *
+     * Behavior is undefined when:
+     * hashCode is not the hash the map's hasher computes for key.
+     */
+    void assign( uint32 hashCode, const char* key, uint32 length,
+                 const V& value );
+
+    /**
+     * Gets the value associated with the given key.
+     *
+     * Returns nullptr if the key is not in the map. The pointer is
+     * invalidated when the map is modified.
+     */
+    V* lookup( const K& key );
+
+    /**
+     * Gets the value associated with the given key.
+     *
+     * Returns nullptr if the key is not in the map. The pointer is
+     * invalidated when the map is modified.
+     */
+    const V* lookup( const K& key ) const;
+
+    /**
+     * Gets the value associated with the key with the given characters.
+     *
+     * Returns nullptr if the key is not in the map.
+     */
+    V* lookup( const char* key, uint32 length );
+
+    /**
+     * Gets the value associated with the key with the given characters.
+     *
+     * Returns nullptr if the key is not in the map.
+     */
+    const V* lookup( const char* key, uint32 length ) const;
+
+    /**
+     * Gets the value associated with the given key using the key's
+     * precomputed hash.
+     *
+     * Returns nullptr if the key is not in the map.
+     *
+     * Behavior is undefined when:
+     * hashCode is not the hash the map's hasher computes for key.
+     */
+    V* lookup( uint32 hashCode, const K& key );
+
+    /**
+     * Gets the value associated with the given key using the key's
+     * precomputed hash.
+     *
+     * Returns nullptr if the key is not in the map.
+     *
+     * Behavior is undefined when:
+     * hashCode is not the hash the map's hasher computes for key.
+     */
+    const V* lookup( uint32 hashCode, const K& key ) const;
+
+    /**
+     * Gets the value associated with the key with the given characters using
+     * the key's precomputed hash, such as one from chash.
+     *
+     * Returns nullptr if the key is not in the map.
+     *
+     * Behavior is undefined when:
+     * hashCode is not the hash the map's hasher computes for key.
+     */
+    V* lookup( uint32 hashCode, const char* key, uint32 length );
+
+    /**
+     * Gets the value associated with the key with the given characters using
+     * the key's precomputed hash, such as one from chash.
+     *
+     * Returns nullptr if the key is not in the map.
+     *
+     * Behavior is undefined when:
+     * hashCode is not the hash the map's hasher computes for key.
+     */
+    const V* lookup( uint32 hashCode, const char* key, uint32 length ) const;
+
     /**
      * Removes the given key and its associated value from the map.
+     *
+     * The last pair is moved into the hole left by the removed pair so the
+     * pairs stay dense. This does not preserve the iteration order.
      */
     void remove( const K& key );
 
+    /**
+     * Assigns each of the given pairs to the map.
+     *
+     * The map is sized for all of the pairs once up front instead of growing
+     * as they are added. Later pairs replace the values of earlier pairs with
+     * the same key.
+     *
+     * Behavior is undefined when:
+     * pairs is nullptr and count is not 0.
+     */
+    void assignAll( const KVPair* pairs, uint32 count );
+
+    /**
+     * Makes room for at least the given number of pairs so that assigning
+     * up to that many does not reallocate or rebuild the index.
+     *
+     * Removing pairs can still shrink the map.
+     */
+    void reserve( uint32 capacity );
+
+    /**
+     * Rebuilds the index with at least the given number of bins.
+     *
+     * The number of bins is rounded up to a power of two that can hold the
+     * current pairs.
+     */
+    void rehash( uint32 binCount );
+
     /**
      * Checks if the key exists in the map.
      */
     bool hasKey( const K& key ) const;
 
+    /**
+     * Checks if the key with the given characters exists in the map.
+     */
+    bool hasKey( const char* key, uint32 length ) const;
+
+    /**
+     * Checks if the key exists in the map using the key's precomputed hash.
+     *
+     * Behavior is undefined when:
+     * hashCode is not the hash the map's hasher computes for key.
+     */
+    bool hasKey( uint32 hashCode, const K& key ) const;
+
+    /**
+     * Checks if the key with the given characters exists in the map using the
+     * key's precomputed hash.
+     *
+     * Behavior is undefined when:
+     * hashCode is not the hash the map's hasher computes for key.
+     */
+    bool hasKey( uint32 hashCode, const char* key, uint32 length ) const;
+
     /**
     * Checks if the value exists in the map.
     */
@@ -236,36 +394,45 @@ class Map
     bool isEmpty() const;
 
     /**
-     * Gets an iterator for the map
+     * Gets the longest probe sequence of any key in the index.
+     *
+     * The length is counted in the index's own probing steps and this walks
+     * the whole index, so it is meant for diagnostics.
      */
-    ConstIterator cbegin() const;
+    uint32 maxProbeLength() const;
 
     /**
-     * Gets an iterator for the end of the map.
+     * Gets the mean probe sequence length of the keys in the index.
+     *
+     * The length is counted in the index's own probing steps and this walks
+     * the whole index, so it is meant for diagnostics.
      */
-    ConstIterator cend() const;
+    float meanProbeLength() const;
 
-  private:
-    // CONSTANTS
     /**
-     * The minimum number of bins.
+     * Gets the memory footprint and occupancy of the map.
+     *
+     * The reserved bytes include the index and, like maxProbeLength, this
+     * walks the whole index.
      */
-    static constexpr uint32 MIN_BINS = 32;
+    ContainerStats stats() const;
 
     /**
-     * Defines a bin that is empty and does not hold a value.
+     * Gets an iterator for the map
      */
-    static constexpr uint32 BIN_EMPTY = static_cast<uint32>( -1 );
+    ConstIterator cbegin() const;
 
     /**
-     * The threshold percentage at which the map grows.
+     * Gets an iterator for the end of the map.
      */
-    static constexpr uint32 GROW_THRESHOLD = 70;
+    ConstIterator cend() const;
 
+  private:
+    // CONSTANTS
     /**
-     * The threshold percentage at which the map shrinks.
+     * The number of pairs assignAll hashes before placing them.
      */
-    static constexpr uint32 SHRINK_THRESHOLD = 30;
+    static constexpr uint32 BATCH_SIZE = 32;
 
     // MEMBERS
     /*
@@ -274,303 +441,237 @@ class Map
     DynamicArray<KVPair> _pairs;
 
     /**
-     * The bin allocator.
-     */
-    mem::AllocatorGuard<uint32> _binAlloc;
-
-    /**
-     * The hash function.
+     * The index of the pairs.
      */
-    std::function<uint32( const K& )> _hashFunc;
+    I _index;
 
     /**
-     * The bins.
+     * The hasher.
      */
-    uint32* _bins;
+    H _hasher;
 
     /**
-     * The number of bins currently in use.
+     * The key equality.
      */
-    uint32 _binsInUse;
-
-    /**
-     * The total number of bins.
-     */
-    uint32 _binCount;
+    E _equality;
 
     // HELPER FUNCTIONS
     /**
-     * Gets the index of a bin that should hold the given value.
+     * Gets the bin that holds the given key.
      *
-     * The returned index may already hold that value and needs to be
-     * checked that it is empty.
+     * Returns I::NOT_FOUND if the key is not in the map.
      */
-    uint32 findBinForKey( const K& key ) const;
+    uint32 findBin( const K& key ) const;
 
     /**
-     * Computes the hash for the given key.
+     * Gets the bin that holds the given key with the given hash.
+     *
+     * Returns I::NOT_FOUND if the key is not in the map.
      */
-    uint32 hash( const K& key ) const;
+    uint32 findBin( uint32 hashCode, const K& key ) const;
 
     /**
-     * Linearly probes for the next position.
+     * Gets the bin that holds the key with the given characters and hash.
+     *
+     * Returns I::NOT_FOUND if the key is not in the map.
      */
-    uint32 probe( uint32 probes ) const;
+    uint32 findBin( uint32 hashCode, const char* key, uint32 length ) const;
 
     /**
-     * Wraps the bin index to be within the bounds.
+     * Gets the value held by the given bin.
+     *
+     * Returns nullptr if the bin is I::NOT_FOUND.
      */
-    uint32 wrap( uint32 index ) const;
+    V* valueAt( uint32 bin ) const;
 
     /**
-     * Checks if the bin at the given index is empty.
+     * Adds the pair to the map under the given hash.
      *
      * Behavior is undefined when:
-     * binIndex is invalid.
+     * The pair's key is already in the map.
      */
-    bool isBinEmpty( uint32 binIndex ) const;
+    void insert( uint32 hashCode, KVPair&& pair );
 
     /**
-     * Checks if the bin at the given index contains the given key.
-     *
-     * This will return false if binIndex is invalid.
+     * Rebuilds the index with the given number of bins.
      */
-    bool doesBinContain( uint32 binIndex, const K& key ) const;
+    void rebuild( uint32 binCount );
 
     /**
-     * Checks if the bin array should shrunk.
+     * Gets the bin that holds the pair at the given index.
+     *
+     * Behavior is undefined when:
+     * pairIndex is invalid.
      */
-    bool shouldShrink() const;
+    uint32 findBinForPair( uint32 pairIndex ) const;
 
     /**
-     * Checks if the bin array should grow.
+     * Computes the hash for the given key.
      */
-    bool shouldGrow() const;
+    uint32 hash( const K& key ) const;
 
     /**
-     * Grows the bin array to twice the current capacity.
+     * Grows the index so another pair can be added.
      */
     void grow();
 
     /**
-     * Shrinks the bin array to half the current capacity.
+     * Shrinks the index to half the current number of bins.
      */
     void shrink();
-
-    /**
-     * Resizes the bin array to the specified size.
-     */
-    void resize( uint32 newSize );
-
-    /**
-     * Resets all of the bins back to empty.
-     *
-     * This does not reset _binsInUse.
-     */
-    void clearBins();
 };
 
 // CONSTANTS
-template<typename K, typename V>
-constexpr uint32 Map<K>::MIN_BINS;
-
-template<typename K, typename V>
-constexpr uint32 Map<K>::BIN_EMPTY;
-
-template<typename K, typename V>
-constexpr uint32 Map<K>::GROW_THRESHOLD;
-
-template<typename K, typename V>
-constexpr uint32 Map<K>::SHRINK_THRESHOLD;
-
-
+template <typename K, typename V, typename H, typename E, typename I>
+constexpr uint32 Map<K, V, H, E, I>::BATCH_SIZE;
 
 // CONSTRUCTORS
-template<typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>::Map() : Map( MIN_BINS )
+Map<K, V, H, E, I>::Map() : Map( nullptr, nullptr, 0, H() )
 {
 }
 
-template<typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>::Map( uint32 capacity ) : Map( capcity, &util::Hasher<K>::hash )
+Map<K, V, H, E, I>::Map( uint32 capacity ) : Map( capacity, H() )
 {
 }
 
-template<typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>::Map( std::function<uint32( const K& )> hashFunc )
-    : Map ( MIN_BINS, hashFunc )
+Map<K, V, H, E, I>::Map( const H& hasher )
+    : Map( nullptr, nullptr, 0, hasher )
 {
 }
 
-template<typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>::Map( uint32 capacity, std::function<uint32( const K& )> hashFunc )
-    : Map( _pairs(), _bins( nullptr ), capacity, hashFunc )
+Map<K, V, H, E, I>::Map( uint32 capacity, const H& hasher )
+    : Map( nullptr, nullptr, capacity, hasher )
 {
 }
 
-template<typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>::Map( mem::IAllocator<KVPair>* pairAlloc,
-                mem::IAllocator<uint32>* intAlloc )
-    : Map( pairAlloc, intAlloc, MIN_BINS )
+Map<K, V, H, E, I>::Map( mem::IAllocator<KVPair>* pairAlloc,
+                         mem::IAllocator<uint32>* intAlloc )
+    : Map( pairAlloc, intAlloc, 0 )
 {
 }
 
-template<typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>::Map( mem::IAllocator<KVPair>* pairAlloc,
-                mem::IAllocator<uint32>* intAlloc, uint32 capacity )
-    : Map( pairAlloc, intAlloc, capacity, &util::Hasher<K>::hash )
+Map<K, V, H, E, I>::Map( mem::IAllocator<KVPair>* pairAlloc,
+                         mem::IAllocator<uint32>* intAlloc, uint32 capacity )
+    : Map( pairAlloc, intAlloc, capacity, H() )
 {
 }
 
-template<typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>::Map( mem::IAllocator<KVPair>* pairAlloc,
-                mem::IAllocator<uint32>* intAlloc,
-                std::function<uint32( const K& )> hashFunc )
-    : Map( pairAlloc, intAlloc, MIN_BINS, hashFunc )
+Map<K, V, H, E, I>::Map( mem::IAllocator<KVPair>* pairAlloc,
+                         mem::IAllocator<uint32>* intAlloc,
+                         const H& hasher )
+    : Map( pairAlloc, intAlloc, 0, hasher )
 {
 }
 
-template<typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>::Map( mem::IAllocator<KVPair>* pairAlloc,
-                mem::IAllocator<uint32>* intAlloc,
-                uint32 capacity, std::function<uint32( const K& )> hashFunc )
-    : _binAlloc( intAlloc ), _pairs( pairAlloc, capacity ),
-      _hashFunc( hashFunc ), _bins( nullptr ), _binsInUse( 0 ),
-      _binCount( MIN_BINS )
+Map<K, V, H, E, I>::Map( mem::IAllocator<KVPair>* pairAlloc,
+                         mem::IAllocator<uint32>* intAlloc,
+                         uint32 capacity, const H& hasher )
+    : _pairs( pairAlloc, capacity ), _index( intAlloc, capacity ),
+      _hasher( hasher )
 {
-    while ( _binCount < capacity )
-    {
-        _binCount <<= 1;
-    }
-
-    _bins = _binAlloc.get( _binCount );
-    clearBins();
 }
 
-template<typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>::Map( const Map<K, V>& map )
-    : _binAlloc( map._binAlloc ), _pairs( map._pairs ),
-      _hashFunc( map._hashFunc ), _bins( nullptr ),
-      _binsInUse( map._binsInUse ), _binCount( map._binCount )
+Map<K, V, H, E, I>::Map( const Map<K, V, H, E, I>& map )
+    : _pairs( map._pairs ), _index( map._index ), _hasher( map._hasher ),
+      _equality( map._equality )
 {
-    _bins = _binAlloc.get( _binCount );
-    mem::MemoryUtils::copy( _bins, map._bins, _binCount );
 }
 
-template<typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>Map( Map<K, V>&& map )
-    : _binAlloc( std::move( map._binAlloc ) ),
-      _pairs( std::move( map._pairs ) ),
-      _hashFunc( std::move( map._hashFunc ) ), _bins( map._bins ),
-      _binsInUse( map._binsInUse ), _binCount( map._binCount )
+Map<K, V, H, E, I>::Map( Map<K, V, H, E, I>&& map )
+    : _pairs( std::move( map._pairs ) ), _index( std::move( map._index ) ),
+      _hasher( std::move( map._hasher ) ),
+      _equality( std::move( map._equality ) )
 {
-    map._bins = nullptr;
-    map._binsInUse = 0;
-    map._binCount = 0;
 }
 
-template<typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>~Map()
+Map<K, V, H, E, I>::~Map()
 {
-    if ( _bins != nullptr )
-    {
-        _binAlloc.release( _bins, _binCount );
-        _bins = nullptr;
-    }
-    _binsInUse = 0;
-    _binCount = 0;
 }
 
 // ITERATOR CONSTRUCTORS
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>::ConstIterator::ConstIterator()
+Map<K, V, H, E, I>::ConstIterator::ConstIterator()
     : _iterValues( nullptr ), _iterIndex( 0 )
 {
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>::ConstIterator::ConstIterator( const Map<K, V>* map, uint32 index )
+Map<K, V, H, E, I>::ConstIterator::ConstIterator( const Map<K, V, H, E, I>* map,
+                                                  uint32 index )
     : _iterValues( &map->_pairs ), _iterIndex( index )
 {
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>::ConstIterator::ConstIterator( const ConstIterator& iter )
+Map<K, V, H, E, I>::ConstIterator::ConstIterator( const ConstIterator& iter )
     : _iterValues( iter._iterValues ), _iterIndex( iter._iterIndex )
 {
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>::ConstIterator::~ConstIterator()
+Map<K, V, H, E, I>::ConstIterator::~ConstIterator()
 {
     _iterValues = nullptr;
     _iterIndex = static_cast<uint32>( -1 );
 }
 
 // OPERATORS
-template<typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>& Map<K, V>::operator=( const Map<K, V>& map )
+Map<K, V, H, E, I>&
+Map<K, V, H, E, I>::operator=( const Map<K, V, H, E, I>& map )
 {
-    if ( _bins != nullptr )
-    {
-        _binAlloc.release( _bins, _binCount );
-    }
-
-    _binAlloc = map._binAlloc;
     _pairs = map._pairs;
-    _hasFunc = map._hashFunc;
-    _bins = _binAlloc.get( _binCount );
-    _binCount = map._binCount;
-    _binsInUse = map._binsInUse;
-    mem::MemoryUtils::copy( _bins, map._bins, _binCount );
+    _index = map._index;
+    _hasher = map._hasher;
+    _equality = map._equality;
 
     return *this;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-Map<K, V>& Map<K, V>::operator=( Map<K, V>&& map )
+Map<K, V, H, E, I>& Map<K, V, H, E, I>::operator=( Map<K, V, H, E, I>&& map )
 {
-    if ( _bins != nullptr )
-    {
-        _binAlloc.release( _bins, _binCount );
-    }
-
-    _binAlloc = std::move( map.binAlloc );
     _pairs = std::move( map._pairs );
-    _hashFunc = std::move( map._hashFunc );
-    _bins = map._bins;
-    _binCount = map._binCount;
-    _binsInUse = map._binsInUse;
-
-    map._bins = nullptr;
-    map._binsInUse = 0;
-    map._binCount = 0;
+    _index = std::move( map._index );
+    _hasher = std::move( map._hasher );
+    _equality = std::move( map._equality );
 
     return *this;
 }
 
 // ITERATOR OPERATORS
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-typename Map<K, V>::ConstIterator& Map<K, V>::ConstIterator::operator=(
-    const ConstIterator& iter)
+typename Map<K, V, H, E, I>::ConstIterator&
+Map<K, V, H, E, I>::ConstIterator::operator=( const ConstIterator& iter )
 {
     _iterValues = iter._iterValues;
     _iterIndex = iter._iterIndex;
@@ -578,150 +679,322 @@ typename Map<K, V>::ConstIterator& Map<K, V>::ConstIterator::operator=(
     return *this;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-typename Map<K, V>::Constiterator& Map<K, V>::ConstIterator::operator++()
+typename Map<K, V, H, E, I>::ConstIterator&
+Map<K, V, H, E, I>::ConstIterator::operator++()
 {
     ++_iterIndex;
 
     return *this;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-typename Map<K, V>::Constiterator& Map<K, V>::ConstIterator::operator--()
+typename Map<K, V, H, E, I>::ConstIterator&
+Map<K, V, H, E, I>::ConstIterator::operator++( int32 )
+{
+    ++_iterIndex;
+
+    return *this;
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+inline
+typename Map<K, V, H, E, I>::ConstIterator&
+Map<K, V, H, E, I>::ConstIterator::operator--()
 {
     _iterIndex = _iterIndex > 0 ? _iterIndex - 1 : _iterValues->size();
 
     return *this;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-typename Map<K, V>::Constiterator& Map<K, V>::ConstIterator::operator--( int32 )
+typename Map<K, V, H, E, I>::ConstIterator&
+Map<K, V, H, E, I>::ConstIterator::operator--( int32 )
 {
-    _iterIndex = _iterIndex > 0 ? _iterIndex - 1 : _iterValues ->size();
+    _iterIndex = _iterIndex > 0 ? _iterIndex - 1 : _iterValues->size();
 
     return *this;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-const typename Map<K, V>::KVPair& Map<K, V>::ConstIterator::operator*() const
+const typename Map<K, V, H, E, I>::KVPair&
+Map<K, V, H, E, I>::ConstIterator::operator*() const
 {
     return ( *_iterValues )[_iterIndex];
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-const typename Map<K, V>::KVPair* Map<K, V>::ConstIterator::operator->() const
+const typename Map<K, V, H, E, I>::KVPair*
+Map<K, V, H, E, I>::ConstIterator::operator->() const
 {
     return &( *_iterValues )[_iterIndex];
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-bool Map<K, V>::ConstIterator::operator==( const ConstIterator& iter ) const
+bool
+Map<K, V, H, E, I>::ConstIterator::operator==( const ConstIterator& iter ) const
 {
     return _iterValues == iter._iterValues && _iterIndex == iter._iterIndex;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-bool Map<K, V>::ConstIterator::operator!=( const ConstIterator& iter ) const
+bool
+Map<K, V, H, E, I>::ConstIterator::operator!=( const ConstIterator& iter ) const
 {
     return _iterValues != iter._iterValues || _iterIndex != iter._iterIndex;
 }
 
 // MEMBER FUNCTIONS
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-void Map<K, V>::assign( const K& key, const V& value )
+void Map<K, V, H, E, I>::assign( const K& key, const V& value )
 {
-    if ( shouldGrow() )
+    assign( hash( key ), key, value );
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+void Map<K, V, H, E, I>::assign( K&& key, V&& value )
+{
+    const uint32 hashCode = hash( key );
+    const uint32 bin = findBin( hashCode, key );
+    if ( bin != I::NOT_FOUND )
     {
-        grow();
+        _pairs[_index.itemAt( bin )].value = std::move( value );
+        return;
     }
 
-    uint32 binIndex = findBinForKey( key );
-    if ( isBinEmpty( binIndex ) )
+    insert( hashCode, KVPair{ std::move( key ), std::move( value ) } );
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+inline
+void Map<K, V, H, E, I>::assign( const char* key, uint32 length,
+                                 const V& value )
+{
+    assign( _hasher.hash( key, length ), key, length, value );
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+void Map<K, V, H, E, I>::assign( uint32 hashCode, const K& key, const V& value )
+{
+    const uint32 bin = findBin( hashCode, key );
+    if ( bin != I::NOT_FOUND )
     {
-        ++_binsInUse;
-        _bins[binIndex] = _pairs.size();
-        _pairs.push( KVPair( std::move( key ), std::move( value ) ) );
+        _pairs[_index.itemAt( bin )].value = value;
+        return;
     }
-    else
+
+    insert( hashCode, KVPair{ key, value } );
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+void Map<K, V, H, E, I>::assign( uint32 hashCode, const char* key,
+                                 uint32 length, const V& value )
+{
+    const uint32 bin = findBin( hashCode, key, length );
+    if ( bin != I::NOT_FOUND )
     {
-        _pairs[binIndex].value = std::move( value );
+        _pairs[_index.itemAt( bin )].value = value;
+        return;
     }
+
+    insert( hashCode, KVPair{ K( key, length ), value } );
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+inline
+V* Map<K, V, H, E, I>::lookup( const K& key )
+{
+    return valueAt( findBin( key ) );
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-void Map<K, V>::assign ( K&& key, V&& value )
+V* Map<K, V, H, E, I>::lookup( const char* key, uint32 length )
 {
-    if ( shouldGrow() )
+    return valueAt( findBin( _hasher.hash( key, length ), key, length ) );
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+inline
+V* Map<K, V, H, E, I>::lookup( uint32 hashCode, const K& key )
+{
+    return valueAt( findBin( hashCode, key ) );
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+inline
+V* Map<K, V, H, E, I>::lookup( uint32 hashCode, const char* key, uint32 length )
+{
+    return valueAt( findBin( hashCode, key, length ) );
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+inline
+const V* Map<K, V, H, E, I>::lookup( const K& key ) const
+{
+    return valueAt( findBin( key ) );
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+inline
+const V* Map<K, V, H, E, I>::lookup( const char* key, uint32 length ) const
+{
+    return valueAt( findBin( _hasher.hash( key, length ), key, length ) );
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+inline
+const V* Map<K, V, H, E, I>::lookup( uint32 hashCode, const K& key ) const
+{
+    return valueAt( findBin( hashCode, key ) );
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+inline
+const V* Map<K, V, H, E, I>::lookup( uint32 hashCode,
+                                     const char* key, uint32 length ) const
+{
+    return valueAt( findBin( hashCode, key, length ) );
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+void Map<K, V, H, E, I>::remove( const K& key )
+{
+    const uint32 bin = findBin( key );
+    if ( bin == I::NOT_FOUND )
     {
-        grow();
+        return;
     }
 
-    uint32 binIndex = findBinForKey( key );
-    if ( isBinEmpty( binIndex ) )
+    const uint32 index = _index.itemAt( bin );
+    const uint32 last = _pairs.size() - 1;
+
+    // move the last pair into the hole and patch the one bin that
+    // referenced it
+    if ( index != last )
     {
-        ++_binsInUse;
-        _bins[binIndex] = _pairs.size();
-        _pairs.push( KVPair( std::move( key ), std::move( value ) ) );
+        _index.setItemAt( findBinForPair( last ), index );
+        _pairs[index] = std::move( _pairs[last] );
     }
-    else
+
+    _pairs.pop();
+    _index.erase( bin );
+
+    if ( _index.shouldShrink() )
     {
-        _pairs[binIndex].value = std::move( value );
+        shrink();
     }
 }
 
-template <typename K, typename V>
-inline
-void Map<K, V>::remove( const K& key )
+template <typename K, typename V, typename H, typename E, typename I>
+void Map<K, V, H, E, I>::assignAll( const KVPair* pairs, uint32 count )
 {
-    if ( shouldShrink() )
-    {
-        shrink();
-    }
+    assert( pairs != nullptr || count == 0 );
 
-    uint32 binIndex = findBinForKey( value );
+    reserve( _pairs.size() + count );
+
+    uint32 hashes[BATCH_SIZE];
+    uint32 batch;
+    uint32 batchCount;
+    uint32 bin;
     uint32 i;
-    if ( !isBinEmpty( binIndex ) )
+    for ( batch = 0; batch < count; batch += batchCount )
     {
-        --_binsInUse;
-        _pairs.removeAt( _bins[binIndex] );
+        batchCount = count - batch < BATCH_SIZE ? count - batch : BATCH_SIZE;
 
-        // correct bin indices
-        for ( i = 0; i < _binCount; ++i )
+        // hash the whole batch first so its groups are already being loaded
+        // by the time they are probed
+        for ( i = 0; i < batchCount; ++i )
         {
-            if ( !isBinEmpty( i ) && _bins[i] > _bins[binIndex] )
+            hashes[i] = hash( pairs[batch + i].key );
+            _index.prefetch( hashes[i] );
+        }
+
+        for ( i = 0; i < batchCount; ++i )
+        {
+            const KVPair& pair = pairs[batch + i];
+            bin = findBin( hashes[i], pair.key );
+            if ( bin != I::NOT_FOUND )
+            {
+                _pairs[_index.itemAt( bin )].value = pair.value;
+            }
+            else
             {
-                --( _bins[i] );
+                insert( hashes[i], KVPair{ pair.key, pair.value } );
             }
         }
+    }
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+void Map<K, V, H, E, I>::reserve( uint32 capacity )
+{
+    _pairs.reserve( capacity );
 
-        _bins[binIndex] = BIN_EMPTY;
+    const uint32 binCount = I::binsFor( capacity );
+    if ( binCount > _index.binCount() )
+    {
+        rebuild( binCount );
     }
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
+void Map<K, V, H, E, I>::rehash( uint32 binCount )
+{
+    uint32 bins = I::binsFor( _pairs.size() );
+    while ( bins < binCount )
+    {
+        bins <<= 1;
+    }
+
+    rebuild( bins );
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+inline
+bool Map<K, V, H, E, I>::hasKey( const K& key ) const
+{
+    return findBin( key ) != I::NOT_FOUND;
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+inline
+bool Map<K, V, H, E, I>::hasKey( const char* key, uint32 length ) const
+{
+    return findBin( _hasher.hash( key, length ), key, length ) !=
+           I::NOT_FOUND;
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
+inline
+bool Map<K, V, H, E, I>::hasKey( uint32 hashCode, const K& key ) const
+{
+    return findBin( hashCode, key ) != I::NOT_FOUND;
+}
+
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-bool Map<K, V>::hasKey( const K& key ) const
+bool Map<K, V, H, E, I>::hasKey( uint32 hashCode, const char* key,
+                                 uint32 length ) const
 {
-    const uint32 binIndex = findBinForKey( key );
-    return binIndex != -1 && doesBinContain( binIndex, key );
+    return findBin( hashCode, key, length ) != I::NOT_FOUND;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-bool Map<K, V>::hasValue( const V& value ) const
+bool Map<K, V, H, E, I>::hasValue( const V& value ) const
 {
-    for (ConstIterator iter = cbegin(); iter != cend(); ++iter)
+    for ( ConstIterator iter = cbegin(); iter != cend(); ++iter )
     {
-        if (iter->value == value)
+        if ( iter->value == value )
         {
             return true;
         }
@@ -729,156 +1002,163 @@ bool Map<K, V>::hasValue( const V& value ) const
     return false;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-bool Map<K, V>::isEmpty()
+void Map<K, V, H, E, I>::clear()
 {
-    return _pairs.isEmpty();
+    _pairs.clear();
+    _index.clear();
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-uint32 Map<K, V>::size()
+uint32 Map<K, V, H, E, I>::size() const
 {
-    return _values.size();
+    return _pairs.size();
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-void Map<K, V>::clear()
+bool Map<K, V, H, E, I>::isEmpty() const
 {
-    _pairs.clear();
-    mem::MemoryUtils::map( _bins, BIN_EMPTY, _binCount );
-    _binsInUse = 0;
+    return _pairs.isEmpty();
 }
 
-template <typename K, typename V>
-inline
-typename Map<K, V>::ConstIterator Map<K, V>::cbegin() const
+template <typename K, typename V, typename H, typename E, typename I>
+uint32 Map<K, V, H, E, I>::maxProbeLength() const
 {
-    return ConstIterator( this, 0 );
+    return _index.maxProbeLength(
+        [this]( uint32 i ) { return hash( _pairs[i].key ); } );
 }
 
-template <typename K, typename V>
-inline
-typename Map<K, V>::ConstIterator Map<K, V>::cend() const
+template <typename K, typename V, typename H, typename E, typename I>
+float Map<K, V, H, E, I>::meanProbeLength() const
 {
-    return ConstIterator( this, _pairs.size() );
+    return _index.meanProbeLength(
+        [this]( uint32 i ) { return hash( _pairs[i].key ); } );
 }
 
-// HELPER FUNCTIONS
-template <typename K, typename V>
-inline
-uint32 Map<K, V>::findBinForKey( const T& key ) const
+template <typename K, typename V, typename H, typename E, typename I>
+ContainerStats Map<K, V, H, E, I>::stats() const
 {
-    const uint32 hashCode = hash( key );
-    uint32 i;
-    uint32 probes;
-    for ( i = wrap( hashCode ), probes = 0;
-          !isBinEmpty( i ) && !doesBinContain( i, key );
-          i = wrap( i + probe( ++probes ) ) )
-    {
-        // do nothing
-    }
+    ContainerStats stats = _pairs.stats();
+    stats.bytesReserved += _index.byteCount();
+    stats.bucketCount = _index.binCount();
+    stats.maxProbeLength = maxProbeLength();
 
-    return i;
+    return stats;
 }
 
-template<typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-uint32 Map<K, V>::hash( const K& key ) const
+typename Map<K, V, H, E, I>::ConstIterator Map<K, V, H, E, I>::cbegin() const
 {
-    return _hashFunc( key );
+    return ConstIterator( this, 0 );
 }
 
-template<typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-uint32 Map<K, V>::probe( uint32 probes ) const
+typename Map<K, V, H, E, I>::ConstIterator Map<K, V, H, E, I>::cend() const
 {
-    return probes;
+    return ConstIterator( this, _pairs.size() );
 }
 
-template<typename K, typename V>
+// HELPER FUNCTIONS
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-uint32 Map<K, V>::wrap( uint32 index ) const
+uint32 Map<K, V, H, E, I>::findBin( const K& key ) const
 {
-    return index & ( _binCount - 1 );
+    return findBin( hash( key ), key );
 }
 
-template<typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-bool Map<K, V>::isBinEmpty( uint32 binIndex ) const
+uint32 Map<K, V, H, E, I>::findBin( uint32 hashCode, const K& key ) const
 {
-    assert( binIndex < _binCount );
-    return _bins[binIndex] == BIN_EMPTY;
+    const DynamicArray<KVPair>& pairs = _pairs;
+    const E& equality = _equality;
+    return _index.find( hashCode, [&pairs, &equality, &key]( uint32 i ) {
+        return equality.equals( pairs[i].key, key );
+    } );
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-bool Map<K, V>::doesBinContain( uint32 binIndex, const K& key ) const
+uint32 Map<K, V, H, E, I>::findBin( uint32 hashCode, const char* key,
+                                    uint32 length ) const
 {
-    return binIndex < _binCount && !isBinEmpty( binIndex ) &&
-        hash( _pairs[_bins[binIndex]] ) == hash( key );
+    const DynamicArray<KVPair>& pairs = _pairs;
+    const E& equality = _equality;
+    return _index.find( hashCode,
+                        [&pairs, &equality, key, length]( uint32 i ) {
+        return equality.equals( pairs[i].key, key, length );
+    } );
 }
 
-template<typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-bool Map<K, V>::shouldShrink() const
+V* Map<K, V, H, E, I>::valueAt( uint32 bin ) const
 {
-    return ( ( _binsInUse * 100 ) / _binCount ) <= SHRINK_THRESHOLD &&
-        _binCount > MIN_BINS;
+    if ( bin == I::NOT_FOUND )
+    {
+        return nullptr;
+    }
+
+    return const_cast<V*>( &_pairs[_index.itemAt( bin )].value );
 }
 
-template<typename K, typename V>
-inline
-bool Map<K, V>::shouldGrow() const
+template <typename K, typename V, typename H, typename E, typename I>
+void Map<K, V, H, E, I>::insert( uint32 hashCode, KVPair&& pair )
 {
-    return ( ( _binsInUse * 100 ) / _binCount ) >= GROW_THRESHOLD;
+    if ( _index.shouldGrow() )
+    {
+        grow();
+    }
+
+    _index.insert( hashCode, _pairs.size() );
+    _pairs.push( std::move( pair ) );
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-void Map<K, V>::grow()
+uint32 Map<K, V, H, E, I>::findBinForPair( uint32 pairIndex ) const
 {
-    resize( _binCount << 1 );
+    const uint32 bin = _index.find(
+        hash( _pairs[pairIndex].key ),
+        [pairIndex]( uint32 i ) { return i == pairIndex; } );
+
+    assert( bin != I::NOT_FOUND );
+    return bin;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename H, typename E, typename I>
 inline
-void Map<K, V>::shrink()
+uint32 Map<K, V, H, E, I>::hash( const K& key ) const
 {
-    resize( _binCount >> 1 );
+    return _hasher.hash( key );
 }
 
-template <typename K, typename V>
-inline
-void Map<K, V>::resize( uint32 newSize )
+template <typename K, typename V, typename H, typename E, typename I>
+void Map<K, V, H, E, I>::rebuild( uint32 binCount )
 {
-    assert( _bins != nullptr );
-    _binAlloc.release( _bins, newSize );
-    _bins = _binAlloc.get( newSize );
-    _binCount = newSize;
-    clearBins();
-
-    uint32 i;
-    uint32 pos;
-    for ( i = 0; i < _pairs.size(); ++i )
-    {
-        pos = findBinForKey( _pairs[i] );
-        _bins[pos] = i;
-    }
+    _index.rehash( binCount, _pairs.size(),
+                   [this]( uint32 i ) { return hash( _pairs[i].key ); } );
 }
 
-template <typename K, typename V>
-inline
-void Map<K, V>::clearBins()
+template <typename K, typename V, typename H, typename E, typename I>
+void Map<K, V, H, E, I>::grow()
 {
-    mem::MemoryUtils::map( _bins, BIN_EMPTY, _binCount );
+    _index.grow( [this]( uint32 i ) { return hash( _pairs[i].key ); } );
 }
 
+template <typename K, typename V, typename H, typename E, typename I>
+void Map<K, V, H, E, I>::shrink()
+{
+    _index.shrink( [this]( uint32 i ) { return hash( _pairs[i].key ); } );
+}
 
-} // end nspc cntr
+} // End nspc cntr
 
-} // end nspc nge
+} // End nspc nge
 
-#endif
\ No newline at end of file
+#endif
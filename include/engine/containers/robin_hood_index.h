@@ -0,0 +1,582 @@
+// robin_hood_index.h
+//
+// Defines an open addressing index that uses Robin Hood displacement and
+// backward shift deletion. It is a drop in replacement for HashIndex in the
+// hashed containers.
+//
+// Each bin holds the position of an item in the dense storage of the owning
+// container along with the item's full hash code. Bins are probed linearly
+// from the item's home bin. An insert takes the bin of any item that is
+// closer to its own home than the inserted item is, and carries the
+// displaced item further along. This keeps the probe lengths of all items
+// close to the mean.
+//
+// Removal shifts the items that follow the removed one back by one bin
+// until an empty bin or an item in its home bin is reached. No deleted
+// markers are left behind, so the probe lengths after any amount of add and
+// remove churn are the same as those of a freshly built index.
+//
+#ifndef NGE_CNTR_ROBIN_HOOD_INDEX_H
+#define NGE_CNTR_ROBIN_HOOD_INDEX_H
+
+#include <assert.h>
+#include <utility>
+
+#include "engine/intdef.h"
+#include "engine/memory/allocator_guard.h"
+#include "engine/memory/memory_utils.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+class RobinHoodIndex
+{
+  public:
+    // CONSTANTS
+    /**
+     * Returned by find when no bin matches.
+     */
+    static constexpr uint32 NOT_FOUND = static_cast<uint32>( -1 );
+
+    /**
+     * The minimum number of bins.
+     */
+    static constexpr uint32 MIN_BINS = 32;
+
+  private:
+    // CONSTANTS
+    /**
+     * The item position of a bin that does not hold an item.
+     */
+    static constexpr uint32 EMPTY = static_cast<uint32>( -1 );
+
+    /**
+     * The threshold percentage of used bins at which the index grows.
+     */
+    static constexpr uint32 GROW_THRESHOLD = 85;
+
+    /**
+     * The threshold percentage of used bins at which the index shrinks.
+     */
+    static constexpr uint32 SHRINK_THRESHOLD = 30;
+
+    // MEMBERS
+    /**
+     * The allocator for the bins.
+     *
+     * The item positions and the hash codes share one allocation.
+     */
+    mem::AllocatorGuard<uint32> _alloc;
+
+    /**
+     * The item position stored in each bin.
+     */
+    uint32* _items;
+
+    /**
+     * The hash code of the item in each bin.
+     *
+     * This points into the same allocation as the items.
+     */
+    uint32* _hashes;
+
+    /**
+     * The total number of bins.
+     */
+    uint32 _binCount;
+
+    /**
+     * The right shift that maps a mixed hash code to its home bin.
+     */
+    uint32 _shift;
+
+    /**
+     * The number of bins that hold an item.
+     */
+    uint32 _used;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the bin an item with the given hash code is placed in when there
+     * are no collisions.
+     */
+    uint32 home( uint32 hashCode ) const;
+
+    /**
+     * Gets how many bins past its home bin the item in the given bin is.
+     */
+    uint32 distance( uint32 bin ) const;
+
+    /**
+     * Allocates the given number of empty bins.
+     */
+    void allocate( uint32 binCount );
+
+    /**
+     * Releases the bins.
+     */
+    void release();
+
+  public:
+    // GLOBAL FUNCTIONS
+    /**
+     * Gets the number of bins needed to hold the given number of items
+     * without growing.
+     */
+    static uint32 binsFor( uint32 capacity );
+
+    // CONSTRUCTORS
+    /**
+     * Constructs a new index.
+     */
+    RobinHoodIndex();
+
+    /**
+     * Constructs a new index that can hold the given number of items
+     * without growing.
+     */
+    RobinHoodIndex( uint32 capacity );
+
+    /**
+     * Constructs a new index using the given allocator.
+     */
+    RobinHoodIndex( mem::IAllocator<uint32>* alloc );
+
+    /**
+     * Constructs a new index using the given allocator that can hold the
+     * given number of items without growing.
+     */
+    RobinHoodIndex( mem::IAllocator<uint32>* alloc, uint32 capacity );
+
+    /**
+     * Constructs a copy of the given index.
+     */
+    RobinHoodIndex( const RobinHoodIndex& index );
+
+    /**
+     * Moves the index to a new instance.
+     */
+    RobinHoodIndex( RobinHoodIndex&& index );
+
+    /**
+     * Destructs the index.
+     */
+    ~RobinHoodIndex();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the given index.
+     */
+    RobinHoodIndex& operator=( const RobinHoodIndex& index );
+
+    /**
+     * Moves the index to this instance.
+     */
+    RobinHoodIndex& operator=( RobinHoodIndex&& index );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Finds the bin that holds an item with the given hash code for which
+     * isMatch( itemIndex ) returns true.
+     *
+     * isMatch is only called for bins with the same hash code. Returns
+     * NOT_FOUND if there is no such bin.
+     */
+    template <typename EQ>
+    uint32 find( uint32 hashCode, EQ isMatch ) const;
+
+    /**
+     * Hints that the home bin for the given hash code is about to be read.
+     */
+    void prefetch( uint32 hashCode ) const;
+
+    /**
+     * Stores the given item position and returns the bin it is placed in.
+     *
+     * This can move other items to different bins. It does not check if the
+     * item already exists and it does not grow the index.
+     *
+     * Behavior is undefined when:
+     * there are no free bins
+     */
+    uint32 insert( uint32 hashCode, uint32 itemIndex );
+
+    /**
+     * Removes the item from the given bin.
+     *
+     * This can move other items to different bins.
+     *
+     * Behavior is undefined when:
+     * bin does not hold an item
+     */
+    void erase( uint32 bin );
+
+    /**
+     * Gets the item position stored in the given bin.
+     */
+    uint32 itemAt( uint32 bin ) const;
+
+    /**
+     * Sets the item position stored in the given bin.
+     *
+     * This is used to patch a bin after its item moved in the dense storage.
+     */
+    void setItemAt( uint32 bin, uint32 itemIndex );
+
+    /**
+     * Rebuilds the index with the given number of bins for the items at
+     * positions [0, count).
+     *
+     * The index keeps the hash code of every item so hashOf is only called
+     * for items it does not already hold.
+     */
+    template <typename HF>
+    void rehash( uint32 binCount, uint32 count, HF hashOf );
+
+    /**
+     * Checks if the index must grow before another item is inserted.
+     */
+    bool shouldGrow() const;
+
+    /**
+     * Checks if the index should shrink.
+     */
+    bool shouldShrink() const;
+
+    /**
+     * Doubles the number of bins.
+     */
+    template <typename HF>
+    void grow( HF hashOf );
+
+    /**
+     * Halves the number of bins.
+     */
+    template <typename HF>
+    void shrink( HF hashOf );
+
+    /**
+     * Removes all of the items from the index.
+     */
+    void clear();
+
+    /**
+     * Gets the number of items in the index.
+     */
+    uint32 size() const;
+
+    /**
+     * Gets the total number of bins.
+     */
+    uint32 binCount() const;
+
+    /**
+     * Gets the number of bytes allocated for the bins.
+     */
+    uint64 byteCount() const;
+
+    /**
+     * Gets the largest number of bins past its home bin that any item is.
+     *
+     * This walks every bin. hashOf is not called since the index keeps the
+     * hash code of every item.
+     */
+    template <typename HF>
+    uint32 maxProbeLength( HF hashOf ) const;
+
+    /**
+     * Gets the mean number of bins past their home bin that the items are.
+     *
+     * This walks every bin. hashOf is not called since the index keeps the
+     * hash code of every item.
+     */
+    template <typename HF>
+    float meanProbeLength( HF hashOf ) const;
+};
+
+// HELPER FUNCTIONS
+inline
+uint32 RobinHoodIndex::home( uint32 hashCode ) const
+{
+    // fibonacci hashing spreads hash codes that only differ in their high
+    // bits across all of the bins
+    return ( hashCode * 2654435769u ) >> _shift;
+}
+
+inline
+uint32 RobinHoodIndex::distance( uint32 bin ) const
+{
+    return ( bin - home( _hashes[bin] ) ) & ( _binCount - 1 );
+}
+
+// GLOBAL FUNCTIONS
+inline
+uint32 RobinHoodIndex::binsFor( uint32 capacity )
+{
+    uint32 bins = MIN_BINS;
+    while ( ( static_cast<uint64>( bins ) * GROW_THRESHOLD ) / 100 <=
+            capacity )
+    {
+        bins <<= 1;
+    }
+
+    return bins;
+}
+
+// CONSTRUCTORS
+inline
+RobinHoodIndex::RobinHoodIndex() : RobinHoodIndex( nullptr, 0 )
+{
+}
+
+inline
+RobinHoodIndex::RobinHoodIndex( uint32 capacity )
+    : RobinHoodIndex( nullptr, capacity )
+{
+}
+
+inline
+RobinHoodIndex::RobinHoodIndex( mem::IAllocator<uint32>* alloc )
+    : RobinHoodIndex( alloc, 0 )
+{
+}
+
+inline
+RobinHoodIndex::RobinHoodIndex( mem::IAllocator<uint32>* alloc,
+                                uint32 capacity )
+    : _alloc( alloc ), _items( nullptr ), _hashes( nullptr ), _binCount( 0 ),
+      _shift( 0 ), _used( 0 )
+{
+    allocate( binsFor( capacity ) );
+}
+
+inline
+RobinHoodIndex::RobinHoodIndex( const RobinHoodIndex& index )
+    : _alloc( index._alloc ), _items( nullptr ), _hashes( nullptr ),
+      _binCount( 0 ), _shift( 0 ), _used( 0 )
+{
+    if ( index._items != nullptr )
+    {
+        allocate( index._binCount );
+        mem::MemoryUtils::copy( _items, index._items, _binCount * 2 );
+    }
+    _used = index._used;
+}
+
+inline
+RobinHoodIndex::RobinHoodIndex( RobinHoodIndex&& index )
+    : _alloc( index._alloc ), _items( index._items ),
+      _hashes( index._hashes ), _binCount( index._binCount ),
+      _shift( index._shift ), _used( index._used )
+{
+    index._items = nullptr;
+    index._hashes = nullptr;
+    index._binCount = 0;
+    index._used = 0;
+}
+
+inline
+RobinHoodIndex::~RobinHoodIndex()
+{
+    release();
+}
+
+// MEMBER FUNCTIONS
+template <typename EQ>
+uint32 RobinHoodIndex::find( uint32 hashCode, EQ isMatch ) const
+{
+    if ( _binCount == 0 )
+    {
+        return NOT_FOUND;
+    }
+
+    const uint32 mask = _binCount - 1;
+    uint32 bin;
+    uint32 dist;
+    for ( bin = home( hashCode ), dist = 0; _items[bin] != EMPTY;
+          bin = ( bin + 1 ) & mask, ++dist )
+    {
+        // the item would have displaced any item closer to its home
+        if ( distance( bin ) < dist )
+        {
+            return NOT_FOUND;
+        }
+
+        if ( _hashes[bin] == hashCode && isMatch( _items[bin] ) )
+        {
+            return bin;
+        }
+    }
+
+    return NOT_FOUND;
+}
+
+inline
+void RobinHoodIndex::prefetch( uint32 hashCode ) const
+{
+    if ( _binCount == 0 )
+    {
+        return;
+    }
+
+#if defined( __GNUC__ )
+    const uint32 bin = home( hashCode );
+    __builtin_prefetch( _items + bin );
+    __builtin_prefetch( _hashes + bin );
+#else
+    ( void )hashCode;
+#endif
+}
+
+inline
+uint32 RobinHoodIndex::itemAt( uint32 bin ) const
+{
+    assert( bin < _binCount );
+    assert( _items[bin] != EMPTY );
+    return _items[bin];
+}
+
+inline
+void RobinHoodIndex::setItemAt( uint32 bin, uint32 itemIndex )
+{
+    assert( bin < _binCount );
+    assert( _items[bin] != EMPTY );
+    _items[bin] = itemIndex;
+}
+
+template <typename HF>
+void RobinHoodIndex::rehash( uint32 binCount, uint32 count, HF hashOf )
+{
+    assert( binCount >= MIN_BINS );
+    assert( ( binCount & ( binCount - 1 ) ) == 0 );
+    assert( ( static_cast<uint64>( binCount ) * GROW_THRESHOLD ) / 100 >
+            count );
+
+    uint32* oldItems = _items;
+    uint32* oldHashes = _hashes;
+    const uint32 oldBinCount = _binCount;
+    const uint32 oldUsed = _used;
+
+    _items = nullptr;
+    _hashes = nullptr;
+    allocate( binCount );
+
+    uint32 i;
+    if ( oldItems != nullptr && oldUsed == count )
+    {
+        // the old bins hold every item along with its hash code
+        for ( i = 0; i < oldBinCount; ++i )
+        {
+            if ( oldItems[i] != EMPTY )
+            {
+                insert( oldHashes[i], oldItems[i] );
+            }
+        }
+    }
+    else
+    {
+        for ( i = 0; i < count; ++i )
+        {
+            insert( hashOf( i ), i );
+        }
+    }
+
+    if ( oldItems != nullptr )
+    {
+        _alloc.release( oldItems, oldBinCount * 2 );
+    }
+}
+
+inline
+bool RobinHoodIndex::shouldGrow() const
+{
+    return ( static_cast<uint64>( _used + 1 ) * 100 ) >
+        static_cast<uint64>( _binCount ) * GROW_THRESHOLD;
+}
+
+inline
+bool RobinHoodIndex::shouldShrink() const
+{
+    return _binCount > MIN_BINS &&
+        ( static_cast<uint64>( _used ) * 100 ) <=
+        static_cast<uint64>( _binCount ) * SHRINK_THRESHOLD;
+}
+
+template <typename HF>
+inline
+void RobinHoodIndex::grow( HF hashOf )
+{
+    rehash( _binCount << 1, _used, hashOf );
+}
+
+template <typename HF>
+inline
+void RobinHoodIndex::shrink( HF hashOf )
+{
+    rehash( _binCount >> 1, _used, hashOf );
+}
+
+inline
+uint32 RobinHoodIndex::size() const
+{
+    return _used;
+}
+
+inline
+uint32 RobinHoodIndex::binCount() const
+{
+    return _binCount;
+}
+
+inline
+uint64 RobinHoodIndex::byteCount() const
+{
+    return _items != nullptr
+        ? static_cast<uint64>( _binCount ) * 2 * sizeof( uint32 ) : 0;
+}
+
+template <typename HF>
+uint32 RobinHoodIndex::maxProbeLength( HF ) const
+{
+    uint32 longest = 0;
+    uint32 i;
+    for ( i = 0; i < _binCount; ++i )
+    {
+        if ( _items[i] != EMPTY && distance( i ) > longest )
+        {
+            longest = distance( i );
+        }
+    }
+
+    return longest;
+}
+
+template <typename HF>
+float RobinHoodIndex::meanProbeLength( HF ) const
+{
+    if ( _used == 0 )
+    {
+        return 0.0f;
+    }
+
+    uint64 total = 0;
+    uint32 i;
+    for ( i = 0; i < _binCount; ++i )
+    {
+        if ( _items[i] != EMPTY )
+        {
+            total += distance( i );
+        }
+    }
+
+    return static_cast<float>( total ) / static_cast<float>( _used );
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif
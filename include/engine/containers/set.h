@@ -2,13 +2,15 @@
 #ifndef NGE_CNTR_SET_H
 #define NGE_CNTR_SET_H
 
-#include <functional>
-#include <engine/utility/hasher.h>
 
 #include "engine/intdef.h"
+#include "engine/containers/container_stats.h"
 #include "engine/containers/dynamic_array.h"
+#include "engine/containers/hash_index.h"
+#include "engine/containers/robin_hood_index.h"
 #include "engine/memory/allocator_guard.h"
-#include "list.h"
+#include "engine/utility/equality.h"
+#include "engine/utility/hasher.h"
 
 namespace nge
 {
@@ -17,8 +19,8 @@ namespace cntr
 {
 
 // TODO: consider using progressive bin copy after resize if necessary
-// TODO: cache hashes in separate array if necessary
-template <typename T>
+template <typename T, typename H = util::Hasher<T>,
+          typename E = util::Equality<T>, typename I = HashIndex>
 class Set
 {
   public:
@@ -50,7 +52,7 @@ class Set
         /**
          * Constructs an iterator for the set with the given index.
          */
-        ConstIterator( const Set<T>* set, uint32 index );
+        ConstIterator( const Set<T, H, E, I>* set, uint32 index );
 
         /**
          * Constructs a copy of the given iterator.
@@ -115,127 +117,82 @@ class Set
   private:
     // CONSTANTS
     /**
-     * The minimum number of bins.
+     * The number of values addAll hashes before placing them.
      */
-    static constexpr uint32 MIN_BINS = 32;
-
-    /**
-     * Defines a bin that is empty and does not hold a value.
-     */
-    static constexpr uint32 BIN_EMPTY = static_cast<uint32>( -1 );
-
-    /**
-     * The threshold percentage at which the map grows.
-     */
-    static constexpr uint32 GROW_THRESHOLD = 70;
-
-    /**
-     * The threshold percentage at which the map shrinks.
-     */
-    static constexpr uint32 SHRINK_THRESHOLD = 30;
+    static constexpr uint32 BATCH_SIZE = 32;
 
     // MEMBERS
-    /**
-     * The bin allocator.
-     */
-    mem::AllocatorGuard<uint32> _binAlloc;
-
     /**
      * The values in the array.
      */
     DynamicArray<T> _values;
 
     /**
-     * The hash function.
-     */
-    std::function<uint32( const T& )> _hashFunc;
-
-    /**
-     * The bins.
+     * The index of the values.
      */
-    uint32* _bins;
+    I _index;
 
     /**
-     * The number of bins currently in use.
+     * The hasher.
      */
-    uint32 _binsInUse;
+    H _hasher;
 
     /**
-     * The total number of bins.
+     * The value equality.
      */
-    uint32 _binCount;
+    E _equality;
 
     // HELPER FUNCTIONS
     /**
-     * Gets the index of a bin that should hold the given value.
+     * Gets the bin that holds the given value.
      *
-     * The returned index may already hold that value and needs to be
-     * checked that it is empty.
+     * Returns I::NOT_FOUND if the value is not in the set.
      */
-    uint32 findBinForValue( const T& value ) const;
+    uint32 findBin( const T& value ) const;
 
     /**
-     * Computes the hash for the given value.
-     */
-    uint32 hash( const T& value ) const;
-
-    /**
-     * Linearly probes for the next position.
-     */
-    uint32 probe( uint32 probes ) const;
-
-    /**
-     * Wraps the bin index to be within the bounds.
+     * Gets the bin that holds the given value with the given hash.
+     *
+     * Returns I::NOT_FOUND if the value is not in the set.
      */
-    uint32 wrap( uint32 index ) const;
+    uint32 findBin( uint32 hashCode, const T& value ) const;
 
     /**
-     * Checks if the bin at the given index is empty.
+     * Gets the bin that holds the value at the given index.
      *
      * Behavior is undefined when:
-     * binIndex is invalid.
+     * valueIndex is invalid.
      */
-    bool isBinEmpty( uint32 binIndex ) const;
+    uint32 findBinForIndex( uint32 valueIndex ) const;
 
     /**
-     * Checks if the bin at the given index contains the given value.
-     *
-     * This will return false if binIndex is invalid.
+     * Computes the hash for the given value.
      */
-    bool doesBinContain( uint32 binIndex, const T& value ) const;
+    uint32 hash( const T& value ) const;
 
     /**
-     * Checks if the bin array should shrunk.
+     * Adds the value to the set under the given hash.
+     *
+     * Behavior is undefined when:
+     * The value is already in the set.
      */
-    bool shouldShrink() const;
+    void insert( uint32 hashCode, T&& value );
 
     /**
-     * Checks if the bin array should grow.
+     * Rebuilds the index with the given number of bins.
      */
-    bool shouldGrow() const;
+    void rebuild( uint32 binCount );
 
     /**
-     * Grows the bin array to twice the current capacity.
+     * Grows the index so another value can be added.
      */
     void grow();
 
     /**
-     * Shrinks the bin array to half the current capacity.
+     * Shrinks the index to half the current number of bins.
      */
     void shrink();
 
-    /**
-     * Resizes the bin array to the specified size.
-     */
-    void resize( uint32 newSize );
-
-    /**
-     * Resets all of the bins back to empty.
-     *
-     * This does not reset _binsInUse.
-     */
-    void clearBins();
-
   public:
     // CONSTRUCTORS
     /**
@@ -249,15 +206,15 @@ class Set
     Set( uint32 capacity );
 
     /**
-     * Constructs a new set that uses the given hash function.
+     * Constructs a new set that uses the given hasher.
      */
-    Set( std::function<uint32( const T& )> hashFunc );
+    Set( const H& hasher );
 
     /**
      * Constructs a new set with the given initial capacity that uses
-     * the given hash function.
+     * the given hasher.
      */
-    Set( uint32 capacity, std::function<uint32( const T& )> hashFunc );
+    Set( uint32 capacity, const H& hasher );
 
     /**
      * Constructs a new set that uses the given allocators.
@@ -271,27 +228,27 @@ class Set
          uint32 capacity );
 
     /**
-     * Constructs a new set using the given allocators and hash function.
+     * Constructs a new set using the given allocators and hasher.
      */
     Set( mem::IAllocator<T>* valueAlloc, mem::IAllocator<uint32>* intAlloc,
-         std::function<uint32( const T& )> hashFunc );
+         const H& hasher );
 
     /**
      * Constructs a new set using the given allocators, initial capacity, and
-     * hash function.
+     * hasher.
      */
     Set( mem::IAllocator<T>* valueAlloc, mem::IAllocator<uint32>* intAlloc,
-         uint32 capacity, std::function<uint32( const T& )> hashFunc );
+         uint32 capacity, const H& hasher );
 
     /**
      * Constructs a copy of the give nset.
      */
-    Set( const Set<T>& set );
+    Set( const Set<T, H, E, I>& set );
 
     /**
      * Moves the set to a new instance.
      */
-    Set( Set<T>&& set );
+    Set( Set<T, H, E, I>&& set );
 
     /**
      * Destructs the set.
@@ -302,12 +259,12 @@ class Set
     /**
      * Assigns this as a copy of the given set.
      */
-    Set<T>& operator=( const Set<T>& set );
+    Set<T, H, E, I>& operator=( const Set<T, H, E, I>& set );
 
     /**
      * Moves the set data to this instance.
      */
-    Set<T>& operator=( Set<T>&& set );
+    Set<T, H, E, I>& operator=( Set<T, H, E, I>&& set );
 
     /**
      * Gets the item in the set at the given index.
@@ -334,9 +291,39 @@ class Set
 
     /**
      * Removes the given value from the set.
+     *
+     * The last value is moved into the hole left by the removed value so the
+     * values stay dense. This does not preserve the iteration order.
      */
     void remove( const T& value );
 
+    /**
+     * Adds a copy of each of the given values to the set.
+     *
+     * The set is sized for all of the values once up front instead of
+     * growing as they are added.
+     *
+     * Behavior is undefined when:
+     * values is nullptr and count is not 0.
+     */
+    void addAll( const T* values, uint32 count );
+
+    /**
+     * Makes room for at least the given number of values so that adding up
+     * to that many does not reallocate or rebuild the index.
+     *
+     * Removing values can still shrink the set.
+     */
+    void reserve( uint32 capacity );
+
+    /**
+     * Rebuilds the index with at least the given number of bins.
+     *
+     * The number of bins is rounded up to a power of two that can hold the
+     * current values.
+     */
+    void rehash( uint32 binCount );
+
     /**
      * Checks if the value exists in the set.
      */
@@ -366,467 +353,438 @@ class Set
      * Checks if the set is empty.
      */
     bool isEmpty() const;
-};
 
-// CONSTANTS
-template <typename T>
-constexpr uint32 Set<T>::MIN_BINS;
+    /**
+     * Gets the longest probe sequence of any value in the index.
+     *
+     * The length is counted in the index's own probing steps and this walks
+     * the whole index, so it is meant for diagnostics.
+     */
+    uint32 maxProbeLength() const;
 
-template <typename T>
-constexpr uint32 Set<T>::BIN_EMPTY;
+    /**
+     * Gets the mean probe sequence length of the values in the index.
+     *
+     * The length is counted in the index's own probing steps and this walks
+     * the whole index, so it is meant for diagnostics.
+     */
+    float meanProbeLength() const;
 
-template <typename T>
-constexpr uint32 Set<T>::GROW_THRESHOLD;
+    /**
+     * Gets the memory footprint and occupancy of the set.
+     *
+     * The reserved bytes include the index and, like maxProbeLength, this
+     * walks the whole index.
+     */
+    ContainerStats stats() const;
+};
 
-template <typename T>
-constexpr uint32 Set<T>::SHRINK_THRESHOLD;
+// CONSTANTS
+template <typename T, typename H, typename E, typename I>
+constexpr uint32 Set<T, H, E, I>::BATCH_SIZE;
 
 // CONSTRUCTORS
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>::Set() : _binAlloc(), _values(), _hashFunc( &util::Hasher<T>::hash ),
-                _bins( nullptr ), _binsInUse( 0 ), _binCount( MIN_BINS )
+Set<T, H, E, I>::Set() : _values(), _index(), _hasher()
 {
-    _bins = _binAlloc.get( _binCount );
-    clearBins();
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>::Set( uint32 capacity )
-    : _binAlloc(), _values( capacity ), _hashFunc( &util::Hasher<T>::hash ),
-      _bins( nullptr ), _binsInUse( 0 ), _binCount( MIN_BINS )
+Set<T, H, E, I>::Set( uint32 capacity )
+    : _values( capacity ), _index( capacity ),
+      _hasher()
 {
-    while ( _binCount < capacity )
-    {
-        _binCount <<= 1;
-    }
-
-    _bins = _binAlloc.get( _binCount );
-    clearBins();
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>::Set( std::function<uint32( const T& )> hashFunc )
-    : _binAlloc(), _values(), _hashFunc( hashFunc ), _bins( nullptr ),
-      _binsInUse( 0 ), _binCount( MIN_BINS )
+Set<T, H, E, I>::Set( const H& hasher )
+    : _values(), _index(), _hasher( hasher )
 {
-    _bins = _binAlloc.get( _binCount );
-    clearBins();
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>::Set( uint32 capacity, std::function<uint32( const T& )> hashFunc )
-    : _binAlloc(), _values( capacity ), _hashFunc( hashFunc ),
-      _bins( nullptr ), _binsInUse( 0 ), _binCount( MIN_BINS )
+Set<T, H, E, I>::Set( uint32 capacity, const H& hasher )
+    : _values( capacity ), _index( capacity ), _hasher( hasher )
 {
-    while ( _binCount < capacity )
-    {
-        _binCount <<= 1;
-    }
-
-    _bins = _binAlloc.get( _binCount );
-    clearBins();
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>::Set( mem::IAllocator<T>* valueAlloc,
-             mem::IAllocator<uint32>* intAlloc )
-    : _binAlloc( intAlloc ), _values( valueAlloc ),
-      _hashFunc( &util::Hasher<T>::hash ),  _bins( nullptr ),
-      _binsInUse( 0 ), _binCount( MIN_BINS )
+Set<T, H, E, I>::Set( mem::IAllocator<T>* valueAlloc,
+                      mem::IAllocator<uint32>* intAlloc )
+    : _values( valueAlloc ), _index( intAlloc ),
+      _hasher()
 {
-    _bins = _binAlloc.get( _binCount );
-    clearBins();
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>::Set( mem::IAllocator<T>* valueAlloc,
-             mem::IAllocator<uint32>* intAlloc, uint32 capacity )
-    : _binAlloc( intAlloc ), _values( valueAlloc, capacity ),
-      _hashFunc( &util::Hasher<T>::hash ), _bins( nullptr ),
-      _binsInUse( 0 ), _binCount( MIN_BINS )
+Set<T, H, E, I>::Set( mem::IAllocator<T>* valueAlloc,
+                      mem::IAllocator<uint32>* intAlloc, uint32 capacity )
+    : _values( valueAlloc, capacity ), _index( intAlloc, capacity ),
+      _hasher()
 {
-    while ( _binCount < capacity )
-    {
-        _binCount <<= 1;
-    }
-
-    _bins = _binAlloc.get( _binCount );
-    clearBins();
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>::Set( mem::IAllocator<T>* valueAlloc, mem::IAllocator<uint32>* intAlloc,
-             std::function<uint32( const T& )> hashFunc )
-    : _binAlloc( intAlloc ), _values( valueAlloc ), _hashFunc( hashFunc ),
-      _bins( nullptr ), _binsInUse( 0 ), _binCount( MIN_BINS )
+Set<T, H, E, I>::Set( mem::IAllocator<T>* valueAlloc,
+                      mem::IAllocator<uint32>* intAlloc, const H& hasher )
+    : _values( valueAlloc ), _index( intAlloc ), _hasher( hasher )
 {
-    _bins = _binAlloc.get( _binCount );
-    clearBins();
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>::Set( mem::IAllocator<T>* valueAlloc, mem::IAllocator<uint32>* intAlloc,
-             uint32 capacity, std::function<uint32( const T& )> hashFunc )
-    : _binAlloc( intAlloc ), _values( valueAlloc, capacity ),
-      _hashFunc( hashFunc ), _bins( nullptr ), _binsInUse( 0 ),
-      _binCount( MIN_BINS )
+Set<T, H, E, I>::Set( mem::IAllocator<T>* valueAlloc,
+                      mem::IAllocator<uint32>* intAlloc, uint32 capacity,
+                      const H& hasher )
+    : _values( valueAlloc, capacity ), _index( intAlloc, capacity ),
+      _hasher( hasher )
 {
-    while ( _binCount < capacity )
-    {
-        _binCount <<= 1;
-    }
-
-    _bins = _binAlloc.get( _binCount );
-    clearBins();
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>::Set( const Set<T>& set )
-    : _binAlloc( set._binAlloc ), _values( set._values ),
-      _hashFunc( set._hashFunc ), _bins( nullptr ),
-      _binsInUse( set._binsInUse ), _binCount( set._binCount )
+Set<T, H, E, I>::Set( const Set<T, H, E, I>& set )
+    : _values( set._values ), _index( set._index ),
+      _hasher( set._hasher ),
+      _equality( set._equality )
 {
-    _bins = _binAlloc.get( _binCount );
-    mem::MemoryUtils::copy( _bins, set._bins, _binCount );
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>::Set( Set<T>&& set )
-    : _binAlloc( std::move( set._binAlloc ) ),
-      _values( std::move( set._values ) ),
-      _hashFunc( std::move( set._hashFunc ) ), _bins( set._bins ),
-      _binsInUse( set._binsInUse ), _binCount( set._binCount )
+Set<T, H, E, I>::Set( Set<T, H, E, I>&& set )
+    : _values( std::move( set._values ) ), _index( std::move( set._index ) ),
+      _hasher( std::move( set._hasher ) ),
+      _equality( std::move( set._equality ) )
 {
-    set._bins = nullptr;
-    set._binsInUse = 0;
-    set._binCount = 0;
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>::~Set()
+Set<T, H, E, I>::~Set()
 {
-    if ( _bins != nullptr )
-    {
-        _binAlloc.release( _bins, _binCount );
-        _bins = nullptr;
-    }
-    _binsInUse = 0;
-    _binCount = 0;
 }
 
 // OPERATORS
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>& Set<T>::operator=( const Set<T>& set )
+Set<T, H, E, I>& Set<T, H, E, I>::operator=( const Set<T, H, E, I>& set )
 {
-    if ( _bins != nullptr )
-    {
-        _binAlloc.release( _bins, _binCount );
-    }
-
-    _binAlloc = set._binAlloc;
     _values = set._values;
-    _hashFunc = set._hashFunc;
-    _bins = _binAlloc.get( _binCount );
-    _binCount = set._binCount;
-    _binsInUse = set._binsInUse;
-    mem::MemoryUtils::copy( _bins, set._bins, _binCount );
+    _index = set._index;
+    _hasher = set._hasher;
+    _equality = set._equality;
 
     return *this;
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>& Set<T>::operator=( Set<T>&& set )
+Set<T, H, E, I>& Set<T, H, E, I>::operator=( Set<T, H, E, I>&& set )
 {
-    if ( _bins != nullptr )
-    {
-        _binAlloc.release( _bins, _binCount );
-    }
-
-    _binAlloc = std::move( set._binAlloc );
     _values = std::move( set._values );
-    _hashFunc = std::move( set._hashFunc );
-    _bins = set._bins;
-    _binCount = set._binCount;
-    _binsInUse = set._binsInUse;
-
-    set._bins = nullptr;
-    set._binsInUse = 0;
-    set._binCount = 0;
+    _index = std::move( set._index );
+    _hasher = std::move( set._hasher );
+    _equality = std::move( set._equality );
 
     return *this;
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-const T& Set<T>::operator[]( uint32 index ) const
+const T& Set<T, H, E, I>::operator[]( uint32 index ) const
 {
     assert( index < size() );
     return _values[index];
 }
 
-template <typename T>
-void Set<T>::add( const T& value )
+template <typename T, typename H, typename E, typename I>
+void Set<T, H, E, I>::add( const T& value )
 {
-    if ( shouldGrow() )
+    const uint32 hashCode = hash( value );
+    if ( findBin( hashCode, value ) == I::NOT_FOUND )
     {
-        grow();
+        insert( hashCode, T( value ) );
     }
+}
 
-    uint32 binIndex = findBinForValue( value );
-    if ( isBinEmpty( binIndex ) )
+template <typename T, typename H, typename E, typename I>
+void Set<T, H, E, I>::add( T&& value )
+{
+    const uint32 hashCode = hash( value );
+    if ( findBin( hashCode, value ) == I::NOT_FOUND )
     {
-        ++_binsInUse;
-        _bins[binIndex] = _values.size();
-        _values.push( std::move( value ) );
+        insert( hashCode, std::move( value ) );
     }
 }
 
-template <typename T>
-void Set<T>::add( T&& value )
+template <typename T, typename H, typename E, typename I>
+void Set<T, H, E, I>::addAll( const T* values, uint32 count )
 {
-    if ( shouldGrow() )
+    assert( values != nullptr || count == 0 );
+
+    reserve( _values.size() + count );
+
+    uint32 hashes[BATCH_SIZE];
+    uint32 batch;
+    uint32 batchCount;
+    uint32 i;
+    for ( batch = 0; batch < count; batch += batchCount )
     {
-        grow();
+        batchCount = count - batch < BATCH_SIZE ? count - batch : BATCH_SIZE;
+
+        // hash the whole batch first so its groups are already being loaded
+        // by the time they are probed
+        for ( i = 0; i < batchCount; ++i )
+        {
+            hashes[i] = hash( values[batch + i] );
+            _index.prefetch( hashes[i] );
+        }
+
+        for ( i = 0; i < batchCount; ++i )
+        {
+            const T& value = values[batch + i];
+            if ( findBin( hashes[i], value ) == I::NOT_FOUND )
+            {
+                insert( hashes[i], T( value ) );
+            }
+        }
     }
+}
+
+template <typename T, typename H, typename E, typename I>
+void Set<T, H, E, I>::reserve( uint32 capacity )
+{
+    _values.reserve( capacity );
 
-    uint32 binIndex = findBinForValue( value );
-    if ( isBinEmpty( binIndex ) )
+    const uint32 binCount = I::binsFor( capacity );
+    if ( binCount > _index.binCount() )
     {
-        ++_binsInUse;
-        _bins[binIndex] = _values.size();
-        _values.push( std::move( value ) );
+        rebuild( binCount );
     }
 }
 
-template <typename T>
-void Set<T>::remove( const T& value )
+template <typename T, typename H, typename E, typename I>
+void Set<T, H, E, I>::rehash( uint32 binCount )
 {
-    if ( shouldShrink() )
+    uint32 bins = I::binsFor( _values.size() );
+    while ( bins < binCount )
     {
-        shrink();
+        bins <<= 1;
     }
 
-    uint32 binIndex = findBinForValue( value );
-    uint32 i;
-    if ( !isBinEmpty( binIndex ) )
+    rebuild( bins );
+}
+
+template <typename T, typename H, typename E, typename I>
+void Set<T, H, E, I>::remove( const T& value )
+{
+    const uint32 bin = findBin( value );
+    if ( bin == I::NOT_FOUND )
     {
-        --_binsInUse;
-        _values.removeAt( _bins[binIndex] );
+        return;
+    }
 
-        // correct bin indices
-        for ( i = 0; i < _binCount; ++i )
-        {
-            if ( !isBinEmpty( i ) && _bins[i] > _bins[binIndex] )
-            {
-                --( _bins[i] );
-            }
-        }
+    const uint32 index = _index.itemAt( bin );
+    const uint32 last = _values.size() - 1;
+
+    // move the last value into the hole and patch the one bin that
+    // referenced it
+    if ( index != last )
+    {
+        _index.setItemAt( findBinForIndex( last ), index );
+        _values[index] = std::move( _values[last] );
+    }
 
-        _bins[binIndex] = BIN_EMPTY;
+    _values.pop();
+    _index.erase( bin );
+
+    if ( _index.shouldShrink() )
+    {
+        shrink();
     }
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-bool Set<T>::has( const T& value ) const
+bool Set<T, H, E, I>::has( const T& value ) const
 {
-    const uint32 binIndex = findBinForValue( value );
-    return binIndex != -1 && doesBinContain( binIndex, value );
+    return findBin( value ) != I::NOT_FOUND;
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-void Set<T>::clear()
+void Set<T, H, E, I>::clear()
 {
     _values.clear();
-    mem::MemoryUtils::set( _bins, BIN_EMPTY, _binCount );
-    _binsInUse = 0;
+    _index.clear();
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-typename Set<T>::ConstIterator Set<T>::cbegin() const
+typename Set<T, H, E, I>::ConstIterator Set<T, H, E, I>::cbegin() const
 {
     return ConstIterator( this, 0 );
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-typename Set<T>::ConstIterator Set<T>::cend() const
+typename Set<T, H, E, I>::ConstIterator Set<T, H, E, I>::cend() const
 {
     return ConstIterator( this, _values.size() );
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-uint32 Set<T>::size() const
+uint32 Set<T, H, E, I>::size() const
 {
     return _values.size();
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-bool Set<T>::isEmpty() const
+bool Set<T, H, E, I>::isEmpty() const
 {
     return _values.isEmpty();
 }
 
-// HELPER FUNCTIONS
-template <typename T>
-uint32 Set<T>::findBinForValue( const T& value ) const
+template <typename T, typename H, typename E, typename I>
+uint32 Set<T, H, E, I>::maxProbeLength() const
 {
-    const uint32 hashCode = hash( value );
-    uint32 i;
-    uint32 probes;
-    for ( i = wrap( hashCode ), probes = 0;
-          !isBinEmpty( i ) && !doesBinContain( i, value );
-          i = probe( ++probes ) )
-    {
-        // do nothing
-    }
-
-    return i;
+    return _index.maxProbeLength(
+        [this]( uint32 i ) { return hash( _values[i] ); } );
 }
 
-template <typename T>
-inline
-uint32 Set<T>::hash( const T& value ) const
+template <typename T, typename H, typename E, typename I>
+float Set<T, H, E, I>::meanProbeLength() const
 {
-    return _hashFunc( value );
+    return _index.meanProbeLength(
+        [this]( uint32 i ) { return hash( _values[i] ); } );
 }
 
-template <typename T>
-inline
-uint32 Set<T>::probe( uint32 probes ) const
+template <typename T, typename H, typename E, typename I>
+ContainerStats Set<T, H, E, I>::stats() const
 {
-    return probes;
-}
+    ContainerStats stats = _values.stats();
+    stats.bytesReserved += _index.byteCount();
+    stats.bucketCount = _index.binCount();
+    stats.maxProbeLength = maxProbeLength();
 
-template <typename T>
-inline
-uint32 Set<T>::wrap( uint32 index ) const
-{
-    return index & ( _binCount - 1 );
+    return stats;
 }
 
-template <typename T>
+// HELPER FUNCTIONS
+template <typename T, typename H, typename E, typename I>
 inline
-bool Set<T>::isBinEmpty( uint32 binIndex ) const
+uint32 Set<T, H, E, I>::findBin( const T& value ) const
 {
-    assert( binIndex < _binCount );
-    return _bins[binIndex] == BIN_EMPTY;
+    return findBin( hash( value ), value );
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-bool Set<T>::doesBinContain( uint32 binIndex, const T& value ) const
+uint32 Set<T, H, E, I>::findBin( uint32 hashCode, const T& value ) const
 {
-    return binIndex < _binCount && !isBinEmpty( binIndex ) &&
-        hash( _values[_bins[binIndex]] ) == hash( value );
+    const DynamicArray<T>& values = _values;
+    const E& equality = _equality;
+    return _index.find( hashCode, [&values, &equality, &value]( uint32 i ) {
+        return equality.equals( values[i], value );
+    } );
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-bool Set<T>::shouldShrink() const
+uint32 Set<T, H, E, I>::findBinForIndex( uint32 valueIndex ) const
 {
-    return ( ( _binsInUse * 100 ) / _binCount ) <= SHRINK_THRESHOLD &&
-        _binCount > MIN_BINS;
+    const uint32 bin = _index.find(
+        hash( _values[valueIndex] ),
+        [valueIndex]( uint32 i ) { return i == valueIndex; } );
+
+    assert( bin != I::NOT_FOUND );
+    return bin;
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-bool Set<T>::shouldGrow() const
+uint32 Set<T, H, E, I>::hash( const T& value ) const
 {
-    return ( ( _binsInUse * 100 ) / _binCount ) >= GROW_THRESHOLD;
+    return _hasher.hash( value );
 }
 
-template <typename T>
-inline
-void Set<T>::grow()
+template <typename T, typename H, typename E, typename I>
+void Set<T, H, E, I>::insert( uint32 hashCode, T&& value )
 {
-    resize( _binCount << 1 );
+    if ( _index.shouldGrow() )
+    {
+        grow();
+    }
+
+    _index.insert( hashCode, _values.size() );
+    _values.push( std::move( value ) );
 }
 
-template <typename T>
-inline
-void Set<T>::shrink()
+template <typename T, typename H, typename E, typename I>
+void Set<T, H, E, I>::rebuild( uint32 binCount )
 {
-    resize( _binCount >> 1 );
+    _index.rehash( binCount, _values.size(),
+                   [this]( uint32 i ) { return hash( _values[i] ); } );
 }
 
-template <typename T>
-void Set<T>::resize( uint32 newSize )
+template <typename T, typename H, typename E, typename I>
+void Set<T, H, E, I>::grow()
 {
-    assert( _bins != nullptr );
-    _binAlloc.release( _bins, newSize );
-    _bins = _binAlloc.get( newSize );
-    _binCount = newSize;
-    clearBins();
-
-    uint32 i;
-    uint32 pos;
-    for ( i = 0; i < _values.size(); ++i )
-    {
-        pos = findBinForValue( _values[i] );
-        _bins[pos] = i;
-    }
+    _index.grow( [this]( uint32 i ) { return hash( _values[i] ); } );
 }
 
-template <typename T>
-inline
-void Set<T>::clearBins()
+template <typename T, typename H, typename E, typename I>
+void Set<T, H, E, I>::shrink()
 {
-    mem::MemoryUtils::set( _bins, BIN_EMPTY, _binCount );
+    _index.shrink( [this]( uint32 i ) { return hash( _values[i] ); } );
 }
 
 // ITERATOR CONSTRUCTORS
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>::ConstIterator::ConstIterator()
+Set<T, H, E, I>::ConstIterator::ConstIterator()
     : _iterValues( nullptr ), _iterIndex( 0 )
 {
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>::ConstIterator::ConstIterator( const Set<T>* set, uint32 index )
+Set<T, H, E, I>::ConstIterator::ConstIterator( const Set<T, H, E, I>* set,
+                                               uint32 index )
     : _iterValues( &set->_values ), _iterIndex( index )
 {
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>::ConstIterator::ConstIterator( const ConstIterator& iter )
+Set<T, H, E, I>::ConstIterator::ConstIterator( const ConstIterator& iter )
     : _iterValues( iter._iterValues ), _iterIndex( iter._iterIndex )
 {
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-Set<T>::ConstIterator::~ConstIterator()
+Set<T, H, E, I>::ConstIterator::~ConstIterator()
 {
     _iterValues = nullptr;
     _iterIndex = static_cast<uint32>( -1 );
 }
 
 // ITERATOR OPERATORS
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-typename Set<T>::ConstIterator& Set<T>::ConstIterator::operator=(
-    const ConstIterator& iter )
+typename Set<T, H, E, I>::ConstIterator&
+Set<T, H, E, I>::ConstIterator::operator=( const ConstIterator& iter )
 {
     _iterValues = iter._iterValues;
     _iterIndex = iter._iterIndex;
@@ -834,66 +792,72 @@ typename Set<T>::ConstIterator& Set<T>::ConstIterator::operator=(
     return *this;
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-typename Set<T>::ConstIterator& Set<T>::ConstIterator::operator++()
+typename Set<T, H, E, I>::ConstIterator&
+Set<T, H, E, I>::ConstIterator::operator++()
 {
     ++_iterIndex;
 
     return *this;
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-typename Set<T>::ConstIterator& Set<T>::ConstIterator::operator++( int32 )
+typename Set<T, H, E, I>::ConstIterator&
+Set<T, H, E, I>::ConstIterator::operator++( int32 )
 {
     ++_iterIndex;
 
     return *this;
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-typename Set<T>::ConstIterator& Set<T>::ConstIterator::operator--()
+typename Set<T, H, E, I>::ConstIterator&
+Set<T, H, E, I>::ConstIterator::operator--()
 {
     _iterIndex = _iterIndex > 0 ? _iterIndex - 1 : _iterValues->size();
 
     return *this;
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-typename Set<T>::ConstIterator& Set<T>::ConstIterator::operator--( int32 )
+typename Set<T, H, E, I>::ConstIterator&
+Set<T, H, E, I>::ConstIterator::operator--( int32 )
 {
     _iterIndex = _iterIndex > 0 ? _iterIndex - 1 : _iterValues->size();
 
     return *this;
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-const T& Set<T>::ConstIterator::operator*() const
+const T& Set<T, H, E, I>::ConstIterator::operator*() const
 {
     return ( *_iterValues )[_iterIndex];
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-const T* Set<T>::ConstIterator::operator->() const
+const T* Set<T, H, E, I>::ConstIterator::operator->() const
 {
     return &( *_iterValues )[_iterIndex];
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-bool Set<T>::ConstIterator::operator==( const ConstIterator& iter ) const
+bool
+Set<T, H, E, I>::ConstIterator::operator==( const ConstIterator& iter ) const
 {
     return _iterValues == iter._iterValues && _iterIndex == iter._iterIndex;
 }
 
-template <typename T>
+template <typename T, typename H, typename E, typename I>
 inline
-bool Set<T>::ConstIterator::operator!=( const ConstIterator& iter ) const
+bool
+Set<T, H, E, I>::ConstIterator::operator!=( const ConstIterator& iter ) const
 {
     return _iterValues != iter._iterValues || _iterIndex != iter._iterIndex;
 }
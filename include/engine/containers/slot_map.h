@@ -0,0 +1,649 @@
+// slot_map.h
+//
+// Defines a container that hands out generation tagged handles to its
+// values.
+//
+// The values are kept densely packed in a DynamicArray so iterating them
+// walks memory sequentially. Each handle names a slot that records where its
+// value currently is, so inserting, removing and looking up by handle are
+// all constant time. Removing moves the last value into the hole, so the
+// values are not kept in insertion order.
+//
+// A slot's generation changes every time its value is removed, so a handle
+// to a removed value stays invalid even after the slot is reused. The
+// handle holds as many bits of generation as it does of slot index, so
+// with 32 bit handles a slot can be reused 32768 times before old handles
+// to it could match again.
+//
+#ifndef NGE_CNTR_SLOT_MAP_H
+#define NGE_CNTR_SLOT_MAP_H
+
+#include <assert.h>
+#include <type_traits>
+#include <utility>
+
+#include "engine/intdef.h"
+#include "engine/containers/container_stats.h"
+#include "engine/containers/dynamic_array.h"
+#include "engine/memory/iallocator.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+template <typename T, typename H = uint32>
+class SlotMap
+{
+    static_assert( std::is_same<H, uint32>::value ||
+                   std::is_same<H, uint64>::value,
+                   "Handles must be uint32 or uint64." );
+
+  public:
+    // TYPES
+    /**
+     * Names a value in the map.
+     *
+     * The low half of the bits is the slot and the high half is the slot's
+     * generation when the value was inserted.
+     */
+    typedef H Handle;
+
+    typedef typename DynamicArray<T>::Iterator Iterator;
+
+    typedef typename DynamicArray<T>::ConstIterator ConstIterator;
+
+    // CONSTANTS
+    /**
+     * A handle that never names a value.
+     */
+    static constexpr H NULL_HANDLE = 0;
+
+    /**
+     * The number of bits of a handle that hold the slot.
+     */
+    static constexpr uint32 INDEX_BITS = sizeof( H ) * 4;
+
+    /**
+     * The most values the map can hold.
+     */
+    static constexpr uint32 MAX_SIZE = sizeof( H ) == 4
+        ? static_cast<uint32>( 1 ) << INDEX_BITS
+        : static_cast<uint32>( -1 );
+
+  private:
+    // CONSTANTS
+    /**
+     * Marks the end of the free slot list.
+     */
+    static constexpr uint32 END = static_cast<uint32>( -1 );
+
+    // MEMBERS
+    /**
+     * The values.
+     */
+    DynamicArray<T> _values;
+
+    /**
+     * The slot of each value.
+     */
+    DynamicArray<uint32> _owners;
+
+    /**
+     * The index of each slot's value, or the next free slot when the slot is
+     * free.
+     */
+    DynamicArray<uint32> _slots;
+
+    /**
+     * The generation of each slot.
+     *
+     * Generations are odd while the slot holds a value and even while it is
+     * free, so a handle can only match a slot that is in use.
+     */
+    DynamicArray<uint32> _generations;
+
+    /**
+     * The most recently freed slot.
+     */
+    uint32 _free;
+
+    // HELPER FUNCTIONS
+    /**
+     * Takes a free slot for a value that is about to be added at the end of
+     * the values and gets its handle.
+     */
+    H acquire();
+
+    /**
+     * Gets the slot named by the handle.
+     *
+     * Returns END if the handle does not name a value in the map.
+     */
+    uint32 slotOf( H handle ) const;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a new slot map.
+     */
+    SlotMap();
+
+    /**
+     * Constructs a new slot map with the given initial capacity.
+     */
+    SlotMap( uint32 capacity );
+
+    /**
+     * Constructs a new slot map with the given allocators.
+     */
+    SlotMap( mem::IAllocator<T>* valueAlloc,
+             mem::IAllocator<uint32>* intAlloc );
+
+    /**
+     * Constructs a new slot map with the given allocators and initial
+     * capacity.
+     */
+    SlotMap( mem::IAllocator<T>* valueAlloc, mem::IAllocator<uint32>* intAlloc,
+             uint32 capacity );
+
+    /**
+     * Constructs a copy of the given slot map.
+     *
+     * Handles to the original name the same values in the copy.
+     */
+    SlotMap( const SlotMap<T, H>& map );
+
+    /**
+     * Moves the slot map to a new instance.
+     */
+    SlotMap( SlotMap<T, H>&& map );
+
+    /**
+     * Destructs the slot map.
+     */
+    ~SlotMap();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the given slot map.
+     */
+    SlotMap<T, H>& operator=( const SlotMap<T, H>& map );
+
+    /**
+     * Moves the slot map data to this instance.
+     */
+    SlotMap<T, H>& operator=( SlotMap<T, H>&& map );
+
+    /**
+     * Gets the value at the given index of the packed values.
+     *
+     * Behavior is undefined when:
+     * index is not less than the size of the map.
+     */
+    T& operator[]( uint32 index );
+
+    /**
+     * Gets the value at the given index of the packed values.
+     *
+     * Behavior is undefined when:
+     * index is not less than the size of the map.
+     */
+    const T& operator[]( uint32 index ) const;
+
+    // MEMBER FUNCTIONS
+    /**
+     * Adds a copy of the value to the map and gets its handle.
+     *
+     * Behavior is undefined when:
+     * the map already holds MAX_SIZE values.
+     */
+    H insert( const T& value );
+
+    /**
+     * Moves the value into the map and gets its handle.
+     *
+     * Behavior is undefined when:
+     * the map already holds MAX_SIZE values.
+     */
+    H insert( T&& value );
+
+    /**
+     * Constructs a value in the map from the given arguments and gets its
+     * handle.
+     *
+     * Behavior is undefined when:
+     * the map already holds MAX_SIZE values.
+     */
+    template <typename... Args>
+    H emplace( Args&&... args );
+
+    /**
+     * Removes the value named by the handle.
+     *
+     * The last value is moved into the hole left by the removed value. The
+     * handle and any copies of it no longer name a value. Returns false if
+     * the handle did not name a value in the map.
+     */
+    bool remove( H handle );
+
+    /**
+     * Gets the value named by the handle.
+     *
+     * Returns nullptr if the handle does not name a value in the map. The
+     * pointer is invalidated when a value is inserted or removed.
+     */
+    T* lookup( H handle );
+
+    /**
+     * Gets the value named by the handle.
+     *
+     * Returns nullptr if the handle does not name a value in the map. The
+     * pointer is invalidated when a value is inserted or removed.
+     */
+    const T* lookup( H handle ) const;
+
+    /**
+     * Checks if the handle names a value in the map.
+     */
+    bool has( H handle ) const;
+
+    /**
+     * Gets the handle of the value at the given index of the packed values.
+     *
+     * Behavior is undefined when:
+     * index is not less than the size of the map.
+     */
+    H handleAt( uint32 index ) const;
+
+    /**
+     * Removes all of the values from the map.
+     *
+     * Every handle handed out so far stops naming a value.
+     */
+    void clear();
+
+    /**
+     * Makes room for at least the given number of values so that inserting
+     * up to that many does not reallocate.
+     */
+    void reserve( uint32 capacity );
+
+    /**
+     * Gets an iterator over the packed values.
+     */
+    Iterator begin();
+
+    /**
+     * Gets a constant iterator over the packed values.
+     */
+    ConstIterator cbegin() const;
+
+    /**
+     * Gets an iterator for the end of the packed values.
+     */
+    Iterator end();
+
+    /**
+     * Gets a constant iterator for the end of the packed values.
+     */
+    ConstIterator cend() const;
+
+    /**
+     * Gets the number of values in the map.
+     */
+    uint32 size() const;
+
+    /**
+     * Checks if the map is empty.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Gets the memory footprint and occupancy of the map.
+     *
+     * The byte counts include the slot bookkeeping and the free count is
+     * the number of slots waiting to be reused.
+     */
+    ContainerStats stats() const;
+};
+
+// CONSTANTS
+template <typename T, typename H>
+constexpr H SlotMap<T, H>::NULL_HANDLE;
+
+template <typename T, typename H>
+constexpr uint32 SlotMap<T, H>::INDEX_BITS;
+
+template <typename T, typename H>
+constexpr uint32 SlotMap<T, H>::MAX_SIZE;
+
+template <typename T, typename H>
+constexpr uint32 SlotMap<T, H>::END;
+
+// CONSTRUCTORS
+template <typename T, typename H>
+inline
+SlotMap<T, H>::SlotMap() : SlotMap( nullptr, nullptr, 0 )
+{
+}
+
+template <typename T, typename H>
+inline
+SlotMap<T, H>::SlotMap( uint32 capacity )
+    : SlotMap( nullptr, nullptr, capacity )
+{
+}
+
+template <typename T, typename H>
+inline
+SlotMap<T, H>::SlotMap( mem::IAllocator<T>* valueAlloc,
+                        mem::IAllocator<uint32>* intAlloc )
+    : SlotMap( valueAlloc, intAlloc, 0 )
+{
+}
+
+template <typename T, typename H>
+inline
+SlotMap<T, H>::SlotMap( mem::IAllocator<T>* valueAlloc,
+                        mem::IAllocator<uint32>* intAlloc, uint32 capacity )
+    : _values( valueAlloc, capacity ), _owners( intAlloc, capacity ),
+      _slots( intAlloc, capacity ), _generations( intAlloc, capacity ),
+      _free( END )
+{
+}
+
+template <typename T, typename H>
+inline
+SlotMap<T, H>::SlotMap( const SlotMap<T, H>& map )
+    : _values( map._values ), _owners( map._owners ), _slots( map._slots ),
+      _generations( map._generations ), _free( map._free )
+{
+}
+
+template <typename T, typename H>
+inline
+SlotMap<T, H>::SlotMap( SlotMap<T, H>&& map )
+    : _values( std::move( map._values ) ),
+      _owners( std::move( map._owners ) ),
+      _slots( std::move( map._slots ) ),
+      _generations( std::move( map._generations ) ), _free( map._free )
+{
+    map._free = END;
+}
+
+template <typename T, typename H>
+inline
+SlotMap<T, H>::~SlotMap()
+{
+}
+
+// OPERATORS
+template <typename T, typename H>
+inline
+SlotMap<T, H>& SlotMap<T, H>::operator=( const SlotMap<T, H>& map )
+{
+    _values = map._values;
+    _owners = map._owners;
+    _slots = map._slots;
+    _generations = map._generations;
+    _free = map._free;
+
+    return *this;
+}
+
+template <typename T, typename H>
+inline
+SlotMap<T, H>& SlotMap<T, H>::operator=( SlotMap<T, H>&& map )
+{
+    _values = std::move( map._values );
+    _owners = std::move( map._owners );
+    _slots = std::move( map._slots );
+    _generations = std::move( map._generations );
+    _free = map._free;
+
+    map._free = END;
+
+    return *this;
+}
+
+template <typename T, typename H>
+inline
+T& SlotMap<T, H>::operator[]( uint32 index )
+{
+    return _values[index];
+}
+
+template <typename T, typename H>
+inline
+const T& SlotMap<T, H>::operator[]( uint32 index ) const
+{
+    return _values[index];
+}
+
+// MEMBER FUNCTIONS
+template <typename T, typename H>
+inline
+H SlotMap<T, H>::insert( const T& value )
+{
+    const H handle = acquire();
+    _values.push( value );
+
+    return handle;
+}
+
+template <typename T, typename H>
+inline
+H SlotMap<T, H>::insert( T&& value )
+{
+    const H handle = acquire();
+    _values.push( std::move( value ) );
+
+    return handle;
+}
+
+template <typename T, typename H>
+template <typename... Args>
+inline
+H SlotMap<T, H>::emplace( Args&&... args )
+{
+    const H handle = acquire();
+    _values.emplace( std::forward<Args>( args )... );
+
+    return handle;
+}
+
+template <typename T, typename H>
+bool SlotMap<T, H>::remove( H handle )
+{
+    const uint32 slot = slotOf( handle );
+    if ( slot == END )
+    {
+        return false;
+    }
+
+    // move the last value into the hole and point its slot at it
+    const uint32 index = _slots[slot];
+    const uint32 last = _values.size() - 1;
+    if ( index != last )
+    {
+        _values[index] = std::move( _values[last] );
+        _owners[index] = _owners[last];
+        _slots[_owners[index]] = index;
+    }
+
+    _values.pop();
+    _owners.pop();
+
+    ++_generations[slot];
+    _slots[slot] = _free;
+    _free = slot;
+
+    return true;
+}
+
+template <typename T, typename H>
+inline
+T* SlotMap<T, H>::lookup( H handle )
+{
+    const uint32 slot = slotOf( handle );
+    return slot != END ? &_values[_slots[slot]] : nullptr;
+}
+
+template <typename T, typename H>
+inline
+const T* SlotMap<T, H>::lookup( H handle ) const
+{
+    const uint32 slot = slotOf( handle );
+    return slot != END ? &_values[_slots[slot]] : nullptr;
+}
+
+template <typename T, typename H>
+inline
+bool SlotMap<T, H>::has( H handle ) const
+{
+    return slotOf( handle ) != END;
+}
+
+template <typename T, typename H>
+inline
+H SlotMap<T, H>::handleAt( uint32 index ) const
+{
+    assert( index < _values.size() );
+
+    const uint32 slot = _owners[index];
+    return static_cast<H>( _generations[slot] ) << INDEX_BITS | slot;
+}
+
+template <typename T, typename H>
+void SlotMap<T, H>::clear()
+{
+    uint32 i;
+    for ( i = 0; i < _owners.size(); ++i )
+    {
+        const uint32 slot = _owners[i];
+        ++_generations[slot];
+        _slots[slot] = _free;
+        _free = slot;
+    }
+
+    _values.clear();
+    _owners.clear();
+}
+
+template <typename T, typename H>
+inline
+void SlotMap<T, H>::reserve( uint32 capacity )
+{
+    _values.reserve( capacity );
+    _owners.reserve( capacity );
+    _slots.reserve( capacity );
+    _generations.reserve( capacity );
+}
+
+template <typename T, typename H>
+inline
+typename SlotMap<T, H>::Iterator SlotMap<T, H>::begin()
+{
+    return _values.begin();
+}
+
+template <typename T, typename H>
+inline
+typename SlotMap<T, H>::ConstIterator SlotMap<T, H>::cbegin() const
+{
+    return _values.cbegin();
+}
+
+template <typename T, typename H>
+inline
+typename SlotMap<T, H>::Iterator SlotMap<T, H>::end()
+{
+    return _values.end();
+}
+
+template <typename T, typename H>
+inline
+typename SlotMap<T, H>::ConstIterator SlotMap<T, H>::cend() const
+{
+    return _values.cend();
+}
+
+template <typename T, typename H>
+inline
+uint32 SlotMap<T, H>::size() const
+{
+    return _values.size();
+}
+
+template <typename T, typename H>
+inline
+bool SlotMap<T, H>::isEmpty() const
+{
+    return _values.isEmpty();
+}
+
+template <typename T, typename H>
+inline
+ContainerStats SlotMap<T, H>::stats() const
+{
+    ContainerStats stats = _values.stats();
+    const ContainerStats owners = _owners.stats();
+    const ContainerStats slots = _slots.stats();
+    const ContainerStats generations = _generations.stats();
+    stats.bytesUsed += owners.bytesUsed + slots.bytesUsed +
+        generations.bytesUsed;
+    stats.bytesReserved += owners.bytesReserved + slots.bytesReserved +
+        generations.bytesReserved;
+    stats.freeCount = _slots.size() - _values.size();
+
+    return stats;
+}
+
+// HELPER FUNCTIONS
+template <typename T, typename H>
+H SlotMap<T, H>::acquire()
+{
+    assert( _values.size() < MAX_SIZE );
+
+    uint32 slot;
+    if ( _free != END )
+    {
+        slot = _free;
+        _free = _slots[slot];
+        _slots[slot] = _values.size();
+    }
+    else
+    {
+        slot = _slots.size();
+        _slots.push( _values.size() );
+        _generations.push( 0 );
+    }
+
+    const uint32 generation = ++_generations[slot];
+    _owners.push( slot );
+
+    return static_cast<H>( generation ) << INDEX_BITS | slot;
+}
+
+template <typename T, typename H>
+inline
+uint32 SlotMap<T, H>::slotOf( H handle ) const
+{
+    const H mask = ( static_cast<H>( 1 ) << INDEX_BITS ) - 1;
+    const uint32 slot = static_cast<uint32>( handle & mask );
+    const uint32 generation = static_cast<uint32>( handle >> INDEX_BITS );
+
+    // the handle only holds the low bits of the generation and an even
+    // generation belongs to a free slot
+    return ( generation & 1 ) != 0 && slot < _slots.size() &&
+           generation == static_cast<uint32>( _generations[slot] & mask )
+        ? slot : END;
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif
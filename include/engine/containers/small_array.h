@@ -0,0 +1,861 @@
+// small_array.h
+// The small array is a resizable array that stores its first N items inside
+// of the array object itself. The allocator is only used once the array
+// holds more than N items, and the items move back inside of the object
+// when the array shrinks to N items or fewer.
+//
+// This suits the many short arrays that are kept per entity, which would
+// otherwise each make a heap allocation.
+//
+// Unlike the dynamic array the items are always contiguous starting at
+// index zero, so iterators are plain pointers. Like the dynamic array only
+// the live items are constructed, both inline and once spilled, so T does
+// not need a default constructor.
+
+#ifndef NGE_CNTR_SMALL_ARRAY_H
+#define NGE_CNTR_SMALL_ARRAY_H
+
+#include <assert.h>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "engine/intdef.h"
+#include "engine/containers/container_stats.h"
+#include "engine/memory/allocator_guard.h"
+#include "engine/memory/iallocator.h"
+#include "engine/memory/memory_utils.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+template <typename T, uint32 N>
+class SmallArray
+{
+    static_assert( N > 0, "SmallArray needs room for at least one item" );
+
+  private:
+    // MEMBERS
+    /**
+     * The allocator used once the items no longer fit in the object.
+     */
+    mem::AllocatorGuard<T> _allocator;
+
+    /**
+     * The uninitialized storage inside of the object.
+     */
+    typename std::aligned_storage<sizeof( T ), alignof( T )>::type
+        _inline[N];
+
+    /**
+     * The array of values.
+     *
+     * This points to the inline storage until the array spills.
+     */
+    T* _values;
+
+    /**
+     * The number of items in the array.
+     */
+    uint32 _size;
+
+    /**
+     * The capacity of the array.
+     */
+    uint32 _capacity;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the storage inside of the object.
+     */
+    T* inlineValues();
+
+    /**
+     * Gets the storage inside of the object.
+     */
+    const T* inlineValues() const;
+
+    /**
+     * Checks if the items are stored inside of the object.
+     */
+    bool isInline() const;
+
+    /**
+     * Moves the items to storage with the given capacity.
+     *
+     * The inline storage is used when the capacity is N or less.
+     */
+    void resize( uint32 newCapacity );
+
+    /**
+     * Shifts the items forward one spot starting at the given index.
+     *
+     * The slot past the last item must be raw storage. The slot at the
+     * start is left holding a moved from item.
+     */
+    void shiftForward( uint32 start );
+
+    /**
+     * Shifts the items backward one spot starting at the given index.
+     *
+     * The last slot is left holding a moved from item.
+     */
+    void shiftBackward( uint32 start );
+
+    /**
+     * Checks if the array must grow before another item is added.
+     */
+    bool shouldGrow() const;
+
+    /**
+     * Checks if the array should shrink.
+     */
+    bool shouldShrink() const;
+
+    /**
+     * Destroys the items, releases the allocated storage, if any, and
+     * switches back to the inline storage.
+     */
+    void release();
+
+  public:
+    // TYPES
+    /**
+     * Defines an iterator for the array.
+     */
+    typedef T* Iterator;
+
+    /**
+     * Defines a constant iterator for the array.
+     */
+    typedef const T* ConstIterator;
+
+    // CONSTRUCTORS
+    /**
+     * Constructs a new SmallArray.
+     */
+    SmallArray();
+
+    /**
+     * Constructs a new SmallArray that uses the given allocator once it
+     * holds more than N items.
+     */
+    SmallArray( mem::IAllocator<T>* allocator );
+
+    /**
+     * Constructs a copy of the given array.
+     *
+     * The copy only allocates if it holds more than N items.
+     */
+    SmallArray( const SmallArray<T, N>& array );
+
+    /**
+     * Moves the array to a new instance.
+     *
+     * Allocated storage is taken over while inline items are moved one at a
+     * time.
+     */
+    SmallArray( SmallArray<T, N>&& array );
+
+    /**
+     * Destructs the array.
+     */
+    ~SmallArray();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the given array.
+     */
+    SmallArray<T, N>& operator=( const SmallArray<T, N>& array );
+
+    /**
+     * Moves the array to this instance.
+     */
+    SmallArray<T, N>& operator=( SmallArray<T, N>&& array );
+
+    /**
+     * Gets the item at the given index.
+     *
+     * Behavior is undefined when:
+     * index is out of bounds
+     */
+    const T& operator[]( uint32 index ) const;
+
+    /**
+     * Gets the item at the given index.
+     *
+     * Behavior is undefined when:
+     * index is out of bounds
+     */
+    T& operator[]( uint32 index );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Gets the item at the given index.
+     *
+     * Throws std::runtime_error if the index is out of bounds.
+     */
+    T& at( uint32 index ) const;
+
+    /**
+     * Adds a copy of the value to the end of the array.
+     */
+    void push( const T& value );
+
+    /**
+     * Moves the value to the end of the array.
+     */
+    void push( T&& value );
+
+    /**
+     * Adds a copy of the value to the start of the array.
+     */
+    void pushFront( const T& value );
+
+    /**
+     * Moves the value to the start of the array.
+     */
+    void pushFront( T&& value );
+
+    /**
+     * Inserts a copy of the value at the given index.
+     *
+     * Throws std::runtime_error if the index is out of bounds.
+     */
+    void insertAt( uint32 index, const T& value );
+
+    /**
+     * Moves the value into the array at the given index.
+     *
+     * Throws std::runtime_error if the index is out of bounds.
+     */
+    void insertAt( uint32 index, T&& value );
+
+    /**
+     * Removes the last item in the array.
+     *
+     * Behavior is undefined when:
+     * the array is empty
+     */
+    T pop();
+
+    /**
+     * Removes the first item in the array.
+     *
+     * Behavior is undefined when:
+     * the array is empty
+     */
+    T popFront();
+
+    /**
+     * Removes the item at the given index.
+     *
+     * Throws std::runtime_error if the index is out of bounds.
+     */
+    T removeAt( uint32 index );
+
+    /**
+     * Removes the first occurrence of the value in the array.
+     *
+     * Returns true if the value was removed.
+     */
+    bool remove( const T& value );
+
+    /**
+     * Destroys all items in the array.
+     *
+     * Allocated storage is released.
+     */
+    void clear();
+
+    /**
+     * Grows the array so it can hold at least the given number of items
+     * without reallocating.
+     *
+     * This never reduces the capacity.
+     */
+    void reserve( uint32 capacity );
+
+    /**
+     * Gets an iterator at the start of the array.
+     */
+    Iterator begin();
+
+    /**
+     * Gets a constant iterator at the start of the array.
+     */
+    ConstIterator cbegin() const;
+
+    /**
+     * Gets an iterator at the end of the array.
+     */
+    Iterator end();
+
+    /**
+     * Gets a constant iterator at the end of the array.
+     */
+    ConstIterator cend() const;
+
+    /**
+     * Finds the index of the first occurrence of the value in the array.
+     *
+     * Returns (uint32)-1 if not found.
+     */
+    uint32 indexOf( const T& value ) const;
+
+    /**
+     * Checks if the array contains the given value.
+     */
+    bool has( const T& value ) const;
+
+    /**
+     * Gets the size of the array.
+     */
+    uint32 size() const;
+
+    /**
+     * Checks if the array is empty.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Gets the number of items the array can hold without reallocating.
+     */
+    uint32 capacity() const;
+
+    /**
+     * Checks if the items are stored inside of the array object.
+     */
+    bool isSmall() const;
+
+    /**
+     * Gets the memory footprint and occupancy of the array.
+     *
+     * The inline storage reserves no bytes.
+     */
+    ContainerStats stats() const;
+};
+
+// CONSTRUCTORS
+template <typename T, uint32 N>
+inline
+SmallArray<T, N>::SmallArray()
+    : _allocator(), _values( inlineValues() ), _size( 0 ), _capacity( N )
+{
+}
+
+template <typename T, uint32 N>
+inline
+SmallArray<T, N>::SmallArray( mem::IAllocator<T>* allocator )
+    : _allocator( allocator ), _values( inlineValues() ), _size( 0 ),
+      _capacity( N )
+{
+}
+
+template <typename T, uint32 N>
+SmallArray<T, N>::SmallArray( const SmallArray<T, N>& array )
+    : _allocator( array._allocator ), _values( inlineValues() ),
+      _size( array._size ), _capacity( N )
+{
+    if ( _size > N )
+    {
+        _capacity = array._capacity;
+        _values = _allocator.getRaw( _capacity );
+    }
+
+    mem::MemoryUtils::copyConstruct( _values, array._values, _size );
+}
+
+template <typename T, uint32 N>
+SmallArray<T, N>::SmallArray( SmallArray<T, N>&& array )
+    : _allocator( array._allocator ), _values( inlineValues() ),
+      _size( array._size ), _capacity( N )
+{
+    if ( array.isInline() )
+    {
+        mem::MemoryUtils::moveConstruct( _values, array._values, _size );
+        mem::MemoryUtils::destroy( array._values, _size );
+    }
+    else
+    {
+        _values = array._values;
+        _capacity = array._capacity;
+    }
+
+    array._values = array.inlineValues();
+    array._size = 0;
+    array._capacity = N;
+}
+
+template <typename T, uint32 N>
+inline
+SmallArray<T, N>::~SmallArray()
+{
+    release();
+}
+
+// OPERATORS
+template <typename T, uint32 N>
+SmallArray<T, N>& SmallArray<T, N>::operator=( const SmallArray<T, N>& array )
+{
+    if ( this == &array )
+    {
+        return *this;
+    }
+
+    release();
+
+    _allocator = array._allocator;
+    _size = array._size;
+    if ( _size > N )
+    {
+        _capacity = array._capacity;
+        _values = _allocator.getRaw( _capacity );
+    }
+
+    mem::MemoryUtils::copyConstruct( _values, array._values, _size );
+
+    return *this;
+}
+
+template <typename T, uint32 N>
+SmallArray<T, N>& SmallArray<T, N>::operator=( SmallArray<T, N>&& array )
+{
+    if ( this == &array )
+    {
+        return *this;
+    }
+
+    release();
+
+    _allocator = array._allocator;
+    _size = array._size;
+    if ( array.isInline() )
+    {
+        mem::MemoryUtils::moveConstruct( _values, array._values, _size );
+        mem::MemoryUtils::destroy( array._values, _size );
+    }
+    else
+    {
+        _values = array._values;
+        _capacity = array._capacity;
+    }
+
+    array._values = array.inlineValues();
+    array._size = 0;
+    array._capacity = N;
+
+    return *this;
+}
+
+template <typename T, uint32 N>
+inline
+const T& SmallArray<T, N>::operator[]( uint32 index ) const
+{
+    assert( index < _size );
+    return _values[index];
+}
+
+template <typename T, uint32 N>
+inline
+T& SmallArray<T, N>::operator[]( uint32 index )
+{
+    assert( index < _size );
+    return _values[index];
+}
+
+// MEMBER FUNCTIONS
+template <typename T, uint32 N>
+inline
+T& SmallArray<T, N>::at( uint32 index ) const
+{
+    if ( index >= _size )
+    {
+        throw std::runtime_error( "Index is out of bounds!" );
+    }
+
+    return _values[index];
+}
+
+template <typename T, uint32 N>
+inline
+void SmallArray<T, N>::push( const T& value )
+{
+    if ( shouldGrow() )
+    {
+        resize( _capacity << 1 );
+    }
+
+    new ( _values + _size ) T( value );
+    ++_size;
+}
+
+template <typename T, uint32 N>
+inline
+void SmallArray<T, N>::push( T&& value )
+{
+    if ( shouldGrow() )
+    {
+        resize( _capacity << 1 );
+    }
+
+    new ( _values + _size ) T( std::move( value ) );
+    ++_size;
+}
+
+template <typename T, uint32 N>
+inline
+void SmallArray<T, N>::pushFront( const T& value )
+{
+    insertAt( 0, value );
+}
+
+template <typename T, uint32 N>
+inline
+void SmallArray<T, N>::pushFront( T&& value )
+{
+    insertAt( 0, std::move( value ) );
+}
+
+template <typename T, uint32 N>
+void SmallArray<T, N>::insertAt( uint32 index, const T& value )
+{
+    if ( index > _size )
+    {
+        throw std::runtime_error( "Index is out of bounds!" );
+    }
+
+    if ( shouldGrow() )
+    {
+        resize( _capacity << 1 );
+    }
+
+    if ( index == _size )
+    {
+        new ( _values + _size ) T( value );
+    }
+    else
+    {
+        shiftForward( index );
+        _values[index] = value;
+    }
+
+    ++_size;
+}
+
+template <typename T, uint32 N>
+void SmallArray<T, N>::insertAt( uint32 index, T&& value )
+{
+    if ( index > _size )
+    {
+        throw std::runtime_error( "Index is out of bounds!" );
+    }
+
+    if ( shouldGrow() )
+    {
+        resize( _capacity << 1 );
+    }
+
+    if ( index == _size )
+    {
+        new ( _values + _size ) T( std::move( value ) );
+    }
+    else
+    {
+        shiftForward( index );
+        _values[index] = std::move( value );
+    }
+
+    ++_size;
+}
+
+template <typename T, uint32 N>
+T SmallArray<T, N>::pop()
+{
+    assert( _size > 0 );
+
+    T elem = std::move( _values[_size - 1] );
+    _values[_size - 1].~T();
+    --_size;
+
+    if ( shouldShrink() )
+    {
+        resize( _capacity >> 1 );
+    }
+
+    return elem;
+}
+
+template <typename T, uint32 N>
+inline
+T SmallArray<T, N>::popFront()
+{
+    assert( _size > 0 );
+    return removeAt( 0 );
+}
+
+template <typename T, uint32 N>
+T SmallArray<T, N>::removeAt( uint32 index )
+{
+    if ( index >= _size )
+    {
+        throw std::runtime_error( "Index is out of bounds!" );
+    }
+
+    T elem = std::move( _values[index] );
+    shiftBackward( index );
+    _values[_size - 1].~T();
+    --_size;
+
+    if ( shouldShrink() )
+    {
+        resize( _capacity >> 1 );
+    }
+
+    return elem;
+}
+
+template <typename T, uint32 N>
+inline
+bool SmallArray<T, N>::remove( const T& value )
+{
+    const uint32 index = indexOf( value );
+    if ( index == static_cast<uint32>( -1 ) )
+    {
+        return false;
+    }
+
+    removeAt( index );
+    return true;
+}
+
+template <typename T, uint32 N>
+inline
+void SmallArray<T, N>::clear()
+{
+    release();
+}
+
+template <typename T, uint32 N>
+void SmallArray<T, N>::reserve( uint32 capacity )
+{
+    uint32 newCapacity = _capacity;
+    while ( newCapacity < capacity )
+    {
+        newCapacity <<= 1;
+    }
+
+    if ( newCapacity != _capacity )
+    {
+        resize( newCapacity );
+    }
+}
+
+template <typename T, uint32 N>
+inline
+typename SmallArray<T, N>::Iterator SmallArray<T, N>::begin()
+{
+    return _values;
+}
+
+template <typename T, uint32 N>
+inline
+typename SmallArray<T, N>::ConstIterator SmallArray<T, N>::cbegin() const
+{
+    return _values;
+}
+
+template <typename T, uint32 N>
+inline
+typename SmallArray<T, N>::Iterator SmallArray<T, N>::end()
+{
+    return _values + _size;
+}
+
+template <typename T, uint32 N>
+inline
+typename SmallArray<T, N>::ConstIterator SmallArray<T, N>::cend() const
+{
+    return _values + _size;
+}
+
+template <typename T, uint32 N>
+uint32 SmallArray<T, N>::indexOf( const T& value ) const
+{
+    uint32 i;
+    for ( i = 0; i < _size; ++i )
+    {
+        if ( _values[i] == value )
+        {
+            return i;
+        }
+    }
+
+    return static_cast<uint32>( -1 );
+}
+
+template <typename T, uint32 N>
+inline
+bool SmallArray<T, N>::has( const T& value ) const
+{
+    return indexOf( value ) != static_cast<uint32>( -1 );
+}
+
+template <typename T, uint32 N>
+inline
+uint32 SmallArray<T, N>::size() const
+{
+    return _size;
+}
+
+template <typename T, uint32 N>
+inline
+bool SmallArray<T, N>::isEmpty() const
+{
+    return _size == 0;
+}
+
+template <typename T, uint32 N>
+inline
+uint32 SmallArray<T, N>::capacity() const
+{
+    return _capacity;
+}
+
+template <typename T, uint32 N>
+inline
+bool SmallArray<T, N>::isSmall() const
+{
+    return isInline();
+}
+
+template <typename T, uint32 N>
+inline
+ContainerStats SmallArray<T, N>::stats() const
+{
+    ContainerStats stats;
+    stats.size = _size;
+    stats.capacity = _capacity;
+    stats.bytesUsed = static_cast<uint64>( _size ) * sizeof( T );
+    stats.bytesReserved = isInline()
+        ? 0 : static_cast<uint64>( _capacity ) * sizeof( T );
+
+    return stats;
+}
+
+// HELPER FUNCTIONS
+template <typename T, uint32 N>
+inline
+T* SmallArray<T, N>::inlineValues()
+{
+    return reinterpret_cast<T*>( _inline );
+}
+
+template <typename T, uint32 N>
+inline
+const T* SmallArray<T, N>::inlineValues() const
+{
+    return reinterpret_cast<const T*>( _inline );
+}
+
+template <typename T, uint32 N>
+inline
+bool SmallArray<T, N>::isInline() const
+{
+    return _values == inlineValues();
+}
+
+template <typename T, uint32 N>
+void SmallArray<T, N>::resize( uint32 newCapacity )
+{
+    assert( newCapacity >= _size );
+
+    T* oldValues = _values;
+    const uint32 oldCapacity = _capacity;
+    const bool wasInline = isInline();
+
+    if ( newCapacity <= N )
+    {
+        if ( wasInline )
+        {
+            return;
+        }
+
+        _values = inlineValues();
+        _capacity = N;
+    }
+    else
+    {
+        _values = _allocator.getRaw( newCapacity );
+        _capacity = newCapacity;
+    }
+
+    mem::MemoryUtils::moveConstruct( _values, oldValues, _size );
+    mem::MemoryUtils::destroy( oldValues, _size );
+
+    if ( !wasInline )
+    {
+        _allocator.releaseRaw( oldValues, oldCapacity );
+    }
+}
+
+template <typename T, uint32 N>
+void SmallArray<T, N>::shiftForward( uint32 start )
+{
+    assert( start < _size );
+    assert( _size < _capacity );
+
+    // the slot past the last item is raw storage so the last item is move
+    // constructed into it and the rest are move assigned
+    new ( _values + _size ) T( std::move( _values[_size - 1] ) );
+    mem::MemoryUtils::moveBackward( _values + start + 1, _values + start,
+                                    _size - 1 - start );
+}
+
+template <typename T, uint32 N>
+void SmallArray<T, N>::shiftBackward( uint32 start )
+{
+    assert( start < _size );
+
+    mem::MemoryUtils::move( _values + start, _values + start + 1,
+                            _size - 1 - start );
+}
+
+template <typename T, uint32 N>
+inline
+bool SmallArray<T, N>::shouldGrow() const
+{
+    return _size >= _capacity;
+}
+
+template <typename T, uint32 N>
+inline
+bool SmallArray<T, N>::shouldShrink() const
+{
+    return !isInline() && _size <= ( _capacity >> 2 );
+}
+
+template <typename T, uint32 N>
+void SmallArray<T, N>::release()
+{
+    mem::MemoryUtils::destroy( _values, _size );
+
+    if ( !isInline() )
+    {
+        _allocator.releaseRaw( _values, _capacity );
+    }
+
+    _values = inlineValues();
+    _size = 0;
+    _capacity = N;
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif
@@ -0,0 +1,703 @@
+// sort_utils.h
+//
+// Defines in place sorting and binary searching for the engine's arrays.
+//
+// The functions work on any array with size() and operator[] such as
+// DynamicArray, FixedArray and SmallArray. They index the array directly so
+// a DynamicArray is sorted in its own block, wrap point included, without
+// copying the items out.
+//
+#ifndef NGE_CNTR_SORT_UTILS_H
+#define NGE_CNTR_SORT_UTILS_H
+
+#include <assert.h>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "engine/intdef.h"
+#include "engine/memory/default_allocator.h"
+#include "engine/memory/memory_utils.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+struct SortUtils
+{
+  private:
+    // CONSTANTS
+    /**
+     * Ranges up to this size are insertion sorted.
+     */
+    static constexpr uint32 INSERTION_SORT_SIZE = 16;
+
+    /**
+     * The number of bits a radix sort pass sorts by.
+     */
+    static constexpr uint32 RADIX_BITS = 8;
+
+    /**
+     * The number of buckets in a radix sort pass.
+     */
+    static constexpr uint32 RADIX_SIZE = 1 << RADIX_BITS;
+
+    // TYPES
+    /**
+     * Gets the item type of an array.
+     */
+    template <typename A>
+    struct Item
+    {
+        typedef typename std::remove_cv<typename std::remove_reference<
+            decltype( std::declval<A&>()[0] )>::type>::type Type;
+    };
+
+    /**
+     * Compares items with their less than operator.
+     */
+    struct Less
+    {
+        template <typename T, typename U>
+        bool operator()( const T& a, const U& b ) const;
+    };
+
+    /**
+     * Gets the item itself as its radix sort key.
+     */
+    struct Identity
+    {
+        template <typename T>
+        const T& operator()( const T& value ) const;
+    };
+
+    // HELPER FUNCTIONS
+    /**
+     * Insertion sorts the items from the start up to the end.
+     */
+    template <typename A, typename C>
+    static void insertionSort( A& array, uint32 start, uint32 end,
+                               C& less );
+
+    /**
+     * Heap sorts the items from the start up to the end.
+     */
+    template <typename A, typename C>
+    static void heapSort( A& array, uint32 start, uint32 end, C& less );
+
+    /**
+     * Moves the item at the given heap position down until the heap that
+     * starts at the given index is valid.
+     */
+    template <typename A, typename C>
+    static void siftDown( A& array, uint32 start, uint32 pos, uint32 count,
+                          C& less );
+
+    /**
+     * Partitions the items around the median of the first, middle and last
+     * items and gets the final index of the pivot.
+     *
+     * Behavior is undefined when:
+     * there are fewer than three items
+     */
+    template <typename A, typename C>
+    static uint32 partition( A& array, uint32 start, uint32 end, C& less );
+
+    /**
+     * Quick sorts the items, falling back to heap sort once the recursion
+     * gets too deep and insertion sort for small ranges.
+     */
+    template <typename A, typename C>
+    static void introSort( A& array, uint32 start, uint32 end, uint32 depth,
+                           C& less );
+
+    /**
+     * Merge sorts the items using the buffer for the left halves.
+     */
+    template <typename A, typename T, typename C>
+    static void mergeSort( A& array, uint32 start, uint32 end, T* buffer,
+                           C& less );
+
+  public:
+    /**
+     * Sorts the array with the given less than comparison.
+     *
+     * This is an introsort, it does not allocate and runs in O(n log n)
+     * time in the worst case. Equal items may be reordered.
+     */
+    template <typename A, typename C>
+    static void sort( A& array, C less );
+
+    /**
+     * Sorts the array in ascending order.
+     */
+    template <typename A>
+    static void sort( A& array );
+
+    /**
+     * Sorts the array with the given less than comparison keeping equal
+     * items in their original order.
+     *
+     * This is a merge sort that allocates a buffer for half of the array.
+     */
+    template <typename A, typename C>
+    static void stableSort( A& array, C less );
+
+    /**
+     * Sorts the array in ascending order keeping equal items in their
+     * original order.
+     */
+    template <typename A>
+    static void stableSort( A& array );
+
+    /**
+     * Sorts the array in ascending order of the integral key the function
+     * gets for each item.
+     *
+     * This is a stable least significant digit radix sort that allocates a
+     * buffer for the whole array. Passes over bytes that are the same for
+     * every key are skipped.
+     */
+    template <typename A, typename K>
+    static void radixSort( A& array, K key );
+
+    /**
+     * Sorts an array of integers in ascending order.
+     */
+    template <typename A>
+    static void radixSort( A& array );
+
+    /**
+     * Gets the index of the first item that is not less than the value.
+     *
+     * Gets the size of the array when every item is less.
+     *
+     * Behavior is undefined when:
+     * the array is not sorted by the comparison
+     */
+    template <typename A, typename T, typename C>
+    static uint32 lowerBound( const A& array, const T& value, C less );
+
+    /**
+     * Gets the index of the first item that is not less than the value.
+     */
+    template <typename A, typename T>
+    static uint32 lowerBound( const A& array, const T& value );
+
+    /**
+     * Gets the index of the first item that is greater than the value.
+     *
+     * Gets the size of the array when no item is greater.
+     *
+     * Behavior is undefined when:
+     * the array is not sorted by the comparison
+     */
+    template <typename A, typename T, typename C>
+    static uint32 upperBound( const A& array, const T& value, C less );
+
+    /**
+     * Gets the index of the first item that is greater than the value.
+     */
+    template <typename A, typename T>
+    static uint32 upperBound( const A& array, const T& value );
+
+    /**
+     * Finds the index of the first item equal to the value.
+     *
+     * Returns (uint32)-1 if not found.
+     *
+     * Behavior is undefined when:
+     * the array is not sorted by the comparison
+     */
+    template <typename A, typename T, typename C>
+    static uint32 binarySearch( const A& array, const T& value, C less );
+
+    /**
+     * Finds the index of the first item equal to the value.
+     *
+     * Returns (uint32)-1 if not found.
+     */
+    template <typename A, typename T>
+    static uint32 binarySearch( const A& array, const T& value );
+};
+
+// TYPES
+template <typename T, typename U>
+inline
+bool SortUtils::Less::operator()( const T& a, const U& b ) const
+{
+    return a < b;
+}
+
+template <typename T>
+inline
+const T& SortUtils::Identity::operator()( const T& value ) const
+{
+    return value;
+}
+
+// HELPER FUNCTIONS
+template <typename A, typename C>
+void SortUtils::insertionSort( A& array, uint32 start, uint32 end, C& less )
+{
+    typedef typename Item<A>::Type T;
+
+    uint32 i;
+    uint32 j;
+    for ( i = start + 1; i < end; ++i )
+    {
+        if ( !less( array[i], array[i - 1] ) )
+        {
+            continue;
+        }
+
+        T value = std::move( array[i] );
+        for ( j = i; j > start && less( value, array[j - 1] ); --j )
+        {
+            array[j] = std::move( array[j - 1] );
+        }
+
+        array[j] = std::move( value );
+    }
+}
+
+template <typename A, typename C>
+void SortUtils::heapSort( A& array, uint32 start, uint32 end, C& less )
+{
+    using std::swap;
+
+    const uint32 count = end - start;
+    uint32 i;
+
+    for ( i = count / 2; i > 0; --i )
+    {
+        siftDown( array, start, i - 1, count, less );
+    }
+
+    for ( i = count - 1; i > 0; --i )
+    {
+        swap( array[start], array[start + i] );
+        siftDown( array, start, 0, i, less );
+    }
+}
+
+template <typename A, typename C>
+void SortUtils::siftDown( A& array, uint32 start, uint32 pos, uint32 count,
+                          C& less )
+{
+    typedef typename Item<A>::Type T;
+
+    T value = std::move( array[start + pos] );
+    uint32 child;
+    for ( child = pos * 2 + 1; child < count; child = pos * 2 + 1 )
+    {
+        if ( child + 1 < count
+             && less( array[start + child], array[start + child + 1] ) )
+        {
+            ++child;
+        }
+
+        if ( !less( value, array[start + child] ) )
+        {
+            break;
+        }
+
+        array[start + pos] = std::move( array[start + child] );
+        pos = child;
+    }
+
+    array[start + pos] = std::move( value );
+}
+
+template <typename A, typename C>
+uint32 SortUtils::partition( A& array, uint32 start, uint32 end, C& less )
+{
+    using std::swap;
+
+    assert( end - start >= 3 );
+
+    // order the first, middle and last items so the first and last act as
+    // sentinels for the scans, then park the median just before the last
+    const uint32 middle = start + ( end - start ) / 2;
+    const uint32 last = end - 1;
+    if ( less( array[middle], array[start] ) )
+    {
+        swap( array[middle], array[start] );
+    }
+
+    if ( less( array[last], array[middle] ) )
+    {
+        swap( array[last], array[middle] );
+        if ( less( array[middle], array[start] ) )
+        {
+            swap( array[middle], array[start] );
+        }
+    }
+
+    const uint32 pivot = last - 1;
+    swap( array[middle], array[pivot] );
+
+    // stopping on items equal to the pivot keeps ranges full of duplicates
+    // balanced
+    uint32 i = start;
+    uint32 j = pivot;
+    while ( true )
+    {
+        while ( less( array[++i], array[pivot] ) )
+        {
+        }
+
+        while ( less( array[pivot], array[--j] ) )
+        {
+        }
+
+        if ( i >= j )
+        {
+            break;
+        }
+
+        swap( array[i], array[j] );
+    }
+
+    if ( i != pivot )
+    {
+        swap( array[i], array[pivot] );
+    }
+
+    return i;
+}
+
+template <typename A, typename C>
+void SortUtils::introSort( A& array, uint32 start, uint32 end, uint32 depth,
+                           C& less )
+{
+    while ( end - start > INSERTION_SORT_SIZE )
+    {
+        if ( depth == 0 )
+        {
+            heapSort( array, start, end, less );
+            return;
+        }
+
+        --depth;
+        const uint32 pivot = partition( array, start, end, less );
+
+        // recurse into the smaller side so the stack stays logarithmic
+        if ( pivot - start < end - pivot )
+        {
+            introSort( array, start, pivot, depth, less );
+            start = pivot + 1;
+        }
+        else
+        {
+            introSort( array, pivot + 1, end, depth, less );
+            end = pivot;
+        }
+    }
+
+    insertionSort( array, start, end, less );
+}
+
+template <typename A, typename T, typename C>
+void SortUtils::mergeSort( A& array, uint32 start, uint32 end, T* buffer,
+                           C& less )
+{
+    using namespace mem;
+
+    if ( end - start <= INSERTION_SORT_SIZE )
+    {
+        insertionSort( array, start, end, less );
+        return;
+    }
+
+    const uint32 middle = start + ( end - start ) / 2;
+    mergeSort( array, start, middle, buffer, less );
+    mergeSort( array, middle, end, buffer, less );
+
+    if ( !less( array[middle], array[middle - 1] ) )
+    {
+        return;
+    }
+
+    // move the left half out and merge it with the right half in place,
+    // taking from the left on ties keeps the sort stable
+    const uint32 leftCount = middle - start;
+    uint32 i;
+    for ( i = 0; i < leftCount; ++i )
+    {
+        new ( buffer + i ) T( std::move( array[start + i] ) );
+    }
+
+    uint32 left = 0;
+    uint32 right = middle;
+    uint32 out = start;
+    while ( left < leftCount && right < end )
+    {
+        if ( less( array[right], buffer[left] ) )
+        {
+            array[out++] = std::move( array[right++] );
+        }
+        else
+        {
+            array[out++] = std::move( buffer[left++] );
+        }
+    }
+
+    while ( left < leftCount )
+    {
+        array[out++] = std::move( buffer[left++] );
+    }
+
+    MemoryUtils::destroy( buffer, leftCount );
+}
+
+// MEMBER FUNCTIONS
+template <typename A, typename C>
+inline
+void SortUtils::sort( A& array, C less )
+{
+    const uint32 count = array.size();
+
+    uint32 depth = 0;
+    uint32 i;
+    for ( i = count; i > 1; i >>= 1 )
+    {
+        depth += 2;
+    }
+
+    introSort( array, 0, count, depth, less );
+}
+
+template <typename A>
+inline
+void SortUtils::sort( A& array )
+{
+    sort( array, Less() );
+}
+
+template <typename A, typename C>
+void SortUtils::stableSort( A& array, C less )
+{
+    typedef typename Item<A>::Type T;
+
+    const uint32 count = array.size();
+    if ( count <= INSERTION_SORT_SIZE )
+    {
+        insertionSort( array, 0, count, less );
+        return;
+    }
+
+    mem::DefaultAllocator<T> alloc;
+    T* buffer = alloc.getRaw( ( count + 1 ) / 2 );
+    mergeSort( array, 0, count, buffer, less );
+    alloc.releaseRaw( buffer, ( count + 1 ) / 2 );
+}
+
+template <typename A>
+inline
+void SortUtils::stableSort( A& array )
+{
+    stableSort( array, Less() );
+}
+
+template <typename A, typename K>
+void SortUtils::radixSort( A& array, K key )
+{
+    using namespace mem;
+
+    typedef typename Item<A>::Type T;
+    typedef typename std::remove_cv<typename std::remove_reference<
+        decltype( key( array[0] ) )>::type>::type Key;
+    typedef typename std::make_unsigned<Key>::type Bits;
+
+    static_assert( std::is_integral<Key>::value,
+                   "radix sort keys must be integral" );
+
+    constexpr uint32 PASSES = sizeof( Bits ) * 8 / RADIX_BITS;
+    const uint32 count = array.size();
+    if ( count <= 1 )
+    {
+        return;
+    }
+
+    // flipping the sign bit orders signed keys correctly as unsigned ones
+    const Bits flip = std::is_signed<Key>::value
+        ? static_cast<Bits>( Bits( 1 ) << ( sizeof( Bits ) * 8 - 1 ) )
+        : Bits( 0 );
+    auto digit = [&key, flip]( const T& item, uint32 pass ) {
+        const Bits bits = static_cast<Bits>( key( item ) ) ^ flip;
+        return static_cast<uint32>( bits >> ( pass * RADIX_BITS ) )
+            & ( RADIX_SIZE - 1 );
+    };
+
+    // count every digit of every pass up front in a single sweep
+    uint32 counts[PASSES][RADIX_SIZE] = {};
+    uint32 i;
+    uint32 pass;
+    for ( i = 0; i < count; ++i )
+    {
+        for ( pass = 0; pass < PASSES; ++pass )
+        {
+            ++counts[pass][digit( array[i], pass )];
+        }
+    }
+
+    DefaultAllocator<T> alloc;
+    T* buffer = alloc.getRaw( count );
+    bool isBufferLive = false;
+    bool isInBuffer = false;
+
+    for ( pass = 0; pass < PASSES; ++pass )
+    {
+        // a pass where every key has the same digit would not move anything
+        uint32 offsets[RADIX_SIZE];
+        uint32 total = 0;
+        uint32 bucket;
+        bool isTrivial = false;
+        for ( bucket = 0; bucket < RADIX_SIZE; ++bucket )
+        {
+            isTrivial = isTrivial || counts[pass][bucket] == count;
+            offsets[bucket] = total;
+            total += counts[pass][bucket];
+        }
+
+        if ( isTrivial )
+        {
+            continue;
+        }
+
+        // scatter back and forth between the array and the buffer
+        if ( isInBuffer )
+        {
+            for ( i = 0; i < count; ++i )
+            {
+                array[offsets[digit( buffer[i], pass )]++] =
+                    std::move( buffer[i] );
+            }
+        }
+        else if ( isBufferLive )
+        {
+            for ( i = 0; i < count; ++i )
+            {
+                buffer[offsets[digit( array[i], pass )]++] =
+                    std::move( array[i] );
+            }
+        }
+        else
+        {
+            for ( i = 0; i < count; ++i )
+            {
+                new ( buffer + offsets[digit( array[i], pass )]++ )
+                    T( std::move( array[i] ) );
+            }
+
+            isBufferLive = true;
+        }
+
+        isInBuffer = !isInBuffer;
+    }
+
+    if ( isInBuffer )
+    {
+        for ( i = 0; i < count; ++i )
+        {
+            array[i] = std::move( buffer[i] );
+        }
+    }
+
+    if ( isBufferLive )
+    {
+        MemoryUtils::destroy( buffer, count );
+    }
+
+    alloc.releaseRaw( buffer, count );
+}
+
+template <typename A>
+inline
+void SortUtils::radixSort( A& array )
+{
+    radixSort( array, Identity() );
+}
+
+template <typename A, typename T, typename C>
+uint32 SortUtils::lowerBound( const A& array, const T& value, C less )
+{
+    uint32 start = 0;
+    uint32 count = array.size();
+    while ( count > 0 )
+    {
+        const uint32 step = count / 2;
+        if ( less( array[start + step], value ) )
+        {
+            start += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    return start;
+}
+
+template <typename A, typename T>
+inline
+uint32 SortUtils::lowerBound( const A& array, const T& value )
+{
+    return lowerBound( array, value, Less() );
+}
+
+template <typename A, typename T, typename C>
+uint32 SortUtils::upperBound( const A& array, const T& value, C less )
+{
+    uint32 start = 0;
+    uint32 count = array.size();
+    while ( count > 0 )
+    {
+        const uint32 step = count / 2;
+        if ( !less( value, array[start + step] ) )
+        {
+            start += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    return start;
+}
+
+template <typename A, typename T>
+inline
+uint32 SortUtils::upperBound( const A& array, const T& value )
+{
+    return upperBound( array, value, Less() );
+}
+
+template <typename A, typename T, typename C>
+inline
+uint32 SortUtils::binarySearch( const A& array, const T& value, C less )
+{
+    const uint32 index = lowerBound( array, value, less );
+    return index < array.size() && !less( value, array[index] )
+        ? index : static_cast<uint32>( -1 );
+}
+
+template <typename A, typename T>
+inline
+uint32 SortUtils::binarySearch( const A& array, const T& value )
+{
+    return binarySearch( array, value, Less() );
+}
+
+} // End nspc cntr
+
+} // End nspc nge
+
+#endif
@@ -0,0 +1,221 @@
+// aligned_allocator.h
+//
+// Defines an allocator that over-aligns all of the storage it hands out.
+//
+// The containers only ask their allocator for storage that is aligned for
+// T. Wrapping the allocator of a container in an aligned allocator makes
+// every request go through getAligned instead, so the storage of a
+// DynamicArray of vectors or matrices can be loaded with aligned SIMD
+// instructions or kept on its own cache lines. For example:
+//
+//     AlignedAllocator<Vec4> alloc( 32 );
+//     DynamicArray<Vec4> positions( &alloc );
+//
+#ifndef NGE_MEM_ALIGNED_ALLOCATOR_H
+#define NGE_MEM_ALIGNED_ALLOCATOR_H
+
+#include <assert.h>
+
+#include "engine/intdef.h"
+#include "engine/memory/allocator_guard.h"
+#include "engine/memory/iallocator.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+template <typename T>
+class AlignedAllocator : public IAllocator<T>
+{
+  private:
+    // MEMBERS
+    /**
+     * The underlying allocator.
+     */
+    AllocatorGuard<T> _allocator;
+
+    /**
+     * The alignment of all of the storage.
+     */
+    uint32 _alignment;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs an allocator that aligns the storage of the default
+     * allocator to the given alignment.
+     *
+     * Behavior is undefined when:
+     * alignment is not a power of two
+     */
+    AlignedAllocator( uint32 alignment );
+
+    /**
+     * Constructs an allocator that aligns the storage of the given
+     * allocator to the given alignment.
+     *
+     * Behavior is undefined when:
+     * alignment is not a power of two
+     */
+    AlignedAllocator( IAllocator<T>* allocator, uint32 alignment );
+
+    /**
+     * Constructs a copy of the given allocator.
+     */
+    AlignedAllocator( const AlignedAllocator<T>& alloc );
+
+    /**
+     * Destructs the allocator.
+     */
+    virtual ~AlignedAllocator();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the given allocator.
+     */
+    AlignedAllocator<T>& operator=( const AlignedAllocator<T>& alloc );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates aligned storage for the given number of instances without
+     * constructing them.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * out of memory
+     */
+    virtual T* getRaw( uint32 count );
+
+    /**
+     * Releases storage from getRaw with the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer was not returned by getRaw
+     * any of the instances have not been destroyed
+     * count is less than or equal to zero
+     */
+    virtual void releaseRaw( T* pointer, uint32 count );
+
+    /**
+     * Allocates storage for the given number of instances without
+     * constructing them, aligned to the stricter of the given alignment and
+     * the alignment of the allocator.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * alignment is not a power of two
+     * out of memory
+     */
+    virtual T* getAligned( uint32 count, uint32 alignment );
+
+    /**
+     * Releases storage from getAligned with the given number of instances
+     * and alignment.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer was not returned by getAligned with the same alignment
+     * any of the instances have not been destroyed
+     * count is less than or equal to zero
+     */
+    virtual void releaseAligned( T* pointer, uint32 count, uint32 alignment );
+
+    // ACCESSOR FUNCTIONS
+    /**
+     * Gets the alignment of all of the storage.
+     */
+    uint32 alignment() const;
+};
+
+// CONSTRUCTORS
+template <typename T>
+inline
+AlignedAllocator<T>::AlignedAllocator( uint32 alignment )
+    : AlignedAllocator( nullptr, alignment )
+{
+}
+
+template <typename T>
+inline
+AlignedAllocator<T>::AlignedAllocator( IAllocator<T>* allocator,
+                                       uint32 alignment )
+    : _allocator( allocator ), _alignment( alignment )
+{
+    assert( alignment > 0 && ( alignment & ( alignment - 1 ) ) == 0 );
+}
+
+template <typename T>
+inline
+AlignedAllocator<T>::AlignedAllocator( const AlignedAllocator<T>& alloc )
+    : _allocator( alloc._allocator ), _alignment( alloc._alignment )
+{
+}
+
+template <typename T>
+inline
+AlignedAllocator<T>::~AlignedAllocator()
+{
+}
+
+// OPERATORS
+template <typename T>
+inline
+AlignedAllocator<T>& AlignedAllocator<T>::operator=(
+    const AlignedAllocator<T>& alloc )
+{
+    _allocator = alloc._allocator;
+    _alignment = alloc._alignment;
+
+    return *this;
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* AlignedAllocator<T>::getRaw( uint32 count )
+{
+    return _allocator.getAligned( count, _alignment );
+}
+
+template <typename T>
+inline
+void AlignedAllocator<T>::releaseRaw( T* pointer, uint32 count )
+{
+    _allocator.releaseAligned( pointer, count, _alignment );
+}
+
+template <typename T>
+inline
+T* AlignedAllocator<T>::getAligned( uint32 count, uint32 alignment )
+{
+    alignment = alignment > _alignment ? alignment : _alignment;
+    return _allocator.getAligned( count, alignment );
+}
+
+template <typename T>
+inline
+void AlignedAllocator<T>::releaseAligned( T* pointer, uint32 count,
+                                          uint32 alignment )
+{
+    alignment = alignment > _alignment ? alignment : _alignment;
+    _allocator.releaseAligned( pointer, count, alignment );
+}
+
+// ACCESSOR FUNCTIONS
+template <typename T>
+inline
+uint32 AlignedAllocator<T>::alignment() const
+{
+    return _alignment;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif
@@ -0,0 +1,261 @@
+// allocation_tracker.h
+//
+// Defines a heap profiler that records where and when memory is allocated.
+//
+// Tracking allocators report every allocation and release to a tracker
+// along with the tag of their call site, such as "scene.nodes" or
+// "path.open", and the number of bytes. The tracker keeps the totals,
+// live bytes and peak of each tag, and splits the counts into frames at
+// every call to endFrame so that the frames where allocations spike stand
+// out. The totals can be written as a readable report, and the frames as a
+// CSV or JSON timeline, to find the allocations on hot paths.
+//
+// The tracker is guarded by a mutex, so it adds a lock to every tracked
+// allocation and is meant for profiling rather than shipping builds. Its
+// own storage comes from the default allocator and is never tracked.
+//
+#ifndef NGE_MEM_ALLOCATION_TRACKER_H
+#define NGE_MEM_ALLOCATION_TRACKER_H
+
+#include <iosfwd>
+#include <mutex>
+
+#include "engine/intdef.h"
+#include "engine/containers/dynamic_array.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class AllocationTracker
+{
+  public:
+    // STRUCTURES
+    /**
+     * Defines the totals of one call site tag.
+     */
+    struct TagStats
+    {
+        /**
+         * The tag of the call site.
+         */
+        const char* tag;
+
+        /**
+         * The number of allocations.
+         */
+        uint64 allocationCount;
+
+        /**
+         * The number of releases.
+         */
+        uint64 releaseCount;
+
+        /**
+         * The number of bytes in all of the allocations.
+         */
+        uint64 bytesAllocated;
+
+        /**
+         * The number of bytes that are currently allocated.
+         */
+        uint64 bytesLive;
+
+        /**
+         * The most bytes that have been allocated at once.
+         */
+        uint64 peakBytesLive;
+    };
+
+    /**
+     * Defines the totals of one frame.
+     */
+    struct FrameStats
+    {
+        /**
+         * The index of the frame.
+         */
+        uint32 frame;
+
+        /**
+         * The number of allocations during the frame.
+         */
+        uint64 allocationCount;
+
+        /**
+         * The number of releases during the frame.
+         */
+        uint64 releaseCount;
+
+        /**
+         * The number of bytes allocated during the frame.
+         */
+        uint64 bytesAllocated;
+
+        /**
+         * The number of bytes that were allocated when the frame ended.
+         */
+        uint64 bytesLive;
+    };
+
+  private:
+    // MEMBERS
+    /**
+     * Guards the statistics.
+     */
+    mutable std::mutex _mutex;
+
+    /**
+     * The totals of each tag in the order they were first seen.
+     */
+    cntr::DynamicArray<TagStats> _tags;
+
+    /**
+     * The totals of every frame that has ended.
+     */
+    cntr::DynamicArray<FrameStats> _frames;
+
+    /**
+     * The totals of the frame in progress.
+     */
+    FrameStats _current;
+
+    /**
+     * The number of bytes that are currently allocated.
+     */
+    uint64 _bytesLive;
+
+    /**
+     * The most bytes that have been allocated at once.
+     */
+    uint64 _peakBytesLive;
+
+    // CONSTRUCTORS
+    /**
+     * Disabled: the statistics belong to a single tracker.
+     */
+    AllocationTracker( const AllocationTracker& tracker ) = delete;
+
+    // OPERATORS
+    /**
+     * Disabled: the statistics belong to a single tracker.
+     */
+    AllocationTracker& operator=( const AllocationTracker& tracker ) =
+        delete;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the totals of the tag, adding them if the tag is new.
+     */
+    TagStats& statsOf( const char* tag );
+
+    /**
+     * Writes the string as a quoted JSON string.
+     */
+    static void writeJsonString( std::ostream& out, const char* string );
+
+  public:
+    // GLOBAL FUNCTIONS
+    /**
+     * Gets the tracker shared by the whole engine.
+     */
+    static AllocationTracker& global();
+
+    // CONSTRUCTORS
+    /**
+     * Constructs a new tracker at the start of frame zero.
+     */
+    AllocationTracker();
+
+    /**
+     * Destructs the tracker.
+     */
+    ~AllocationTracker();
+
+    // MEMBER FUNCTIONS
+    /**
+     * Records an allocation of the given number of bytes.
+     *
+     * The tag is not copied, so it is usually a string literal.
+     *
+     * Behavior is undefined when:
+     * tag is null
+     * the tag is destroyed before the tracker
+     */
+    void recordAllocation( const char* tag, uint64 bytes );
+
+    /**
+     * Records a release of the given number of bytes.
+     *
+     * Behavior is undefined when:
+     * tag is null
+     * the bytes were not allocated under the tag
+     */
+    void recordRelease( const char* tag, uint64 bytes );
+
+    /**
+     * Ends the frame in progress, adding it to the timeline, and starts the
+     * next one.
+     */
+    void endFrame();
+
+    /**
+     * Clears every statistic and the timeline and starts over at frame
+     * zero.
+     *
+     * Allocations that are still live are forgotten, so this should only be
+     * called when nothing tracked is allocated.
+     */
+    void reset();
+
+    /**
+     * Replaces the contents of the array with the totals of every tag.
+     */
+    void snapshot( cntr::DynamicArray<TagStats>* tags ) const;
+
+    /**
+     * Replaces the contents of the array with the totals of every frame
+     * that has ended.
+     */
+    void timeline( cntr::DynamicArray<FrameStats>* frames ) const;
+
+    /**
+     * Writes a readable report of the totals of every tag, with the tags
+     * that allocated the most bytes first.
+     */
+    void writeReport( std::ostream& out ) const;
+
+    /**
+     * Writes the timeline as CSV with a header row and one row per frame.
+     */
+    void writeCsv( std::ostream& out ) const;
+
+    /**
+     * Writes the totals of every tag and the timeline as a JSON object.
+     */
+    void writeJson( std::ostream& out ) const;
+
+    // ACCESSOR FUNCTIONS
+    /**
+     * Gets the index of the frame in progress.
+     */
+    uint32 frame() const;
+
+    /**
+     * Gets the number of bytes that are currently allocated.
+     */
+    uint64 bytesLive() const;
+
+    /**
+     * Gets the most bytes that have been allocated at once.
+     */
+    uint64 peakBytesLive() const;
+};
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif
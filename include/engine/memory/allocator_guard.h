@@ -56,25 +56,51 @@ class AllocatorGuard : public IAllocator<T>
 
     // FREE OPERATORS
     /**
-     * Allocates the given number of instances.
+     * Allocates storage for the given number of instances without
+     * constructing them.
      *
      * Behavior is undefined when:
      * T is void
      * count is less than or equal to zero
      * out of memory
      */
-    virtual T* get( uint32 count );
+    virtual T* getRaw( uint32 count );
 
     /**
-     * Releases the allocation with the given number of instances.
+     * Releases storage from getRaw with the given number of instances.
      *
      * Behavior is undefined when:
      * T is void
-     * pointer is invalid
+     * pointer was not returned by getRaw
+     * any of the instances have not been destroyed
      * count is less than or equal to zero
+     */
+    virtual void releaseRaw( T* pointer, uint32 count );
+
+    /**
+     * Allocates storage for the given number of instances without
+     * constructing them, starting at an address that is a multiple of the
+     * given alignment.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * alignment is not a power of two
      * out of memory
      */
-    virtual void release( T* pointer, uint32 count );
+    virtual T* getAligned( uint32 count, uint32 alignment );
+
+    /**
+     * Releases storage from getAligned with the given number of instances
+     * and alignment.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer was not returned by getAligned with the same alignment
+     * any of the instances have not been destroyed
+     * count is less than or equal to zero
+     */
+    virtual void releaseAligned( T* pointer, uint32 count, uint32 alignment );
 
     /**
      * Gets the underlying allocator.
@@ -143,16 +169,31 @@ AllocatorGuard<T>& AllocatorGuard<T>::operator=(
 // MEMBER FUNCTIONS
 template <typename T>
 inline
-T* AllocatorGuard<T>::get( uint32 count )
+T* AllocatorGuard<T>::getRaw( uint32 count )
+{
+    return _allocator->getRaw( count );
+}
+
+template <typename T>
+inline
+void AllocatorGuard<T>::releaseRaw( T* pointer, uint32 count )
+{
+    _allocator->releaseRaw( pointer, count );
+}
+
+template <typename T>
+inline
+T* AllocatorGuard<T>::getAligned( uint32 count, uint32 alignment )
 {
-    return _allocator->get( count );
+    return _allocator->getAligned( count, alignment );
 }
 
 template <typename T>
 inline
-void AllocatorGuard<T>::release( T* pointer, uint32 count )
+void AllocatorGuard<T>::releaseAligned( T* pointer, uint32 count,
+                                        uint32 alignment )
 {
-    _allocator->release( pointer, count );
+    _allocator->releaseAligned( pointer, count, alignment );
 }
 
 template <typename T>
@@ -0,0 +1,272 @@
+// arena.h
+//
+// Defines a linear arena that hands out memory by bumping an offset.
+//
+// Memory comes from large blocks and is never given back one allocation at
+// a time. Instead everything is freed at once by reset, which makes the
+// arena a good fit for scratch data that only lives for a frame. When an
+// allocation does not fit in the current block a new block is added, and
+// the next reset merges the blocks into one big enough for the whole frame
+// so that a steady workload settles on a single block.
+//
+// The arena is not thread safe.
+//
+#ifndef NGE_MEM_ARENA_H
+#define NGE_MEM_ARENA_H
+
+#include <assert.h>
+
+#include "engine/intdef.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class Arena
+{
+  public:
+    // CONSTANTS
+    /**
+     * The default number of bytes in a block.
+     */
+    static constexpr uint32 DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+  private:
+    // CONSTANTS
+    /**
+     * The alignment the data of a block is padded to from its header.
+     */
+    static constexpr uint32 BLOCK_ALIGNMENT = 16;
+
+    // STRUCTURES
+    /**
+     * Defines the header at the start of every block.
+     */
+    struct Block
+    {
+        /**
+         * The block that was filled before this one.
+         */
+        Block* previous;
+
+        /**
+         * The number of bytes in the block after the header.
+         */
+        uint32 size;
+    };
+
+    /**
+     * The number of bytes taken up by a block header.
+     */
+    static constexpr uint32 HEADER_SIZE =
+        ( sizeof( Block ) + BLOCK_ALIGNMENT - 1 ) & ~( BLOCK_ALIGNMENT - 1 );
+
+    // MEMBERS
+    /**
+     * The block allocations are being carved from.
+     */
+    Block* _current;
+
+    /**
+     * The offset of the next free byte in the current block.
+     */
+    uint32 _offset;
+
+    /**
+     * The smallest number of bytes in a new block.
+     */
+    uint32 _blockSize;
+
+    /**
+     * The number of bytes handed out since the last reset, padding
+     * included.
+     */
+    uint32 _used;
+
+    /**
+     * The most bytes handed out between two resets.
+     */
+    uint32 _peak;
+
+    /**
+     * The number of bytes in all of the blocks.
+     */
+    uint32 _reserved;
+
+    /**
+     * The number of blocks.
+     */
+    uint32 _blockCount;
+
+    // CONSTRUCTORS
+    /**
+     * Disabled: allocations cannot be shared between arenas.
+     */
+    Arena( const Arena& arena ) = delete;
+
+    // OPERATORS
+    /**
+     * Disabled: allocations cannot be shared between arenas.
+     */
+    Arena& operator=( const Arena& arena ) = delete;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the first byte after the block's header.
+     */
+    static uint8* dataOf( Block* block );
+
+    /**
+     * Adds a block of at least the given number of bytes and makes it the
+     * current block.
+     */
+    void addBlock( uint32 size );
+
+    /**
+     * Releases every block.
+     */
+    void releaseBlocks();
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a new arena using the default block size.
+     *
+     * No memory is allocated until the first allocation.
+     */
+    Arena();
+
+    /**
+     * Constructs a new arena whose blocks are at least the given number of
+     * bytes.
+     *
+     * No memory is allocated until the first allocation.
+     *
+     * Behavior is undefined when:
+     * blockSize is zero
+     */
+    Arena( uint32 blockSize );
+
+    /**
+     * Destructs the arena and releases all of its memory.
+     */
+    ~Arena();
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of bytes with the given alignment.
+     *
+     * Behavior is undefined when:
+     * size is zero
+     * alignment is not a power of two
+     * out of memory
+     */
+    void* allocate( uint32 size, uint32 alignment );
+
+    /**
+     * Frees every allocation at once.
+     *
+     * Nothing is destroyed, so the arena must only hold instances that do
+     * not need their destructors run or that have already been destroyed.
+     * If more than one block was used the blocks are replaced by a single
+     * block that fits all of them.
+     */
+    void reset();
+
+    /**
+     * Gets the number of bytes handed out since the last reset.
+     */
+    uint32 bytesUsed() const;
+
+    /**
+     * Gets the most bytes handed out between two resets.
+     */
+    uint32 peakBytesUsed() const;
+
+    /**
+     * Gets the number of bytes in all of the blocks.
+     */
+    uint32 bytesReserved() const;
+
+    /**
+     * Gets the number of blocks.
+     */
+    uint32 blockCount() const;
+};
+
+// CONSTRUCTORS
+inline
+Arena::Arena() : Arena( DEFAULT_BLOCK_SIZE )
+{
+}
+
+// MEMBER FUNCTIONS
+inline
+void* Arena::allocate( uint32 size, uint32 alignment )
+{
+    assert( size > 0 );
+    assert( alignment > 0 && ( alignment & ( alignment - 1 ) ) == 0 );
+
+    uint32 padding = 0;
+    if ( _current != nullptr )
+    {
+        const uintptr_t next =
+            reinterpret_cast<uintptr_t>( dataOf( _current ) + _offset );
+        padding = static_cast<uint32>( -next & ( alignment - 1 ) );
+    }
+
+    if ( _current == nullptr ||
+         static_cast<uint64>( _offset ) + padding + size > _current->size )
+    {
+        addBlock( size + alignment - 1 );
+        const uintptr_t next =
+            reinterpret_cast<uintptr_t>( dataOf( _current ) );
+        padding = static_cast<uint32>( -next & ( alignment - 1 ) );
+    }
+
+    void* pointer = dataOf( _current ) + _offset + padding;
+    _offset += padding + size;
+    _used += padding + size;
+    _peak = _used > _peak ? _used : _peak;
+
+    return pointer;
+}
+
+inline
+uint32 Arena::bytesUsed() const
+{
+    return _used;
+}
+
+inline
+uint32 Arena::peakBytesUsed() const
+{
+    return _peak;
+}
+
+inline
+uint32 Arena::bytesReserved() const
+{
+    return _reserved;
+}
+
+inline
+uint32 Arena::blockCount() const
+{
+    return _blockCount;
+}
+
+// HELPER FUNCTIONS
+inline
+uint8* Arena::dataOf( Block* block )
+{
+    return reinterpret_cast<uint8*>( block ) + HEADER_SIZE;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif
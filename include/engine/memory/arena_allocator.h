@@ -0,0 +1,195 @@
+// arena_allocator.h
+//
+// Defines an allocator that carves typed allocations out of an arena.
+//
+// Releasing only runs the destructors of the instances. Their memory stays
+// in the arena until it is reset, usually once at the end of a frame, so
+// containers of per-frame scratch data never touch the global heap once the
+// arena has warmed up. Every container using the allocator must be cleared
+// or destroyed before the arena is reset.
+//
+#ifndef NGE_MEM_ARENA_ALLOCATOR_H
+#define NGE_MEM_ARENA_ALLOCATOR_H
+
+#include <assert.h>
+
+#include "engine/intdef.h"
+#include "engine/memory/arena.h"
+#include "engine/memory/iallocator.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+template <typename T>
+class ArenaAllocator : public IAllocator<T>
+{
+  private:
+    // MEMBERS
+    /**
+     * The arena the instances are carved from.
+     */
+    Arena* _arena;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs an allocator for the given arena.
+     *
+     * Behavior is undefined when:
+     * arena is null
+     */
+    ArenaAllocator( Arena* arena );
+
+    /**
+     * Constructs an allocator for the same arena as the given allocator.
+     */
+    ArenaAllocator( const ArenaAllocator<T>& alloc );
+
+    /**
+     * Destructs the allocator.
+     */
+    virtual ~ArenaAllocator();
+
+    // OPERATORS
+    /**
+     * Assigns this to allocate from the same arena as the given allocator.
+     */
+    ArenaAllocator<T>& operator=( const ArenaAllocator<T>& alloc );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates storage for the given number of instances without
+     * constructing them.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * out of memory
+     */
+    virtual T* getRaw( uint32 count );
+
+    /**
+     * Does nothing since the storage is reclaimed when the arena is reset.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer was not returned by getRaw
+     * count is less than or equal to zero
+     */
+    virtual void releaseRaw( T* pointer, uint32 count );
+
+    /**
+     * Allocates storage for the given number of instances without
+     * constructing them, starting at an address that is a multiple of the
+     * given alignment.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * alignment is not a power of two
+     * out of memory
+     */
+    virtual T* getAligned( uint32 count, uint32 alignment );
+
+    /**
+     * Does nothing since the storage is reclaimed when the arena is reset.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer was not returned by getAligned
+     * count is less than or equal to zero
+     */
+    virtual void releaseAligned( T* pointer, uint32 count, uint32 alignment );
+
+    /**
+     * Gets the arena the instances are carved from.
+     */
+    Arena* arena() const;
+};
+
+// CONSTRUCTORS
+template <typename T>
+inline
+ArenaAllocator<T>::ArenaAllocator( Arena* arena ) : _arena( arena )
+{
+    assert( arena != nullptr );
+}
+
+template <typename T>
+inline
+ArenaAllocator<T>::ArenaAllocator( const ArenaAllocator<T>& alloc )
+    : _arena( alloc._arena )
+{
+}
+
+template <typename T>
+inline
+ArenaAllocator<T>::~ArenaAllocator()
+{
+    _arena = nullptr;
+}
+
+// OPERATORS
+template <typename T>
+inline
+ArenaAllocator<T>& ArenaAllocator<T>::operator=(
+    const ArenaAllocator<T>& alloc )
+{
+    _arena = alloc._arena;
+
+    return *this;
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* ArenaAllocator<T>::getRaw( uint32 count )
+{
+    assert( count > 0 );
+
+    return static_cast<T*>(
+        _arena->allocate( sizeof( T ) * count, alignof( T ) ) );
+}
+
+template <typename T>
+inline
+void ArenaAllocator<T>::releaseRaw( T* pointer, uint32 count )
+{
+    assert( pointer != nullptr );
+    assert( count > 0 );
+}
+
+template <typename T>
+inline
+T* ArenaAllocator<T>::getAligned( uint32 count, uint32 alignment )
+{
+    assert( count > 0 );
+
+    alignment = alignment > alignof( T ) ? alignment : alignof( T );
+    return static_cast<T*>(
+        _arena->allocate( sizeof( T ) * count, alignment ) );
+}
+
+template <typename T>
+inline
+void ArenaAllocator<T>::releaseAligned( T* pointer, uint32 count, uint32 )
+{
+    assert( pointer != nullptr );
+    assert( count > 0 );
+}
+
+template <typename T>
+inline
+Arena* ArenaAllocator<T>::arena() const
+{
+    return _arena;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif
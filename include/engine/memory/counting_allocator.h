@@ -3,6 +3,7 @@
 #define NGE_MEM_COUNTING_ALLOCATOR_H
 
 #include <assert.h>
+#include <atomic>
 
 #include "engine/intdef.h"
 #include "engine/memory/allocator_guard.h"
@@ -20,8 +21,10 @@ class CountingAllocator : public IAllocator<T>
     // GLOBALS
     /**
      * Global instance count of type T.
+     *
+     * This is atomic since allocators of T may be used from any thread.
      */
-    static uint32 g_count;
+    static std::atomic<uint32> g_count;
 
     // MEMBERS
     /**
@@ -32,7 +35,7 @@ class CountingAllocator : public IAllocator<T>
     /**
      * Local instance count of type T.
      */
-    uint32 _count;
+    std::atomic<uint32> _count;
 
   public:
     // CONSTRUCTORS
@@ -68,26 +71,52 @@ class CountingAllocator : public IAllocator<T>
     CountingAllocator<T>& operator=( const CountingAllocator<T>& alloc );
 
     // MEMBER FUNCTIONS
-    /**
-     * Allocates the given number of instances.
-     *
-     * Behavior is undefined when:
-     * T is void
-     * count is less than or equal to zero
-     * out of memory
-     */
-     virtual T* get( uint32 count );
+     /**
+      * Allocates storage for the given number of instances without
+      * constructing them.
+      *
+      * Behavior is undefined when:
+      * T is void
+      * count is less than or equal to zero
+      * out of memory
+      */
+     virtual T* getRaw( uint32 count );
+
+     /**
+      * Releases storage from getRaw with the given number of instances.
+      *
+      * Behavior is undefined when:
+      * T is void
+      * pointer was not returned by getRaw
+      * any of the instances have not been destroyed
+      * count is less than or equal to zero
+      */
+     virtual void releaseRaw( T* pointer, uint32 count );
 
      /**
-      * Releases the allocation with the given number of instances.
+      * Allocates storage for the given number of instances without
+      * constructing them, starting at an address that is a multiple of the
+      * given alignment.
       *
       * Behavior is undefined when:
       * T is void
-      * pointer is invalid
       * count is less than or equal to zero
+      * alignment is not a power of two
       * out of memory
       */
-     virtual void release( T* pointer, uint32 count );
+     virtual T* getAligned( uint32 count, uint32 alignment );
+
+     /**
+      * Releases storage from getAligned with the given number of instances
+      * and alignment.
+      *
+      * Behavior is undefined when:
+      * T is void
+      * pointer was not returned by getAligned with the same alignment
+      * any of the instances have not been destroyed
+      * count is less than or equal to zero
+      */
+     virtual void releaseAligned( T* pointer, uint32 count, uint32 alignment );
 
      // ACCESSOR FUNCTIONS
      /**
@@ -104,7 +133,7 @@ class CountingAllocator : public IAllocator<T>
 
 // GLOBALS
 template <typename T>
-uint32 CountingAllocator<T>::g_count = 0;
+std::atomic<uint32> CountingAllocator<T>::g_count( 0 );
 
 // CONSTRUCTORS
 template <typename T>
@@ -150,19 +179,46 @@ CountingAllocator<T>& CountingAllocator<T>::operator=(
 // MEMBER FUNCTIONS
 template <typename T>
 inline
-T* CountingAllocator<T>::get( uint32 count )
+T* CountingAllocator<T>::getRaw( uint32 count )
+{
+    assert( count > 0 );
+
+    _count += count;
+    g_count += count;
+
+    return IAllocator<T>::getRaw( count );
+}
+
+template <typename T>
+inline
+void CountingAllocator<T>::releaseRaw( T* pointer, uint32 count )
+{
+    assert( pointer != nullptr );
+    assert( count > 0 );
+    assert( _count >= count );
+
+    _count -= count;
+    g_count -= count;
+
+    IAllocator<T>::releaseRaw( pointer, count );
+}
+
+template <typename T>
+inline
+T* CountingAllocator<T>::getAligned( uint32 count, uint32 alignment )
 {
     assert( count > 0 );
 
     _count += count;
     g_count += count;
 
-    return new T[count];
+    return IAllocator<T>::getAligned( count, alignment );
 }
 
 template <typename T>
 inline
-void CountingAllocator<T>::release(T* pointer, uint32 count)
+void CountingAllocator<T>::releaseAligned( T* pointer, uint32 count,
+                                           uint32 alignment )
 {
     assert( pointer != nullptr );
     assert( count > 0 );
@@ -171,7 +227,7 @@ void CountingAllocator<T>::release(T* pointer, uint32 count)
     _count -= count;
     g_count -= count;
 
-    delete[] pointer;
+    IAllocator<T>::releaseAligned( pointer, count, alignment );
 }
 
 // ACCESSOR FUNCTIONS
@@ -1,5 +1,6 @@
 // default_allocator.h
-// The default allocator is a simple wrapper for the new and delete functions.
+// The default allocator is a simple wrapper for the global operator new and
+// delete functions.
 #ifndef NGE_MEM_DEFAULT_ALLOCATOR_H
 #define NGE_MEM_DEFAULT_ALLOCATOR_H
 
@@ -38,28 +39,6 @@ class DefaultAllocator : public IAllocator<T>
      * Assigns a copy of an allocator.
      */
     DefaultAllocator<T>& operator =( const DefaultAllocator<T>& assign );
-
-    // MEMBER FUNCTIONS
-    /**
-     * Allocates the given number of instances.
-     *
-     * Behavior is undefined when:
-     * T is void
-     * count is less than or equal to zero
-     * out of memory
-     */
-    virtual T* get( uint32 count );
-
-    /**
-     * Releases the allocation with the given number of instances.
-     *
-     * Behavior is undefined when:
-     * T is void
-     * pointer is invalid
-     * count is less than or equal to zero
-     * out of memory
-     */
-    virtual void release( T* pointer, uint32 count );
 };
 
 //CONSTRUCTORS
@@ -90,25 +69,6 @@ DefaultAllocator<T>& DefaultAllocator<T>::operator =(
     return *this;
 }
 
-// MEMBER FUNCTIONS
-template<typename T>
-inline
-T* DefaultAllocator<T>::get( uint32 count )
-{
-    assert( count > 0 );
-    return new T[count];
-}
-
-template<typename T>
-inline
-void DefaultAllocator<T>::release( T* pointer, uint32 count )
-{
-    assert( count > 0 );
-    assert( pointer != nullptr );
-
-    delete[] pointer;
-}
-
 } // End nspc mem
 
 } // End nspc nge
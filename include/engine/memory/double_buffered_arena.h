@@ -0,0 +1,161 @@
+// double_buffered_arena.h
+//
+// Defines a pair of arenas that take turns so data can live for two frames.
+//
+// Data made this frame comes from the current arena. Flipping at the end of
+// the frame makes it the previous arena, where it stays readable for the
+// whole next frame, and resets the other arena to become current. This
+// suits results that are produced one frame and consumed the next, such as
+// render commands built by the simulation and drawn a frame later.
+//
+// Allocators should be made for the current arena each frame since an
+// ArenaAllocator keeps allocating from the same arena after a flip.
+//
+#ifndef NGE_MEM_DOUBLE_BUFFERED_ARENA_H
+#define NGE_MEM_DOUBLE_BUFFERED_ARENA_H
+
+#include "engine/intdef.h"
+#include "engine/memory/arena.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class DoubleBufferedArena
+{
+  private:
+    // MEMBERS
+    /**
+     * The first of the arenas.
+     */
+    Arena _first;
+
+    /**
+     * The second of the arenas.
+     */
+    Arena _second;
+
+    /**
+     * The arena that allocations for this frame come from.
+     */
+    Arena* _current;
+
+    /**
+     * The arena that holds the data of the last frame.
+     */
+    Arena* _previous;
+
+    // CONSTRUCTORS
+    /**
+     * Disabled: allocations cannot be shared between arenas.
+     */
+    DoubleBufferedArena( const DoubleBufferedArena& arena ) = delete;
+
+    // OPERATORS
+    /**
+     * Disabled: allocations cannot be shared between arenas.
+     */
+    DoubleBufferedArena& operator=( const DoubleBufferedArena& arena ) =
+        delete;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a new pair of arenas using the default block size.
+     */
+    DoubleBufferedArena();
+
+    /**
+     * Constructs a new pair of arenas whose blocks are at least the given
+     * number of bytes.
+     *
+     * Behavior is undefined when:
+     * blockSize is zero
+     */
+    DoubleBufferedArena( uint32 blockSize );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Frees the data of the previous frame and makes its arena current.
+     *
+     * The data of the frame that just ended stays valid until the next
+     * flip.
+     */
+    void flip();
+
+    /**
+     * Gets the arena that allocations for this frame come from.
+     */
+    Arena& current();
+
+    /**
+     * Gets the arena that allocations for this frame come from.
+     */
+    const Arena& current() const;
+
+    /**
+     * Gets the arena that holds the data of the last frame.
+     */
+    Arena& previous();
+
+    /**
+     * Gets the arena that holds the data of the last frame.
+     */
+    const Arena& previous() const;
+};
+
+// CONSTRUCTORS
+inline
+DoubleBufferedArena::DoubleBufferedArena()
+    : DoubleBufferedArena( Arena::DEFAULT_BLOCK_SIZE )
+{
+}
+
+inline
+DoubleBufferedArena::DoubleBufferedArena( uint32 blockSize )
+    : _first( blockSize ), _second( blockSize ), _current( &_first ),
+      _previous( &_second )
+{
+}
+
+// MEMBER FUNCTIONS
+inline
+void DoubleBufferedArena::flip()
+{
+    Arena* ended = _current;
+    _current = _previous;
+    _previous = ended;
+    _current->reset();
+}
+
+inline
+Arena& DoubleBufferedArena::current()
+{
+    return *_current;
+}
+
+inline
+const Arena& DoubleBufferedArena::current() const
+{
+    return *_current;
+}
+
+inline
+Arena& DoubleBufferedArena::previous()
+{
+    return *_previous;
+}
+
+inline
+const Arena& DoubleBufferedArena::previous() const
+{
+    return *_previous;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif
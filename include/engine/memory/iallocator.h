@@ -1,7 +1,28 @@
 // iallocator.h
+//
+// Defines the interface that the containers allocate their storage through.
+//
+// Allocators only implement the raw storage functions. The get and release
+// functions construct and destroy instances in storage from getRaw and
+// releaseRaw. They are not virtual, so they are only compiled when called.
+// An allocator of a type without a default constructor can still hand out
+// raw storage, while calling get with it fails to compile.
+//
+// Storage from get and getRaw is aligned for T. Storage that needs a larger
+// alignment, such as vectors and matrices that are loaded with aligned SIMD
+// instructions, comes from getAligned. The default implementation serves
+// alignments beyond what the global operator new guarantees by
+// over-allocating and keeping the original pointer just in front of the
+// aligned address.
+//
 #ifndef NGE_MEM_IALLOCATOR_H
 #define NGE_MEM_IALLOCATOR_H
 
+#include <assert.h>
+#include <new>
+#include <stddef.h>
+#include <type_traits>
+
 #include "engine/intdef.h"
 
 namespace nge
@@ -13,6 +34,27 @@ namespace mem
 template <typename T>
 class IAllocator
 {
+  protected:
+    // HELPER FUNCTIONS
+    /**
+     * Allocates the given number of bytes at an address that is a multiple
+     * of the given alignment.
+     *
+     * Behavior is undefined when:
+     * alignment is not a power of two
+     * out of memory
+     */
+    static void* alignedNew( uint64 bytes, uint32 alignment );
+
+    /**
+     * Frees bytes from alignedNew that were allocated with the given
+     * alignment.
+     *
+     * Behavior is undefined when:
+     * pointer was not returned by alignedNew with the same alignment
+     */
+    static void alignedDelete( void* pointer, uint32 alignment );
+
   public:
     // CONSTRUCTORS
     /**
@@ -22,25 +64,83 @@ class IAllocator
 
     // MEMBER FUNCTIONS
     /**
-     * Allocates the given number of instances.
+     * Allocates and default constructs the given number of instances in
+     * storage from getRaw.
+     *
+     * This fails to compile when T is not default constructible. If a
+     * constructor throws, the instances that were constructed are destroyed
+     * and the storage is released before the exception is passed on.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * out of memory
+     */
+    T* get( uint32 count );
+
+    /**
+     * Destroys the instances from get and releases their storage through
+     * releaseRaw.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer was not returned by get
+     * count is less than or equal to zero
+     */
+    void release( T* pointer, uint32 count );
+
+    /**
+     * Allocates storage for the given number of instances without
+     * constructing them.
+     *
+     * The caller constructs and destroys the instances. The default
+     * implementation uses the global operator new.
      *
      * Behavior is undefined when:
      * T is void
      * count is less than or equal to zero
      * out of memory
      */
-    virtual T* get( uint32 count ) = 0;
+    virtual T* getRaw( uint32 count );
+
+    /**
+     * Releases storage from getRaw with the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer was not returned by getRaw
+     * any of the instances have not been destroyed
+     * count is less than or equal to zero
+     */
+    virtual void releaseRaw( T* pointer, uint32 count );
 
     /**
-     * Releases the allocation with the given number of instances.
+     * Allocates storage for the given number of instances without
+     * constructing them, starting at an address that is a multiple of the
+     * given alignment.
+     *
+     * The storage is never aligned less strictly than T requires. The
+     * default implementation uses alignedNew.
      *
      * Behavior is undefined when:
      * T is void
-     * pointer is invalid
      * count is less than or equal to zero
+     * alignment is not a power of two
      * out of memory
      */
-    virtual void release( T* pointer, uint32 count ) = 0;
+    virtual T* getAligned( uint32 count, uint32 alignment );
+
+    /**
+     * Releases storage from getAligned with the given number of instances
+     * and alignment.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer was not returned by getAligned with the same alignment
+     * any of the instances have not been destroyed
+     * count is less than or equal to zero
+     */
+    virtual void releaseAligned( T* pointer, uint32 count, uint32 alignment );
 };
 
 // CONSTRUCTORS
@@ -50,6 +150,132 @@ IAllocator<T>::~IAllocator()
 {
 }
 
+// HELPER FUNCTIONS
+template <typename T>
+inline
+void* IAllocator<T>::alignedNew( uint64 bytes, uint32 alignment )
+{
+    assert( alignment > 0 && ( alignment & ( alignment - 1 ) ) == 0 );
+
+    if ( alignment <= alignof( max_align_t ) )
+    {
+        return ::operator new( static_cast<size_t>( bytes ) );
+    }
+
+    // reserve enough to find an aligned address with room for the original
+    // pointer in front of it
+    void* block = ::operator new(
+        static_cast<size_t>( bytes ) + alignment - 1 + sizeof( void* ) );
+    const uintptr_t start =
+        reinterpret_cast<uintptr_t>( block ) + sizeof( void* );
+    void** pointer = reinterpret_cast<void**>(
+        ( start + alignment - 1 ) & ~static_cast<uintptr_t>( alignment - 1 ) );
+    pointer[-1] = block;
+
+    return pointer;
+}
+
+template <typename T>
+inline
+void IAllocator<T>::alignedDelete( void* pointer, uint32 alignment )
+{
+    assert( pointer != nullptr );
+
+    if ( alignment <= alignof( max_align_t ) )
+    {
+        ::operator delete( pointer );
+        return;
+    }
+
+    ::operator delete( static_cast<void**>( pointer )[-1] );
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* IAllocator<T>::get( uint32 count )
+{
+    static_assert( std::is_default_constructible<T>::value,
+                   "get needs a default constructible T, use getRaw" );
+    assert( count > 0 );
+
+    T* pointer = getRaw( count );
+    uint32 i = 0;
+    try
+    {
+        for ( ; i < count; ++i )
+        {
+            new ( pointer + i ) T();
+        }
+    }
+    catch ( ... )
+    {
+        while ( i > 0 )
+        {
+            pointer[--i].~T();
+        }
+        releaseRaw( pointer, count );
+        throw;
+    }
+
+    return pointer;
+}
+
+template <typename T>
+inline
+void IAllocator<T>::release( T* pointer, uint32 count )
+{
+    assert( pointer != nullptr );
+    assert( count > 0 );
+
+    uint32 i;
+    for ( i = 0; i < count; ++i )
+    {
+        pointer[i].~T();
+    }
+    releaseRaw( pointer, count );
+}
+
+template <typename T>
+inline
+T* IAllocator<T>::getRaw( uint32 count )
+{
+    assert( count > 0 );
+    return static_cast<T*>( alignedNew( sizeof( T ) * count, alignof( T ) ) );
+}
+
+template <typename T>
+inline
+void IAllocator<T>::releaseRaw( T* pointer, uint32 count )
+{
+    assert( count > 0 );
+    assert( pointer != nullptr );
+
+    alignedDelete( pointer, alignof( T ) );
+}
+
+template <typename T>
+inline
+T* IAllocator<T>::getAligned( uint32 count, uint32 alignment )
+{
+    assert( count > 0 );
+
+    alignment = alignment > alignof( T ) ? alignment : alignof( T );
+    return static_cast<T*>( alignedNew( sizeof( T ) * count, alignment ) );
+}
+
+template <typename T>
+inline
+void IAllocator<T>::releaseAligned( T* pointer, uint32 count,
+                                    uint32 alignment )
+{
+    assert( count > 0 );
+    assert( pointer != nullptr );
+
+    alignment = alignment > alignof( T ) ? alignment : alignof( T );
+    alignedDelete( pointer, alignment );
+}
+
 } // End nspc mem
 
 } // End nspc nge
@@ -2,6 +2,9 @@
 #ifndef NGE_MEM_MEMORY_UTILS_H
 #define NGE_MEM_MEMORY_UTILS_H
 
+#include <cstring>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 #include "engine/intdef.h"
@@ -14,19 +17,145 @@ namespace mem
 
 struct MemoryUtils
 {
+  private:
+    // HELPER FUNCTIONS
+    /**
+     * Copies items one at a time.
+     */
+    template <typename T>
+    static void copy( T* dst, const T* src, uint32 count, std::false_type );
+
+    /**
+     * Copies trivially copyable items in a single block.
+     */
+    template <typename T>
+    static void copy( T* dst, const T* src, uint32 count, std::true_type );
+
+    /**
+     * Moves items one at a time from the first to the last.
+     */
+    template <typename T>
+    static void move( T* dst, T* src, uint32 count, std::false_type );
+
+    /**
+     * Moves items one at a time from the last to the first.
+     */
+    template <typename T>
+    static void moveBackward( T* dst, T* src, uint32 count,
+                              std::false_type );
+
+    /**
+     * Moves trivially copyable items in a single block.
+     */
+    template <typename T>
+    static void move( T* dst, T* src, uint32 count, std::true_type );
+
+    /**
+     * Moves trivially copyable items in a single block.
+     */
+    template <typename T>
+    static void moveBackward( T* dst, T* src, uint32 count, std::true_type );
+
+    /**
+     * Copy constructs items one at a time.
+     */
+    template <typename T>
+    static void copyConstruct( T* dst, const T* src, uint32 count,
+                               std::false_type );
+
+    /**
+     * Copy constructs trivially copyable items in a single block.
+     */
+    template <typename T>
+    static void copyConstruct( T* dst, const T* src, uint32 count,
+                               std::true_type );
+
+    /**
+     * Move constructs items one at a time.
+     */
+    template <typename T>
+    static void moveConstruct( T* dst, T* src, uint32 count,
+                               std::false_type );
+
+    /**
+     * Move constructs trivially copyable items in a single block.
+     */
+    template <typename T>
+    static void moveConstruct( T* dst, T* src, uint32 count,
+                               std::true_type );
+
+    /**
+     * Destroys items one at a time.
+     */
+    template <typename T>
+    static void destroy( T* ptr, uint32 count, std::false_type );
+
+    /**
+     * Does nothing for trivially destructible items.
+     */
+    template <typename T>
+    static void destroy( T* ptr, uint32 count, std::true_type );
+
   public:
     /**
      * Copies items from the source to the destination.
+     *
+     * Trivially copyable items are copied with a single memcpy.
+     *
+     * Behavior is undefined when:
+     * the source and destination overlap
      */
     template <typename T>
-    static void copy( T* dst, T* src, uint32 count );
+    static void copy( T* dst, const T* src, uint32 count );
 
     /**
      * Moves items from the source to the destination.
+     *
+     * Trivially copyable items are moved with a single memmove. Other items
+     * are moved from the first to the last, so the ranges may overlap when
+     * the destination comes before the source.
      */
     template <typename T>
     static void move( T* dst, T* src, uint32 count );
 
+    /**
+     * Moves items from the source to the destination starting with the last
+     * item.
+     *
+     * Trivially copyable items are moved with a single memmove. The ranges
+     * may overlap when the destination comes after the source.
+     */
+    template <typename T>
+    static void moveBackward( T* dst, T* src, uint32 count );
+
+    /**
+     * Copy constructs items in uninitialized destination storage from the
+     * source.
+     *
+     * Behavior is undefined when:
+     * the source and destination overlap
+     * the destination holds live items
+     */
+    template <typename T>
+    static void copyConstruct( T* dst, const T* src, uint32 count );
+
+    /**
+     * Move constructs items in uninitialized destination storage from the
+     * source. The source items are left alive in a moved from state.
+     *
+     * Behavior is undefined when:
+     * the source and destination overlap
+     * the destination holds live items
+     */
+    template <typename T>
+    static void moveConstruct( T* dst, T* src, uint32 count );
+
+    /**
+     * Destroys the items, leaving their storage uninitialized.
+     */
+    template <typename T>
+    static void destroy( T* ptr, uint32 count );
+
     /**
      * Sets the all of the values in the array to the given value.
      */
@@ -34,8 +163,10 @@ struct MemoryUtils
     static void set( T* ptr, const T& value, uint32 count );
 };
 
+// HELPER FUNCTIONS
 template <typename T>
-void MemoryUtils::copy( T* dst, T* src, uint32 count )
+inline
+void MemoryUtils::copy( T* dst, const T* src, uint32 count, std::false_type )
 {
     uint32 i;
     for ( i = 0; i < count; ++i )
@@ -45,7 +176,18 @@ void MemoryUtils::copy( T* dst, T* src, uint32 count )
 }
 
 template <typename T>
-void MemoryUtils::move( T* dst, T* src, uint32 count )
+inline
+void MemoryUtils::copy( T* dst, const T* src, uint32 count, std::true_type )
+{
+    if ( count > 0 )
+    {
+        std::memcpy( dst, src, count * sizeof( T ) );
+    }
+}
+
+template <typename T>
+inline
+void MemoryUtils::move( T* dst, T* src, uint32 count, std::false_type )
 {
     uint32 i;
     for ( i = 0; i < count; ++i )
@@ -54,6 +196,140 @@ void MemoryUtils::move( T* dst, T* src, uint32 count )
     }
 }
 
+template <typename T>
+inline
+void MemoryUtils::moveBackward( T* dst, T* src, uint32 count,
+                                std::false_type )
+{
+    uint32 i;
+    for ( i = count; i > 0; --i )
+    {
+        dst[i - 1] = std::move( src[i - 1] );
+    }
+}
+
+template <typename T>
+inline
+void MemoryUtils::move( T* dst, T* src, uint32 count, std::true_type )
+{
+    if ( count > 0 )
+    {
+        std::memmove( dst, src, count * sizeof( T ) );
+    }
+}
+
+template <typename T>
+inline
+void MemoryUtils::moveBackward( T* dst, T* src, uint32 count,
+                                std::true_type )
+{
+    move( dst, src, count, std::true_type() );
+}
+
+template <typename T>
+inline
+void MemoryUtils::copyConstruct( T* dst, const T* src, uint32 count,
+                                 std::false_type )
+{
+    uint32 i;
+    for ( i = 0; i < count; ++i )
+    {
+        new ( dst + i ) T( src[i] );
+    }
+}
+
+template <typename T>
+inline
+void MemoryUtils::copyConstruct( T* dst, const T* src, uint32 count,
+                                 std::true_type )
+{
+    copy( dst, src, count, std::true_type() );
+}
+
+template <typename T>
+inline
+void MemoryUtils::moveConstruct( T* dst, T* src, uint32 count,
+                                 std::false_type )
+{
+    uint32 i;
+    for ( i = 0; i < count; ++i )
+    {
+        new ( dst + i ) T( std::move( src[i] ) );
+    }
+}
+
+template <typename T>
+inline
+void MemoryUtils::moveConstruct( T* dst, T* src, uint32 count,
+                                 std::true_type )
+{
+    copy( dst, src, count, std::true_type() );
+}
+
+template <typename T>
+inline
+void MemoryUtils::destroy( T* ptr, uint32 count, std::false_type )
+{
+    uint32 i;
+    for ( i = 0; i < count; ++i )
+    {
+        ptr[i].~T();
+    }
+}
+
+template <typename T>
+inline
+void MemoryUtils::destroy( T*, uint32, std::true_type )
+{
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+void MemoryUtils::copy( T* dst, const T* src, uint32 count )
+{
+    copy( dst, src, count, typename std::is_trivially_copyable<T>::type() );
+}
+
+template <typename T>
+inline
+void MemoryUtils::move( T* dst, T* src, uint32 count )
+{
+    move( dst, src, count, typename std::is_trivially_copyable<T>::type() );
+}
+
+template <typename T>
+inline
+void MemoryUtils::moveBackward( T* dst, T* src, uint32 count )
+{
+    moveBackward( dst, src, count,
+                  typename std::is_trivially_copyable<T>::type() );
+}
+
+template <typename T>
+inline
+void MemoryUtils::copyConstruct( T* dst, const T* src, uint32 count )
+{
+    copyConstruct( dst, src, count,
+                   typename std::is_trivially_copyable<T>::type() );
+}
+
+template <typename T>
+inline
+void MemoryUtils::moveConstruct( T* dst, T* src, uint32 count )
+{
+    moveConstruct( dst, src, count,
+                   typename std::is_trivially_copyable<T>::type() );
+}
+
+template <typename T>
+inline
+void MemoryUtils::destroy( T* ptr, uint32 count )
+{
+    destroy( ptr, count,
+             typename std::is_trivially_destructible<T>::type() );
+}
+
 template <typename T>
 void MemoryUtils::set( T* ptr, const T& value, uint32 count )
 {
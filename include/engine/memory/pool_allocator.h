@@ -0,0 +1,422 @@
+// pool_allocator.h
+//
+// Defines an allocator that hands out single instances from pooled chunks.
+//
+// Each chunk is an array of slots that are each large enough for one T.
+// Free slots are linked through their own storage, so getting or releasing
+// an instance is a pointer pop or push that never touches the global heap
+// once the pool has grown. Chunks are only freed when the pool is
+// destroyed.
+//
+// Only single instances are pooled. Requests for more than one instance,
+// like the arrays of the containers, are passed on to the fallback
+// allocator, as are requests for a stricter alignment than the slots have.
+// The allocator counts its live instances like the counting allocator does.
+// It is not thread safe.
+//
+#ifndef NGE_MEM_POOL_ALLOCATOR_H
+#define NGE_MEM_POOL_ALLOCATOR_H
+
+#include <assert.h>
+#include <new>
+#include <type_traits>
+
+#include "engine/intdef.h"
+#include "engine/memory/allocator_guard.h"
+#include "engine/memory/iallocator.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+template <typename T>
+class PoolAllocator : public IAllocator<T>
+{
+  public:
+    // CONSTANTS
+    /**
+     * The default number of slots in a chunk.
+     */
+    static constexpr uint32 DEFAULT_CHUNK_SIZE = 64;
+
+  private:
+    // STRUCTURES
+    /**
+     * Defines a slot that holds an instance or links to the next free slot.
+     */
+    union Slot
+    {
+        /**
+         * The next free slot, or the previous chunk in the first slot of a
+         * chunk.
+         */
+        Slot* next;
+
+        /**
+         * The storage for the instance.
+         */
+        typename std::aligned_storage<sizeof( T ), alignof( T )>::type item;
+    };
+
+    // MEMBERS
+    /**
+     * The allocator for requests of more than one instance.
+     */
+    AllocatorGuard<T> _fallback;
+
+    /**
+     * The first free slot.
+     */
+    Slot* _free;
+
+    /**
+     * The most recently allocated chunk.
+     */
+    Slot* _chunks;
+
+    /**
+     * The number of slots in a chunk.
+     */
+    uint32 _chunkSize;
+
+    /**
+     * The number of slots in all of the chunks.
+     */
+    uint32 _capacity;
+
+    /**
+     * The number of instances currently allocated.
+     */
+    uint32 _count;
+
+    // CONSTRUCTORS
+    /**
+     * Disabled: instances cannot be shared between pools.
+     */
+    PoolAllocator( const PoolAllocator<T>& alloc ) = delete;
+
+    // OPERATORS
+    /**
+     * Disabled: instances cannot be shared between pools.
+     */
+    PoolAllocator<T>& operator=( const PoolAllocator<T>& alloc ) = delete;
+
+    // HELPER FUNCTIONS
+    /**
+     * Allocates a chunk and adds its slots to the free list.
+     */
+    void addChunk();
+
+    /**
+     * Takes a slot off of the free list.
+     */
+    T* pop();
+
+    /**
+     * Puts the slot back on the free list.
+     */
+    void push( T* pointer );
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a pool using the default chunk size and allocator.
+     */
+    PoolAllocator();
+
+    /**
+     * Constructs a pool whose chunks hold the given number of instances.
+     *
+     * Behavior is undefined when:
+     * chunkSize is zero
+     */
+    PoolAllocator( uint32 chunkSize );
+
+    /**
+     * Constructs a pool that passes requests for more than one instance to
+     * the given allocator.
+     */
+    PoolAllocator( IAllocator<T>* fallback );
+
+    /**
+     * Constructs a pool whose chunks hold the given number of instances and
+     * that passes requests for more than one instance to the given
+     * allocator.
+     *
+     * Behavior is undefined when:
+     * chunkSize is zero
+     */
+    PoolAllocator( IAllocator<T>* fallback, uint32 chunkSize );
+
+    /**
+     * Destructs the pool and frees its chunks.
+     */
+    virtual ~PoolAllocator();
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates storage for the given number of instances without
+     * constructing them.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * out of memory
+     */
+    virtual T* getRaw( uint32 count );
+
+    /**
+     * Releases storage from getRaw with the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer was not returned by getRaw
+     * any of the instances have not been destroyed
+     * count is less than or equal to zero
+     */
+    virtual void releaseRaw( T* pointer, uint32 count );
+
+    /**
+     * Allocates storage for the given number of instances without
+     * constructing them, starting at an address that is a multiple of the
+     * given alignment.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * alignment is not a power of two
+     * out of memory
+     */
+    virtual T* getAligned( uint32 count, uint32 alignment );
+
+    /**
+     * Releases storage from getAligned with the given number of instances
+     * and alignment.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer was not returned by getAligned with the same alignment
+     * any of the instances have not been destroyed
+     * count is less than or equal to zero
+     */
+    virtual void releaseAligned( T* pointer, uint32 count, uint32 alignment );
+
+    /**
+     * Adds chunks until at least the given number of instances are pooled.
+     */
+    void reserve( uint32 capacity );
+
+    // ACCESSOR FUNCTIONS
+    /**
+     * Gets the number of instances that are currently allocated.
+     */
+    uint32 getAllocationCount() const;
+
+    /**
+     * Gets the number of slots in all of the chunks.
+     */
+    uint32 capacity() const;
+};
+
+// CONSTANTS
+template <typename T>
+constexpr uint32 PoolAllocator<T>::DEFAULT_CHUNK_SIZE;
+
+// CONSTRUCTORS
+template <typename T>
+inline
+PoolAllocator<T>::PoolAllocator()
+    : PoolAllocator( nullptr, DEFAULT_CHUNK_SIZE )
+{
+}
+
+template <typename T>
+inline
+PoolAllocator<T>::PoolAllocator( uint32 chunkSize )
+    : PoolAllocator( nullptr, chunkSize )
+{
+}
+
+template <typename T>
+inline
+PoolAllocator<T>::PoolAllocator( IAllocator<T>* fallback )
+    : PoolAllocator( fallback, DEFAULT_CHUNK_SIZE )
+{
+}
+
+template <typename T>
+inline
+PoolAllocator<T>::PoolAllocator( IAllocator<T>* fallback, uint32 chunkSize )
+    : _fallback( fallback ), _free( nullptr ), _chunks( nullptr ),
+      _chunkSize( chunkSize ), _capacity( 0 ), _count( 0 )
+{
+    assert( chunkSize > 0 );
+}
+
+template <typename T>
+inline
+PoolAllocator<T>::~PoolAllocator()
+{
+    // check for memory leak
+    assert( _count <= 0 );
+
+    Slot* previous;
+    while ( _chunks != nullptr )
+    {
+        previous = _chunks->next;
+        IAllocator<T>::alignedDelete( _chunks, alignof( Slot ) );
+        _chunks = previous;
+    }
+}
+
+// HELPER FUNCTIONS
+template <typename T>
+inline
+void PoolAllocator<T>::addChunk()
+{
+    // the first slot links the chunks together, and new Slot[] would only
+    // align the chunk as well as operator new aligns before C++17
+    Slot* chunk = static_cast<Slot*>( IAllocator<T>::alignedNew(
+        static_cast<uint64>( sizeof( Slot ) ) * ( _chunkSize + 1 ),
+        alignof( Slot ) ) );
+    chunk->next = _chunks;
+    _chunks = chunk;
+
+    uint32 i;
+    for ( i = _chunkSize; i > 0; --i )
+    {
+        chunk[i].next = _free;
+        _free = chunk + i;
+    }
+
+    _capacity += _chunkSize;
+}
+
+template <typename T>
+inline
+T* PoolAllocator<T>::pop()
+{
+    if ( _free == nullptr )
+    {
+        addChunk();
+    }
+
+    Slot* slot = _free;
+    _free = slot->next;
+    ++_count;
+
+    return reinterpret_cast<T*>( &slot->item );
+}
+
+template <typename T>
+inline
+void PoolAllocator<T>::push( T* pointer )
+{
+    assert( _count > 0 );
+
+    Slot* slot = reinterpret_cast<Slot*>( pointer );
+    slot->next = _free;
+    _free = slot;
+    --_count;
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* PoolAllocator<T>::getRaw( uint32 count )
+{
+    assert( count > 0 );
+
+    if ( count > 1 )
+    {
+        _count += count;
+        return _fallback.getRaw( count );
+    }
+
+    return pop();
+}
+
+template <typename T>
+inline
+void PoolAllocator<T>::releaseRaw( T* pointer, uint32 count )
+{
+    assert( pointer != nullptr );
+    assert( count > 0 );
+    assert( _count >= count );
+
+    if ( count > 1 )
+    {
+        _count -= count;
+        _fallback.releaseRaw( pointer, count );
+        return;
+    }
+
+    push( pointer );
+}
+
+template <typename T>
+inline
+T* PoolAllocator<T>::getAligned( uint32 count, uint32 alignment )
+{
+    assert( count > 0 );
+
+    if ( count > 1 || alignment > alignof( Slot ) )
+    {
+        _count += count;
+        return _fallback.getAligned( count, alignment );
+    }
+
+    return pop();
+}
+
+template <typename T>
+inline
+void PoolAllocator<T>::releaseAligned( T* pointer, uint32 count,
+                                       uint32 alignment )
+{
+    assert( pointer != nullptr );
+    assert( count > 0 );
+    assert( _count >= count );
+
+    if ( count > 1 || alignment > alignof( Slot ) )
+    {
+        _count -= count;
+        _fallback.releaseAligned( pointer, count, alignment );
+        return;
+    }
+
+    push( pointer );
+}
+
+template <typename T>
+inline
+void PoolAllocator<T>::reserve( uint32 capacity )
+{
+    while ( _capacity < capacity )
+    {
+        addChunk();
+    }
+}
+
+// ACCESSOR FUNCTIONS
+template <typename T>
+inline
+uint32 PoolAllocator<T>::getAllocationCount() const
+{
+    return _count;
+}
+
+template <typename T>
+inline
+uint32 PoolAllocator<T>::capacity() const
+{
+    return _capacity;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif
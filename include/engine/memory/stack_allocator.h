@@ -0,0 +1,199 @@
+// stack_allocator.h
+//
+// Defines a last in first out allocator over a single fixed buffer.
+//
+// Allocating bumps the top of the stack and nothing is freed on its own.
+// Instead a marker of the top is taken before a group of allocations and
+// the stack is rewound to it afterwards, freeing the whole group at once.
+// Markers nest, so a function can take its own marker while its caller's
+// temporaries are still live. A StackMarker rewinds at the end of a scope
+// so nested temporary buffers in math or pathfinding code cost a pointer
+// bump and are freed in bulk when the scope exits.
+//
+// Unlike an arena the buffer never grows, so pointers stay valid until the
+// stack is rewound past them. The allocator is not thread safe.
+//
+#ifndef NGE_MEM_STACK_ALLOCATOR_H
+#define NGE_MEM_STACK_ALLOCATOR_H
+
+#include <assert.h>
+
+#include "engine/intdef.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class StackAllocator
+{
+  public:
+    // TYPES
+    /**
+     * The top of the stack at the time a marker was taken.
+     */
+    typedef uint32 Marker;
+
+  private:
+    // MEMBERS
+    /**
+     * The buffer allocations are carved from.
+     */
+    uint8* _buffer;
+
+    /**
+     * The number of bytes in the buffer.
+     */
+    uint32 _capacity;
+
+    /**
+     * The offset of the next free byte in the buffer.
+     */
+    uint32 _top;
+
+    /**
+     * The highest the top of the stack has been.
+     */
+    uint32 _peak;
+
+    // CONSTRUCTORS
+    /**
+     * Disabled: allocations cannot be shared between stacks.
+     */
+    StackAllocator( const StackAllocator& stack ) = delete;
+
+    // OPERATORS
+    /**
+     * Disabled: allocations cannot be shared between stacks.
+     */
+    StackAllocator& operator=( const StackAllocator& stack ) = delete;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a new stack with a buffer of the given number of bytes.
+     *
+     * Behavior is undefined when:
+     * capacity is zero
+     * out of memory
+     */
+    StackAllocator( uint32 capacity );
+
+    /**
+     * Destructs the stack and releases its buffer.
+     */
+    ~StackAllocator();
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of bytes with the given alignment on top
+     * of the stack.
+     *
+     * Behavior is undefined when:
+     * size is zero
+     * alignment is not a power of two
+     * the stack does not have room for the allocation
+     */
+    void* allocate( uint32 size, uint32 alignment );
+
+    /**
+     * Gets a marker of the current top of the stack.
+     */
+    Marker mark() const;
+
+    /**
+     * Frees every allocation that was made after the marker was taken.
+     *
+     * Nothing is destroyed, so the freed allocations must only hold
+     * instances that do not need their destructors run or that have already
+     * been destroyed.
+     *
+     * Behavior is undefined when:
+     * the stack was already rewound past the marker
+     */
+    void rewindTo( Marker marker );
+
+    /**
+     * Frees every allocation at once.
+     */
+    void reset();
+
+    // ACCESSOR FUNCTIONS
+    /**
+     * Gets the number of bytes that are allocated, padding included.
+     */
+    uint32 bytesUsed() const;
+
+    /**
+     * Gets the most bytes that have been allocated at once.
+     */
+    uint32 peakBytesUsed() const;
+
+    /**
+     * Gets the number of bytes in the buffer.
+     */
+    uint32 capacity() const;
+};
+
+// MEMBER FUNCTIONS
+inline
+void* StackAllocator::allocate( uint32 size, uint32 alignment )
+{
+    assert( size > 0 );
+    assert( alignment > 0 && ( alignment & ( alignment - 1 ) ) == 0 );
+
+    const uintptr_t next = reinterpret_cast<uintptr_t>( _buffer + _top );
+    const uint32 padding = static_cast<uint32>( -next & ( alignment - 1 ) );
+    assert( static_cast<uint64>( _top ) + padding + size <= _capacity );
+
+    void* pointer = _buffer + _top + padding;
+    _top += padding + size;
+    _peak = _top > _peak ? _top : _peak;
+
+    return pointer;
+}
+
+inline
+StackAllocator::Marker StackAllocator::mark() const
+{
+    return _top;
+}
+
+inline
+void StackAllocator::rewindTo( Marker marker )
+{
+    assert( marker <= _top );
+    _top = marker;
+}
+
+inline
+void StackAllocator::reset()
+{
+    _top = 0;
+}
+
+// ACCESSOR FUNCTIONS
+inline
+uint32 StackAllocator::bytesUsed() const
+{
+    return _top;
+}
+
+inline
+uint32 StackAllocator::peakBytesUsed() const
+{
+    return _peak;
+}
+
+inline
+uint32 StackAllocator::capacity() const
+{
+    return _capacity;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif
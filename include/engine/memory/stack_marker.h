@@ -0,0 +1,163 @@
+// stack_marker.h
+//
+// Defines a guard that rewinds a stack allocator at the end of a scope.
+//
+// The guard takes a marker of the stack when it is constructed and rewinds
+// the stack to it when it is destructed, so everything allocated from the
+// stack in between is freed in bulk. Guards must be destructed in the
+// reverse order they were constructed in, which scopes do naturally.
+//
+#ifndef NGE_MEM_STACK_MARKER_H
+#define NGE_MEM_STACK_MARKER_H
+
+#include <assert.h>
+
+#include "engine/intdef.h"
+#include "engine/memory/stack_allocator.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+class StackMarker
+{
+  private:
+    // MEMBERS
+    /**
+     * The stack that is rewound.
+     */
+    StackAllocator* _stack;
+
+    /**
+     * The top of the stack when the guard was constructed.
+     */
+    StackAllocator::Marker _marker;
+
+    // CONSTRUCTORS
+    /**
+     * Disabled: the stack must only be rewound once.
+     */
+    StackMarker( const StackMarker& marker ) = delete;
+
+    // OPERATORS
+    /**
+     * Disabled: the stack must only be rewound once.
+     */
+    StackMarker& operator=( const StackMarker& marker ) = delete;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a guard that rewinds the stack to its current top.
+     *
+     * Behavior is undefined when:
+     * stack is null
+     */
+    StackMarker( StackAllocator* stack );
+
+    /**
+     * Moves the guard to this instance.
+     */
+    StackMarker( StackMarker&& marker );
+
+    /**
+     * Destructs the guard and rewinds the stack.
+     */
+    ~StackMarker();
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates the given number of bytes with the given alignment from the
+     * guarded stack.
+     *
+     * Behavior is undefined when:
+     * the guard was moved from
+     * size is zero
+     * alignment is not a power of two
+     * the stack does not have room for the allocation
+     */
+    void* allocate( uint32 size, uint32 alignment );
+
+    /**
+     * Frees everything allocated since the guard was constructed while
+     * keeping the guard.
+     *
+     * Behavior is undefined when:
+     * the guard was moved from
+     */
+    void rewind();
+
+    // ACCESSOR FUNCTIONS
+    /**
+     * Gets the stack that is rewound, or null if the guard was moved from.
+     */
+    StackAllocator* stack() const;
+
+    /**
+     * Gets the top of the stack when the guard was constructed.
+     */
+    StackAllocator::Marker marker() const;
+};
+
+// CONSTRUCTORS
+inline
+StackMarker::StackMarker( StackAllocator* stack )
+    : _stack( stack ), _marker( 0 )
+{
+    assert( stack != nullptr );
+    _marker = stack->mark();
+}
+
+inline
+StackMarker::StackMarker( StackMarker&& marker )
+    : _stack( marker._stack ), _marker( marker._marker )
+{
+    marker._stack = nullptr;
+    marker._marker = 0;
+}
+
+inline
+StackMarker::~StackMarker()
+{
+    if ( _stack != nullptr )
+    {
+        _stack->rewindTo( _marker );
+        _stack = nullptr;
+    }
+}
+
+// MEMBER FUNCTIONS
+inline
+void* StackMarker::allocate( uint32 size, uint32 alignment )
+{
+    assert( _stack != nullptr );
+    return _stack->allocate( size, alignment );
+}
+
+inline
+void StackMarker::rewind()
+{
+    assert( _stack != nullptr );
+    _stack->rewindTo( _marker );
+}
+
+// ACCESSOR FUNCTIONS
+inline
+StackAllocator* StackMarker::stack() const
+{
+    return _stack;
+}
+
+inline
+StackAllocator::Marker StackMarker::marker() const
+{
+    return _marker;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif
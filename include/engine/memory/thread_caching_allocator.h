@@ -0,0 +1,573 @@
+// thread_caching_allocator.h
+//
+// Defines an allocator that keeps a cache of free blocks on every thread.
+//
+// Requests for up to MAX_CACHED_COUNT instances are rounded up to a power of
+// two size class. Each thread keeps a free list per size class and only
+// takes the shared pool's lock to move a batch of blocks at a time, taking
+// a batch when its list runs dry and giving one back when its list grows
+// past two batches. Most allocations are therefore a pop from a thread
+// local list that no other thread touches, so throughput scales with the
+// number of threads instead of queueing on the heap's lock.
+//
+// The caches and the shared pool belong to T rather than to an allocator,
+// so blocks can be released through any allocator of T on any thread. A
+// thread's cache goes back to the shared pool when the thread exits, and
+// the shared pool frees its blocks when the program ends. Larger requests
+// go straight to the global operator new, as do over-aligned types and
+// requests for a stricter alignment than the global operator new
+// guarantees.
+//
+#ifndef NGE_MEM_THREAD_CACHING_ALLOCATOR_H
+#define NGE_MEM_THREAD_CACHING_ALLOCATOR_H
+
+#include <assert.h>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <stddef.h>
+
+#include "engine/intdef.h"
+#include "engine/memory/iallocator.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+template <typename T>
+class ThreadCachingAllocator : public IAllocator<T>
+{
+  public:
+    // CONSTANTS
+    /**
+     * The largest number of instances that is served from the caches.
+     */
+    static constexpr uint32 MAX_CACHED_COUNT = 256;
+
+    /**
+     * The number of blocks moved between a thread and the shared pool at
+     * once.
+     */
+    static constexpr uint32 BATCH_SIZE = 32;
+
+  private:
+    // CONSTANTS
+    /**
+     * The number of size classes, one per power of two up to
+     * MAX_CACHED_COUNT.
+     */
+    static constexpr uint32 CLASS_COUNT = 9;
+
+    /**
+     * The size class of requests that are not cached.
+     */
+    static constexpr uint32 NO_CLASS = static_cast<uint32>( -1 );
+
+    // STRUCTURES
+    /**
+     * Defines the link stored in a free block.
+     */
+    struct Block
+    {
+        Block* next;
+    };
+
+    /**
+     * Defines the free blocks shared by every thread.
+     */
+    struct SharedPool
+    {
+        /**
+         * Guards the free lists.
+         */
+        std::mutex mutex;
+
+        /**
+         * The free list of each size class.
+         */
+        Block* heads[CLASS_COUNT];
+
+        /**
+         * Constructs empty free lists.
+         */
+        SharedPool();
+
+        /**
+         * Frees every block.
+         */
+        ~SharedPool();
+    };
+
+    /**
+     * Defines the free blocks of one thread.
+     */
+    struct ThreadCache
+    {
+        /**
+         * The free list of each size class.
+         */
+        Block* heads[CLASS_COUNT];
+
+        /**
+         * The length of each free list.
+         */
+        uint32 lengths[CLASS_COUNT];
+
+        /**
+         * Constructs empty free lists.
+         */
+        ThreadCache();
+
+        /**
+         * Gives every block back to the shared pool.
+         */
+        ~ThreadCache();
+    };
+
+    // MEMBERS
+    /**
+     * The number of instances currently allocated.
+     */
+    std::atomic<uint32> _count;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the pool shared by every thread.
+     */
+    static SharedPool& sharedPool();
+
+    /**
+     * Gets the cache of the calling thread.
+     */
+    static ThreadCache& threadCache();
+
+    /**
+     * Gets the size class of a request for the given number of instances.
+     *
+     * Returns NO_CLASS if the request is not cached.
+     */
+    static uint32 classOf( uint32 count );
+
+    /**
+     * Gets the number of bytes in a block of the size class.
+     */
+    static uint32 bytesOf( uint32 sizeClass );
+
+    /**
+     * Moves a batch of blocks of the size class from the shared pool to the
+     * cache, or allocates a block if the pool has none.
+     */
+    static void refill( ThreadCache& cache, uint32 sizeClass );
+
+    /**
+     * Moves a batch of blocks of the size class from the cache to the
+     * shared pool.
+     */
+    static void flush( ThreadCache& cache, uint32 sizeClass );
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs the allocator.
+     */
+    ThreadCachingAllocator();
+
+    /**
+     * Constructs a copy of an allocator.
+     *
+     * This does not retain the allocation count.
+     */
+    ThreadCachingAllocator( const ThreadCachingAllocator<T>& alloc );
+
+    /**
+     * Destructs the allocator.
+     */
+    virtual ~ThreadCachingAllocator();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the allocator.
+     *
+     * This does not retain the allocation count.
+     */
+    ThreadCachingAllocator<T>& operator=(
+        const ThreadCachingAllocator<T>& alloc );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates storage for the given number of instances without
+     * constructing them.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * out of memory
+     */
+    virtual T* getRaw( uint32 count );
+
+    /**
+     * Releases storage from getRaw with the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer was not returned by getRaw
+     * any of the instances have not been destroyed
+     * count is less than or equal to zero
+     */
+    virtual void releaseRaw( T* pointer, uint32 count );
+
+    /**
+     * Allocates storage for the given number of instances without
+     * constructing them, starting at an address that is a multiple of the
+     * given alignment.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * alignment is not a power of two
+     * out of memory
+     */
+    virtual T* getAligned( uint32 count, uint32 alignment );
+
+    /**
+     * Releases storage from getAligned with the given number of instances
+     * and alignment.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer was not returned by getAligned with the same alignment
+     * any of the instances have not been destroyed
+     * count is less than or equal to zero
+     */
+    virtual void releaseAligned( T* pointer, uint32 count, uint32 alignment );
+
+    // ACCESSOR FUNCTIONS
+    /**
+     * Gets the number of instances that are currently allocated through
+     * this allocator.
+     */
+    uint32 getAllocationCount() const;
+};
+
+// CONSTANTS
+template <typename T>
+constexpr uint32 ThreadCachingAllocator<T>::MAX_CACHED_COUNT;
+
+template <typename T>
+constexpr uint32 ThreadCachingAllocator<T>::BATCH_SIZE;
+
+template <typename T>
+constexpr uint32 ThreadCachingAllocator<T>::CLASS_COUNT;
+
+template <typename T>
+constexpr uint32 ThreadCachingAllocator<T>::NO_CLASS;
+
+// STRUCTURES
+template <typename T>
+inline
+ThreadCachingAllocator<T>::SharedPool::SharedPool() : mutex()
+{
+    uint32 i;
+    for ( i = 0; i < CLASS_COUNT; ++i )
+    {
+        heads[i] = nullptr;
+    }
+}
+
+template <typename T>
+inline
+ThreadCachingAllocator<T>::SharedPool::~SharedPool()
+{
+    Block* next;
+    uint32 i;
+    for ( i = 0; i < CLASS_COUNT; ++i )
+    {
+        while ( heads[i] != nullptr )
+        {
+            next = heads[i]->next;
+            ::operator delete( heads[i] );
+            heads[i] = next;
+        }
+    }
+}
+
+template <typename T>
+inline
+ThreadCachingAllocator<T>::ThreadCache::ThreadCache()
+{
+    // the shared pool must be constructed first so it outlives the cache
+    sharedPool();
+
+    uint32 i;
+    for ( i = 0; i < CLASS_COUNT; ++i )
+    {
+        heads[i] = nullptr;
+        lengths[i] = 0;
+    }
+}
+
+template <typename T>
+inline
+ThreadCachingAllocator<T>::ThreadCache::~ThreadCache()
+{
+    SharedPool& pool = sharedPool();
+    Block* last;
+    uint32 i;
+    for ( i = 0; i < CLASS_COUNT; ++i )
+    {
+        if ( heads[i] == nullptr )
+        {
+            continue;
+        }
+
+        for ( last = heads[i]; last->next != nullptr; last = last->next )
+        {
+        }
+
+        std::lock_guard<std::mutex> lock( pool.mutex );
+        last->next = pool.heads[i];
+        pool.heads[i] = heads[i];
+    }
+}
+
+// CONSTRUCTORS
+template <typename T>
+inline
+ThreadCachingAllocator<T>::ThreadCachingAllocator() : _count( 0 )
+{
+}
+
+template <typename T>
+inline
+ThreadCachingAllocator<T>::ThreadCachingAllocator(
+    const ThreadCachingAllocator<T>& ) : _count( 0 )
+{
+}
+
+template <typename T>
+inline
+ThreadCachingAllocator<T>::~ThreadCachingAllocator()
+{
+    // check for memory leak
+    assert( _count <= 0 );
+}
+
+// OPERATORS
+template <typename T>
+inline
+ThreadCachingAllocator<T>& ThreadCachingAllocator<T>::operator=(
+    const ThreadCachingAllocator<T>& )
+{
+    return *this;
+}
+
+// HELPER FUNCTIONS
+template <typename T>
+inline
+typename ThreadCachingAllocator<T>::SharedPool&
+ThreadCachingAllocator<T>::sharedPool()
+{
+    static SharedPool pool;
+    return pool;
+}
+
+template <typename T>
+inline
+typename ThreadCachingAllocator<T>::ThreadCache&
+ThreadCachingAllocator<T>::threadCache()
+{
+    static thread_local ThreadCache cache;
+    return cache;
+}
+
+template <typename T>
+inline
+uint32 ThreadCachingAllocator<T>::classOf( uint32 count )
+{
+    // the cached blocks are only aligned as well as operator new aligns
+    if ( count > MAX_CACHED_COUNT || alignof( T ) > alignof( max_align_t ) )
+    {
+        return NO_CLASS;
+    }
+
+    uint32 sizeClass = 0;
+    while ( ( static_cast<uint32>( 1 ) << sizeClass ) < count )
+    {
+        ++sizeClass;
+    }
+
+    return sizeClass;
+}
+
+template <typename T>
+inline
+uint32 ThreadCachingAllocator<T>::bytesOf( uint32 sizeClass )
+{
+    // a free block must be able to hold its link
+    const uint32 bytes = static_cast<uint32>( sizeof( T ) ) << sizeClass;
+    return bytes > sizeof( Block ) ? bytes : sizeof( Block );
+}
+
+template <typename T>
+void ThreadCachingAllocator<T>::refill( ThreadCache& cache,
+                                        uint32 sizeClass )
+{
+    assert( cache.heads[sizeClass] == nullptr );
+
+    SharedPool& pool = sharedPool();
+    {
+        std::lock_guard<std::mutex> lock( pool.mutex );
+
+        Block* last = pool.heads[sizeClass];
+        if ( last != nullptr )
+        {
+            uint32 length;
+            for ( length = 1; length < BATCH_SIZE && last->next != nullptr;
+                  ++length )
+            {
+                last = last->next;
+            }
+
+            cache.heads[sizeClass] = pool.heads[sizeClass];
+            cache.lengths[sizeClass] = length;
+            pool.heads[sizeClass] = last->next;
+            last->next = nullptr;
+            return;
+        }
+    }
+
+    Block* block =
+        static_cast<Block*>( ::operator new( bytesOf( sizeClass ) ) );
+    block->next = nullptr;
+    cache.heads[sizeClass] = block;
+    cache.lengths[sizeClass] = 1;
+}
+
+template <typename T>
+void ThreadCachingAllocator<T>::flush( ThreadCache& cache, uint32 sizeClass )
+{
+    assert( cache.lengths[sizeClass] > BATCH_SIZE );
+
+    // cut the batch off outside of the lock
+    Block* first = cache.heads[sizeClass];
+    Block* last = first;
+    uint32 i;
+    for ( i = 1; i < BATCH_SIZE; ++i )
+    {
+        last = last->next;
+    }
+    cache.heads[sizeClass] = last->next;
+    cache.lengths[sizeClass] -= BATCH_SIZE;
+
+    SharedPool& pool = sharedPool();
+    std::lock_guard<std::mutex> lock( pool.mutex );
+    last->next = pool.heads[sizeClass];
+    pool.heads[sizeClass] = first;
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* ThreadCachingAllocator<T>::getRaw( uint32 count )
+{
+    assert( count > 0 );
+
+    _count.fetch_add( count, std::memory_order_relaxed );
+
+    const uint32 sizeClass = classOf( count );
+    if ( sizeClass == NO_CLASS )
+    {
+        return IAllocator<T>::getRaw( count );
+    }
+
+    ThreadCache& cache = threadCache();
+    if ( cache.heads[sizeClass] == nullptr )
+    {
+        refill( cache, sizeClass );
+    }
+
+    Block* block = cache.heads[sizeClass];
+    cache.heads[sizeClass] = block->next;
+    --cache.lengths[sizeClass];
+
+    return reinterpret_cast<T*>( block );
+}
+
+template <typename T>
+inline
+void ThreadCachingAllocator<T>::releaseRaw( T* pointer, uint32 count )
+{
+    assert( pointer != nullptr );
+    assert( count > 0 );
+    assert( _count.load( std::memory_order_relaxed ) >= count );
+
+    _count.fetch_sub( count, std::memory_order_relaxed );
+
+    const uint32 sizeClass = classOf( count );
+    if ( sizeClass == NO_CLASS )
+    {
+        IAllocator<T>::releaseRaw( pointer, count );
+        return;
+    }
+
+    ThreadCache& cache = threadCache();
+    Block* block = reinterpret_cast<Block*>( pointer );
+    block->next = cache.heads[sizeClass];
+    cache.heads[sizeClass] = block;
+    if ( ++cache.lengths[sizeClass] > 2 * BATCH_SIZE )
+    {
+        flush( cache, sizeClass );
+    }
+}
+
+template <typename T>
+inline
+T* ThreadCachingAllocator<T>::getAligned( uint32 count, uint32 alignment )
+{
+    assert( count > 0 );
+
+    // every cached block came from the global operator new on its own
+    if ( alignment <= alignof( max_align_t ) )
+    {
+        return getRaw( count );
+    }
+
+    _count.fetch_add( count, std::memory_order_relaxed );
+    return IAllocator<T>::getAligned( count, alignment );
+}
+
+template <typename T>
+inline
+void ThreadCachingAllocator<T>::releaseAligned( T* pointer, uint32 count,
+                                                uint32 alignment )
+{
+    assert( pointer != nullptr );
+    assert( count > 0 );
+
+    if ( alignment <= alignof( max_align_t ) )
+    {
+        releaseRaw( pointer, count );
+        return;
+    }
+
+    assert( _count.load( std::memory_order_relaxed ) >= count );
+
+    _count.fetch_sub( count, std::memory_order_relaxed );
+    IAllocator<T>::releaseAligned( pointer, count, alignment );
+}
+
+// ACCESSOR FUNCTIONS
+template <typename T>
+inline
+uint32 ThreadCachingAllocator<T>::getAllocationCount() const
+{
+    return _count.load( std::memory_order_relaxed );
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif
@@ -0,0 +1,298 @@
+// tracking_allocator.h
+//
+// Defines an allocator that reports its allocations to an allocation
+// tracker under the tag of its call site.
+//
+// Where the counting allocator only knows how many instances of T are live,
+// a tracking allocator also records the bytes of every allocation, the tag
+// it came from and the frame it happened in. Giving the container on a
+// suspected hot path its own tracking allocator, possibly wrapping the
+// allocator it already used, shows exactly how much it allocates per
+// frame. For example:
+//
+//     TrackingAllocator<Node> alloc( "path.open" );
+//     DynamicArray<Node> open( &alloc );
+//
+#ifndef NGE_MEM_TRACKING_ALLOCATOR_H
+#define NGE_MEM_TRACKING_ALLOCATOR_H
+
+#include <assert.h>
+
+#include "engine/intdef.h"
+#include "engine/memory/allocation_tracker.h"
+#include "engine/memory/allocator_guard.h"
+#include "engine/memory/iallocator.h"
+
+namespace nge
+{
+
+namespace mem
+{
+
+template <typename T>
+class TrackingAllocator : public IAllocator<T>
+{
+  private:
+    // MEMBERS
+    /**
+     * The underlying allocator.
+     */
+    AllocatorGuard<T> _allocator;
+
+    /**
+     * The tracker the allocations are reported to.
+     */
+    AllocationTracker* _tracker;
+
+    /**
+     * The tag of the call site.
+     */
+    const char* _tag;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the number of bytes in the given number of instances.
+     */
+    static uint64 bytesOf( uint32 count );
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs an allocator that reports the allocations of the default
+     * allocator to the global tracker under the given tag.
+     *
+     * The tag is not copied, so it is usually a string literal.
+     *
+     * Behavior is undefined when:
+     * tag is null
+     */
+    TrackingAllocator( const char* tag );
+
+    /**
+     * Constructs an allocator that reports the allocations of the given
+     * allocator to the global tracker under the given tag.
+     *
+     * Behavior is undefined when:
+     * tag is null
+     */
+    TrackingAllocator( const char* tag, IAllocator<T>* alloc );
+
+    /**
+     * Constructs an allocator that reports the allocations of the given
+     * allocator to the given tracker under the given tag.
+     *
+     * Behavior is undefined when:
+     * tag is null
+     * tracker is null
+     */
+    TrackingAllocator( const char* tag, IAllocator<T>* alloc,
+                       AllocationTracker* tracker );
+
+    /**
+     * Constructs a copy of the given allocator.
+     */
+    TrackingAllocator( const TrackingAllocator<T>& alloc );
+
+    /**
+     * Destructs the allocator.
+     */
+    virtual ~TrackingAllocator();
+
+    // OPERATORS
+    /**
+     * Assigns this as a copy of the given allocator.
+     */
+    TrackingAllocator<T>& operator=( const TrackingAllocator<T>& alloc );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Allocates storage for the given number of instances without
+     * constructing them.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * out of memory
+     */
+    virtual T* getRaw( uint32 count );
+
+    /**
+     * Releases storage from getRaw with the given number of instances.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer was not returned by getRaw
+     * any of the instances have not been destroyed
+     * count is less than or equal to zero
+     */
+    virtual void releaseRaw( T* pointer, uint32 count );
+
+    /**
+     * Allocates storage for the given number of instances without
+     * constructing them, starting at an address that is a multiple of the
+     * given alignment.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * count is less than or equal to zero
+     * alignment is not a power of two
+     * out of memory
+     */
+    virtual T* getAligned( uint32 count, uint32 alignment );
+
+    /**
+     * Releases storage from getAligned with the given number of instances
+     * and alignment.
+     *
+     * Behavior is undefined when:
+     * T is void
+     * pointer was not returned by getAligned with the same alignment
+     * any of the instances have not been destroyed
+     * count is less than or equal to zero
+     */
+    virtual void releaseAligned( T* pointer, uint32 count, uint32 alignment );
+
+    // ACCESSOR FUNCTIONS
+    /**
+     * Gets the tag of the call site.
+     */
+    const char* tag() const;
+
+    /**
+     * Gets the tracker the allocations are reported to.
+     */
+    AllocationTracker* tracker() const;
+};
+
+// CONSTRUCTORS
+template <typename T>
+inline
+TrackingAllocator<T>::TrackingAllocator( const char* tag )
+    : TrackingAllocator( tag, nullptr, &AllocationTracker::global() )
+{
+}
+
+template <typename T>
+inline
+TrackingAllocator<T>::TrackingAllocator( const char* tag,
+                                         IAllocator<T>* alloc )
+    : TrackingAllocator( tag, alloc, &AllocationTracker::global() )
+{
+}
+
+template <typename T>
+inline
+TrackingAllocator<T>::TrackingAllocator( const char* tag,
+                                         IAllocator<T>* alloc,
+                                         AllocationTracker* tracker )
+    : _allocator( alloc ), _tracker( tracker ), _tag( tag )
+{
+    assert( tag != nullptr );
+    assert( tracker != nullptr );
+}
+
+template <typename T>
+inline
+TrackingAllocator<T>::TrackingAllocator( const TrackingAllocator<T>& alloc )
+    : _allocator( alloc._allocator ), _tracker( alloc._tracker ),
+      _tag( alloc._tag )
+{
+}
+
+template <typename T>
+inline
+TrackingAllocator<T>::~TrackingAllocator()
+{
+    _tracker = nullptr;
+}
+
+// OPERATORS
+template <typename T>
+inline
+TrackingAllocator<T>& TrackingAllocator<T>::operator=(
+    const TrackingAllocator<T>& alloc )
+{
+    _allocator = alloc._allocator;
+    _tracker = alloc._tracker;
+    _tag = alloc._tag;
+
+    return *this;
+}
+
+// HELPER FUNCTIONS
+template <typename T>
+inline
+uint64 TrackingAllocator<T>::bytesOf( uint32 count )
+{
+    return static_cast<uint64>( sizeof( T ) ) * count;
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+T* TrackingAllocator<T>::getRaw( uint32 count )
+{
+    assert( count > 0 );
+
+    // only record the allocation once it succeeded
+    T* pointer = _allocator.getRaw( count );
+    _tracker->recordAllocation( _tag, bytesOf( count ) );
+
+    return pointer;
+}
+
+template <typename T>
+inline
+void TrackingAllocator<T>::releaseRaw( T* pointer, uint32 count )
+{
+    assert( pointer != nullptr );
+    assert( count > 0 );
+
+    _tracker->recordRelease( _tag, bytesOf( count ) );
+    _allocator.releaseRaw( pointer, count );
+}
+
+template <typename T>
+inline
+T* TrackingAllocator<T>::getAligned( uint32 count, uint32 alignment )
+{
+    assert( count > 0 );
+
+    T* pointer = _allocator.getAligned( count, alignment );
+    _tracker->recordAllocation( _tag, bytesOf( count ) );
+
+    return pointer;
+}
+
+template <typename T>
+inline
+void TrackingAllocator<T>::releaseAligned( T* pointer, uint32 count,
+                                           uint32 alignment )
+{
+    assert( pointer != nullptr );
+    assert( count > 0 );
+
+    _tracker->recordRelease( _tag, bytesOf( count ) );
+    _allocator.releaseAligned( pointer, count, alignment );
+}
+
+// ACCESSOR FUNCTIONS
+template <typename T>
+inline
+const char* TrackingAllocator<T>::tag() const
+{
+    return _tag;
+}
+
+template <typename T>
+inline
+AllocationTracker* TrackingAllocator<T>::tracker() const
+{
+    return _tracker;
+}
+
+} // End nspc mem
+
+} // End nspc nge
+
+#endif
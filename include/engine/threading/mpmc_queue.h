@@ -0,0 +1,359 @@
+// mpmc_queue.h
+//
+// Defines a bounded lock free queue for any number of producer and consumer
+// threads.
+//
+// This is Dmitry Vyukov's bounded queue. Each cell of the power of two ring
+// carries a sequence number that tells the threads whether it is ready to
+// be written or read for the current lap around the ring. Producers and
+// consumers claim positions with a compare and swap on their own index, and
+// the two indices sit on separate cache lines.
+//
+#ifndef NGE_THRD_MPMC_QUEUE_H
+#define NGE_THRD_MPMC_QUEUE_H
+
+#include <assert.h>
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "engine/intdef.h"
+#include "engine/memory/allocator_guard.h"
+#include "engine/memory/iallocator.h"
+
+namespace nge
+{
+
+namespace thrd
+{
+
+template <typename T>
+class MpmcQueue
+{
+  public:
+    // STRUCTURES
+    /**
+     * Defines a slot in the ring.
+     */
+    struct Cell
+    {
+        /**
+         * The position the cell is ready to be written at, or one past the
+         * position it is ready to be read at.
+         */
+        std::atomic<uint32> sequence;
+
+        /**
+         * The storage for the item.
+         */
+        typename std::aligned_storage<sizeof( T ), alignof( T )>::type item;
+    };
+
+  private:
+    // CONSTANTS
+    /**
+     * The assumed size of a cache line in bytes.
+     */
+    static constexpr uint32 CACHE_LINE_SIZE = 64;
+
+    // MEMBERS
+    /**
+     * The allocator for the cells.
+     */
+    mem::AllocatorGuard<Cell> _allocator;
+
+    /**
+     * The ring of cells.
+     */
+    Cell* _cells;
+
+    /**
+     * The number of cells minus one.
+     */
+    uint32 _mask;
+
+    /**
+     * Keeps the producers' line apart from the shared members.
+     */
+    char _producerPad[CACHE_LINE_SIZE];
+
+    /**
+     * The next position to be written.
+     */
+    std::atomic<uint32> _tail;
+
+    /**
+     * Keeps the consumers' line apart from the producers'.
+     */
+    char _consumerPad[CACHE_LINE_SIZE];
+
+    /**
+     * The next position to be read.
+     */
+    std::atomic<uint32> _head;
+
+    /**
+     * Keeps the consumers' line apart from whatever follows the queue.
+     */
+    char _endPad[CACHE_LINE_SIZE];
+
+    // CONSTRUCTORS
+    /**
+     * Disabled: queues cannot be copied.
+     */
+    MpmcQueue( const MpmcQueue<T>& queue ) = delete;
+
+    // OPERATORS
+    /**
+     * Disabled: queues cannot be copied.
+     */
+    MpmcQueue<T>& operator=( const MpmcQueue<T>& queue ) = delete;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a new queue that holds at least the given number of items.
+     *
+     * The capacity is rounded up to a power of two of at least 2.
+     *
+     * Behavior is undefined when:
+     * capacity is 0 or greater than 2^30
+     */
+    MpmcQueue( uint32 capacity );
+
+    /**
+     * Constructs a new queue that holds at least the given number of items
+     * using the given allocator.
+     *
+     * The capacity is rounded up to a power of two of at least 2.
+     *
+     * Behavior is undefined when:
+     * capacity is 0 or greater than 2^30
+     */
+    MpmcQueue( mem::IAllocator<Cell>* allocator, uint32 capacity );
+
+    /**
+     * Destructs the queue and any items still in it.
+     */
+    ~MpmcQueue();
+
+    // MEMBER FUNCTIONS
+    /**
+     * Adds a copy of the value to the back of the queue.
+     *
+     * Returns false without adding the value if the queue is full.
+     */
+    bool tryPush( const T& value );
+
+    /**
+     * Moves the value to the back of the queue.
+     *
+     * Returns false without moving the value if the queue is full.
+     */
+    bool tryPush( T&& value );
+
+    /**
+     * Constructs an item from the given arguments at the back of the queue.
+     *
+     * Returns false without constructing the item if the queue is full.
+     */
+    template <typename... Args>
+    bool tryEmplace( Args&&... args );
+
+    /**
+     * Moves the item at the front of the queue into value.
+     *
+     * Returns false without changing value if the queue is empty.
+     */
+    bool tryPop( T& value );
+
+    /**
+     * Gets the number of items in the queue.
+     *
+     * The count is already stale when other threads are active and
+     * includes items that are still being written or read.
+     */
+    uint32 size() const;
+
+    /**
+     * Checks if the queue is empty.
+     *
+     * The result is already stale when other threads are active.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Gets the number of items the queue can hold.
+     */
+    uint32 capacity() const;
+};
+
+// CONSTANTS
+template <typename T>
+constexpr uint32 MpmcQueue<T>::CACHE_LINE_SIZE;
+
+// CONSTRUCTORS
+template <typename T>
+inline
+MpmcQueue<T>::MpmcQueue( uint32 capacity ) : MpmcQueue( nullptr, capacity )
+{
+}
+
+template <typename T>
+MpmcQueue<T>::MpmcQueue( mem::IAllocator<Cell>* allocator, uint32 capacity )
+    : _allocator( allocator ), _cells( nullptr ), _mask( 0 ), _tail( 0 ),
+      _head( 0 )
+{
+    assert( capacity > 0 && capacity <= ( 1u << 30 ) );
+
+    uint32 count = 2;
+    while ( count < capacity )
+    {
+        count <<= 1;
+    }
+
+    _cells = _allocator.getRaw( count );
+    _mask = count - 1;
+
+    uint32 i;
+    for ( i = 0; i < count; ++i )
+    {
+        new ( &_cells[i].sequence ) std::atomic<uint32>( i );
+    }
+}
+
+template <typename T>
+MpmcQueue<T>::~MpmcQueue()
+{
+    const uint32 tail = _tail.load( std::memory_order_relaxed );
+    uint32 head;
+    for ( head = _head.load( std::memory_order_relaxed ); head != tail;
+          ++head )
+    {
+        reinterpret_cast<T*>( &_cells[head & _mask].item )->~T();
+    }
+
+    _allocator.releaseRaw( _cells, _mask + 1 );
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+bool MpmcQueue<T>::tryPush( const T& value )
+{
+    return tryEmplace( value );
+}
+
+template <typename T>
+inline
+bool MpmcQueue<T>::tryPush( T&& value )
+{
+    return tryEmplace( std::move( value ) );
+}
+
+template <typename T>
+template <typename... Args>
+bool MpmcQueue<T>::tryEmplace( Args&&... args )
+{
+    Cell* cell;
+    uint32 pos = _tail.load( std::memory_order_relaxed );
+    for ( ;; )
+    {
+        cell = &_cells[pos & _mask];
+        const int32 lap = static_cast<int32>(
+            cell->sequence.load( std::memory_order_acquire ) - pos );
+        if ( lap == 0 )
+        {
+            // the cell is free for this lap so try to claim the position
+            if ( _tail.compare_exchange_weak( pos, pos + 1,
+                                              std::memory_order_relaxed ) )
+            {
+                break;
+            }
+        }
+        else if ( lap < 0 )
+        {
+            // the cell still holds the item from the previous lap
+            return false;
+        }
+        else
+        {
+            pos = _tail.load( std::memory_order_relaxed );
+        }
+    }
+
+    new ( &cell->item ) T( std::forward<Args>( args )... );
+    cell->sequence.store( pos + 1, std::memory_order_release );
+
+    return true;
+}
+
+template <typename T>
+bool MpmcQueue<T>::tryPop( T& value )
+{
+    Cell* cell;
+    uint32 pos = _head.load( std::memory_order_relaxed );
+    for ( ;; )
+    {
+        cell = &_cells[pos & _mask];
+        const int32 lap = static_cast<int32>(
+            cell->sequence.load( std::memory_order_acquire ) - ( pos + 1 ) );
+        if ( lap == 0 )
+        {
+            // the cell holds an item for this lap so try to claim it
+            if ( _head.compare_exchange_weak( pos, pos + 1,
+                                              std::memory_order_relaxed ) )
+            {
+                break;
+            }
+        }
+        else if ( lap < 0 )
+        {
+            // the cell has not been written this lap
+            return false;
+        }
+        else
+        {
+            pos = _head.load( std::memory_order_relaxed );
+        }
+    }
+
+    T* item = reinterpret_cast<T*>( &cell->item );
+    value = std::move( *item );
+    item->~T();
+
+    // make the cell free for the producers' next lap
+    cell->sequence.store( pos + _mask + 1, std::memory_order_release );
+
+    return true;
+}
+
+template <typename T>
+inline
+uint32 MpmcQueue<T>::size() const
+{
+    const uint32 head = _head.load( std::memory_order_acquire );
+    const uint32 tail = _tail.load( std::memory_order_acquire );
+    return static_cast<int32>( tail - head ) > 0 ? tail - head : 0;
+}
+
+template <typename T>
+inline
+bool MpmcQueue<T>::isEmpty() const
+{
+    return size() == 0;
+}
+
+template <typename T>
+inline
+uint32 MpmcQueue<T>::capacity() const
+{
+    return _mask + 1;
+}
+
+} // End nspc thrd
+
+} // End nspc nge
+
+#endif
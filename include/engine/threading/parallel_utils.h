@@ -0,0 +1,275 @@
+// parallel_utils.h
+//
+// Defines data parallel algorithms that split an array into chunks and run
+// them on a thread pool.
+//
+// The algorithms work on any array with size() and operator[] such as
+// DynamicArray, FixedArray and SmallArray. Chunks are sized in whole cache
+// lines of items so threads do not write to the same line, and there are a
+// few chunks per thread so uneven work still balances out.
+//
+#ifndef NGE_THRD_PARALLEL_UTILS_H
+#define NGE_THRD_PARALLEL_UTILS_H
+
+#include <algorithm>
+#include <assert.h>
+#include <type_traits>
+#include <utility>
+
+#include "engine/containers/dynamic_array.h"
+#include "engine/intdef.h"
+#include "engine/memory/default_allocator.h"
+#include "engine/memory/memory_utils.h"
+#include "engine/threading/thread_pool.h"
+
+namespace nge
+{
+
+namespace thrd
+{
+
+struct ParallelUtils
+{
+  private:
+    // CONSTANTS
+    /**
+     * The assumed size of a cache line in bytes.
+     */
+    static constexpr uint32 CACHE_LINE_SIZE = 64;
+
+    /**
+     * The smallest chunk in bytes worth handing to another thread.
+     */
+    static constexpr uint32 MIN_CHUNK_SIZE = 4096;
+
+    /**
+     * The number of chunks each thread should get for load balancing.
+     */
+    static constexpr uint32 CHUNKS_PER_THREAD = 4;
+
+    // HELPER FUNCTIONS
+    /**
+     * Gets the number of items in a chunk for items of the given size.
+     */
+    static uint32 chunkSize( const ThreadPool& pool, uint32 count,
+                             uint32 itemSize );
+
+    /**
+     * Runs the function with the start and end of each chunk.
+     */
+    template <typename F>
+    static void forChunks( ThreadPool& pool, uint32 count, uint32 itemSize,
+                           F function );
+
+  public:
+    /**
+     * Calls the function with every item in the array.
+     *
+     * Behavior is undefined when:
+     * the function modifies items other than the one it was given
+     */
+    template <typename A, typename F>
+    static void forEach( ThreadPool& pool, A& array, F function );
+
+    /**
+     * Sets every item in the destination to the function of the source item
+     * at the same index.
+     *
+     * The source and destination may be the same array.
+     *
+     * Behavior is undefined when:
+     * the destination is smaller than the source
+     */
+    template <typename A, typename B, typename F>
+    static void transform( ThreadPool& pool, const A& source,
+                           B& destination, F function );
+
+    /**
+     * Combines all of the items in the array and gets the result.
+     *
+     * The items are combined in chunks and then the chunk results are
+     * combined, so the order of combination differs from a sequential loop.
+     *
+     * Behavior is undefined when:
+     * combine is not associative
+     * identity is not an identity of combine
+     */
+    template <typename A, typename T, typename F>
+    static T reduce( ThreadPool& pool, const A& array, T identity,
+                     F combine );
+
+    /**
+     * Sorts the array with the given less than comparison.
+     *
+     * The chunks are sorted in parallel and then merged in parallel rounds
+     * using a temporary buffer the size of the array.
+     */
+    template <typename A, typename C>
+    static void sort( ThreadPool& pool, A& array, C less );
+
+    /**
+     * Sorts the array in ascending order.
+     */
+    template <typename A>
+    static void sort( ThreadPool& pool, A& array );
+};
+
+// HELPER FUNCTIONS
+template <typename F>
+inline
+void ParallelUtils::forChunks( ThreadPool& pool, uint32 count,
+                               uint32 itemSize, F function )
+{
+    const uint32 size = chunkSize( pool, count, itemSize );
+    pool.run( ( count + size - 1 ) / size,
+              [count, size, &function]( uint32 chunk ) {
+        const uint32 start = chunk * size;
+        function( start, std::min( count, start + size ) );
+    } );
+}
+
+// MEMBER FUNCTIONS
+template <typename A, typename F>
+inline
+void ParallelUtils::forEach( ThreadPool& pool, A& array, F function )
+{
+    forChunks( pool, array.size(), sizeof( array[0] ),
+               [&array, &function]( uint32 start, uint32 end ) {
+        uint32 i;
+        for ( i = start; i < end; ++i )
+        {
+            function( array[i] );
+        }
+    } );
+}
+
+template <typename A, typename B, typename F>
+inline
+void ParallelUtils::transform( ThreadPool& pool, const A& source,
+                               B& destination, F function )
+{
+    assert( destination.size() >= source.size() );
+
+    forChunks( pool, source.size(), sizeof( destination[0] ),
+               [&source, &destination, &function]( uint32 start,
+                                                   uint32 end ) {
+        uint32 i;
+        for ( i = start; i < end; ++i )
+        {
+            destination[i] = function( source[i] );
+        }
+    } );
+}
+
+template <typename A, typename T, typename F>
+T ParallelUtils::reduce( ThreadPool& pool, const A& array, T identity,
+                         F combine )
+{
+    const uint32 count = array.size();
+    const uint32 size = chunkSize( pool, count, sizeof( array[0] ) );
+    const uint32 chunks = ( count + size - 1 ) / size;
+    uint32 i;
+
+    cntr::DynamicArray<T> partials( chunks );
+    for ( i = 0; i < chunks; ++i )
+    {
+        partials.push( identity );
+    }
+
+    // each chunk accumulates locally and stores its result once
+    pool.run( chunks, [&]( uint32 chunk ) {
+        const uint32 start = chunk * size;
+        const uint32 end = std::min( count, start + size );
+        T result = identity;
+        uint32 j;
+        for ( j = start; j < end; ++j )
+        {
+            result = combine( result, array[j] );
+        }
+
+        partials[chunk] = std::move( result );
+    } );
+
+    T result = identity;
+    for ( i = 0; i < chunks; ++i )
+    {
+        result = combine( result, partials[i] );
+    }
+
+    return result;
+}
+
+template <typename A, typename C>
+void ParallelUtils::sort( ThreadPool& pool, A& array, C less )
+{
+    using namespace mem;
+
+    typedef typename std::remove_reference<decltype( array[0] )>::type T;
+
+    const uint32 count = array.size();
+    if ( count <= 1 )
+    {
+        return;
+    }
+
+    const uint32 size = chunkSize( pool, count, sizeof( T ) );
+    const uint32 chunks = ( count + size - 1 ) / size;
+
+    DefaultAllocator<T> alloc;
+    T* buffer = alloc.getRaw( count );
+
+    // move into contiguous storage and sort each chunk
+    pool.run( chunks, [&]( uint32 chunk ) {
+        const uint32 start = chunk * size;
+        const uint32 end = std::min( count, start + size );
+        uint32 i;
+        for ( i = start; i < end; ++i )
+        {
+            new ( buffer + i ) T( std::move( array[i] ) );
+        }
+
+        std::sort( buffer + start, buffer + end, less );
+    } );
+
+    // merge neighboring runs in rounds, each round halving the run count
+    uint32 width;
+    for ( width = size; width < count; width <<= 1 )
+    {
+        const uint32 pairs = ( count + 2 * width - 1 ) / ( 2 * width );
+        pool.run( pairs, [&]( uint32 pair ) {
+            const uint32 start = pair * 2 * width;
+            const uint32 middle = std::min( count, start + width );
+            const uint32 end = std::min( count, start + 2 * width );
+            std::inplace_merge( buffer + start, buffer + middle,
+                                buffer + end, less );
+        } );
+    }
+
+    pool.run( chunks, [&]( uint32 chunk ) {
+        const uint32 start = chunk * size;
+        const uint32 end = std::min( count, start + size );
+        uint32 i;
+        for ( i = start; i < end; ++i )
+        {
+            array[i] = std::move( buffer[i] );
+        }
+
+        MemoryUtils::destroy( buffer + start, end - start );
+    } );
+
+    alloc.releaseRaw( buffer, count );
+}
+
+template <typename A>
+inline
+void ParallelUtils::sort( ThreadPool& pool, A& array )
+{
+    typedef typename std::remove_reference<decltype( array[0] )>::type T;
+    sort( pool, array, []( const T& a, const T& b ) { return a < b; } );
+}
+
+} // End nspc thrd
+
+} // End nspc nge
+
+#endif
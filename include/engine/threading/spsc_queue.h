@@ -0,0 +1,329 @@
+// spsc_queue.h
+//
+// Defines a bounded lock free queue for one producer and one consumer
+// thread.
+//
+// The items live in a power of two ring like DynamicArray's. The head is
+// only written by the consumer and the tail only by the producer, and each
+// sits on its own cache line next to that thread's cached copy of the other
+// index, so the threads only touch each other's line when the queue looks
+// full or empty.
+//
+#ifndef NGE_THRD_SPSC_QUEUE_H
+#define NGE_THRD_SPSC_QUEUE_H
+
+#include <assert.h>
+#include <atomic>
+#include <new>
+#include <utility>
+
+#include "engine/intdef.h"
+#include "engine/memory/allocator_guard.h"
+#include "engine/memory/iallocator.h"
+
+namespace nge
+{
+
+namespace thrd
+{
+
+template <typename T>
+class SpscQueue
+{
+  private:
+    // CONSTANTS
+    /**
+     * The assumed size of a cache line in bytes.
+     */
+    static constexpr uint32 CACHE_LINE_SIZE = 64;
+
+    // MEMBERS
+    /**
+     * The allocator for the items.
+     */
+    mem::AllocatorGuard<T> _allocator;
+
+    /**
+     * The ring of items.
+     */
+    T* _values;
+
+    /**
+     * The number of items the ring holds, a power of two.
+     */
+    uint32 _capacity;
+
+    /**
+     * Keeps the consumer's line apart from the shared members.
+     */
+    char _consumerPad[CACHE_LINE_SIZE];
+
+    /**
+     * The count of items popped so far, written by the consumer.
+     */
+    std::atomic<uint32> _head;
+
+    /**
+     * The consumer's last view of the tail.
+     */
+    uint32 _cachedTail;
+
+    /**
+     * Keeps the producer's line apart from the consumer's.
+     */
+    char _producerPad[CACHE_LINE_SIZE];
+
+    /**
+     * The count of items pushed so far, written by the producer.
+     */
+    std::atomic<uint32> _tail;
+
+    /**
+     * The producer's last view of the head.
+     */
+    uint32 _cachedHead;
+
+    /**
+     * Keeps the producer's line apart from whatever follows the queue.
+     */
+    char _endPad[CACHE_LINE_SIZE];
+
+    // CONSTRUCTORS
+    /**
+     * Disabled: queues cannot be copied.
+     */
+    SpscQueue( const SpscQueue<T>& queue ) = delete;
+
+    // OPERATORS
+    /**
+     * Disabled: queues cannot be copied.
+     */
+    SpscQueue<T>& operator=( const SpscQueue<T>& queue ) = delete;
+
+    // HELPER FUNCTIONS
+    /**
+     * Checks if the producer has room for another item.
+     */
+    bool hasRoom();
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a new queue that holds at least the given number of items.
+     *
+     * The capacity is rounded up to a power of two.
+     *
+     * Behavior is undefined when:
+     * capacity is 0 or greater than 2^31
+     */
+    SpscQueue( uint32 capacity );
+
+    /**
+     * Constructs a new queue that holds at least the given number of items
+     * using the given allocator.
+     *
+     * The capacity is rounded up to a power of two.
+     *
+     * Behavior is undefined when:
+     * capacity is 0 or greater than 2^31
+     */
+    SpscQueue( mem::IAllocator<T>* allocator, uint32 capacity );
+
+    /**
+     * Destructs the queue and any items still in it.
+     */
+    ~SpscQueue();
+
+    // MEMBER FUNCTIONS
+    /**
+     * Adds a copy of the value to the back of the queue.
+     *
+     * Returns false without adding the value if the queue is full. Only
+     * the producer thread may call this.
+     */
+    bool tryPush( const T& value );
+
+    /**
+     * Moves the value to the back of the queue.
+     *
+     * Returns false without moving the value if the queue is full. Only the
+     * producer thread may call this.
+     */
+    bool tryPush( T&& value );
+
+    /**
+     * Constructs an item from the given arguments at the back of the queue.
+     *
+     * Returns false without constructing the item if the queue is full.
+     * Only the producer thread may call this.
+     */
+    template <typename... Args>
+    bool tryEmplace( Args&&... args );
+
+    /**
+     * Moves the item at the front of the queue into value.
+     *
+     * Returns false without changing value if the queue is empty. Only the
+     * consumer thread may call this.
+     */
+    bool tryPop( T& value );
+
+    /**
+     * Gets the number of items in the queue.
+     *
+     * The count is already stale when the other thread is active.
+     */
+    uint32 size() const;
+
+    /**
+     * Checks if the queue is empty.
+     *
+     * The result is already stale when the other thread is active.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Gets the number of items the queue can hold.
+     */
+    uint32 capacity() const;
+};
+
+// CONSTANTS
+template <typename T>
+constexpr uint32 SpscQueue<T>::CACHE_LINE_SIZE;
+
+// CONSTRUCTORS
+template <typename T>
+inline
+SpscQueue<T>::SpscQueue( uint32 capacity ) : SpscQueue( nullptr, capacity )
+{
+}
+
+template <typename T>
+SpscQueue<T>::SpscQueue( mem::IAllocator<T>* allocator, uint32 capacity )
+    : _allocator( allocator ), _values( nullptr ), _capacity( 1 ),
+      _head( 0 ), _cachedTail( 0 ), _tail( 0 ), _cachedHead( 0 )
+{
+    assert( capacity > 0 && capacity <= ( 1u << 31 ) );
+
+    while ( _capacity < capacity )
+    {
+        _capacity <<= 1;
+    }
+
+    _values = _allocator.getRaw( _capacity );
+}
+
+template <typename T>
+SpscQueue<T>::~SpscQueue()
+{
+    const uint32 tail = _tail.load( std::memory_order_relaxed );
+    uint32 head;
+    for ( head = _head.load( std::memory_order_relaxed ); head != tail;
+          ++head )
+    {
+        _values[head & ( _capacity - 1 )].~T();
+    }
+
+    _allocator.releaseRaw( _values, _capacity );
+}
+
+// MEMBER FUNCTIONS
+template <typename T>
+inline
+bool SpscQueue<T>::tryPush( const T& value )
+{
+    return tryEmplace( value );
+}
+
+template <typename T>
+inline
+bool SpscQueue<T>::tryPush( T&& value )
+{
+    return tryEmplace( std::move( value ) );
+}
+
+template <typename T>
+template <typename... Args>
+bool SpscQueue<T>::tryEmplace( Args&&... args )
+{
+    if ( !hasRoom() )
+    {
+        return false;
+    }
+
+    const uint32 tail = _tail.load( std::memory_order_relaxed );
+    new ( _values + ( tail & ( _capacity - 1 ) ) )
+        T( std::forward<Args>( args )... );
+
+    // publish the item to the consumer
+    _tail.store( tail + 1, std::memory_order_release );
+
+    return true;
+}
+
+template <typename T>
+bool SpscQueue<T>::tryPop( T& value )
+{
+    const uint32 head = _head.load( std::memory_order_relaxed );
+    if ( head == _cachedTail )
+    {
+        _cachedTail = _tail.load( std::memory_order_acquire );
+        if ( head == _cachedTail )
+        {
+            return false;
+        }
+    }
+
+    T* item = _values + ( head & ( _capacity - 1 ) );
+    value = std::move( *item );
+    item->~T();
+
+    // hand the slot back to the producer
+    _head.store( head + 1, std::memory_order_release );
+
+    return true;
+}
+
+template <typename T>
+inline
+uint32 SpscQueue<T>::size() const
+{
+    const uint32 head = _head.load( std::memory_order_acquire );
+    return _tail.load( std::memory_order_acquire ) - head;
+}
+
+template <typename T>
+inline
+bool SpscQueue<T>::isEmpty() const
+{
+    return size() == 0;
+}
+
+template <typename T>
+inline
+uint32 SpscQueue<T>::capacity() const
+{
+    return _capacity;
+}
+
+// HELPER FUNCTIONS
+template <typename T>
+inline
+bool SpscQueue<T>::hasRoom()
+{
+    const uint32 tail = _tail.load( std::memory_order_relaxed );
+    if ( tail - _cachedHead < _capacity )
+    {
+        return true;
+    }
+
+    _cachedHead = _head.load( std::memory_order_acquire );
+    return tail - _cachedHead < _capacity;
+}
+
+} // End nspc thrd
+
+} // End nspc nge
+
+#endif
@@ -0,0 +1,190 @@
+// thread_pool.h
+//
+// Defines a pool of worker threads that run fork join style jobs.
+//
+// A job is a number of tasks identified by their index. The calling thread
+// hands the job to the workers, helps run its tasks, then returns once all of
+// them have finished. The threads are created once and reused by every job.
+//
+#ifndef NGE_THRD_THREAD_POOL_H
+#define NGE_THRD_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "engine/containers/dynamic_array.h"
+#include "engine/intdef.h"
+
+namespace nge
+{
+
+namespace thrd
+{
+
+class ThreadPool
+{
+  public:
+    // TYPES
+    /**
+     * Defines a task that is given its index in the job.
+     */
+    typedef std::function<void( uint32 )> Task;
+
+  private:
+    // MEMBERS
+    /**
+     * The worker threads.
+     */
+    cntr::DynamicArray<std::thread> _threads;
+
+    /**
+     * Guards the job state shared with the workers.
+     */
+    std::mutex _mutex;
+
+    /**
+     * Serializes jobs started from different threads.
+     */
+    std::mutex _runMutex;
+
+    /**
+     * Wakes the workers when a job starts or the pool stops.
+     */
+    std::condition_variable _wake;
+
+    /**
+     * Wakes the calling thread when the job finishes.
+     */
+    std::condition_variable _done;
+
+    /**
+     * The task of the current job.
+     */
+    const Task* _task;
+
+    /**
+     * The number of tasks in the current job.
+     */
+    uint32 _taskCount;
+
+    /**
+     * The index of the next task to be claimed.
+     */
+    std::atomic<uint32> _nextTask;
+
+    /**
+     * The number of tasks that have not finished.
+     */
+    uint32 _pending;
+
+    /**
+     * The number of workers running tasks of the current job.
+     */
+    uint32 _active;
+
+    /**
+     * Incremented for every job so the workers can tell them apart.
+     */
+    uint32 _generation;
+
+    /**
+     * If the workers should exit.
+     */
+    bool _isStopping;
+
+    // HELPER FUNCTIONS
+    /**
+     * Runs on each worker thread until the pool is destroyed.
+     */
+    void work();
+
+    /**
+     * Claims and runs tasks of the current job until there are none left and
+     * gets the number that were run.
+     */
+    uint32 runTasks();
+
+    /**
+     * Starts the given number of worker threads.
+     */
+    void start( uint32 workerCount );
+
+    // CONSTRUCTORS
+    /**
+     * Disabled: thread pools cannot be copied.
+     */
+    ThreadPool( const ThreadPool& pool ) = delete;
+
+    // OPERATORS
+    /**
+     * Disabled: thread pools cannot be copied.
+     */
+    ThreadPool& operator=( const ThreadPool& pool ) = delete;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a pool with a worker for every hardware thread except the
+     * calling one.
+     */
+    ThreadPool();
+
+    /**
+     * Constructs a pool with the given number of workers.
+     *
+     * A pool without workers runs every job on the calling thread.
+     */
+    ThreadPool( uint32 workerCount );
+
+    /**
+     * Destructs the pool, waiting for the workers to exit.
+     */
+    ~ThreadPool();
+
+    // MEMBER FUNCTIONS
+    /**
+     * Runs the task once for every index from zero up to the task count and
+     * returns once they have all finished.
+     *
+     * The calling thread runs tasks as well. Tasks may run in any order and
+     * concurrently with each other.
+     *
+     * Behavior is undefined when:
+     * the task throws
+     * called from inside a task of the same pool
+     */
+    void run( uint32 taskCount, const Task& task );
+
+    /**
+     * Gets the number of worker threads.
+     */
+    uint32 workerCount() const;
+
+    /**
+     * Gets the number of threads that run a job, the workers and the
+     * calling thread.
+     */
+    uint32 concurrency() const;
+};
+
+// MEMBER FUNCTIONS
+inline
+uint32 ThreadPool::workerCount() const
+{
+    return _threads.size();
+}
+
+inline
+uint32 ThreadPool::concurrency() const
+{
+    return _threads.size() + 1;
+}
+
+} // End nspc thrd
+
+} // End nspc nge
+
+#endif
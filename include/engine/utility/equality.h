@@ -0,0 +1,69 @@
+// equality.h
+//
+// Defines the default key equality used by the hashed containers. To
+// compare keys differently specialize equality or pass another type with an
+// equals( const T&, const T& ) function as the container's equality policy.
+//
+// Equality<String> can also compare against a raw character range for the
+// containers' String lookups that do not construct a String.
+//
+#ifndef NGE_UTIL_EQUALITY_H
+#define NGE_UTIL_EQUALITY_H
+
+#include "engine/intdef.h"
+#include "engine/strdef.h"
+
+namespace nge
+{
+
+namespace util
+{
+
+template <typename T>
+struct Equality
+{
+    /**
+     * Checks if the two values are equal.
+     */
+    static bool equals( const T& lhs, const T& rhs );
+};
+
+template <>
+struct Equality<String>
+{
+    /**
+     * Checks if the two values are equal.
+     */
+    static bool equals( const String& lhs, const String& rhs );
+
+    /**
+     * Checks if the value holds exactly the given range of characters.
+     */
+    static bool equals( const String& lhs, const char* rhs, uint32 length );
+};
+
+template <typename T>
+inline
+bool Equality<T>::equals( const T& lhs, const T& rhs )
+{
+    return lhs == rhs;
+}
+
+inline
+bool Equality<String>::equals( const String& lhs, const String& rhs )
+{
+    return lhs == rhs;
+}
+
+inline
+bool Equality<String>::equals( const String& lhs, const char* rhs,
+                               uint32 length )
+{
+    return lhs.length() == length && lhs.compare( 0, length, rhs, length ) == 0;
+}
+
+} // End nspc util
+
+} // End nspc nge
+
+#endif
@@ -55,6 +55,11 @@ struct HashUtils
      */
     static uint32 fnv1a( const String& value );
 
+    /**
+     * Computes the fnv1a hash of the given range of characters.
+     */
+    static uint32 fnv1a( const char* value, uint32 length );
+
     /**
      * Compiles the fnv hash code at compile time.
      */
@@ -3,9 +3,21 @@
 // Defines default hash function implementations. To add new default hash
 // implementations specialize hasher.
 //
+// Hashed containers take the hasher as a template parameter so that the hash
+// function can be inlined. A hasher is any type with a hash( const T& )
+// function that can be called on an instance. FunctionHasher adapts a
+// runtime function for the cases where the hash function is not known at
+// compile time.
+//
+// Hasher<String> can also hash a raw character range, which lets the hashed
+// containers look up String keys without constructing a String. It hashes
+// the same way as chash so a literal's hash can be computed at compile time.
+//
 #ifndef NGE_UTIL_HASHER_H
 #define NGE_UTIL_HASHER_H
 
+#include <functional>
+
 #include "engine/intdef.h"
 #include "engine/strdef.h"
 #include "engine/utility/hash_utils.h"
@@ -20,11 +32,61 @@ template <typename T>
 struct Hasher
 {
     /**
-     * Computes the hash for a give value.
+     * Computes the hash for a given value.
      */
     static uint32 hash( const T& value );
 };
 
+template <>
+struct Hasher<String>
+{
+    /**
+     * Computes the hash for a given value.
+     */
+    static uint32 hash( const String& value );
+
+    /**
+     * Computes the hash for the given range of characters.
+     *
+     * This is the same hash as the String with the same characters.
+     */
+    static uint32 hash( const char* value, uint32 length );
+};
+
+template <typename T>
+class FunctionHasher
+{
+  private:
+    // MEMBERS
+    /**
+     * The hash function.
+     */
+    std::function<uint32( const T& )> _func;
+
+  public:
+    // CONSTRUCTORS
+    /**
+     * Constructs a hasher that uses Hasher<T>.
+     */
+    FunctionHasher();
+
+    /**
+     * Constructs a hasher that calls the given function.
+     */
+    FunctionHasher( uint32 ( *func )( const T& ) );
+
+    /**
+     * Constructs a hasher that calls the given function.
+     */
+    FunctionHasher( std::function<uint32( const T& )> func );
+
+    // MEMBER FUNCTIONS
+    /**
+     * Computes the hash for a given value.
+     */
+    uint32 hash( const T& value ) const;
+};
+
 template <typename T>
 inline
 uint32 Hasher<T>::hash( const T& value )
@@ -32,13 +94,45 @@ uint32 Hasher<T>::hash( const T& value )
     return 0;
 }
 
-template <>
+template <typename T>
+inline
+FunctionHasher<T>::FunctionHasher() : _func( &Hasher<T>::hash )
+{
+}
+
+template <typename T>
+inline
+FunctionHasher<T>::FunctionHasher( uint32 ( *func )( const T& ) )
+    : _func( func )
+{
+}
+
+template <typename T>
+inline
+FunctionHasher<T>::FunctionHasher( std::function<uint32( const T& )> func )
+    : _func( std::move( func ) )
+{
+}
+
+template <typename T>
+inline
+uint32 FunctionHasher<T>::hash( const T& value ) const
+{
+    return _func( value );
+}
+
 inline
 uint32 Hasher<String>::hash( const String& value )
 {
     return HashUtils::fnv1a( value );
 }
 
+inline
+uint32 Hasher<String>::hash( const char* value, uint32 length )
+{
+    return HashUtils::fnv1a( value, length );
+}
+
 template <>
 inline
 uint32 Hasher<uint8>::hash( const uint8& value )
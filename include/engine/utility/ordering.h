@@ -0,0 +1,38 @@
+// ordering.h
+//
+// Defines the default key ordering used by the sorted containers. To order
+// keys differently specialize ordering or pass another type with a
+// less( const T&, const T& ) function as the container's ordering policy.
+//
+#ifndef NGE_UTIL_ORDERING_H
+#define NGE_UTIL_ORDERING_H
+
+#include "engine/intdef.h"
+
+namespace nge
+{
+
+namespace util
+{
+
+template <typename T>
+struct Ordering
+{
+    /**
+     * Checks if the left value is ordered before the right value.
+     */
+    static bool less( const T& lhs, const T& rhs );
+};
+
+template <typename T>
+inline
+bool Ordering<T>::less( const T& lhs, const T& rhs )
+{
+    return lhs < rhs;
+}
+
+} // End nspc util
+
+} // End nspc nge
+
+#endif
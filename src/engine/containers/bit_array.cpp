@@ -0,0 +1,288 @@
+// bit_array.cpp
+#include "engine/containers/bit_array.h"
+
+#include "engine/memory/memory_utils.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+// CONSTRUCTORS
+BitArray::BitArray( mem::IAllocator<uint64>* allocator, uint32 size )
+    : _allocator( allocator ), _words( nullptr ), _size( 0 ), _capacity( 0 )
+{
+    resize( size );
+}
+
+BitArray::BitArray( const BitArray& array )
+    : _allocator( array._allocator ), _words( nullptr ), _size( 0 ),
+      _capacity( 0 )
+{
+    *this = array;
+}
+
+BitArray::BitArray( BitArray&& array )
+    : _allocator( array._allocator ), _words( array._words ),
+      _size( array._size ), _capacity( array._capacity )
+{
+    array._words = nullptr;
+    array._size = 0;
+    array._capacity = 0;
+}
+
+BitArray::~BitArray()
+{
+    if ( _words != nullptr )
+    {
+        _allocator.release( _words, _capacity );
+    }
+}
+
+// OPERATORS
+BitArray& BitArray::operator=( const BitArray& array )
+{
+    if ( this == &array )
+    {
+        return *this;
+    }
+
+    const uint32 words = array.wordCount();
+    if ( words > _capacity )
+    {
+        reallocate( words );
+    }
+
+    if ( words > 0 )
+    {
+        mem::MemoryUtils::copy( _words, array._words, words );
+    }
+    _size = array._size;
+
+    return *this;
+}
+
+BitArray& BitArray::operator=( BitArray&& array )
+{
+    if ( this == &array )
+    {
+        return *this;
+    }
+
+    if ( _words != nullptr )
+    {
+        _allocator.release( _words, _capacity );
+    }
+
+    _allocator = array._allocator;
+    _words = array._words;
+    _size = array._size;
+    _capacity = array._capacity;
+
+    array._words = nullptr;
+    array._size = 0;
+    array._capacity = 0;
+
+    return *this;
+}
+
+BitArray& BitArray::operator&=( const BitArray& array )
+{
+    assert( _size == array._size );
+
+    const uint32 words = wordCount();
+    uint32 i;
+    for ( i = 0; i < words; ++i )
+    {
+        _words[i] &= array._words[i];
+    }
+
+    return *this;
+}
+
+BitArray& BitArray::operator|=( const BitArray& array )
+{
+    assert( _size == array._size );
+
+    const uint32 words = wordCount();
+    uint32 i;
+    for ( i = 0; i < words; ++i )
+    {
+        _words[i] |= array._words[i];
+    }
+
+    return *this;
+}
+
+BitArray& BitArray::operator^=( const BitArray& array )
+{
+    assert( _size == array._size );
+
+    const uint32 words = wordCount();
+    uint32 i;
+    for ( i = 0; i < words; ++i )
+    {
+        _words[i] ^= array._words[i];
+    }
+
+    return *this;
+}
+
+bool BitArray::operator==( const BitArray& array ) const
+{
+    if ( _size != array._size )
+    {
+        return false;
+    }
+
+    const uint32 words = wordCount();
+    uint32 i;
+    for ( i = 0; i < words; ++i )
+    {
+        if ( _words[i] != array._words[i] )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// MEMBER FUNCTIONS
+void BitArray::setAll()
+{
+    const uint32 words = wordCount();
+    if ( words > 0 )
+    {
+        mem::MemoryUtils::set( _words, ~static_cast<uint64>( 0 ), words );
+        clearTail();
+    }
+}
+
+void BitArray::clearAll()
+{
+    const uint32 words = wordCount();
+    if ( words > 0 )
+    {
+        mem::MemoryUtils::set( _words, static_cast<uint64>( 0 ), words );
+    }
+}
+
+void BitArray::flipAll()
+{
+    const uint32 words = wordCount();
+    uint32 i;
+    for ( i = 0; i < words; ++i )
+    {
+        _words[i] = ~_words[i];
+    }
+
+    if ( words > 0 )
+    {
+        clearTail();
+    }
+}
+
+void BitArray::push( bool value )
+{
+    if ( _size == _capacity * BitUtils::WORD_BITS )
+    {
+        reallocate( _capacity > 0 ? _capacity * 2 : 1 );
+    }
+
+    // the bit past the end is already clear
+    if ( _size % BitUtils::WORD_BITS == 0 )
+    {
+        _words[_size / BitUtils::WORD_BITS] = 0;
+    }
+
+    ++_size;
+    if ( value )
+    {
+        set( _size - 1 );
+    }
+}
+
+void BitArray::resize( uint32 size )
+{
+    const uint32 oldWords = wordCount();
+    const uint32 words = BitUtils::wordsFor( size );
+    if ( words > _capacity )
+    {
+        reallocate( words );
+    }
+
+    // the bits past the old end are already clear in the old last word
+    if ( words > oldWords )
+    {
+        mem::MemoryUtils::set( _words + oldWords, static_cast<uint64>( 0 ),
+                               words - oldWords );
+    }
+
+    _size = size;
+    if ( size < oldWords * BitUtils::WORD_BITS && words > 0 )
+    {
+        clearTail();
+    }
+}
+
+void BitArray::reserve( uint32 capacity )
+{
+    const uint32 words = BitUtils::wordsFor( capacity );
+    if ( words > _capacity )
+    {
+        reallocate( words );
+    }
+}
+
+bool BitArray::any() const
+{
+    const uint32 words = wordCount();
+    uint32 i;
+    for ( i = 0; i < words; ++i )
+    {
+        if ( _words[i] != 0 )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+ContainerStats BitArray::stats() const
+{
+    ContainerStats stats;
+    stats.size = _size;
+    stats.capacity = _capacity * BitUtils::WORD_BITS;
+    stats.bytesUsed = static_cast<uint64>( wordCount() ) * sizeof( uint64 );
+    stats.bytesReserved = static_cast<uint64>( _capacity ) * sizeof( uint64 );
+
+    return stats;
+}
+
+// HELPER FUNCTIONS
+void BitArray::reallocate( uint32 wordCount )
+{
+    assert( wordCount > _capacity );
+
+    uint64* words = _allocator.get( wordCount );
+    if ( _words != nullptr )
+    {
+        mem::MemoryUtils::copy( words, _words, this->wordCount() );
+        _allocator.release( _words, _capacity );
+    }
+
+    _words = words;
+    _capacity = wordCount;
+}
+
+void BitArray::clearTail()
+{
+    _words[wordCount() - 1] &= BitUtils::tailMask( _size );
+}
+
+} // End nspc cntr
+
+} // End nspc nge
@@ -0,0 +1,16 @@
+// bit_utils.cpp
+#include "engine/containers/bit_utils.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+// CONSTANTS
+constexpr uint32 BitUtils::WORD_BITS;
+constexpr uint32 BitUtils::NOT_FOUND;
+
+} // End nspc cntr
+
+} // End nspc nge
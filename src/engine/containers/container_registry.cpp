@@ -0,0 +1,96 @@
+// container_registry.cpp
+#include "engine/containers/container_registry.h"
+
+#include <string.h>
+
+namespace nge
+{
+
+namespace cntr
+{
+
+// GLOBAL FUNCTIONS
+ContainerRegistry& ContainerRegistry::global()
+{
+    static ContainerRegistry registry;
+    return registry;
+}
+
+// CONSTRUCTORS
+ContainerRegistry::ContainerRegistry() : _mutex(), _records()
+{
+}
+
+ContainerRegistry::~ContainerRegistry()
+{
+}
+
+// MEMBER FUNCTIONS
+bool ContainerRegistry::remove( const void* container )
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    const uint32 size = _records.size();
+    uint32 i;
+    for ( i = 0; i < size; ++i )
+    {
+        if ( _records[i].container == container )
+        {
+            _records[i] = _records[size - 1];
+            _records.pop();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint32 ContainerRegistry::size() const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _records.size();
+}
+
+// HELPER FUNCTIONS
+void ContainerRegistry::addRecord( const char* tag, const void* container,
+                                   StatsFunction stats )
+{
+    assert( tag != nullptr );
+    assert( container != nullptr );
+
+    Record record;
+    record.tag = tag;
+    record.container = container;
+    record.stats = stats;
+
+    std::lock_guard<std::mutex> lock( _mutex );
+    _records.push( record );
+}
+
+void ContainerRegistry::collect( const char* tag,
+                                 DynamicArray<Entry>* entries ) const
+{
+    assert( entries != nullptr );
+    entries->clear();
+
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    Entry entry;
+    const uint32 size = _records.size();
+    uint32 i;
+    for ( i = 0; i < size; ++i )
+    {
+        const Record& record = _records[i];
+        if ( tag == nullptr || strcmp( tag, record.tag ) == 0 )
+        {
+            entry.tag = record.tag;
+            entry.container = record.container;
+            entry.stats = record.stats( record.container );
+            entries->push( entry );
+        }
+    }
+}
+
+} // End nspc cntr
+
+} // End nspc nge
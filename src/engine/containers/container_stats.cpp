@@ -0,0 +1,2 @@
+// container_stats.cpp
+#include "engine/containers/container_stats.h"
@@ -0,0 +1,2 @@
+// fixed_bitset.cpp
+#include "engine/containers/fixed_bitset.h"
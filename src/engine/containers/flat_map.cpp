@@ -0,0 +1,2 @@
+// flat_map.cpp
+#include "engine/containers/flat_map.h"
@@ -0,0 +1,2 @@
+// flat_set.cpp
+#include "engine/containers/flat_set.h"
@@ -0,0 +1,156 @@
+// hash_index.cpp
+#include "engine/containers/hash_index.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+// CONSTANTS
+constexpr uint32 HashIndex::NOT_FOUND;
+constexpr uint32 HashIndex::GROUP_SIZE;
+constexpr uint32 HashIndex::MIN_BINS;
+constexpr uint8 HashIndex::CTRL_EMPTY;
+constexpr uint8 HashIndex::CTRL_DELETED;
+constexpr uint32 HashIndex::GROW_THRESHOLD;
+constexpr uint32 HashIndex::SHRINK_THRESHOLD;
+
+// OPERATORS
+HashIndex& HashIndex::operator=( const HashIndex& index )
+{
+    if ( this == &index )
+    {
+        return *this;
+    }
+
+    release();
+
+    _alloc = index._alloc;
+    if ( index._slots != nullptr )
+    {
+        allocate( index._binCount );
+        mem::MemoryUtils::copy( _slots, index._slots,
+                                allocationSize( _binCount ) );
+    }
+    _used = index._used;
+    _deleted = index._deleted;
+
+    return *this;
+}
+
+HashIndex& HashIndex::operator=( HashIndex&& index )
+{
+    if ( this == &index )
+    {
+        return *this;
+    }
+
+    release();
+
+    _alloc = index._alloc;
+    _slots = index._slots;
+    _ctrl = index._ctrl;
+    _binCount = index._binCount;
+    _used = index._used;
+    _deleted = index._deleted;
+
+    index._slots = nullptr;
+    index._ctrl = nullptr;
+    index._binCount = 0;
+    index._used = 0;
+    index._deleted = 0;
+
+    return *this;
+}
+
+// MEMBER FUNCTIONS
+uint32 HashIndex::insert( uint32 hashCode, uint32 itemIndex )
+{
+    assert( _binCount > 0 );
+
+    uint32 group;
+    uint32 probes;
+    uint32 mask;
+    uint32 bin;
+    for ( group = firstGroup( hashCode ), probes = 0;
+          ( mask = matchFree( _ctrl + group * GROUP_SIZE ) ) == 0;
+          group = nextGroup( group, ++probes ) )
+    {
+        assert( probes < _binCount / GROUP_SIZE );
+    }
+
+    bin = group * GROUP_SIZE + lowestBit( mask );
+    if ( _ctrl[bin] == CTRL_DELETED )
+    {
+        --_deleted;
+    }
+
+    _ctrl[bin] = fingerprint( hashCode );
+    _slots[bin] = itemIndex;
+    ++_used;
+
+    return bin;
+}
+
+void HashIndex::erase( uint32 bin )
+{
+    assert( bin < _binCount );
+    assert( ( _ctrl[bin] & 0x80 ) == 0 );
+
+    // probing already stops at this group when it has an empty bin, so the
+    // bin can be emptied instead of leaving a deleted marker behind
+    const uint8* group = _ctrl + ( bin / GROUP_SIZE ) * GROUP_SIZE;
+    if ( matchByte( group, CTRL_EMPTY ) != 0 )
+    {
+        _ctrl[bin] = CTRL_EMPTY;
+    }
+    else
+    {
+        _ctrl[bin] = CTRL_DELETED;
+        ++_deleted;
+    }
+
+    --_used;
+}
+
+void HashIndex::clear()
+{
+    if ( _ctrl != nullptr )
+    {
+        mem::MemoryUtils::set( _ctrl, CTRL_EMPTY, _binCount );
+    }
+
+    _used = 0;
+    _deleted = 0;
+}
+
+// HELPER FUNCTIONS
+void HashIndex::allocate( uint32 binCount )
+{
+    assert( _slots == nullptr );
+    assert( binCount % GROUP_SIZE == 0 );
+
+    _slots = _alloc.get( allocationSize( binCount ) );
+    _ctrl = reinterpret_cast<uint8*>( _slots + binCount );
+    _binCount = binCount;
+    clear();
+}
+
+void HashIndex::release()
+{
+    if ( _slots != nullptr )
+    {
+        _alloc.release( _slots, allocationSize( _binCount ) );
+    }
+
+    _slots = nullptr;
+    _ctrl = nullptr;
+    _binCount = 0;
+    _used = 0;
+    _deleted = 0;
+}
+
+} // End nspc cntr
+
+} // End nspc nge
@@ -0,0 +1,2 @@
+// intrusive_hash_set.cpp
+#include "engine/containers/intrusive_hash_set.h"
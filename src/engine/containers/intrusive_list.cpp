@@ -0,0 +1,2 @@
+// intrusive_list.cpp
+#include "engine/containers/intrusive_list.h"
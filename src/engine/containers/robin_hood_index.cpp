@@ -0,0 +1,161 @@
+// robin_hood_index.cpp
+#include "engine/containers/robin_hood_index.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+// CONSTANTS
+constexpr uint32 RobinHoodIndex::NOT_FOUND;
+constexpr uint32 RobinHoodIndex::MIN_BINS;
+constexpr uint32 RobinHoodIndex::EMPTY;
+constexpr uint32 RobinHoodIndex::GROW_THRESHOLD;
+constexpr uint32 RobinHoodIndex::SHRINK_THRESHOLD;
+
+// OPERATORS
+RobinHoodIndex& RobinHoodIndex::operator=( const RobinHoodIndex& index )
+{
+    if ( this == &index )
+    {
+        return *this;
+    }
+
+    release();
+
+    _alloc = index._alloc;
+    if ( index._items != nullptr )
+    {
+        allocate( index._binCount );
+        mem::MemoryUtils::copy( _items, index._items, _binCount * 2 );
+    }
+    _used = index._used;
+
+    return *this;
+}
+
+RobinHoodIndex& RobinHoodIndex::operator=( RobinHoodIndex&& index )
+{
+    if ( this == &index )
+    {
+        return *this;
+    }
+
+    release();
+
+    _alloc = index._alloc;
+    _items = index._items;
+    _hashes = index._hashes;
+    _binCount = index._binCount;
+    _shift = index._shift;
+    _used = index._used;
+
+    index._items = nullptr;
+    index._hashes = nullptr;
+    index._binCount = 0;
+    index._used = 0;
+
+    return *this;
+}
+
+// MEMBER FUNCTIONS
+uint32 RobinHoodIndex::insert( uint32 hashCode, uint32 itemIndex )
+{
+    assert( _binCount > 0 );
+    assert( _used < _binCount );
+
+    const uint32 mask = _binCount - 1;
+    uint32 placed = NOT_FOUND;
+    uint32 bin;
+    uint32 dist;
+    for ( bin = home( hashCode ), dist = 0; _items[bin] != EMPTY;
+          bin = ( bin + 1 ) & mask, ++dist )
+    {
+        // take the bin from an item that is closer to its home and carry
+        // that item further along instead
+        const uint32 binDist = distance( bin );
+        if ( binDist < dist )
+        {
+            std::swap( _items[bin], itemIndex );
+            std::swap( _hashes[bin], hashCode );
+            dist = binDist;
+
+            if ( placed == NOT_FOUND )
+            {
+                placed = bin;
+            }
+        }
+    }
+
+    _items[bin] = itemIndex;
+    _hashes[bin] = hashCode;
+    ++_used;
+
+    return placed == NOT_FOUND ? bin : placed;
+}
+
+void RobinHoodIndex::erase( uint32 bin )
+{
+    assert( bin < _binCount );
+    assert( _items[bin] != EMPTY );
+
+    // shift the following items back until one is already in its home bin
+    const uint32 mask = _binCount - 1;
+    uint32 next;
+    for ( next = ( bin + 1 ) & mask;
+          _items[next] != EMPTY && distance( next ) > 0;
+          bin = next, next = ( next + 1 ) & mask )
+    {
+        _items[bin] = _items[next];
+        _hashes[bin] = _hashes[next];
+    }
+
+    _items[bin] = EMPTY;
+    --_used;
+}
+
+void RobinHoodIndex::clear()
+{
+    if ( _items != nullptr )
+    {
+        mem::MemoryUtils::set( _items, EMPTY, _binCount );
+    }
+
+    _used = 0;
+}
+
+// HELPER FUNCTIONS
+void RobinHoodIndex::allocate( uint32 binCount )
+{
+    assert( _items == nullptr );
+    assert( ( binCount & ( binCount - 1 ) ) == 0 );
+
+    _items = _alloc.get( binCount * 2 );
+    _hashes = _items + binCount;
+    _binCount = binCount;
+
+    for ( _shift = 32; binCount > 1; binCount >>= 1 )
+    {
+        --_shift;
+    }
+
+    clear();
+}
+
+void RobinHoodIndex::release()
+{
+    if ( _items != nullptr )
+    {
+        _alloc.release( _items, _binCount * 2 );
+    }
+
+    _items = nullptr;
+    _hashes = nullptr;
+    _binCount = 0;
+    _used = 0;
+}
+
+} // End nspc cntr
+
+} // End nspc nge
@@ -0,0 +1,2 @@
+// slot_map.cpp
+#include "engine/containers/slot_map.h"
@@ -0,0 +1,2 @@
+// small_array.cpp
+#include "engine/containers/small_array.h"
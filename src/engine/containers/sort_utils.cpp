@@ -0,0 +1,17 @@
+// sort_utils.cpp
+#include "engine/containers/sort_utils.h"
+
+namespace nge
+{
+
+namespace cntr
+{
+
+// CONSTANTS
+constexpr uint32 SortUtils::INSERTION_SORT_SIZE;
+constexpr uint32 SortUtils::RADIX_BITS;
+constexpr uint32 SortUtils::RADIX_SIZE;
+
+} // End nspc cntr
+
+} // End nspc nge
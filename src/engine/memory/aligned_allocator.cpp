@@ -0,0 +1,2 @@
+// aligned_allocator.cpp
+#include "engine/memory/aligned_allocator.h"
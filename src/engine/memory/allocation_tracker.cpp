@@ -0,0 +1,290 @@
+// allocation_tracker.cpp
+#include "engine/memory/allocation_tracker.h"
+
+#include <iomanip>
+#include <ostream>
+#include <string.h>
+
+namespace nge
+{
+
+namespace mem
+{
+
+// GLOBAL FUNCTIONS
+AllocationTracker& AllocationTracker::global()
+{
+    static AllocationTracker tracker;
+    return tracker;
+}
+
+// CONSTRUCTORS
+AllocationTracker::AllocationTracker()
+    : _mutex(), _tags(), _frames(), _current(), _bytesLive( 0 ),
+      _peakBytesLive( 0 )
+{
+}
+
+AllocationTracker::~AllocationTracker()
+{
+}
+
+// MEMBER FUNCTIONS
+void AllocationTracker::recordAllocation( const char* tag, uint64 bytes )
+{
+    assert( tag != nullptr );
+
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    TagStats& stats = statsOf( tag );
+    ++stats.allocationCount;
+    stats.bytesAllocated += bytes;
+    stats.bytesLive += bytes;
+    if ( stats.bytesLive > stats.peakBytesLive )
+    {
+        stats.peakBytesLive = stats.bytesLive;
+    }
+
+    ++_current.allocationCount;
+    _current.bytesAllocated += bytes;
+
+    _bytesLive += bytes;
+    if ( _bytesLive > _peakBytesLive )
+    {
+        _peakBytesLive = _bytesLive;
+    }
+}
+
+void AllocationTracker::recordRelease( const char* tag, uint64 bytes )
+{
+    assert( tag != nullptr );
+
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    TagStats& stats = statsOf( tag );
+    assert( stats.bytesLive >= bytes );
+    ++stats.releaseCount;
+    stats.bytesLive -= bytes;
+
+    ++_current.releaseCount;
+
+    assert( _bytesLive >= bytes );
+    _bytesLive -= bytes;
+}
+
+void AllocationTracker::endFrame()
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    _current.bytesLive = _bytesLive;
+    _frames.push( _current );
+
+    const uint32 next = _current.frame + 1;
+    _current = FrameStats();
+    _current.frame = next;
+}
+
+void AllocationTracker::reset()
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    _tags.clear();
+    _frames.clear();
+    _current = FrameStats();
+    _bytesLive = 0;
+    _peakBytesLive = 0;
+}
+
+void AllocationTracker::snapshot( cntr::DynamicArray<TagStats>* tags ) const
+{
+    assert( tags != nullptr );
+    tags->clear();
+
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    const uint32 size = _tags.size();
+    uint32 i;
+    for ( i = 0; i < size; ++i )
+    {
+        tags->push( _tags[i] );
+    }
+}
+
+void AllocationTracker::timeline(
+    cntr::DynamicArray<FrameStats>* frames ) const
+{
+    assert( frames != nullptr );
+    frames->clear();
+
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    const uint32 size = _frames.size();
+    uint32 i;
+    for ( i = 0; i < size; ++i )
+    {
+        frames->push( _frames[i] );
+    }
+}
+
+void AllocationTracker::writeReport( std::ostream& out ) const
+{
+    cntr::DynamicArray<TagStats> tags;
+    snapshot( &tags );
+
+    // insertion sort since there are only ever a handful of tags
+    const uint32 size = tags.size();
+    uint32 i;
+    uint32 j;
+    for ( i = 1; i < size; ++i )
+    {
+        const TagStats stats = tags[i];
+        for ( j = i; j > 0 &&
+                     tags[j - 1].bytesAllocated < stats.bytesAllocated; --j )
+        {
+            tags[j] = tags[j - 1];
+        }
+        tags[j] = stats;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        out << "frames: " << _frames.size()
+            << " bytes live: " << _bytesLive
+            << " peak bytes live: " << _peakBytesLive << '\n';
+    }
+
+    out << std::left << std::setw( 24 ) << "tag" << std::right
+        << std::setw( 12 ) << "allocations" << std::setw( 12 ) << "releases"
+        << std::setw( 16 ) << "bytes" << std::setw( 16 ) << "live"
+        << std::setw( 16 ) << "peak" << '\n';
+    for ( i = 0; i < size; ++i )
+    {
+        out << std::left << std::setw( 24 ) << tags[i].tag << std::right
+            << std::setw( 12 ) << tags[i].allocationCount
+            << std::setw( 12 ) << tags[i].releaseCount
+            << std::setw( 16 ) << tags[i].bytesAllocated
+            << std::setw( 16 ) << tags[i].bytesLive
+            << std::setw( 16 ) << tags[i].peakBytesLive << '\n';
+    }
+}
+
+void AllocationTracker::writeCsv( std::ostream& out ) const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    out << "frame,allocations,releases,bytes_allocated,bytes_live\n";
+
+    const uint32 size = _frames.size();
+    uint32 i;
+    for ( i = 0; i < size; ++i )
+    {
+        const FrameStats& stats = _frames[i];
+        out << stats.frame << ',' << stats.allocationCount << ','
+            << stats.releaseCount << ',' << stats.bytesAllocated << ','
+            << stats.bytesLive << '\n';
+    }
+}
+
+void AllocationTracker::writeJson( std::ostream& out ) const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    out << "{\"bytesLive\":" << _bytesLive
+        << ",\"peakBytesLive\":" << _peakBytesLive << ",\"tags\":[";
+
+    uint32 size = _tags.size();
+    uint32 i;
+    for ( i = 0; i < size; ++i )
+    {
+        const TagStats& stats = _tags[i];
+        out << ( i > 0 ? ",{\"tag\":" : "{\"tag\":" );
+        writeJsonString( out, stats.tag );
+        out << ",\"allocations\":" << stats.allocationCount
+            << ",\"releases\":" << stats.releaseCount
+            << ",\"bytesAllocated\":" << stats.bytesAllocated
+            << ",\"bytesLive\":" << stats.bytesLive
+            << ",\"peakBytesLive\":" << stats.peakBytesLive << '}';
+    }
+
+    out << "],\"frames\":[";
+
+    size = _frames.size();
+    for ( i = 0; i < size; ++i )
+    {
+        const FrameStats& stats = _frames[i];
+        out << ( i > 0 ? ",{\"frame\":" : "{\"frame\":" ) << stats.frame
+            << ",\"allocations\":" << stats.allocationCount
+            << ",\"releases\":" << stats.releaseCount
+            << ",\"bytesAllocated\":" << stats.bytesAllocated
+            << ",\"bytesLive\":" << stats.bytesLive << '}';
+    }
+
+    out << "]}";
+}
+
+// ACCESSOR FUNCTIONS
+uint32 AllocationTracker::frame() const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _current.frame;
+}
+
+uint64 AllocationTracker::bytesLive() const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _bytesLive;
+}
+
+uint64 AllocationTracker::peakBytesLive() const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _peakBytesLive;
+}
+
+// HELPER FUNCTIONS
+AllocationTracker::TagStats& AllocationTracker::statsOf( const char* tag )
+{
+    const uint32 size = _tags.size();
+    uint32 i;
+    for ( i = 0; i < size; ++i )
+    {
+        if ( _tags[i].tag == tag || strcmp( _tags[i].tag, tag ) == 0 )
+        {
+            return _tags[i];
+        }
+    }
+
+    TagStats stats = TagStats();
+    stats.tag = tag;
+    _tags.push( stats );
+
+    return _tags[size];
+}
+
+void AllocationTracker::writeJsonString( std::ostream& out,
+                                         const char* string )
+{
+    out << '"';
+    for ( ; *string != '\0'; ++string )
+    {
+        const char c = *string;
+        if ( c == '"' || c == '\\' )
+        {
+            out << '\\' << c;
+        }
+        else if ( static_cast<unsigned char>( c ) < 0x20 )
+        {
+            out << "\\u" << std::hex << std::setw( 4 ) << std::setfill( '0' )
+                << static_cast<int>( c ) << std::dec << std::setfill( ' ' );
+        }
+        else
+        {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+} // End nspc mem
+
+} // End nspc nge
@@ -0,0 +1,78 @@
+// arena.cpp
+#include "engine/memory/arena.h"
+
+#include <new>
+#include <stddef.h>
+
+namespace nge
+{
+
+namespace mem
+{
+
+// CONSTANTS
+constexpr uint32 Arena::DEFAULT_BLOCK_SIZE;
+constexpr uint32 Arena::BLOCK_ALIGNMENT;
+constexpr uint32 Arena::HEADER_SIZE;
+
+// CONSTRUCTORS
+Arena::Arena( uint32 blockSize )
+    : _current( nullptr ), _offset( 0 ), _blockSize( blockSize ), _used( 0 ),
+      _peak( 0 ), _reserved( 0 ), _blockCount( 0 )
+{
+    assert( blockSize > 0 );
+}
+
+Arena::~Arena()
+{
+    releaseBlocks();
+}
+
+// MEMBER FUNCTIONS
+void Arena::reset()
+{
+    if ( _blockCount > 1 )
+    {
+        const uint32 size = _reserved;
+        releaseBlocks();
+        addBlock( size );
+    }
+
+    _offset = 0;
+    _used = 0;
+}
+
+// HELPER FUNCTIONS
+void Arena::addBlock( uint32 size )
+{
+    size = size > _blockSize ? size : _blockSize;
+
+    Block* block = static_cast<Block*>(
+        ::operator new( static_cast<size_t>( HEADER_SIZE ) + size ) );
+    block->previous = _current;
+    block->size = size;
+
+    _current = block;
+    _offset = 0;
+    _reserved += size;
+    ++_blockCount;
+}
+
+void Arena::releaseBlocks()
+{
+    Block* previous;
+    while ( _current != nullptr )
+    {
+        previous = _current->previous;
+        ::operator delete( _current );
+        _current = previous;
+    }
+
+    _offset = 0;
+    _reserved = 0;
+    _blockCount = 0;
+}
+
+} // End nspc mem
+
+} // End nspc nge
@@ -0,0 +1,2 @@
+// double_buffered_arena.cpp
+#include "engine/memory/double_buffered_arena.h"
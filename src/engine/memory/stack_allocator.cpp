@@ -0,0 +1,28 @@
+// stack_allocator.cpp
+#include "engine/memory/stack_allocator.h"
+
+#include <new>
+
+namespace nge
+{
+
+namespace mem
+{
+
+// CONSTRUCTORS
+StackAllocator::StackAllocator( uint32 capacity )
+    : _buffer( nullptr ), _capacity( capacity ), _top( 0 ), _peak( 0 )
+{
+    assert( capacity > 0 );
+    _buffer = static_cast<uint8*>( ::operator new( capacity ) );
+}
+
+StackAllocator::~StackAllocator()
+{
+    ::operator delete( _buffer );
+    _buffer = nullptr;
+}
+
+} // End nspc mem
+
+} // End nspc nge
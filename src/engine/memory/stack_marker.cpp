@@ -0,0 +1,2 @@
+// stack_marker.cpp
+#include "engine/memory/stack_marker.h"
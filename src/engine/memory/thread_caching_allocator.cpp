@@ -0,0 +1,2 @@
+// thread_caching_allocator.cpp
+#include "engine/memory/thread_caching_allocator.h"
@@ -0,0 +1,2 @@
+// mpmc_queue.cpp
+#include "engine/threading/mpmc_queue.h"
@@ -0,0 +1,32 @@
+// parallel_utils.cpp
+#include "engine/threading/parallel_utils.h"
+
+namespace nge
+{
+
+namespace thrd
+{
+
+// CONSTANTS
+constexpr uint32 ParallelUtils::CACHE_LINE_SIZE;
+constexpr uint32 ParallelUtils::MIN_CHUNK_SIZE;
+constexpr uint32 ParallelUtils::CHUNKS_PER_THREAD;
+
+// HELPER FUNCTIONS
+uint32 ParallelUtils::chunkSize( const ThreadPool& pool, uint32 count,
+                                 uint32 itemSize )
+{
+    const uint32 itemsPerLine = std::max( 1u, CACHE_LINE_SIZE / itemSize );
+    const uint32 chunks = pool.concurrency() * CHUNKS_PER_THREAD;
+
+    uint32 size = std::max( ( count + chunks - 1 ) / chunks,
+                            MIN_CHUNK_SIZE / itemSize );
+
+    // round up to whole cache lines
+    size = ( size + itemsPerLine - 1 ) / itemsPerLine * itemsPerLine;
+    return std::max( 1u, size );
+}
+
+} // End nspc thrd
+
+} // End nspc nge
@@ -0,0 +1,2 @@
+// spsc_queue.cpp
+#include "engine/threading/spsc_queue.h"
@@ -0,0 +1,142 @@
+// thread_pool.cpp
+#include "engine/threading/thread_pool.h"
+
+#include <assert.h>
+
+namespace nge
+{
+
+namespace thrd
+{
+
+// CONSTRUCTORS
+ThreadPool::ThreadPool()
+    : _threads(), _task( nullptr ), _taskCount( 0 ), _nextTask( 0 ),
+      _pending( 0 ), _active( 0 ), _generation( 0 ), _isStopping( false )
+{
+    const uint32 hardwareThreads = std::thread::hardware_concurrency();
+    start( hardwareThreads > 1 ? hardwareThreads - 1 : 0 );
+}
+
+ThreadPool::ThreadPool( uint32 workerCount )
+    : _threads(), _task( nullptr ), _taskCount( 0 ), _nextTask( 0 ),
+      _pending( 0 ), _active( 0 ), _generation( 0 ), _isStopping( false )
+{
+    start( workerCount );
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _isStopping = true;
+    }
+
+    _wake.notify_all();
+    for ( auto iter = _threads.begin(); iter != _threads.end(); ++iter )
+    {
+        iter->join();
+    }
+}
+
+// MEMBER FUNCTIONS
+void ThreadPool::run( uint32 taskCount, const Task& task )
+{
+    uint32 i;
+
+    if ( _threads.isEmpty() || taskCount <= 1 )
+    {
+        for ( i = 0; i < taskCount; ++i )
+        {
+            task( i );
+        }
+
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock( _runMutex );
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _task = &task;
+        _taskCount = taskCount;
+        _nextTask.store( 0 );
+        _pending = taskCount;
+        ++_generation;
+    }
+
+    _wake.notify_all();
+    const uint32 done = runTasks();
+
+    // wait for the workers to leave the job as well so none of them can
+    // claim tasks from the next one with this job's task
+    std::unique_lock<std::mutex> lock( _mutex );
+    _pending -= done;
+    _done.wait( lock, [this]() { return _pending == 0 && _active == 0; } );
+    _task = nullptr;
+}
+
+// HELPER FUNCTIONS
+void ThreadPool::work()
+{
+    std::unique_lock<std::mutex> lock( _mutex );
+    uint32 generation = _generation;
+
+    while ( true )
+    {
+        _wake.wait( lock, [this, &generation]() {
+            return _isStopping || _generation != generation;
+        } );
+
+        if ( _isStopping )
+        {
+            return;
+        }
+
+        // a worker that wakes after the job finished has nothing to join
+        generation = _generation;
+        if ( _pending == 0 )
+        {
+            continue;
+        }
+
+        ++_active;
+        lock.unlock();
+        const uint32 done = runTasks();
+        lock.lock();
+        --_active;
+
+        _pending -= done;
+        if ( _pending == 0 && _active == 0 )
+        {
+            _done.notify_all();
+        }
+    }
+}
+
+uint32 ThreadPool::runTasks()
+{
+    uint32 done = 0;
+    uint32 task;
+    for ( task = _nextTask++; task < _taskCount; task = _nextTask++ )
+    {
+        ( *_task )( task );
+        ++done;
+    }
+
+    return done;
+}
+
+void ThreadPool::start( uint32 workerCount )
+{
+    uint32 i;
+
+    _threads.reserve( workerCount );
+    for ( i = 0; i < workerCount; ++i )
+    {
+        _threads.emplace( &ThreadPool::work, this );
+    }
+}
+
+} // End nspc thrd
+
+} // End nspc nge
@@ -0,0 +1,2 @@
+// equality.cpp
+#include "engine/utility/equality.h"
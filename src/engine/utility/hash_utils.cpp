@@ -8,11 +8,16 @@ namespace util
 {
 
 uint32 HashUtils::fnv1a( const String& value )
+{
+    return fnv1a( value.data(), value.length() );
+}
+
+uint32 HashUtils::fnv1a( const char* value, uint32 length )
 {
     uint32 hashCode = FNV_OFFSET_32;
     uint32 i;
 
-    for ( i = 0; i < value.length(); ++i )
+    for ( i = 0; i < length; ++i )
     {
         hashCode ^= value[i];
         hashCode *= FNV_PRIME_32;
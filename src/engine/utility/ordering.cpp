@@ -0,0 +1,2 @@
+// ordering.cpp
+#include "engine/utility/ordering.h"
@@ -0,0 +1,127 @@
+// bit_array.t.cpp
+#include <engine/containers/bit_array.h>
+#include <engine/memory/counting_allocator.h>
+#include <gtest/gtest.h>
+
+TEST( BitArray, Construction )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    CountingAllocator<uint64> alloc;
+
+    BitArray def;
+    BitArray sized( 100 );
+    BitArray withAlloc( &alloc );
+    BitArray withAllocAndSize( &alloc, 100 );
+    BitArray copy( sized );
+    BitArray move( std::move( copy ) );
+
+    EXPECT_TRUE( def.isEmpty() );
+    EXPECT_EQ( 100, sized.size() );
+    EXPECT_EQ( 2, sized.wordCount() );
+    EXPECT_TRUE( sized.none() );
+    EXPECT_LT( 0, alloc.getAllocationCount() );
+    EXPECT_EQ( sized, move );
+
+    withAllocAndSize.set( 42 );
+    copy = withAllocAndSize;
+    move = std::move( copy );
+    EXPECT_TRUE( move.test( 42 ) );
+    EXPECT_EQ( withAllocAndSize, move );
+}
+
+TEST( BitArray, SetTestAndGrow )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 1000;
+
+    BitArray bits;
+    uint32 i;
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        bits.push( i % 3 == 0 );
+    }
+
+    ASSERT_EQ( COUNT, bits.size() );
+    EXPECT_EQ( 334, bits.count() );
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_EQ( i % 3 == 0, bits.test( i ) );
+    }
+
+    bits.flip( 1 );
+    bits.clear( 0 );
+    bits.set( 2, true );
+    EXPECT_TRUE( bits.test( 1 ) );
+    EXPECT_FALSE( bits.test( 0 ) );
+    EXPECT_TRUE( bits.test( 2 ) );
+
+    // shrinking drops the bits and growing again brings back clear ones
+    bits.setAll();
+    EXPECT_TRUE( bits.all() );
+    bits.resize( 100 );
+    EXPECT_EQ( 100, bits.count() );
+    bits.resize( COUNT );
+    EXPECT_EQ( 100, bits.count() );
+    EXPECT_EQ( BitUtils::NOT_FOUND, bits.findNext( 99 ) );
+
+    bits.flipAll();
+    EXPECT_EQ( COUNT - 100, bits.count() );
+    EXPECT_EQ( 100, bits.findFirst() );
+
+    bits.setWord( bits.wordCount() - 1, ~static_cast<uint64>( 0 ) );
+    EXPECT_EQ( COUNT - 100, bits.count() );
+
+    bits.clearAll();
+    EXPECT_TRUE( bits.none() );
+    EXPECT_EQ( BitUtils::NOT_FOUND, bits.findFirst() );
+}
+
+TEST( BitArray, BitwiseOperators )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 300;
+
+    BitArray evens( COUNT );
+    BitArray threes( COUNT );
+    uint32 index;
+    uint32 i;
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        evens.set( i, i % 2 == 0 );
+        threes.set( i, i % 3 == 0 );
+    }
+
+    BitArray both( evens );
+    both &= threes;
+    BitArray either( evens );
+    either |= threes;
+    BitArray one( evens );
+    one ^= threes;
+
+    for ( i = 0, index = both.findFirst(); index != BitUtils::NOT_FOUND;
+          i += 6, index = both.findNext( index ) )
+    {
+        ASSERT_EQ( i, index );
+    }
+    EXPECT_EQ( COUNT, i );
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_EQ( i % 2 == 0 || i % 3 == 0, either.test( i ) );
+        ASSERT_EQ( ( i % 2 == 0 ) != ( i % 3 == 0 ), one.test( i ) );
+    }
+
+    one |= both;
+    EXPECT_EQ( either, one );
+    EXPECT_NE( either, both );
+    EXPECT_NE( either, BitArray( COUNT + 1 ) );
+}
@@ -0,0 +1,91 @@
+// container_registry.t.cpp
+#include <engine/containers/container_registry.h>
+#include <engine/containers/dynamic_array.h>
+#include <engine/containers/set.h>
+#include <gtest/gtest.h>
+#include <string.h>
+
+TEST( ContainerRegistry, AddAndRemove )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    ContainerRegistry registry;
+    DynamicArray<uint32> array;
+    Set<uint32> set;
+
+    EXPECT_EQ( 0, registry.size() );
+    registry.add( "scene", &array );
+    registry.add( "render", &set );
+    EXPECT_EQ( 2, registry.size() );
+
+    EXPECT_TRUE( registry.remove( &array ) );
+    EXPECT_FALSE( registry.remove( &array ) );
+    EXPECT_EQ( 1, registry.size() );
+    EXPECT_TRUE( registry.remove( &set ) );
+    EXPECT_EQ( 0, registry.size() );
+}
+
+TEST( ContainerRegistry, Snapshot )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    ContainerRegistry registry;
+    DynamicArray<uint32> first;
+    DynamicArray<uint32> second;
+    Set<uint32> set;
+
+    registry.add( "scene", &first );
+    registry.add( "scene", &second );
+    registry.add( "render", &set );
+
+    first.push( 1 );
+    second.push( 1 );
+    second.push( 2 );
+    set.add( 3 );
+
+    DynamicArray<ContainerRegistry::Entry> entries;
+    registry.snapshot( &entries );
+    EXPECT_EQ( 3, entries.size() );
+
+    // snapshots read the containers when they are taken
+    registry.snapshot( "scene", &entries );
+    ASSERT_EQ( 2, entries.size() );
+    uint32 i;
+    for ( i = 0; i < entries.size(); ++i )
+    {
+        EXPECT_EQ( 0, strcmp( "scene", entries[i].tag ) );
+        const DynamicArray<uint32>* array =
+            static_cast<const DynamicArray<uint32>*>( entries[i].container );
+        EXPECT_EQ( array->size(), entries[i].stats.size );
+    }
+
+    registry.snapshot( "render", &entries );
+    ASSERT_EQ( 1, entries.size() );
+    EXPECT_EQ( &set, entries[0].container );
+    EXPECT_EQ( 1, entries[0].stats.size );
+    EXPECT_LT( 0, entries[0].stats.bucketCount );
+
+    registry.snapshot( "missing", &entries );
+    EXPECT_EQ( 0, entries.size() );
+
+    registry.remove( &first );
+    registry.remove( &second );
+    registry.remove( &set );
+}
+
+TEST( ContainerRegistry, Global )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    DynamicArray<uint32> array;
+    ContainerRegistry::global().add( "global", &array );
+    EXPECT_EQ( &ContainerRegistry::global(), &ContainerRegistry::global() );
+
+    DynamicArray<ContainerRegistry::Entry> entries;
+    ContainerRegistry::global().snapshot( "global", &entries );
+    EXPECT_EQ( 1, entries.size() );
+    EXPECT_TRUE( ContainerRegistry::global().remove( &array ) );
+}
@@ -0,0 +1,141 @@
+// container_stats.t.cpp
+#include <engine/containers/bit_array.h>
+#include <engine/containers/container_stats.h>
+#include <engine/containers/dynamic_array.h>
+#include <engine/containers/fixed_bitset.h>
+#include <engine/containers/flat_map.h>
+#include <engine/containers/list.h>
+#include <engine/containers/map.h>
+#include <engine/containers/set.h>
+#include <engine/containers/slot_map.h>
+#include <engine/containers/small_array.h>
+#include <gtest/gtest.h>
+
+TEST( ContainerStats, Construction )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    const ContainerStats stats;
+    EXPECT_EQ( 0, stats.size );
+    EXPECT_EQ( 0, stats.capacity );
+    EXPECT_EQ( 0, stats.bytesUsed );
+    EXPECT_EQ( 0, stats.bytesReserved );
+    EXPECT_EQ( 0, stats.freeCount );
+    EXPECT_EQ( 0, stats.bucketCount );
+    EXPECT_EQ( 0, stats.maxProbeLength );
+    EXPECT_EQ( 0.0f, stats.loadFactor() );
+    EXPECT_EQ( 0, stats.bytesWasted() );
+}
+
+TEST( ContainerStats, Arrays )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    DynamicArray<uint64> array;
+    uint32 i;
+    for ( i = 0; i < 40; ++i )
+    {
+        array.push( i );
+    }
+
+    ContainerStats stats = array.stats();
+    EXPECT_EQ( 40, stats.size );
+    EXPECT_EQ( array.capacity(), stats.capacity );
+    EXPECT_EQ( 40 * sizeof( uint64 ), stats.bytesUsed );
+    EXPECT_EQ( array.capacity() * sizeof( uint64 ), stats.bytesReserved );
+    EXPECT_FLOAT_EQ( 40.0f / array.capacity(), stats.loadFactor() );
+    EXPECT_EQ( stats.bytesReserved - stats.bytesUsed, stats.bytesWasted() );
+
+    SmallArray<uint32, 4> small;
+    small.push( 1 );
+    stats = small.stats();
+    EXPECT_EQ( 1, stats.size );
+    EXPECT_EQ( 4, stats.capacity );
+    EXPECT_EQ( 0, stats.bytesReserved );
+
+    for ( i = 0; i < 8; ++i )
+    {
+        small.push( i );
+    }
+    EXPECT_EQ( small.capacity() * sizeof( uint32 ),
+               small.stats().bytesReserved );
+
+    BitArray bits( 100 );
+    stats = bits.stats();
+    EXPECT_EQ( 100, stats.size );
+    EXPECT_EQ( 128, stats.capacity );
+    EXPECT_EQ( 2 * sizeof( uint64 ), stats.bytesUsed );
+
+    FixedBitset<70> fixed;
+    stats = fixed.stats();
+    EXPECT_EQ( 70, stats.size );
+    EXPECT_EQ( 0, stats.bytesReserved );
+}
+
+TEST( ContainerStats, FreeLists )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    List<uint32> list;
+    uint32 i;
+    for ( i = 0; i < 10; ++i )
+    {
+        list.push( i );
+    }
+
+    ContainerStats stats = list.stats();
+    EXPECT_EQ( 10, stats.size );
+    EXPECT_EQ( list.capacity(), stats.capacity );
+    EXPECT_EQ( stats.capacity - stats.size, stats.freeCount );
+    EXPECT_EQ( stats.capacity * sizeof( List<uint32>::Node ),
+               stats.bytesReserved );
+
+    SlotMap<uint32> slots;
+    const SlotMap<uint32>::Handle first = slots.insert( 1 );
+    const SlotMap<uint32>::Handle second = slots.insert( 2 );
+    slots.insert( 3 );
+    slots.remove( first );
+    slots.remove( second );
+
+    stats = slots.stats();
+    EXPECT_EQ( 1, stats.size );
+    EXPECT_EQ( 2, stats.freeCount );
+    EXPECT_LT( stats.bytesUsed, stats.bytesReserved );
+}
+
+TEST( ContainerStats, Hashed )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    Set<uint32> set;
+    Map<uint32, uint32> map;
+    uint32 i;
+    for ( i = 0; i < 100; ++i )
+    {
+        set.add( i );
+        map.assign( i, i * 2 );
+    }
+
+    ContainerStats stats = set.stats();
+    EXPECT_EQ( 100, stats.size );
+    EXPECT_LT( 100, stats.bucketCount );
+    EXPECT_EQ( set.maxProbeLength(), stats.maxProbeLength );
+    EXPECT_GT( stats.bytesReserved,
+               static_cast<uint64>( stats.capacity ) * sizeof( uint32 ) );
+    EXPECT_FLOAT_EQ( 100.0f / stats.bucketCount, stats.loadFactor() );
+
+    stats = map.stats();
+    EXPECT_EQ( 100, stats.size );
+    EXPECT_EQ( 100 * sizeof( Map<uint32, uint32>::KVPair ), stats.bytesUsed );
+    EXPECT_EQ( map.maxProbeLength(), stats.maxProbeLength );
+
+    FlatMap<uint32, uint32> flat;
+    flat.assign( 1, 2 );
+    EXPECT_EQ( 1, flat.stats().size );
+    EXPECT_EQ( sizeof( FlatMap<uint32, uint32>::KVPair ),
+               flat.stats().bytesUsed );
+}
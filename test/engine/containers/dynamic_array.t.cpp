@@ -1,6 +1,8 @@
 // dynamic_array.t.cpp
 #include <engine/containers/dynamic_array.h>
 #include <gtest/gtest.h>
+#include <string>
+#include <vector>
 
 TEST( DynamicArray, ConstructionAndAssignment )
 {
@@ -192,4 +194,241 @@ TEST( DynamicArray, Iterator )
     }
 
     EXPECT_THROW( list.at( 65 ), std::runtime_error );
-}
\ No newline at end of file
+}
+
+TEST( DynamicArray, Reserve )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    DynamicArray<uint32> array;
+    uint32 i;
+
+    array.push( 1 );
+    array.pushFront( 0 );
+
+    array.reserve( 1000 );
+    EXPECT_LE( 1000, array.capacity() );
+    EXPECT_EQ( 0, array.capacity() & ( array.capacity() - 1 ) );
+
+    const uint32 capacity = array.capacity();
+    array.reserve( 10 );
+    EXPECT_EQ( capacity, array.capacity() );
+
+    ASSERT_EQ( 2, array.size() );
+    EXPECT_EQ( 0, array[0] );
+    EXPECT_EQ( 1, array[1] );
+
+    for ( i = 2; i < 1000; ++i )
+    {
+        array.push( i );
+    }
+    EXPECT_EQ( capacity, array.capacity() );
+}
+
+template <typename T, typename F>
+static void checkShiftsAcrossTheWrapPoint( F makeValue )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    DynamicArray<T> array;
+    std::vector<T> expected;
+    uint32 i;
+    uint32 j;
+
+    // start the items near the end of the block so they wrap around
+    for ( i = 0; i < 20; ++i )
+    {
+        array.pushFront( makeValue( i ) );
+        expected.insert( expected.begin(), makeValue( i ) );
+    }
+
+    for ( i = 0; i < 200; ++i )
+    {
+        const uint32 index = ( i * 7 ) % ( array.size() + 1 );
+        if ( i % 3 == 2 )
+        {
+            const uint32 removeIndex = index % array.size();
+            ASSERT_EQ( expected[removeIndex], array.removeAt( removeIndex ) );
+            expected.erase( expected.begin() + removeIndex );
+        }
+        else
+        {
+            array.insertAt( index, makeValue( 1000 + i ) );
+            expected.insert( expected.begin() + index, makeValue( 1000 + i ) );
+        }
+
+        ASSERT_EQ( expected.size(), array.size() );
+        for ( j = 0; j < array.size(); ++j )
+        {
+            ASSERT_EQ( expected[j], array[j] );
+        }
+    }
+
+    DynamicArray<T> copy( array );
+    DynamicArray<T> assigned;
+    assigned = array;
+    for ( j = 0; j < array.size(); ++j )
+    {
+        ASSERT_EQ( expected[j], copy[j] );
+        ASSERT_EQ( expected[j], assigned[j] );
+    }
+
+    DynamicArray<T> moved( std::move( copy ) );
+    assigned = std::move( moved );
+    for ( j = 0; j < array.size(); ++j )
+    {
+        ASSERT_EQ( expected[j], assigned[j] );
+    }
+}
+
+TEST( DynamicArray, ShiftsAcrossTheWrapPoint )
+{
+    using namespace nge;
+
+    checkShiftsAcrossTheWrapPoint<uint32>( []( uint32 i ) { return i; } );
+    checkShiftsAcrossTheWrapPoint<std::string>( []( uint32 i ) {
+        return std::to_string( i );
+    } );
+}
+
+TEST( DynamicArray, Remove )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    DynamicArray<std::string> array;
+    array.push( "a" );
+    array.push( "b" );
+
+    EXPECT_TRUE( array.remove( "a" ) );
+    EXPECT_FALSE( array.remove( "a" ) );
+    ASSERT_EQ( 1, array.size() );
+    EXPECT_EQ( "b", array[0] );
+}
+
+namespace
+{
+
+/**
+ * An item without a default constructor that counts how it is constructed.
+ */
+struct Counted
+{
+    static nge::uint32 s_constructs;
+    static nge::uint32 s_moves;
+    static nge::uint32 s_destructs;
+
+    nge::uint32 value;
+
+    explicit Counted( nge::uint32 v ) : value( v ) { ++s_constructs; }
+    Counted( const Counted& c ) : value( c.value ) { ++s_constructs; }
+    Counted( Counted&& c ) : value( c.value ) { ++s_moves; }
+    ~Counted() { ++s_destructs; }
+    Counted& operator=( const Counted& ) = default;
+    Counted& operator=( Counted&& ) = default;
+};
+
+nge::uint32 Counted::s_constructs = 0;
+nge::uint32 Counted::s_moves = 0;
+nge::uint32 Counted::s_destructs = 0;
+
+} // End nspc anonymous
+
+TEST( DynamicArray, ConstructsOnlyLiveItems )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 100;
+
+    {
+        DynamicArray<Counted> array;
+        uint32 i;
+        for ( i = 0; i < 32; ++i )
+        {
+            array.push( Counted( i ) );
+        }
+
+        // filling the initial block only constructs the pushed items
+        EXPECT_EQ( 32, Counted::s_constructs );
+        EXPECT_EQ( 32, Counted::s_moves );
+
+        // growing moves each live item exactly once
+        array.push( Counted( 32 ) );
+        EXPECT_EQ( 33, Counted::s_constructs );
+        EXPECT_EQ( 32 + 32 + 1, Counted::s_moves );
+
+        for ( i = 33; i < COUNT; ++i )
+        {
+            array.pushFront( Counted( i ) );
+        }
+
+        array.insertAt( 10, Counted( COUNT ) );
+        array.removeAt( 20 );
+        array.pop();
+        array.popFront();
+
+        DynamicArray<Counted> copy( array );
+        EXPECT_EQ( array.size(), copy.size() );
+        for ( i = 0; i < array.size(); ++i )
+        {
+            ASSERT_EQ( array[i].value, copy[i].value );
+        }
+
+        copy.clear();
+        EXPECT_EQ( 0, copy.size() );
+    }
+
+    // every construction was matched by a destruction
+    EXPECT_EQ( Counted::s_constructs + Counted::s_moves,
+               Counted::s_destructs );
+}
+
+TEST( DynamicArray, Emplace )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    DynamicArray<Counted> array;
+    uint32 i;
+
+    const uint32 constructs = Counted::s_constructs;
+    const uint32 moves = Counted::s_moves;
+    for ( i = 0; i < 32; ++i )
+    {
+        ASSERT_EQ( i, array.emplace( i ).value );
+    }
+
+    // emplacing constructs each value once and never moves it
+    EXPECT_EQ( constructs + 32, Counted::s_constructs );
+    EXPECT_EQ( moves, Counted::s_moves );
+
+    EXPECT_EQ( 100, array.emplaceFront( 100 ).value );
+    EXPECT_EQ( 200, array.emplaceAt( 5, 200 ).value );
+    EXPECT_EQ( 300, array.emplaceAt( array.size(), 300 ).value );
+    EXPECT_THROW( array.emplaceAt( array.size() + 1, 0 ), std::runtime_error );
+
+    ASSERT_EQ( 35, array.size() );
+    EXPECT_EQ( 100, array[0].value );
+    EXPECT_EQ( 3, array[4].value );
+    EXPECT_EQ( 200, array[5].value );
+    EXPECT_EQ( 4, array[6].value );
+    EXPECT_EQ( 300, array[34].value );
+
+    DynamicArray<std::string> strings;
+    EXPECT_EQ( "aaa", strings.emplace( 3, 'a' ) );
+    EXPECT_EQ( "bb", strings.emplaceFront( 2, 'b' ) );
+    EXPECT_EQ( "c", strings.emplaceAt( 1, 1, 'c' ) );
+    EXPECT_EQ( "bb", strings[0] );
+    EXPECT_EQ( "c", strings[1] );
+    EXPECT_EQ( "aaa", strings[2] );
+
+    // a throwing constructor leaves the array as it was
+    EXPECT_THROW( strings.emplaceAt( 1, std::string::npos, 'd' ),
+                  std::length_error );
+    ASSERT_EQ( 3, strings.size() );
+    EXPECT_EQ( "c", strings[1] );
+    EXPECT_EQ( "aaa", strings[2] );
+}
@@ -1,6 +1,7 @@
 // fixed_array.t.cpp
 #include <engine/containers/fixed_array.h>
 #include <gtest/gtest.h>
+#include <string>
 
 TEST( FixedArray, ConstructionAndAssignment )
 {
@@ -192,4 +193,30 @@ TEST( FixedArray, Iterator )
     }
 
     EXPECT_THROW( list.at( SIZE + 1 ), std::runtime_error );
-}
\ No newline at end of file
+}
+TEST( FixedArray, Emplace )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    FixedArray<std::string> array( 8 );
+
+    EXPECT_EQ( "aaa", array.emplace( 3, 'a' ) );
+    EXPECT_EQ( "bb", array.emplaceFront( 2, 'b' ) );
+    EXPECT_EQ( "c", array.emplaceAt( 1, 1, 'c' ) );
+    EXPECT_EQ( "dddd", array.emplaceAt( 3, 4, 'd' ) );
+    EXPECT_THROW( array.emplaceAt( 5, 1, 'e' ), std::runtime_error );
+
+    ASSERT_EQ( 4, array.size() );
+    EXPECT_EQ( "bb", array[0] );
+    EXPECT_EQ( "c", array[1] );
+    EXPECT_EQ( "aaa", array[2] );
+    EXPECT_EQ( "dddd", array[3] );
+
+    // a throwing constructor leaves the array as it was
+    EXPECT_THROW( array.emplaceAt( 1, std::string::npos, 'e' ),
+                  std::length_error );
+    ASSERT_EQ( 4, array.size() );
+    EXPECT_EQ( "c", array[1] );
+    EXPECT_EQ( "dddd", array[3] );
+}
@@ -0,0 +1,108 @@
+// fixed_bitset.t.cpp
+#include <engine/containers/fixed_bitset.h>
+#include <gtest/gtest.h>
+
+TEST( FixedBitset, SetTestAndClear )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    FixedBitset<130> bits;
+    uint32 i;
+
+    EXPECT_EQ( 130, bits.size() );
+    EXPECT_EQ( 3, bits.wordCount() );
+    EXPECT_TRUE( bits.none() );
+
+    for ( i = 0; i < 130; i += 3 )
+    {
+        bits.set( i );
+    }
+
+    EXPECT_EQ( 44, bits.count() );
+    for ( i = 0; i < 130; ++i )
+    {
+        ASSERT_EQ( i % 3 == 0, bits.test( i ) );
+    }
+
+    bits.clear( 0 );
+    bits.flip( 1 );
+    bits.set( 129, true );
+    bits.set( 3, false );
+    EXPECT_FALSE( bits.test( 0 ) );
+    EXPECT_TRUE( bits.test( 1 ) );
+    EXPECT_TRUE( bits.test( 129 ) );
+    EXPECT_FALSE( bits.test( 3 ) );
+
+    bits.setAll();
+    EXPECT_TRUE( bits.all() );
+    EXPECT_EQ( 130, bits.count() );
+
+    // the bits past the end of the set stay clear
+    EXPECT_EQ( 3, bits.word( 2 ) );
+    bits.setWord( 2, ~static_cast<uint64>( 0 ) );
+    EXPECT_EQ( 3, bits.word( 2 ) );
+
+    bits.clearAll();
+    EXPECT_TRUE( bits.none() );
+}
+
+TEST( FixedBitset, Find )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    FixedBitset<200> bits;
+    uint32 index;
+    uint32 i;
+
+    EXPECT_EQ( BitUtils::NOT_FOUND, bits.findFirst() );
+
+    for ( i = 5; i < 200; i += 7 )
+    {
+        bits.set( i );
+    }
+
+    for ( i = 5, index = bits.findFirst(); index != BitUtils::NOT_FOUND;
+          i += 7, index = bits.findNext( index ) )
+    {
+        ASSERT_EQ( i, index );
+    }
+    EXPECT_LE( 200, i );
+    EXPECT_EQ( BitUtils::NOT_FOUND, bits.findNext( 199 ) );
+}
+
+TEST( FixedBitset, BitwiseOperators )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    FixedBitset<70> evens;
+    FixedBitset<70> threes;
+    uint32 i;
+
+    for ( i = 0; i < 70; ++i )
+    {
+        evens.set( i, i % 2 == 0 );
+        threes.set( i, i % 3 == 0 );
+    }
+
+    const FixedBitset<70> both = evens & threes;
+    const FixedBitset<70> either = evens | threes;
+    const FixedBitset<70> one = evens ^ threes;
+    const FixedBitset<70> odds = ~evens;
+
+    for ( i = 0; i < 70; ++i )
+    {
+        ASSERT_EQ( i % 6 == 0, both.test( i ) );
+        ASSERT_EQ( i % 2 == 0 || i % 3 == 0, either.test( i ) );
+        ASSERT_EQ( ( i % 2 == 0 ) != ( i % 3 == 0 ), one.test( i ) );
+        ASSERT_EQ( i % 2 == 1, odds.test( i ) );
+    }
+
+    EXPECT_EQ( 35, odds.count() );
+    EXPECT_TRUE( ( odds | evens ).all() );
+    EXPECT_TRUE( ( odds & evens ).none() );
+    EXPECT_EQ( either, both | one );
+    EXPECT_NE( either, both );
+}
@@ -0,0 +1,141 @@
+// flat_map.t.cpp
+#include <engine/containers/flat_map.h>
+#include <engine/memory/counting_allocator.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+struct Descending
+{
+    static bool less( nge::uint32 lhs, nge::uint32 rhs )
+    {
+        return lhs > rhs;
+    }
+};
+
+} // End nspc anonymous
+
+TEST( FlatMap, Construction )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    CountingAllocator<FlatMap<std::string, uint32>::KVPair> alloc;
+
+    FlatMap<std::string, uint32> def;
+    FlatMap<std::string, uint32> cap( 100 );
+    FlatMap<std::string, uint32> withAlloc( &alloc );
+    FlatMap<std::string, uint32> withAllocAndCap( &alloc, 100 );
+    FlatMap<std::string, uint32> copy( def );
+    FlatMap<std::string, uint32> move( std::move( copy ) );
+
+    EXPECT_LT( 0, alloc.getAllocationCount() );
+
+    withAlloc.assign( "key", 1 );
+    copy = withAlloc;
+    move = std::move( copy );
+    ASSERT_NE( nullptr, move.lookup( "key" ) );
+    EXPECT_EQ( 1, *move.lookup( "key" ) );
+}
+
+TEST( FlatMap, AssignLookupAndRemove )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 200;
+
+    FlatMap<uint32, uint32> map;
+    uint32 i;
+
+    // assign the keys out of order so most of them land in the middle
+    for ( i = 0; i < COUNT; ++i )
+    {
+        map.assign( ( i * 37 ) % COUNT, i );
+    }
+
+    ASSERT_EQ( COUNT, map.size() );
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_EQ( i, map[i].key );
+        ASSERT_EQ( i, map.indexOf( i ) );
+        ASSERT_TRUE( map.hasKey( i ) );
+    }
+
+    map.assign( 5, 1000 );
+    EXPECT_EQ( COUNT, map.size() );
+    EXPECT_EQ( 1000, *map.lookup( 5 ) );
+    EXPECT_EQ( nullptr, map.lookup( COUNT ) );
+    EXPECT_EQ( static_cast<uint32>( -1 ), map.indexOf( COUNT ) );
+
+    for ( i = 0; i < COUNT; i += 2 )
+    {
+        map.remove( i );
+    }
+    map.remove( COUNT );
+
+    ASSERT_EQ( COUNT / 2, map.size() );
+
+    FlatMap<uint32, uint32>::ConstIterator iter;
+    for ( i = 1, iter = map.cbegin(); iter != map.cend(); i += 2, ++iter )
+    {
+        ASSERT_EQ( i, iter->key );
+    }
+
+    map.clear();
+    EXPECT_TRUE( map.isEmpty() );
+}
+
+TEST( FlatMap, AssignAll )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 1000;
+
+    FlatMap<uint32, uint32>::KVPair pairs[COUNT];
+    uint32 i;
+
+    // every key appears twice and the second value should win
+    for ( i = 0; i < COUNT; ++i )
+    {
+        pairs[i].key = ( COUNT - 1 - i ) % ( COUNT / 2 );
+        pairs[i].value = i;
+    }
+
+    FlatMap<uint32, uint32> map;
+    map.assign( 0, 0 );
+    map.assign( COUNT, 0 );
+    map.assignAll( pairs, COUNT );
+    map.assignAll( nullptr, 0 );
+
+    ASSERT_EQ( COUNT / 2 + 1, map.size() );
+    for ( i = 0; i < COUNT / 2; ++i )
+    {
+        ASSERT_EQ( i, map[i].key );
+        ASSERT_EQ( COUNT - 1 - i, map[i].value );
+    }
+    EXPECT_EQ( COUNT, map[COUNT / 2].key );
+}
+
+TEST( FlatMap, Ordering )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    FlatMap<uint32, uint32, Descending> map;
+    uint32 i;
+
+    for ( i = 0; i < 10; ++i )
+    {
+        map.assign( i, i );
+    }
+
+    for ( i = 0; i < 10; ++i )
+    {
+        ASSERT_EQ( 9 - i, map[i].key );
+        ASSERT_EQ( i, *map.lookup( i ) );
+    }
+}
@@ -0,0 +1,102 @@
+// flat_set.t.cpp
+#include <engine/containers/flat_set.h>
+#include <engine/memory/counting_allocator.h>
+#include <gtest/gtest.h>
+
+TEST( FlatSet, Construction )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    CountingAllocator<uint32> alloc;
+
+    FlatSet<uint32> def;
+    FlatSet<uint32> cap( 100 );
+    FlatSet<uint32> withAlloc( &alloc );
+    FlatSet<uint32> withAllocAndCap( &alloc, 100 );
+    FlatSet<uint32> copy( def );
+    FlatSet<uint32> move( std::move( copy ) );
+
+    EXPECT_LT( 0, alloc.getAllocationCount() );
+
+    withAlloc.add( 1 );
+    copy = withAlloc;
+    move = std::move( copy );
+    EXPECT_TRUE( move.has( 1 ) );
+}
+
+TEST( FlatSet, AddHasAndRemove )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 200;
+
+    FlatSet<std::string> set;
+    uint32 i;
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        set.add( std::to_string( 1000 + ( i * 37 ) % COUNT ) );
+        set.add( std::to_string( 1000 + ( i * 37 ) % COUNT ) );
+    }
+
+    ASSERT_EQ( COUNT, set.size() );
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_EQ( std::to_string( 1000 + i ), set[i] );
+        ASSERT_EQ( i, set.indexOf( std::to_string( 1000 + i ) ) );
+    }
+
+    for ( i = 0; i < COUNT; i += 2 )
+    {
+        set.remove( std::to_string( 1000 + i ) );
+    }
+    set.remove( "missing" );
+
+    ASSERT_EQ( COUNT / 2, set.size() );
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_EQ( i % 2 == 1, set.has( std::to_string( 1000 + i ) ) );
+    }
+
+    FlatSet<std::string>::ConstIterator iter;
+    for ( i = 1, iter = set.cbegin(); iter != set.cend(); i += 2, ++iter )
+    {
+        ASSERT_EQ( std::to_string( 1000 + i ), *iter );
+    }
+
+    set.clear();
+    EXPECT_TRUE( set.isEmpty() );
+}
+
+TEST( FlatSet, AddAll )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 1000;
+
+    uint32 values[COUNT];
+    uint32 i;
+
+    // every value appears twice
+    for ( i = 0; i < COUNT; ++i )
+    {
+        values[i] = ( COUNT - 1 - i ) % ( COUNT / 2 );
+    }
+
+    FlatSet<uint32> set;
+    set.add( 0 );
+    set.add( COUNT );
+    set.addAll( values, COUNT );
+    set.addAll( nullptr, 0 );
+
+    ASSERT_EQ( COUNT / 2 + 1, set.size() );
+    for ( i = 0; i < COUNT / 2; ++i )
+    {
+        ASSERT_EQ( i, set[i] );
+    }
+    EXPECT_EQ( COUNT, set[COUNT / 2] );
+}
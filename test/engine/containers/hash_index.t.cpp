@@ -0,0 +1,132 @@
+// hash_index.t.cpp
+#include <engine/containers/hash_index.h>
+#include <gtest/gtest.h>
+
+TEST( HashIndex, Construction )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    DefaultAllocator<uint32> alloc;
+
+    HashIndex def;
+    HashIndex capacity( 100 );
+    HashIndex withAlloc( &alloc );
+    HashIndex withAllocAndCapacity( &alloc, 100 );
+    HashIndex copy( capacity );
+    HashIndex move( std::move( copy ) );
+
+    EXPECT_EQ( HashIndex::MIN_BINS, def.binCount() );
+    EXPECT_EQ( 0, def.size() );
+    EXPECT_LE( 100, capacity.binCount() );
+    EXPECT_EQ( capacity.binCount(), move.binCount() );
+
+    def = capacity;
+    def = std::move( move );
+}
+
+TEST( HashIndex, InsertFindAndErase )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 200;
+
+    HashIndex index( COUNT );
+    uint32 hashes[COUNT];
+    uint32 bins[COUNT];
+    uint32 i;
+
+    // every fourth item shares a hash code to force fingerprint collisions
+    for ( i = 0; i < COUNT; ++i )
+    {
+        hashes[i] = ( i % 4 == 0 ) ? 0xABCD : i * 2654435761u;
+        bins[i] = index.insert( hashes[i], i );
+    }
+
+    EXPECT_EQ( COUNT, index.size() );
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_EQ( bins[i], index.find( hashes[i], [i]( uint32 item ) {
+            return item == i;
+        } ) );
+        ASSERT_EQ( i, index.itemAt( bins[i] ) );
+    }
+
+    for ( i = 0; i < COUNT; i += 2 )
+    {
+        index.erase( bins[i] );
+    }
+
+    EXPECT_EQ( COUNT / 2, index.size() );
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        const uint32 bin = index.find( hashes[i], [i]( uint32 item ) {
+            return item == i;
+        } );
+        ASSERT_EQ( i % 2 == 0 ? HashIndex::NOT_FOUND : bins[i], bin );
+    }
+
+    index.setItemAt( bins[1], 1000 );
+    EXPECT_EQ( 1000, index.itemAt( bins[1] ) );
+
+    index.clear();
+    EXPECT_EQ( 0, index.size() );
+    EXPECT_EQ( HashIndex::NOT_FOUND, index.find( hashes[1], []( uint32 ) {
+        return true;
+    } ) );
+}
+
+TEST( HashIndex, GrowAndShrink )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 1024;
+
+    HashIndex index;
+    uint32 hashes[COUNT];
+    uint32 i;
+
+    auto hashOf = [&hashes]( uint32 item ) { return hashes[item]; };
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        hashes[i] = i * 2654435761u;
+        if ( index.shouldGrow() )
+        {
+            index.grow( hashOf );
+        }
+
+        index.insert( hashes[i], i );
+    }
+
+    EXPECT_LE( HashIndex::binsFor( COUNT ), index.binCount() );
+    EXPECT_LE( index.meanProbeLength( hashOf ),
+               index.maxProbeLength( hashOf ) );
+    EXPECT_GT( index.binCount() / HashIndex::GROUP_SIZE,
+               index.maxProbeLength( hashOf ) );
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_NE( HashIndex::NOT_FOUND,
+                   index.find( hashes[i], [i]( uint32 item ) {
+                       return item == i;
+                   } ) );
+    }
+
+    index.rehash( HashIndex::binsFor( 10 ), 10, hashOf );
+    EXPECT_EQ( 10, index.size() );
+    EXPECT_TRUE( index.shouldShrink() == false );
+
+    for ( i = 0; i < 10; ++i )
+    {
+        ASSERT_NE( HashIndex::NOT_FOUND,
+                   index.find( hashes[i], [i]( uint32 item ) {
+                       return item == i;
+                   } ) );
+    }
+}
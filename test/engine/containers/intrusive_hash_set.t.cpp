@@ -0,0 +1,144 @@
+// intrusive_hash_set.t.cpp
+#include <engine/containers/intrusive_hash_set.h>
+#include <engine/memory/counting_allocator.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+struct Item : public nge::cntr::IntrusiveSetHook<>
+{
+    nge::uint32 key;
+
+    explicit Item( nge::uint32 itemKey = 0 ) : key( itemKey )
+    {
+    }
+};
+
+struct ItemPolicy
+{
+    static nge::uint32 hash( const Item& item )
+    {
+        return item.key;
+    }
+
+    static bool equals( const Item& lhs, const Item& rhs )
+    {
+        return lhs.key == rhs.key;
+    }
+};
+
+typedef nge::cntr::IntrusiveHashSet<Item, ItemPolicy, ItemPolicy> ItemSet;
+
+} // End nspc anonymous
+
+TEST( IntrusiveHashSet, AddFindAndRemove )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 500;
+
+    Item items[COUNT];
+    Item duplicate( 7 );
+    ItemSet set;
+    uint32 i;
+
+    EXPECT_EQ( 0, set.bucketCount() );
+    EXPECT_FALSE( set.has( duplicate ) );
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        items[i].key = i;
+        ASSERT_TRUE( set.add( items[i] ) );
+    }
+
+    EXPECT_FALSE( set.add( duplicate ) );
+    EXPECT_FALSE( duplicate.isLinked() );
+    ASSERT_EQ( COUNT, set.size() );
+    EXPECT_LE( COUNT, set.bucketCount() );
+    EXPECT_EQ( &items[7], set.find( duplicate ) );
+
+    for ( i = 0; i < COUNT; i += 2 )
+    {
+        set.remove( items[i] );
+        ASSERT_FALSE( items[i].isLinked() );
+    }
+
+    ASSERT_EQ( COUNT / 2, set.size() );
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_EQ( i % 2 == 1, set.has( Item( i ) ) );
+    }
+
+    // every remaining item is visited once
+    uint32 visited = 0;
+    uint32 sum = 0;
+    for ( ItemSet::Iterator iter = set.begin(); iter != set.end(); ++iter )
+    {
+        ++visited;
+        sum += iter->key;
+        ASSERT_EQ( 1, ( *iter ).key % 2 );
+    }
+    EXPECT_EQ( COUNT / 2, visited );
+    EXPECT_EQ( ( COUNT / 2 ) * ( COUNT / 2 ), sum );
+
+    set.clear();
+    EXPECT_TRUE( set.isEmpty() );
+    EXPECT_EQ( set.begin(), set.end() );
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_FALSE( items[i].isLinked() );
+    }
+}
+
+TEST( IntrusiveHashSet, ReserveAndMove )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    constexpr uint32 COUNT = 100;
+
+    CountingAllocator<ItemSet::Hook*> alloc;
+    Item items[COUNT];
+    uint32 i;
+
+    {
+        ItemSet set( &alloc, COUNT );
+        const uint32 buckets = set.bucketCount();
+        const uint32 allocations = alloc.getAllocationCount();
+
+        // the reserved buckets take every item without reallocating
+        for ( i = 0; i < COUNT; ++i )
+        {
+            items[i].key = i * 16;
+            set.add( items[i] );
+        }
+        EXPECT_EQ( buckets, set.bucketCount() );
+        EXPECT_EQ( allocations, alloc.getAllocationCount() );
+
+        ItemSet moved( std::move( set ) );
+        EXPECT_TRUE( set.isEmpty() );
+        EXPECT_EQ( COUNT, moved.size() );
+
+        // removing through a moved set still patches the chains
+        for ( i = 0; i < COUNT; i += 3 )
+        {
+            moved.remove( items[i] );
+        }
+        for ( i = 0; i < COUNT; ++i )
+        {
+            ASSERT_EQ( i % 3 != 0, moved.has( Item( i * 16 ) ) );
+        }
+
+        set = std::move( moved );
+        EXPECT_EQ( COUNT - 34, set.size() );
+    }
+
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_FALSE( items[i].isLinked() );
+    }
+}
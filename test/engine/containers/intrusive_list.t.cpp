@@ -0,0 +1,118 @@
+// intrusive_list.t.cpp
+#include <engine/containers/intrusive_list.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+struct Tick;
+struct Draw;
+
+struct Entity : public nge::cntr::IntrusiveListHook<Tick>,
+                public nge::cntr::IntrusiveListHook<Draw>
+{
+    nge::uint32 id;
+
+    explicit Entity( nge::uint32 entityId = 0 ) : id( entityId )
+    {
+    }
+};
+
+} // End nspc anonymous
+
+TEST( IntrusiveList, LinkAndUnlink )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 10;
+
+    Entity entities[COUNT];
+    IntrusiveList<Entity, Tick> list;
+    uint32 i;
+
+    EXPECT_TRUE( list.isEmpty() );
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        entities[i].id = i;
+        list.push( entities[i] );
+    }
+
+    ASSERT_EQ( COUNT, list.size() );
+    EXPECT_EQ( 0, list.front().id );
+    EXPECT_EQ( COUNT - 1, list.back().id );
+
+    // unlink from the middle, the front and the back
+    list.remove( entities[5] );
+    EXPECT_EQ( 0, list.popFront().id );
+    EXPECT_EQ( COUNT - 1, list.pop().id );
+    EXPECT_FALSE( entities[5].IntrusiveListHook<Tick>::isLinked() );
+    EXPECT_EQ( &entities[6], list.next( entities[4] ) );
+    EXPECT_EQ( &entities[4], list.prev( entities[6] ) );
+    EXPECT_EQ( nullptr, list.prev( entities[1] ) );
+    EXPECT_EQ( nullptr, list.next( entities[8] ) );
+
+    list.insertAfter( entities[4], entities[5] );
+    list.pushFront( entities[0] );
+    list.insertBefore( entities[0], entities[9] );
+
+    const uint32 expected[] = { 9, 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+    IntrusiveList<Entity, Tick>::Iterator iter;
+    for ( i = 0, iter = list.begin(); iter != list.end(); ++i, ++iter )
+    {
+        ASSERT_EQ( expected[i], iter->id );
+    }
+    EXPECT_EQ( COUNT, i );
+
+    // moving keeps the items linked in order
+    IntrusiveList<Entity, Tick> moved( std::move( list ) );
+    EXPECT_TRUE( list.isEmpty() );
+    EXPECT_EQ( list.cbegin(), list.cend() );
+    IntrusiveList<Entity, Tick>::ConstIterator citer;
+    for ( i = 0, citer = moved.cbegin(); citer != moved.cend(); ++i, ++citer )
+    {
+        ASSERT_EQ( expected[i], ( *citer ).id );
+    }
+
+    list = std::move( moved );
+    EXPECT_EQ( COUNT, list.size() );
+
+    list.clear();
+    EXPECT_TRUE( list.isEmpty() );
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_FALSE( entities[i].IntrusiveListHook<Tick>::isLinked() );
+    }
+}
+
+TEST( IntrusiveList, SeparateHooks )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    Entity a( 1 );
+    Entity b( 2 );
+
+    IntrusiveList<Entity, Tick> ticking;
+    IntrusiveList<Entity, Draw> drawing;
+
+    ticking.push( a );
+    ticking.push( b );
+    drawing.push( b );
+
+    EXPECT_EQ( 2, ticking.size() );
+    EXPECT_EQ( 1, drawing.size() );
+    EXPECT_EQ( 2, drawing.front().id );
+
+    // a copy is not linked into the original's lists
+    Entity copy( a );
+    EXPECT_FALSE( copy.IntrusiveListHook<Tick>::isLinked() );
+
+    ticking.remove( b );
+    EXPECT_EQ( 1, ticking.size() );
+    EXPECT_TRUE( b.IntrusiveListHook<Draw>::isLinked() );
+
+    drawing.clear();
+    ticking.clear();
+}
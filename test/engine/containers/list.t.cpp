@@ -1,6 +1,8 @@
 // list.t.cpp
 #include <engine/containers/list.h>
 #include <gtest/gtest.h>
+#include <string>
+#include <vector>
 
 TEST( List, ConstructionAndAssignment )
 {
@@ -193,4 +195,246 @@ TEST( List, Iterator )
     }
 
     EXPECT_THROW( list.at( 65 ), std::runtime_error );
-}
\ No newline at end of file
+}
+TEST( List, Emplace )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    List<std::string> list;
+
+    EXPECT_EQ( "aaa", list.emplace( 3, 'a' ) );
+    EXPECT_EQ( "bb", list.emplaceFront( 2, 'b' ) );
+    EXPECT_EQ( "c", list.emplaceAt( 1, 1, 'c' ) );
+    EXPECT_EQ( "dddd", list.emplaceAt( 3, 4, 'd' ) );
+
+    ASSERT_EQ( 4, list.size() );
+    EXPECT_EQ( "bb", list[0] );
+    EXPECT_EQ( "c", list[1] );
+    EXPECT_EQ( "aaa", list[2] );
+    EXPECT_EQ( "dddd", list[3] );
+
+    // a throwing constructor leaves the list as it was
+    EXPECT_THROW( list.emplaceAt( 1, std::string::npos, 'e' ),
+                  std::length_error );
+    ASSERT_EQ( 4, list.size() );
+    EXPECT_EQ( "c", list[1] );
+    EXPECT_EQ( "dddd", list[3] );
+
+    List<std::string> empty;
+    EXPECT_THROW( empty.emplace( std::string::npos, 'e' ), std::length_error );
+    EXPECT_EQ( 0, empty.size() );
+    EXPECT_EQ( "f", empty.emplace( 1, 'f' ) );
+    ASSERT_EQ( 1, empty.size() );
+    EXPECT_EQ( "f", empty[0] );
+}
+
+TEST( List, CopyKeepsOrder )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    uint32 i;
+
+    List<uint32> list;
+    for ( i = 0; i < 40; ++i )
+    {
+        list.pushFront( i );
+    }
+
+    list.removeAt( 10 );
+    list.insertAt( 5, 100 );
+
+    List<uint32> copy( list );
+    List<uint32> assigned;
+    assigned = list;
+
+    ASSERT_EQ( list.size(), copy.size() );
+    ASSERT_EQ( list.size(), assigned.size() );
+    for ( i = 0; i < list.size(); ++i )
+    {
+        ASSERT_EQ( list[i], copy[i] );
+        ASSERT_EQ( list[i], assigned[i] );
+    }
+
+    List<uint32> moved( std::move( copy ) );
+    EXPECT_EQ( 0, copy.size() );
+    ASSERT_EQ( list.size(), moved.size() );
+    for ( i = 0; i < list.size(); ++i )
+    {
+        ASSERT_EQ( list[i], moved[i] );
+    }
+}
+
+TEST( List, Handles )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    typedef List<uint32>::Handle Handle;
+
+    constexpr uint32 COUNT = 100;
+
+    List<uint32> list;
+    Handle handles[COUNT];
+    uint32 i;
+
+    EXPECT_EQ( List<uint32>::NULL_HANDLE, list.first() );
+    EXPECT_EQ( List<uint32>::NULL_HANDLE, list.last() );
+
+    list.push( 0 );
+    handles[0] = list.first();
+    for ( i = 1; i < COUNT; ++i )
+    {
+        handles[i] = list.insertAfter( handles[i - 1], i );
+    }
+
+    // growing the list did not move any of the items
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_EQ( i, list.value( handles[i] ) );
+    }
+
+    EXPECT_EQ( handles[0], list.first() );
+    EXPECT_EQ( handles[COUNT - 1], list.last() );
+    EXPECT_EQ( handles[1], list.next( handles[0] ) );
+    EXPECT_EQ( handles[0], list.prev( handles[1] ) );
+    EXPECT_EQ( List<uint32>::NULL_HANDLE, list.next( list.last() ) );
+    EXPECT_EQ( List<uint32>::NULL_HANDLE, list.prev( list.first() ) );
+    EXPECT_EQ( handles[50], list.handleAt( 50 ) );
+    EXPECT_EQ( handles[3], ( ++( ++( ++list.begin() ) ) ).handle() );
+
+    // removing every other item leaves the rest of the handles valid
+    for ( i = 0; i < COUNT; i += 2 )
+    {
+        ASSERT_EQ( i, list.erase( handles[i] ) );
+    }
+
+    EXPECT_EQ( COUNT / 2, list.size() );
+    for ( i = 1; i < COUNT; i += 2 )
+    {
+        ASSERT_EQ( i, list.value( handles[i] ) );
+    }
+
+    // splice items in around the remaining ones
+    const Handle front = list.insertBefore( handles[1], 1000 );
+    const Handle back = list.insertAfter( handles[COUNT - 1], 2000 );
+    const Handle middle = list.insertAfter( handles[1], 3000 );
+
+    EXPECT_EQ( front, list.first() );
+    EXPECT_EQ( back, list.last() );
+    EXPECT_EQ( 1000, list[0] );
+    EXPECT_EQ( 1, list[1] );
+    EXPECT_EQ( 3000, list[2] );
+    EXPECT_EQ( 3, list[3] );
+    EXPECT_EQ( 2000, list[list.size() - 1] );
+
+    Handle handle;
+    for ( i = 0, handle = list.first(); handle != List<uint32>::NULL_HANDLE;
+          ++i, handle = list.next( handle ) )
+    {
+        ASSERT_EQ( list[i], list.value( handle ) );
+    }
+
+    EXPECT_EQ( list.size(), i );
+    EXPECT_EQ( 3000, list.erase( middle ) );
+    EXPECT_EQ( 3, list[2] );
+}
+
+TEST( List, Defragment )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    typedef List<uint32>::Handle Handle;
+
+    List<uint32> list;
+    std::vector<uint32> expected;
+    uint32 i;
+
+    // churn the list so its nodes are scattered through the array
+    list.push( 0 );
+    expected.push_back( 0 );
+    for ( i = 1; i < 300; ++i )
+    {
+        const uint32 index = ( i * 7919 ) % list.size();
+        if ( i % 3 == 0 )
+        {
+            list.erase( list.handleAt( index ) );
+            expected.erase( expected.begin() + index );
+            if ( list.isEmpty() )
+            {
+                list.push( i );
+                expected.push_back( i );
+            }
+        }
+        else
+        {
+            list.insertBefore( list.handleAt( index ), i );
+            expected.insert( expected.begin() + index, i );
+        }
+    }
+
+    const uint32 capacity = list.capacity();
+    list.defragment();
+
+    EXPECT_EQ( capacity, list.capacity() );
+    ASSERT_EQ( expected.size(), list.size() );
+
+    Handle handle;
+    for ( i = 0, handle = list.first(); handle != List<uint32>::NULL_HANDLE;
+          ++i, handle = list.next( handle ) )
+    {
+        ASSERT_EQ( i, handle );
+        ASSERT_EQ( expected[i], list.value( handle ) );
+    }
+
+    EXPECT_EQ( expected.size(), i );
+
+    // the list still works after defragmenting
+    list.push( 1000 );
+    list.pushFront( 2000 );
+    EXPECT_EQ( 1000, list[list.size() - 1] );
+    EXPECT_EQ( 2000, list[0] );
+
+    // compacting shrinks the internal array down to the items
+    while ( list.size() > 10 )
+    {
+        list.erase( list.last() );
+    }
+
+    list.compact();
+    EXPECT_EQ( 32, list.capacity() );
+    EXPECT_EQ( 2000, list[0] );
+    for ( i = 1; i < list.size(); ++i )
+    {
+        ASSERT_EQ( expected[i - 1], list[i] );
+    }
+}
+
+TEST( List, CompactsWhenMostlyFree )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    uint32 i;
+
+    List<uint32> list;
+    for ( i = 0; i < 1024; ++i )
+    {
+        list.push( i );
+    }
+
+    EXPECT_EQ( 1024, list.capacity() );
+
+    for ( i = 0; i < 1000; ++i )
+    {
+        list.popFront();
+    }
+
+    EXPECT_GT( 1024, list.capacity() );
+    for ( i = 0; i < list.size(); ++i )
+    {
+        ASSERT_EQ( 1000 + i, list[i] );
+    }
+}
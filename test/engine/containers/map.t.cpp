@@ -1,8 +1,9 @@
 // map.t.cpp
 #include <engine/containers/map.h>
 #include <gtest/gtest.h>
+#include <cctype>
 
-std::string getString( nge::uint32 size )
+static std::string getString( nge::uint32 size )
 {
     std::ostringstream oss;
     while ( size-- > 0 )
@@ -26,17 +27,76 @@ TEST( Map, Construction )
     copy = move;
     move = std::move( copy );
 
+    typedef Map<std::string, uint32, FunctionHasher<std::string>> FuncMap;
+
     Map<std::string, uint32> cap( 100 );
-    Map<std::string, uint32> hashFunc( &HashUtils::fnv1a );
-    Map<std::string, uint32> hashFuncAndCap( 100, &HashUtils::fnv1a );
+    FuncMap hashFunc( &HashUtils::fnv1a );
+    FuncMap hashFuncAndCap( 100, &HashUtils::fnv1a );
 
-    DefaultAllocator<Map::KVPair<std::string, uint32>> valAlloc;
+    DefaultAllocator<Map<std::string, uint32>::KVPair> valAlloc;
     DefaultAllocator<uint32> binAlloc;
     Map<std::string, uint32> withAlloc( &valAlloc, &binAlloc );
     Map<std::string, uint32> withAllocAndCap( &valAlloc, &binAlloc, 100 );
-    Map<std::string, uint32> withAllocAndHashFunc( &valAlloc, &binAlloc,
-                                           &HashUtils::fnv1a );
-    Map<std::string, uint32> withAll( &valAlloc, &binAlloc, 100, &HashUtils::fnv1a );
+
+    DefaultAllocator<FuncMap::KVPair> funcValAlloc;
+    FuncMap withAllocAndHashFunc( &funcValAlloc, &binAlloc,
+                                  &HashUtils::fnv1a );
+    FuncMap withAll( &funcValAlloc, &binAlloc, 100, &HashUtils::fnv1a );
+
+    // the default policies are empty so they add nothing to the map
+    EXPECT_LT( sizeof( Map<std::string, uint32> ), sizeof( FuncMap ) );
+}
+
+struct CaseInsensitive
+{
+    static nge::uint32 hash( const std::string& value )
+    {
+        nge::uint32 code = 0;
+        for ( char c : value )
+        {
+            code = code * 31 + std::tolower( c );
+        }
+        return code;
+    }
+
+    static bool equals( const std::string& lhs, const std::string& rhs )
+    {
+        if ( lhs.size() != rhs.size() )
+        {
+            return false;
+        }
+
+        for ( std::size_t i = 0; i < lhs.size(); ++i )
+        {
+            if ( std::tolower( lhs[i] ) != std::tolower( rhs[i] ) )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+TEST( Map, Policies )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    Map<std::string, uint32, CaseInsensitive, CaseInsensitive> map;
+
+    map.assign( "Key", 1 );
+    map.assign( "KEY", 2 );
+    map.assign( "other", 3 );
+
+    EXPECT_EQ( 2, map.size() );
+    EXPECT_TRUE( map.hasKey( "kEy" ) );
+    EXPECT_TRUE( map.hasKey( "OTHER" ) );
+    EXPECT_TRUE( map.hasValue( 2 ) );
+    EXPECT_FALSE( map.hasValue( 1 ) );
+
+    map.remove( "key" );
+    EXPECT_FALSE( map.hasKey( "Key" ) );
+    EXPECT_EQ( 1, map.size() );
 }
 
 TEST( Map, MemberFunctions )
@@ -104,7 +164,8 @@ TEST( Map, Iterator )
     Map<uint32, uint32>::ConstIterator iter;
     for ( i = 0, iter = map.cbegin(); iter != map.cend(); ++i, ++iter )
     {
-        ASSERT_EQ( i, *iter );
+        ASSERT_EQ( i, iter->key );
+        ASSERT_EQ( i, iter->value );
     }
 
     Map<uint32, uint32>::ConstIterator iter2;
@@ -112,4 +173,163 @@ TEST( Map, Iterator )
     {
         ASSERT_EQ( iter, iter2 );
     }
-}
\ No newline at end of file
+}
+
+TEST( Map, RemoveKeepsPairsDense )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 512;
+
+    Map<uint32, uint32> map;
+    uint32 i;
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        map.assign( i, i * 2 );
+    }
+
+    // remove every other key from the middle of the pairs
+    for ( i = 0; i < COUNT; i += 2 )
+    {
+        map.remove( i );
+        ASSERT_FALSE( map.hasKey( i ) );
+    }
+
+    EXPECT_EQ( COUNT / 2, map.size() );
+
+    Map<uint32, uint32>::ConstIterator iter;
+    for ( i = 0, iter = map.cbegin(); iter != map.cend(); ++i, ++iter )
+    {
+        ASSERT_EQ( 1, iter->key % 2 );
+        ASSERT_EQ( iter->key * 2, iter->value );
+    }
+    EXPECT_EQ( COUNT / 2, i );
+
+    // churn the table so deleted bins are reused
+    for ( i = 0; i < COUNT * 4; ++i )
+    {
+        map.assign( COUNT + i, i );
+        map.remove( COUNT + i );
+    }
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_EQ( i % 2 == 1, map.hasKey( i ) );
+    }
+}
+
+TEST( Map, LookupWithoutKeyConstruction )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    Map<std::string, uint32> map;
+
+    map.assign( "speed", 5, 10 );
+    map.assign( chash( "health" ), "health", 6, 100 );
+    map.assign( chash( "speed" ), "speed", 5, 20 );
+
+    EXPECT_EQ( 2, map.size() );
+    EXPECT_TRUE( map.hasKey( "health" ) );
+    EXPECT_TRUE( map.hasKey( "speedy", 5 ) );
+    EXPECT_TRUE( map.hasKey( chash( "health" ), "health", 6 ) );
+    EXPECT_FALSE( map.hasKey( chash( "mana" ), "mana", 4 ) );
+
+    ASSERT_NE( nullptr, map.lookup( "speed" ) );
+    EXPECT_EQ( 20, *map.lookup( "speed" ) );
+    EXPECT_EQ( 100, *map.lookup( "health", 6 ) );
+    EXPECT_EQ( 100, *map.lookup( chash( "health" ), "health" ) );
+    EXPECT_EQ( nullptr, map.lookup( "heal", 4 ) );
+    EXPECT_EQ( nullptr, map.lookup( chash( "mana" ), "mana", 4 ) );
+
+    *map.lookup( chash( "speed" ), "speed", 5 ) = 30;
+
+    const Map<std::string, uint32>& constMap = map;
+    EXPECT_EQ( 30, *constMap.lookup( "speed", 5 ) );
+    EXPECT_EQ( nullptr, constMap.lookup( std::string( "mana" ) ) );
+}
+
+TEST( Map, AssignAllAndReserve )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 1000;
+
+    typedef Map<uint32, uint32>::KVPair KVPair;
+
+    KVPair pairs[COUNT];
+    uint32 i;
+
+    // every key appears twice so later pairs must replace earlier ones
+    for ( i = 0; i < COUNT; ++i )
+    {
+        pairs[i] = KVPair{ i % ( COUNT / 2 ), i };
+    }
+
+    Map<uint32, uint32> map;
+    map.assign( 0, 12345 );
+    map.assign( COUNT, COUNT );
+    map.assignAll( pairs, COUNT );
+    map.assignAll( nullptr, 0 );
+
+    EXPECT_EQ( COUNT / 2 + 1, map.size() );
+    for ( i = 0; i < COUNT / 2; ++i )
+    {
+        ASSERT_NE( nullptr, map.lookup( i ) );
+        ASSERT_EQ( i + COUNT / 2, *map.lookup( i ) );
+    }
+    EXPECT_EQ( COUNT, *map.lookup( COUNT ) );
+
+    map.reserve( COUNT * 4 );
+    for ( i = 0; i < COUNT * 4; ++i )
+    {
+        map.assign( i, i );
+    }
+
+    map.rehash( 16 );
+    map.rehash( COUNT * 16 );
+    EXPECT_EQ( COUNT * 4, map.size() );
+    for ( i = 0; i < COUNT * 4; ++i )
+    {
+        ASSERT_TRUE( map.hasKey( i ) );
+    }
+}
+
+TEST( Map, RobinHoodIndexChurn )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::util;
+
+    constexpr uint32 COUNT = 2000;
+
+    Map<uint32, uint32, Hasher<uint32>, Equality<uint32>, RobinHoodIndex> map;
+    uint32 i;
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        map.assign( i, i * 2 );
+    }
+
+    const uint32 maxLength = map.maxProbeLength();
+
+    // replace the keys many times over without changing the size
+    for ( i = 0; i < COUNT * 50; ++i )
+    {
+        map.remove( i );
+        map.assign( i + COUNT, i );
+    }
+
+    EXPECT_EQ( COUNT, map.size() );
+    EXPECT_GE( maxLength * 2 + 4, map.maxProbeLength() );
+    EXPECT_LE( map.meanProbeLength(), map.maxProbeLength() );
+
+    for ( i = COUNT * 50; i < COUNT * 51; ++i )
+    {
+        ASSERT_NE( nullptr, map.lookup( i ) );
+        ASSERT_EQ( i - COUNT, *map.lookup( i ) );
+    }
+}
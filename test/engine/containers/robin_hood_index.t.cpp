@@ -0,0 +1,183 @@
+// robin_hood_index.t.cpp
+#include <engine/containers/robin_hood_index.h>
+#include <gtest/gtest.h>
+
+TEST( RobinHoodIndex, Construction )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    DefaultAllocator<uint32> alloc;
+
+    RobinHoodIndex def;
+    RobinHoodIndex capacity( 100 );
+    RobinHoodIndex withAlloc( &alloc );
+    RobinHoodIndex withAllocAndCapacity( &alloc, 100 );
+    RobinHoodIndex copy( capacity );
+    RobinHoodIndex move( std::move( copy ) );
+
+    EXPECT_EQ( RobinHoodIndex::MIN_BINS, def.binCount() );
+    EXPECT_EQ( 0, def.size() );
+    EXPECT_LE( 100, capacity.binCount() );
+    EXPECT_EQ( capacity.binCount(), move.binCount() );
+
+    def = capacity;
+    def = std::move( move );
+}
+
+TEST( RobinHoodIndex, InsertFindAndErase )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 200;
+
+    RobinHoodIndex index( COUNT );
+    uint32 hashes[COUNT];
+    uint32 bin;
+    uint32 i;
+
+    // every fourth item shares a hash code to force collisions
+    for ( i = 0; i < COUNT; ++i )
+    {
+        hashes[i] = ( i % 4 == 0 ) ? 0xABCD : i * 2654435761u;
+        bin = index.insert( hashes[i], i );
+        ASSERT_EQ( i, index.itemAt( bin ) );
+    }
+
+    EXPECT_EQ( COUNT, index.size() );
+
+    // inserts and erases move items between bins so look every bin up again
+    for ( i = 0; i < COUNT; ++i )
+    {
+        bin = index.find( hashes[i], [i]( uint32 item ) { return item == i; } );
+        ASSERT_NE( RobinHoodIndex::NOT_FOUND, bin );
+        ASSERT_EQ( i, index.itemAt( bin ) );
+    }
+
+    for ( i = 0; i < COUNT; i += 2 )
+    {
+        index.erase( index.find( hashes[i], [i]( uint32 item ) {
+            return item == i;
+        } ) );
+    }
+
+    EXPECT_EQ( COUNT / 2, index.size() );
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        bin = index.find( hashes[i], [i]( uint32 item ) { return item == i; } );
+        ASSERT_EQ( i % 2 == 0, bin == RobinHoodIndex::NOT_FOUND );
+    }
+
+    bin = index.find( hashes[1], []( uint32 item ) { return item == 1; } );
+    index.setItemAt( bin, 1000 );
+    EXPECT_EQ( 1000, index.itemAt( bin ) );
+
+    index.clear();
+    EXPECT_EQ( 0, index.size() );
+    EXPECT_EQ( RobinHoodIndex::NOT_FOUND, index.find( hashes[1], []( uint32 ) {
+        return true;
+    } ) );
+}
+
+TEST( RobinHoodIndex, GrowAndShrink )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 1024;
+
+    RobinHoodIndex index;
+    uint32 hashes[COUNT];
+    uint32 i;
+
+    auto hashOf = [&hashes]( uint32 item ) { return hashes[item]; };
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        hashes[i] = i * 2654435761u;
+        if ( index.shouldGrow() )
+        {
+            index.grow( hashOf );
+        }
+
+        index.insert( hashes[i], i );
+    }
+
+    EXPECT_LE( RobinHoodIndex::binsFor( COUNT ), index.binCount() );
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_NE( RobinHoodIndex::NOT_FOUND,
+                   index.find( hashes[i], [i]( uint32 item ) {
+                       return item == i;
+                   } ) );
+    }
+
+    index.rehash( RobinHoodIndex::binsFor( 10 ), 10, hashOf );
+    EXPECT_EQ( 10, index.size() );
+    EXPECT_TRUE( index.shouldShrink() == false );
+
+    for ( i = 0; i < 10; ++i )
+    {
+        ASSERT_NE( RobinHoodIndex::NOT_FOUND,
+                   index.find( hashes[i], [i]( uint32 item ) {
+                       return item == i;
+                   } ) );
+    }
+}
+
+TEST( RobinHoodIndex, ProbeLengthsStayBoundedUnderChurn )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 4096;
+    constexpr uint32 ROUNDS = 200000;
+
+    RobinHoodIndex index( COUNT );
+    uint32 hashes[COUNT];
+    uint32 i;
+
+    auto hashOf = [&hashes]( uint32 item ) { return hashes[item]; };
+
+    uint32 seed = 12345;
+    for ( i = 0; i < COUNT; ++i )
+    {
+        seed = seed * 1664525u + 1013904223u;
+        hashes[i] = seed ^ ( seed >> 13 );
+        index.insert( hashes[i], i );
+    }
+
+    const uint32 maxLength = index.maxProbeLength( hashOf );
+    const float meanLength = index.meanProbeLength( hashOf );
+
+    // replace random items with new hash codes, the index never grows
+    for ( i = 0; i < ROUNDS; ++i )
+    {
+        seed = seed * 1664525u + 1013904223u;
+        const uint32 item = seed % COUNT;
+        const uint32 bin = index.find( hashes[item], [item]( uint32 other ) {
+            return other == item;
+        } );
+        ASSERT_NE( RobinHoodIndex::NOT_FOUND, bin );
+
+        index.erase( bin );
+        hashes[item] = seed ^ ( seed >> 13 );
+        index.insert( hashes[item], item );
+    }
+
+    EXPECT_EQ( COUNT, index.size() );
+    EXPECT_GE( maxLength * 2 + 4, index.maxProbeLength( hashOf ) );
+    EXPECT_GE( meanLength * 2 + 1, index.meanProbeLength( hashOf ) );
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_NE( RobinHoodIndex::NOT_FOUND,
+                   index.find( hashes[i], [i]( uint32 item ) {
+                       return item == i;
+                   } ) );
+    }
+}
@@ -26,17 +26,21 @@ TEST( Set, Construction )
     copy = move;
     move = std::move( copy );
 
+    typedef Set<std::string, FunctionHasher<std::string>> FuncSet;
+
     Set<std::string> cap( 100 );
-    Set<std::string> hashFunc( &HashUtils::fnv1a );
-    Set<std::string> hashFuncAndCap( 100, &HashUtils::fnv1a );
+    FuncSet hashFunc( &HashUtils::fnv1a );
+    FuncSet hashFuncAndCap( 100, &HashUtils::fnv1a );
 
     DefaultAllocator<std::string> valAlloc;
     DefaultAllocator<uint32> binAlloc;
     Set<std::string> withAlloc( &valAlloc, &binAlloc );
     Set<std::string> withAllocAndCap( &valAlloc, &binAlloc, 100 );
-    Set<std::string> withAllocAndHashFunc( &valAlloc, &binAlloc,
-                                           &HashUtils::fnv1a );
-    Set<std::string> withAll( &valAlloc, &binAlloc, 100, &HashUtils::fnv1a );
+    FuncSet withAllocAndHashFunc( &valAlloc, &binAlloc, &HashUtils::fnv1a );
+    FuncSet withAll( &valAlloc, &binAlloc, 100, &HashUtils::fnv1a );
+
+    // the default policies are empty so they add nothing to the set
+    EXPECT_LT( sizeof( Set<std::string> ), sizeof( FuncSet ) );
 }
 
 TEST( Set, MemberFunctions )
@@ -109,4 +113,123 @@ TEST( Set, Iterator )
     {
         ASSERT_EQ( iter, iter2 );
     }
-}
\ No newline at end of file
+}
+
+TEST( Set, RemoveKeepsValuesDense )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 512;
+
+    Set<uint32> set;
+    uint32 i;
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        set.add( i );
+    }
+
+    // remove every other value from the middle of the values
+    for ( i = 0; i < COUNT; i += 2 )
+    {
+        set.remove( i );
+        ASSERT_FALSE( set.has( i ) );
+    }
+
+    ASSERT_EQ( COUNT / 2, set.size() );
+
+    for ( i = 0; i < set.size(); ++i )
+    {
+        ASSERT_EQ( 1, set[i] % 2 );
+    }
+
+    // churn the table so deleted bins are reused
+    for ( i = 0; i < COUNT * 4; ++i )
+    {
+        set.add( COUNT + i );
+        set.remove( COUNT + i );
+    }
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_EQ( i % 2 == 1, set.has( i ) );
+    }
+}
+
+TEST( Set, AddAllAndReserve )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 1000;
+
+    uint32 values[COUNT];
+    uint32 i;
+
+    // every value appears twice
+    for ( i = 0; i < COUNT; ++i )
+    {
+        values[i] = i % ( COUNT / 2 );
+    }
+
+    Set<uint32> set;
+    set.add( 0 );
+    set.add( COUNT );
+    set.addAll( values, COUNT );
+    set.addAll( nullptr, 0 );
+
+    EXPECT_EQ( COUNT / 2 + 1, set.size() );
+    for ( i = 0; i < COUNT / 2; ++i )
+    {
+        ASSERT_TRUE( set.has( i ) );
+    }
+
+    set.reserve( COUNT * 4 );
+    for ( i = 0; i < COUNT * 4; ++i )
+    {
+        set.add( i );
+    }
+
+    set.rehash( 16 );
+    set.rehash( COUNT * 16 );
+    EXPECT_EQ( COUNT * 4, set.size() );
+    for ( i = 0; i < COUNT * 4; ++i )
+    {
+        ASSERT_TRUE( set.has( i ) );
+    }
+}
+
+TEST( Set, RobinHoodIndexChurn )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::util;
+
+    constexpr uint32 COUNT = 2000;
+
+    Set<uint32, Hasher<uint32>, Equality<uint32>, RobinHoodIndex> set;
+    uint32 i;
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        set.add( i );
+    }
+
+    const uint32 maxLength = set.maxProbeLength();
+
+    for ( i = 0; i < COUNT * 50; ++i )
+    {
+        set.remove( i );
+        set.add( i + COUNT );
+    }
+
+    EXPECT_EQ( COUNT, set.size() );
+    EXPECT_GE( maxLength * 2 + 4, set.maxProbeLength() );
+    EXPECT_LE( set.meanProbeLength(), set.maxProbeLength() );
+
+    for ( i = COUNT * 50; i < COUNT * 51; ++i )
+    {
+        ASSERT_TRUE( set.has( i ) );
+    }
+}
@@ -0,0 +1,146 @@
+// slot_map.t.cpp
+#include <engine/containers/slot_map.h>
+#include <engine/memory/counting_allocator.h>
+#include <gtest/gtest.h>
+
+TEST( SlotMap, Construction )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    CountingAllocator<std::string> valueAlloc;
+    CountingAllocator<uint32> intAlloc;
+
+    SlotMap<std::string> def;
+    SlotMap<std::string> cap( 100 );
+    SlotMap<std::string> withAlloc( &valueAlloc, &intAlloc );
+    SlotMap<std::string> withAllocAndCap( &valueAlloc, &intAlloc, 100 );
+    SlotMap<std::string> copy( def );
+    SlotMap<std::string> move( std::move( copy ) );
+
+    EXPECT_LT( 0, valueAlloc.getAllocationCount() );
+    EXPECT_LT( 0, intAlloc.getAllocationCount() );
+
+    const SlotMap<std::string>::Handle handle = withAlloc.insert( "value" );
+    copy = withAlloc;
+    move = std::move( copy );
+    ASSERT_NE( nullptr, move.lookup( handle ) );
+    EXPECT_EQ( "value", *move.lookup( handle ) );
+}
+
+TEST( SlotMap, InsertLookupAndRemove )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 200;
+
+    SlotMap<uint32> map;
+    SlotMap<uint32>::Handle handles[COUNT];
+    uint32 i;
+
+    EXPECT_FALSE( map.has( SlotMap<uint32>::NULL_HANDLE ) );
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        handles[i] = map.insert( i );
+    }
+
+    ASSERT_EQ( COUNT, map.size() );
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_EQ( i, *map.lookup( handles[i] ) );
+        ASSERT_EQ( handles[i], map.handleAt( i ) );
+    }
+
+    for ( i = 0; i < COUNT; i += 2 )
+    {
+        ASSERT_TRUE( map.remove( handles[i] ) );
+        ASSERT_FALSE( map.remove( handles[i] ) );
+    }
+
+    ASSERT_EQ( COUNT / 2, map.size() );
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_EQ( i % 2 == 1, map.has( handles[i] ) );
+        if ( i % 2 == 1 )
+        {
+            ASSERT_EQ( i, *map.lookup( handles[i] ) );
+        }
+    }
+
+    // the packed values only hold the remaining values
+    for ( i = 0; i < map.size(); ++i )
+    {
+        ASSERT_EQ( 1, map[i] % 2 );
+        ASSERT_EQ( map[i], *map.lookup( map.handleAt( i ) ) );
+    }
+
+    // reused slots hand out new handles so the stale ones stay invalid
+    for ( i = 0; i < COUNT; i += 2 )
+    {
+        const SlotMap<uint32>::Handle handle = map.emplace( COUNT + i );
+        ASSERT_FALSE( map.has( handles[i] ) );
+        ASSERT_EQ( COUNT + i, *map.lookup( handle ) );
+    }
+    EXPECT_EQ( COUNT, map.size() );
+
+    map.clear();
+    EXPECT_TRUE( map.isEmpty() );
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_EQ( nullptr, map.lookup( handles[i] ) );
+    }
+}
+
+TEST( SlotMap, Iterator )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    SlotMap<uint32, uint64> map;
+    uint32 i;
+
+    for ( i = 0; i < 32; ++i )
+    {
+        map.insert( i );
+    }
+
+    SlotMap<uint32, uint64>::Iterator iter;
+    for ( iter = map.begin(); iter != map.end(); ++iter )
+    {
+        *iter += 100;
+    }
+
+    SlotMap<uint32, uint64>::ConstIterator citer;
+    for ( i = 0, citer = map.cbegin(); citer != map.cend(); ++i, ++citer )
+    {
+        ASSERT_EQ( i + 100, *citer );
+    }
+}
+
+TEST( SlotMap, GenerationsWrap )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    SlotMap<uint32> map;
+    SlotMap<uint32>::Handle handle = map.insert( 0 );
+    const SlotMap<uint32>::Handle first = handle;
+    uint32 i;
+
+    // cycle one slot through every generation its handles can hold
+    for ( i = 1; i < SlotMap<uint32>::MAX_SIZE / 2; ++i )
+    {
+        map.remove( handle );
+        handle = map.insert( i );
+        ASSERT_NE( first, handle );
+        ASSERT_NE( SlotMap<uint32>::NULL_HANDLE, handle );
+    }
+
+    map.remove( handle );
+    handle = map.insert( i );
+    EXPECT_EQ( first, handle );
+    EXPECT_EQ( i, *map.lookup( first ) );
+}
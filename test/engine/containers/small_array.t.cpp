@@ -0,0 +1,260 @@
+// small_array.t.cpp
+#include <engine/containers/small_array.h>
+#include <engine/memory/counting_allocator.h>
+#include <gtest/gtest.h>
+
+TEST( SmallArray, ConstructionAndAssignment )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    DefaultAllocator<uint32> alloc;
+
+    SmallArray<uint32, 4> array( &alloc );
+    SmallArray<uint32, 4> def;
+    uint32 i;
+
+    for ( i = 0; i < 10; ++i )
+    {
+        array.push( i );
+        def.push( i );
+    }
+
+    def.pop();
+    while ( def.size() > 3 )
+    {
+        def.pop();
+    }
+
+    SmallArray<uint32, 4> copy( array );
+    SmallArray<uint32, 4> smallCopy( def );
+    SmallArray<uint32, 4> move( std::move( copy ) );
+    SmallArray<uint32, 4> smallMove( std::move( smallCopy ) );
+
+    EXPECT_EQ( 0, copy.size() );
+    EXPECT_TRUE( copy.isSmall() );
+    EXPECT_EQ( 0, smallCopy.size() );
+
+    ASSERT_EQ( 10, move.size() );
+    ASSERT_EQ( 3, smallMove.size() );
+    EXPECT_FALSE( move.isSmall() );
+    EXPECT_TRUE( smallMove.isSmall() );
+    for ( i = 0; i < 10; ++i )
+    {
+        ASSERT_EQ( i, move[i] );
+    }
+
+    def = move;
+    EXPECT_EQ( 10, def.size() );
+    def = smallMove;
+    EXPECT_EQ( 3, def.size() );
+    EXPECT_TRUE( def.isSmall() );
+    def = std::move( move );
+    EXPECT_EQ( 10, def.size() );
+    EXPECT_EQ( 9, def[9] );
+    def = std::move( smallMove );
+    EXPECT_EQ( 3, def.size() );
+    EXPECT_EQ( 2, def[2] );
+}
+
+TEST( SmallArray, SpillsOnlyPastInlineCapacity )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::mem;
+
+    CountingAllocator<uint32> alloc;
+    SmallArray<uint32, 8> array( &alloc );
+    uint32 i;
+
+    for ( i = 0; i < 8; ++i )
+    {
+        array.push( i );
+    }
+
+    EXPECT_TRUE( array.isSmall() );
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+
+    array.push( 8 );
+    EXPECT_FALSE( array.isSmall() );
+    EXPECT_LT( 0, alloc.getAllocationCount() );
+
+    for ( i = 9; i < 100; ++i )
+    {
+        array.push( i );
+    }
+
+    // popping back down moves the items into the object again
+    for ( i = 99; i >= 2; --i )
+    {
+        ASSERT_EQ( i, array.pop() );
+    }
+
+    EXPECT_TRUE( array.isSmall() );
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+    ASSERT_EQ( 2, array.size() );
+    EXPECT_EQ( 0, array[0] );
+    EXPECT_EQ( 1, array[1] );
+
+    array.reserve( 50 );
+    EXPECT_LE( 50, array.capacity() );
+    array.clear();
+    EXPECT_TRUE( array.isSmall() );
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+}
+
+TEST( SmallArray, InsertAndRemove )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    SmallArray<std::string, 2> array;
+
+    array.push( "b" );
+    array.pushFront( "a" );
+    array.insertAt( 2, "d" );
+    array.insertAt( 2, "c" );
+    array.pushFront( std::string( "_" ) );
+
+    ASSERT_EQ( 5, array.size() );
+    EXPECT_EQ( "_", array[0] );
+    EXPECT_EQ( "a", array[1] );
+    EXPECT_EQ( "b", array[2] );
+    EXPECT_EQ( "c", array[3] );
+    EXPECT_EQ( "d", array[4] );
+    EXPECT_THROW( array.insertAt( 6, "x" ), std::runtime_error );
+
+    EXPECT_EQ( "_", array.popFront() );
+    EXPECT_EQ( "c", array.removeAt( 2 ) );
+    EXPECT_TRUE( array.remove( "a" ) );
+    EXPECT_FALSE( array.remove( "a" ) );
+    EXPECT_THROW( array.removeAt( 2 ), std::runtime_error );
+
+    ASSERT_EQ( 2, array.size() );
+    EXPECT_EQ( "b", array[0] );
+    EXPECT_EQ( "d", array.at( 1 ) );
+    EXPECT_EQ( 1, array.indexOf( "d" ) );
+    EXPECT_TRUE( array.has( "b" ) );
+    EXPECT_FALSE( array.has( "c" ) );
+    EXPECT_THROW( array.at( 2 ), std::runtime_error );
+}
+
+TEST( SmallArray, Iterator )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    SmallArray<uint32, 16> array;
+    uint32 i;
+
+    for ( i = 0; i < 64; ++i )
+    {
+        array.push( i );
+    }
+
+    SmallArray<uint32, 16>::Iterator iter;
+    for ( i = 0, iter = array.begin(); iter != array.end(); ++iter, ++i )
+    {
+        ASSERT_EQ( i, *iter );
+    }
+
+    SmallArray<uint32, 16>::ConstIterator citer;
+    for ( i = 0, citer = array.cbegin(); citer != array.cend(); ++i, ++citer )
+    {
+        ASSERT_EQ( i, *citer );
+    }
+}
+
+namespace
+{
+
+/**
+ * An item without a default constructor that counts its lifetimes.
+ */
+struct Counted
+{
+    static nge::uint32 s_constructs;
+    static nge::uint32 s_destructs;
+
+    nge::uint32 value;
+
+    explicit Counted( nge::uint32 v ) : value( v ) { ++s_constructs; }
+    Counted( const Counted& c ) : value( c.value ) { ++s_constructs; }
+    Counted( Counted&& c ) : value( c.value ) { ++s_constructs; }
+    ~Counted() { ++s_destructs; }
+    Counted& operator=( const Counted& ) = default;
+    Counted& operator=( Counted&& ) = default;
+};
+
+nge::uint32 Counted::s_constructs = 0;
+nge::uint32 Counted::s_destructs = 0;
+
+nge::uint32 liveCount()
+{
+    return Counted::s_constructs - Counted::s_destructs;
+}
+
+} // End nspc anonymous
+
+TEST( SmallArray, ConstructsOnlyLiveItems )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    const uint32 live = liveCount();
+    {
+        SmallArray<Counted, 4> array;
+
+        // the inline storage holds no items until they are added
+        EXPECT_EQ( live, liveCount() );
+
+        uint32 i;
+        for ( i = 0; i < 3; ++i )
+        {
+            array.push( Counted( i ) );
+        }
+        EXPECT_EQ( live + 3, liveCount() );
+
+        // removed items are destroyed while inline
+        EXPECT_EQ( 2, array.pop().value );
+        EXPECT_EQ( live + 2, liveCount() );
+        EXPECT_EQ( 0, array.removeAt( 0 ).value );
+        EXPECT_EQ( live + 1, liveCount() );
+        array.clear();
+        EXPECT_EQ( live, liveCount() );
+
+        // and once spilled to the heap
+        for ( i = 0; i < 10; ++i )
+        {
+            array.push( Counted( i ) );
+        }
+        EXPECT_FALSE( array.isSmall() );
+        EXPECT_EQ( live + 10, liveCount() );
+
+        array.insertAt( 5, Counted( 100 ) );
+        array.pushFront( Counted( 200 ) );
+        EXPECT_EQ( live + 12, liveCount() );
+        EXPECT_EQ( 9, array.pop().value );
+        EXPECT_EQ( 100, array.removeAt( 6 ).value );
+        EXPECT_EQ( live + 10, liveCount() );
+
+        SmallArray<Counted, 4> copy( array );
+        SmallArray<Counted, 4> moved( std::move( copy ) );
+        EXPECT_EQ( live + 20, liveCount() );
+
+        while ( array.size() > 2 )
+        {
+            array.pop();
+        }
+        EXPECT_TRUE( array.isSmall() );
+        EXPECT_EQ( live + 12, liveCount() );
+
+        SmallArray<Counted, 4> smallMoved( std::move( array ) );
+        EXPECT_EQ( live + 12, liveCount() );
+        moved.clear();
+        EXPECT_EQ( live + 2, liveCount() );
+    }
+
+    EXPECT_EQ( live, liveCount() );
+}
@@ -0,0 +1,202 @@
+// sort_utils.t.cpp
+#include <engine/containers/dynamic_array.h>
+#include <engine/containers/fixed_array.h>
+#include <engine/containers/sort_utils.h>
+#include <gtest/gtest.h>
+#include <functional>
+#include <string>
+
+namespace
+{
+
+/**
+ * Fills the array so its items wrap around the end of its block.
+ */
+template <typename T, typename F>
+void fillWrapped( nge::cntr::DynamicArray<T>& array, nge::uint32 count,
+                  F makeValue )
+{
+    nge::uint32 i;
+    for ( i = 0; i < count; ++i )
+    {
+        array.pushFront( makeValue( i ) );
+    }
+}
+
+/**
+ * Checks that the array is in ascending order.
+ */
+template <typename A>
+void expectSorted( const A& array )
+{
+    nge::uint32 i;
+    for ( i = 1; i < array.size(); ++i )
+    {
+        ASSERT_FALSE( array[i] < array[i - 1] ) << "at index " << i;
+    }
+}
+
+} // End nspc anonymous
+
+TEST( SortUtils, Sort )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 5000;
+
+    // random, sorted, reversed, few unique and organ pipe inputs
+    const std::function<uint32( uint32 )> patterns[] = {
+        []( uint32 i ) { return i * 2654435761u; },
+        []( uint32 i ) { return i; },
+        []( uint32 i ) { return COUNT - i; },
+        []( uint32 i ) { return i % 3; },
+        []( uint32 i ) { return i < COUNT / 2 ? i : COUNT - i; },
+    };
+
+    for ( const auto& pattern : patterns )
+    {
+        DynamicArray<uint32> array;
+        fillWrapped( array, COUNT, pattern );
+        SortUtils::sort( array );
+        ASSERT_EQ( COUNT, array.size() );
+        expectSorted( array );
+    }
+
+    DynamicArray<std::string> strings;
+    fillWrapped( strings, COUNT, []( uint32 i ) {
+        return std::to_string( i * 7919 % COUNT );
+    } );
+
+    SortUtils::sort( strings, []( const std::string& a,
+                                  const std::string& b ) {
+        return a > b;
+    } );
+
+    uint32 i;
+    for ( i = 1; i < COUNT; ++i )
+    {
+        ASSERT_GE( strings[i - 1], strings[i] );
+    }
+}
+
+TEST( SortUtils, StableSort )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    typedef std::pair<uint32, uint32> Pair;
+
+    constexpr uint32 COUNT = 3000;
+
+    DynamicArray<Pair> array;
+    uint32 i;
+    for ( i = 0; i < COUNT; ++i )
+    {
+        array.push( Pair( ( i * 7919 ) % 10, i ) );
+    }
+
+    SortUtils::stableSort( array, []( const Pair& a, const Pair& b ) {
+        return a.first < b.first;
+    } );
+
+    // equal keys keep the order they were pushed in
+    for ( i = 1; i < COUNT; ++i )
+    {
+        ASSERT_LE( array[i - 1].first, array[i].first );
+        if ( array[i - 1].first == array[i].first )
+        {
+            ASSERT_LT( array[i - 1].second, array[i].second );
+        }
+    }
+
+    FixedArray<std::string> strings( 5 );
+    strings.push( "d" );
+    strings.push( "b" );
+    strings.push( "a" );
+    strings.push( "c" );
+    SortUtils::stableSort( strings );
+    expectSorted( strings );
+}
+
+TEST( SortUtils, RadixSort )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    constexpr uint32 COUNT = 4000;
+
+    DynamicArray<int32> signedValues;
+    fillWrapped( signedValues, COUNT, []( uint32 i ) {
+        return static_cast<int32>( i * 2654435761u );
+    } );
+
+    SortUtils::radixSort( signedValues );
+    ASSERT_EQ( COUNT, signedValues.size() );
+    expectSorted( signedValues );
+
+    DynamicArray<uint64> wideValues;
+    fillWrapped( wideValues, COUNT, []( uint32 i ) {
+        return static_cast<uint64>( i % 17 ) << 40;
+    } );
+
+    SortUtils::radixSort( wideValues );
+    expectSorted( wideValues );
+
+    // sorting by a key keeps equal keys in order
+    typedef std::pair<uint16, std::string> Command;
+    DynamicArray<Command> commands;
+    uint32 i;
+    for ( i = 0; i < COUNT; ++i )
+    {
+        commands.push( Command( ( i * 31 ) % 100, std::to_string( i ) ) );
+    }
+
+    SortUtils::radixSort( commands, []( const Command& command ) {
+        return command.first;
+    } );
+
+    for ( i = 1; i < COUNT; ++i )
+    {
+        ASSERT_LE( commands[i - 1].first, commands[i].first );
+        if ( commands[i - 1].first == commands[i].first )
+        {
+            ASSERT_LT( std::stoul( commands[i - 1].second ),
+                       std::stoul( commands[i].second ) );
+        }
+    }
+}
+
+TEST( SortUtils, BinarySearch )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+
+    DynamicArray<uint32> array;
+    fillWrapped( array, 100, []( uint32 i ) { return ( 99 - i ) / 2 * 2; } );
+    expectSorted( array );
+
+    EXPECT_EQ( 0, SortUtils::lowerBound( array, 0u ) );
+    EXPECT_EQ( 2, SortUtils::upperBound( array, 0u ) );
+    EXPECT_EQ( 10, SortUtils::lowerBound( array, 10u ) );
+    EXPECT_EQ( 12, SortUtils::lowerBound( array, 11u ) );
+    EXPECT_EQ( 12, SortUtils::upperBound( array, 11u ) );
+    EXPECT_EQ( 100, SortUtils::lowerBound( array, 1000u ) );
+
+    EXPECT_EQ( 10, SortUtils::binarySearch( array, 10u ) );
+    EXPECT_EQ( static_cast<uint32>( -1 ),
+               SortUtils::binarySearch( array, 11u ) );
+    EXPECT_EQ( static_cast<uint32>( -1 ),
+               SortUtils::binarySearch( array, 1000u ) );
+
+    FixedArray<uint32> descending( 4 );
+    descending.push( 9 );
+    descending.push( 7 );
+    descending.push( 7 );
+    descending.push( 1 );
+
+    auto greater = []( uint32 a, uint32 b ) { return a > b; };
+    EXPECT_EQ( 1, SortUtils::lowerBound( descending, 7, greater ) );
+    EXPECT_EQ( 3, SortUtils::upperBound( descending, 7, greater ) );
+    EXPECT_EQ( 3, SortUtils::binarySearch( descending, 1, greater ) );
+}
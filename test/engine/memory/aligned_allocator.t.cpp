@@ -0,0 +1,169 @@
+// aligned_allocator.t.cpp
+#include <engine/containers/dynamic_array.h>
+#include <engine/memory/aligned_allocator.h>
+#include <engine/memory/arena_allocator.h>
+#include <engine/memory/counting_allocator.h>
+#include <engine/memory/pool_allocator.h>
+#include <engine/memory/thread_caching_allocator.h>
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string>
+
+namespace
+{
+
+bool isAligned( const void* pointer, nge::uint32 alignment )
+{
+    return reinterpret_cast<uintptr_t>( pointer ) % alignment == 0;
+}
+
+struct alignas( 64 ) CacheLine
+{
+    nge::uint32 value;
+};
+
+} // End nspc anonymous
+
+TEST( AlignedAllocator, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    AlignedAllocator<float> alloc( 32 );
+    EXPECT_EQ( 32, alloc.alignment() );
+
+    AlignedAllocator<float> copy( alloc );
+    EXPECT_EQ( 32, copy.alignment() );
+
+    EXPECT_DEATH( AlignedAllocator<float>( 24 ), ".*" );
+}
+
+TEST( AlignedAllocator, Default )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    DefaultAllocator<float> alloc;
+    uint32 alignment;
+    for ( alignment = 4; alignment <= 256; alignment <<= 1 )
+    {
+        float* values = alloc.getAligned( 7, alignment );
+        EXPECT_TRUE( isAligned( values, alignment ) );
+        values[6] = 1.0f;
+        alloc.releaseAligned( values, 7, alignment );
+    }
+
+    // over-aligned types are aligned without asking
+    DefaultAllocator<CacheLine> lines;
+    CacheLine* line = lines.getRaw( 3 );
+    EXPECT_TRUE( isAligned( line, 64 ) );
+    lines.releaseRaw( line, 3 );
+    line = lines.get( 3 );
+    EXPECT_TRUE( isAligned( line, 64 ) );
+    lines.release( line, 3 );
+
+    ThreadCachingAllocator<CacheLine> cachedLines;
+    line = cachedLines.getRaw( 2 );
+    EXPECT_TRUE( isAligned( line, 64 ) );
+    cachedLines.releaseRaw( line, 2 );
+}
+
+TEST( AlignedAllocator, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    CountingAllocator<std::string> counter;
+    {
+        AlignedAllocator<std::string> alloc( &counter, 64 );
+
+        std::string* values = alloc.get( 3 );
+        EXPECT_TRUE( isAligned( values, 64 ) );
+        EXPECT_TRUE( values[2].empty() );
+        values[0] = "value";
+        EXPECT_EQ( 3, counter.getAllocationCount() );
+        alloc.release( values, 3 );
+        EXPECT_EQ( 0, counter.getAllocationCount() );
+
+        std::string* raw = alloc.getRaw( 2 );
+        EXPECT_TRUE( isAligned( raw, 64 ) );
+        alloc.releaseRaw( raw, 2 );
+
+        // the stricter alignment wins
+        raw = alloc.getAligned( 1, 128 );
+        EXPECT_TRUE( isAligned( raw, 128 ) );
+        alloc.releaseAligned( raw, 1, 128 );
+        EXPECT_EQ( 0, counter.getAllocationCount() );
+    }
+}
+
+TEST( AlignedAllocator, Allocators )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    Arena arena;
+    ArenaAllocator<float> arenaAlloc( &arena );
+    arenaAlloc.getRaw( 1 );
+    float* values = arenaAlloc.getAligned( 4, 32 );
+    EXPECT_TRUE( isAligned( values, 32 ) );
+    arenaAlloc.releaseAligned( values, 4, 32 );
+
+    PoolAllocator<float> pool;
+    values = pool.getAligned( 1, 4 );
+    EXPECT_EQ( PoolAllocator<float>::DEFAULT_CHUNK_SIZE, pool.capacity() );
+    pool.releaseAligned( values, 1, 4 );
+    values = pool.getAligned( 1, 64 );
+    EXPECT_TRUE( isAligned( values, 64 ) );
+    EXPECT_EQ( 1, pool.getAllocationCount() );
+    pool.releaseAligned( values, 1, 64 );
+    EXPECT_EQ( 0, pool.getAllocationCount() );
+
+    // the chunks of over-aligned types keep every slot aligned
+    PoolAllocator<CacheLine> linePool( nullptr, 4 );
+    CacheLine* lines[6];
+    uint32 i;
+    for ( i = 0; i < 6; ++i )
+    {
+        lines[i] = linePool.getRaw( 1 );
+        EXPECT_TRUE( isAligned( lines[i], 64 ) );
+    }
+    for ( i = 0; i < 6; ++i )
+    {
+        linePool.releaseRaw( lines[i], 1 );
+    }
+    CacheLine* line = linePool.getAligned( 1, 64 );
+    EXPECT_TRUE( isAligned( line, 64 ) );
+    EXPECT_EQ( 8, linePool.capacity() );
+    linePool.releaseAligned( line, 1, 64 );
+
+    ThreadCachingAllocator<float> cached;
+    values = cached.getAligned( 8, 64 );
+    EXPECT_TRUE( isAligned( values, 64 ) );
+    EXPECT_EQ( 8, cached.getAllocationCount() );
+    cached.releaseAligned( values, 8, 64 );
+    values = cached.getAligned( 8, 4 );
+    cached.releaseAligned( values, 8, 4 );
+    EXPECT_EQ( 0, cached.getAllocationCount() );
+}
+
+TEST( AlignedAllocator, Container )
+{
+    using namespace nge;
+    using namespace nge::mem;
+    using namespace nge::cntr;
+
+    AlignedAllocator<float> alloc( 32 );
+    DynamicArray<float> array( &alloc );
+
+    uint32 i;
+    for ( i = 0; i < 100; ++i )
+    {
+        array.push( static_cast<float>( i ) );
+        EXPECT_TRUE( isAligned( &array[0], 32 ) );
+    }
+
+    DynamicArray<float> copy( array );
+    EXPECT_TRUE( isAligned( &copy[0], 32 ) );
+    EXPECT_EQ( 99.0f, copy[99] );
+}
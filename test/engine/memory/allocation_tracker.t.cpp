@@ -0,0 +1,137 @@
+// allocation_tracker.t.cpp
+#include <engine/memory/allocation_tracker.h>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+TEST( AllocationTracker, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+    using namespace nge::cntr;
+
+    AllocationTracker tracker;
+    EXPECT_EQ( 0, tracker.frame() );
+    EXPECT_EQ( 0, tracker.bytesLive() );
+    EXPECT_EQ( 0, tracker.peakBytesLive() );
+
+    DynamicArray<AllocationTracker::TagStats> tags;
+    tracker.snapshot( &tags );
+    EXPECT_EQ( 0, tags.size() );
+
+    EXPECT_EQ( &AllocationTracker::global(), &AllocationTracker::global() );
+}
+
+TEST( AllocationTracker, Tags )
+{
+    using namespace nge;
+    using namespace nge::mem;
+    using namespace nge::cntr;
+
+    AllocationTracker tracker;
+    tracker.recordAllocation( "scene", 64 );
+    tracker.recordAllocation( "path", 16 );
+    tracker.recordAllocation( "scene", 32 );
+    tracker.recordRelease( "scene", 64 );
+
+    // tags with the same contents share their totals
+    const std::string copy( "path" );
+    tracker.recordAllocation( copy.c_str(), 8 );
+
+    EXPECT_EQ( 56, tracker.bytesLive() );
+    EXPECT_EQ( 112, tracker.peakBytesLive() );
+
+    DynamicArray<AllocationTracker::TagStats> tags;
+    tracker.snapshot( &tags );
+    ASSERT_EQ( 2, tags.size() );
+    EXPECT_STREQ( "scene", tags[0].tag );
+    EXPECT_EQ( 2, tags[0].allocationCount );
+    EXPECT_EQ( 1, tags[0].releaseCount );
+    EXPECT_EQ( 96, tags[0].bytesAllocated );
+    EXPECT_EQ( 32, tags[0].bytesLive );
+    EXPECT_EQ( 96, tags[0].peakBytesLive );
+    EXPECT_STREQ( "path", tags[1].tag );
+    EXPECT_EQ( 2, tags[1].allocationCount );
+    EXPECT_EQ( 24, tags[1].bytesLive );
+
+    EXPECT_DEATH( tracker.recordRelease( "path", 100 ), ".*" );
+    EXPECT_DEATH( tracker.recordAllocation( nullptr, 1 ), ".*" );
+
+    tracker.reset();
+    tracker.snapshot( &tags );
+    EXPECT_EQ( 0, tags.size() );
+    EXPECT_EQ( 0, tracker.peakBytesLive() );
+}
+
+TEST( AllocationTracker, Frames )
+{
+    using namespace nge;
+    using namespace nge::mem;
+    using namespace nge::cntr;
+
+    AllocationTracker tracker;
+    tracker.recordAllocation( "scene", 100 );
+    tracker.endFrame();
+
+    uint32 i;
+    for ( i = 0; i < 10; ++i )
+    {
+        tracker.recordAllocation( "path", 10 );
+        tracker.recordRelease( "path", 10 );
+    }
+    tracker.endFrame();
+    EXPECT_EQ( 2, tracker.frame() );
+
+    DynamicArray<AllocationTracker::FrameStats> frames;
+    tracker.timeline( &frames );
+    ASSERT_EQ( 2, frames.size() );
+    EXPECT_EQ( 0, frames[0].frame );
+    EXPECT_EQ( 1, frames[0].allocationCount );
+    EXPECT_EQ( 100, frames[0].bytesAllocated );
+    EXPECT_EQ( 100, frames[0].bytesLive );
+    EXPECT_EQ( 1, frames[1].frame );
+    EXPECT_EQ( 10, frames[1].allocationCount );
+    EXPECT_EQ( 10, frames[1].releaseCount );
+    EXPECT_EQ( 100, frames[1].bytesAllocated );
+    EXPECT_EQ( 100, frames[1].bytesLive );
+}
+
+TEST( AllocationTracker, Output )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    AllocationTracker tracker;
+    tracker.recordAllocation( "small", 8 );
+    tracker.recordAllocation( "large \"quoted\"", 4096 );
+    tracker.endFrame();
+    tracker.recordRelease( "small", 8 );
+    tracker.endFrame();
+
+    std::ostringstream report;
+    tracker.writeReport( report );
+    const std::string text = report.str();
+    EXPECT_NE( std::string::npos, text.find( "peak bytes live: 4104" ) );
+    EXPECT_LT( text.find( "large" ), text.find( "small" ) );
+
+    std::ostringstream csv;
+    tracker.writeCsv( csv );
+    EXPECT_EQ( "frame,allocations,releases,bytes_allocated,bytes_live\n"
+               "0,2,0,4104,4104\n"
+               "1,0,1,0,4096\n",
+               csv.str() );
+
+    std::ostringstream json;
+    tracker.writeJson( json );
+    EXPECT_EQ( "{\"bytesLive\":4096,\"peakBytesLive\":4104,\"tags\":["
+               "{\"tag\":\"small\",\"allocations\":1,\"releases\":1,"
+               "\"bytesAllocated\":8,\"bytesLive\":0,\"peakBytesLive\":8},"
+               "{\"tag\":\"large \\\"quoted\\\"\",\"allocations\":1,"
+               "\"releases\":0,\"bytesAllocated\":4096,\"bytesLive\":4096,"
+               "\"peakBytesLive\":4096}],\"frames\":["
+               "{\"frame\":0,\"allocations\":2,\"releases\":0,"
+               "\"bytesAllocated\":4104,\"bytesLive\":4104},"
+               "{\"frame\":1,\"allocations\":0,\"releases\":1,"
+               "\"bytesAllocated\":0,\"bytesLive\":4096}]}",
+               json.str() );
+}
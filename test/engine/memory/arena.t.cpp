@@ -0,0 +1,77 @@
+// arena.t.cpp
+#include <engine/memory/arena.h>
+#include <gtest/gtest.h>
+
+TEST( Arena, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    Arena def;
+    Arena sized( 256 );
+
+    EXPECT_EQ( 0, def.bytesReserved() );
+    EXPECT_EQ( 0, def.blockCount() );
+    EXPECT_EQ( 0, sized.bytesUsed() );
+
+    EXPECT_DEATH( Arena( 0 ), ".*" );
+}
+
+TEST( Arena, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    Arena arena( 256 );
+
+    uint8* bytes = static_cast<uint8*>( arena.allocate( 3, 1 ) );
+    ASSERT_NE( nullptr, bytes );
+    EXPECT_EQ( 1, arena.blockCount() );
+    EXPECT_EQ( 256, arena.bytesReserved() );
+    EXPECT_EQ( 3, arena.bytesUsed() );
+
+    // allocations are contiguous and padded to their alignment
+    uint8* next = static_cast<uint8*>( arena.allocate( 1, 1 ) );
+    EXPECT_EQ( bytes + 3, next );
+    uint64* aligned = static_cast<uint64*>( arena.allocate( 8, 8 ) );
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( aligned ) % 8 );
+    void* wide = arena.allocate( 4, 64 );
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( wide ) % 64 );
+
+    EXPECT_DEATH( arena.allocate( 0, 1 ), ".*" );
+    EXPECT_DEATH( arena.allocate( 1, 3 ), ".*" );
+}
+
+TEST( Arena, Blocks )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    Arena arena( 64 );
+
+    arena.allocate( 48, 1 );
+    arena.allocate( 48, 1 );
+    EXPECT_EQ( 2, arena.blockCount() );
+
+    // larger than a block
+    arena.allocate( 200, 1 );
+    EXPECT_EQ( 3, arena.blockCount() );
+    EXPECT_EQ( 296, arena.bytesUsed() );
+    const uint32 reserved = arena.bytesReserved();
+    EXPECT_LE( 296, reserved );
+
+    // the blocks merge so the same frame fits in one
+    arena.reset();
+    EXPECT_EQ( 0, arena.bytesUsed() );
+    EXPECT_EQ( 296, arena.peakBytesUsed() );
+    EXPECT_EQ( 1, arena.blockCount() );
+    EXPECT_EQ( reserved, arena.bytesReserved() );
+
+    arena.allocate( 48, 1 );
+    arena.allocate( 48, 1 );
+    arena.allocate( 200, 1 );
+    EXPECT_EQ( 1, arena.blockCount() );
+
+    arena.reset();
+    EXPECT_EQ( 1, arena.blockCount() );
+}
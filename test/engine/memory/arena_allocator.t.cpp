@@ -0,0 +1,76 @@
+// arena_allocator.t.cpp
+#include <engine/containers/dynamic_array.h>
+#include <engine/memory/arena_allocator.h>
+#include <gtest/gtest.h>
+#include <string>
+
+TEST( ArenaAllocator, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    Arena arena;
+    ArenaAllocator<uint32> alloc( &arena );
+    ArenaAllocator<uint32> copy( alloc );
+    EXPECT_EQ( &arena, copy.arena() );
+
+    EXPECT_DEATH( ArenaAllocator<uint32>( nullptr ), ".*" );
+}
+
+TEST( ArenaAllocator, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    Arena arena;
+    ArenaAllocator<std::string> alloc( &arena );
+
+    std::string* values = alloc.get( 4 );
+    ASSERT_NE( nullptr, values );
+    EXPECT_TRUE( values[3].empty() );
+    values[0] = "value";
+    EXPECT_EQ( 4 * sizeof( std::string ), arena.bytesUsed() );
+
+    // releasing destroys the instances but keeps the memory
+    alloc.release( values, 4 );
+    EXPECT_EQ( 4 * sizeof( std::string ), arena.bytesUsed() );
+
+    std::string* raw = alloc.getRaw( 2 );
+    new ( raw ) std::string( "raw" );
+    EXPECT_EQ( "raw", *raw );
+    raw->~basic_string();
+    alloc.releaseRaw( raw, 2 );
+
+    arena.reset();
+    EXPECT_EQ( 0, arena.bytesUsed() );
+
+    EXPECT_DEATH( alloc.release( nullptr, 1 ), ".*" );
+    EXPECT_DEATH( alloc.get( 0 ), ".*" );
+}
+
+TEST( ArenaAllocator, Container )
+{
+    using namespace nge;
+    using namespace nge::mem;
+    using namespace nge::cntr;
+
+    Arena arena;
+    ArenaAllocator<uint32> alloc( &arena );
+
+    uint32 frame;
+    uint32 i;
+    for ( frame = 0; frame < 3; ++frame )
+    {
+        {
+            DynamicArray<uint32> scratch( &alloc );
+            for ( i = 0; i < 1000; ++i )
+            {
+                scratch.push( i );
+            }
+            EXPECT_EQ( 999, scratch[999] );
+        }
+
+        arena.reset();
+        EXPECT_EQ( 1, arena.blockCount() );
+    }
+}
@@ -1,6 +1,9 @@
 //counting_allocator.t.cpp
 #include <gtest/gtest.h>
 #include <engine/memory/counting_allocator.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
 
 TEST( CountingAllocator, Construction )
 {
@@ -47,4 +50,106 @@ TEST( CountingAllocator, Allocation )
     EXPECT_NO_FATAL_FAILURE( alloc.release( value, 100 ) );
     EXPECT_EQ( CountingAllocator<uint32>::getGlobalAllocationCount(), 5 );
     EXPECT_NO_FATAL_FAILURE( otherAlloc.release( otherValue, 5 ) );
-}
\ No newline at end of file
+}
+
+TEST( CountingAllocator, RawAllocation )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    CountingAllocator<std::string> alloc;
+    std::string* values = nullptr;
+
+    EXPECT_NO_FATAL_FAILURE( values = alloc.getRaw( 10 ) );
+    EXPECT_NE( nullptr, values );
+    EXPECT_EQ( 10, alloc.getAllocationCount() );
+
+    new ( values ) std::string( "constructed" );
+    EXPECT_EQ( "constructed", values[0] );
+    values[0].~basic_string();
+
+    EXPECT_NO_FATAL_FAILURE( alloc.releaseRaw( values, 10 ) );
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+}
+
+TEST( CountingAllocator, Threads )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    const uint32 THREAD_COUNT = 4;
+    const uint32 ALLOCATIONS = 1000;
+
+    CountingAllocator<uint64> alloc;
+    std::thread threads[THREAD_COUNT];
+    uint32 t;
+    for ( t = 0; t < THREAD_COUNT; ++t )
+    {
+        threads[t] = std::thread( [&alloc]() {
+            uint32 i;
+            for ( i = 0; i < ALLOCATIONS; ++i )
+            {
+                alloc.release( alloc.get( 2 ), 2 );
+            }
+        } );
+    }
+
+    for ( t = 0; t < THREAD_COUNT; ++t )
+    {
+        threads[t].join();
+    }
+
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+    EXPECT_EQ( 0, CountingAllocator<uint64>::getGlobalAllocationCount() );
+}
+
+namespace
+{
+
+/**
+ * An item whose default constructor throws after a number of instances.
+ */
+struct Throwing
+{
+    static nge::uint32 s_remaining;
+    static nge::uint32 s_live;
+
+    Throwing()
+    {
+        if ( s_remaining == 0 )
+        {
+            throw std::runtime_error( "out of instances" );
+        }
+        --s_remaining;
+        ++s_live;
+    }
+
+    ~Throwing() { --s_live; }
+};
+
+nge::uint32 Throwing::s_remaining = 0;
+nge::uint32 Throwing::s_live = 0;
+
+} // End nspc anonymous
+
+TEST( CountingAllocator, ThrowingConstructor )
+{
+    using namespace nge::mem;
+    using namespace nge;
+
+    CountingAllocator<Throwing> alloc;
+
+    // a throwing constructor destroys the finished instances and releases
+    // the storage
+    Throwing::s_remaining = 3;
+    EXPECT_THROW( alloc.get( 5 ), std::runtime_error );
+    EXPECT_EQ( 0, Throwing::s_live );
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+
+    Throwing::s_remaining = 5;
+    Throwing* values = alloc.get( 5 );
+    EXPECT_EQ( 5, Throwing::s_live );
+    alloc.release( values, 5 );
+    EXPECT_EQ( 0, Throwing::s_live );
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+}
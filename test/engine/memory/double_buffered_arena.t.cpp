@@ -0,0 +1,32 @@
+// double_buffered_arena.t.cpp
+#include <engine/memory/double_buffered_arena.h>
+#include <gtest/gtest.h>
+
+TEST( DoubleBufferedArena, Flip )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    DoubleBufferedArena arenas( 256 );
+    EXPECT_NE( &arenas.current(), &arenas.previous() );
+
+    uint32* first = static_cast<uint32*>(
+        arenas.current().allocate( sizeof( uint32 ), alignof( uint32 ) ) );
+    *first = 1;
+    Arena* firstArena = &arenas.current();
+
+    // the last frame's data stays valid through the next frame
+    arenas.flip();
+    EXPECT_EQ( firstArena, &arenas.previous() );
+    EXPECT_EQ( 1, *first );
+    EXPECT_EQ( sizeof( uint32 ), arenas.previous().bytesUsed() );
+    EXPECT_EQ( 0, arenas.current().bytesUsed() );
+
+    arenas.current().allocate( 8, 8 );
+
+    // and is freed once the frame after it ends
+    arenas.flip();
+    EXPECT_EQ( firstArena, &arenas.current() );
+    EXPECT_EQ( 0, arenas.current().bytesUsed() );
+    EXPECT_EQ( 8, arenas.previous().bytesUsed() );
+}
@@ -1,6 +1,7 @@
 // memory_utils.t.cpp
 #include <engine/memory/memory_utils.h>
 #include <gtest/gtest.h>
+#include <string>
 
 TEST( MemoryUtils, All )
 {
@@ -15,4 +16,33 @@ TEST( MemoryUtils, All )
     MemoryUtils::move( &dst[0], ( char* )"name", 5 );
 
     EXPECT_STREQ( "name", dst );
-}
\ No newline at end of file
+}
+
+TEST( MemoryUtils, OverlappingMoves )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    uint32 values[6] = { 0, 1, 2, 3, 4, 5 };
+    std::string strings[6] = { "0", "1", "2", "3", "4", "5" };
+
+    // shift right by one then back left by one
+    MemoryUtils::moveBackward( values + 1, values, 5 );
+    MemoryUtils::moveBackward( strings + 1, strings, 5 );
+    EXPECT_EQ( 4, values[5] );
+    EXPECT_EQ( "4", strings[5] );
+    EXPECT_EQ( 0, values[1] );
+    EXPECT_EQ( "0", strings[1] );
+
+    MemoryUtils::move( values, values + 1, 5 );
+    MemoryUtils::move( strings, strings + 1, 5 );
+    EXPECT_EQ( 0, values[0] );
+    EXPECT_EQ( "0", strings[0] );
+    EXPECT_EQ( 4, values[4] );
+    EXPECT_EQ( "4", strings[4] );
+
+    std::string copies[6];
+    MemoryUtils::copy( copies, strings, 5 );
+    EXPECT_EQ( "3", copies[3] );
+}
+
@@ -0,0 +1,105 @@
+// pool_allocator.t.cpp
+#include <engine/memory/counting_allocator.h>
+#include <engine/memory/pool_allocator.h>
+#include <gtest/gtest.h>
+#include <string>
+
+TEST( PoolAllocator, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    CountingAllocator<uint32> fallback;
+
+    PoolAllocator<uint32> def;
+    PoolAllocator<uint32> sized( 16 );
+    PoolAllocator<uint32> withFallback( &fallback );
+    PoolAllocator<uint32> withFallbackAndSize( &fallback, 16 );
+
+    EXPECT_EQ( 0, def.capacity() );
+    EXPECT_EQ( 0, def.getAllocationCount() );
+
+    uint32 empty = 0;
+    EXPECT_DEATH( PoolAllocator<uint32> alloc( empty ), ".*" );
+}
+
+TEST( PoolAllocator, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    PoolAllocator<std::string> alloc( 4 );
+
+    std::string* first = alloc.get( 1 );
+    ASSERT_NE( nullptr, first );
+    EXPECT_TRUE( first->empty() );
+    *first = "first";
+    EXPECT_EQ( 1, alloc.getAllocationCount() );
+    EXPECT_EQ( 4, alloc.capacity() );
+
+    std::string* values[5];
+    uint32 i;
+    for ( i = 0; i < 5; ++i )
+    {
+        values[i] = alloc.get( 1 );
+        *values[i] = std::to_string( i );
+    }
+    EXPECT_EQ( 6, alloc.getAllocationCount() );
+    EXPECT_EQ( 8, alloc.capacity() );
+    EXPECT_EQ( "first", *first );
+
+    // released slots are reused before the pool grows
+    alloc.release( values[2], 1 );
+    EXPECT_EQ( values[2], alloc.get( 1 ) );
+    EXPECT_EQ( 8, alloc.capacity() );
+
+    for ( i = 0; i < 5; ++i )
+    {
+        alloc.release( values[i], 1 );
+    }
+    alloc.release( first, 1 );
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+
+    EXPECT_DEATH( alloc.release( nullptr, 1 ), ".*" );
+    EXPECT_DEATH( alloc.get( 0 ), ".*" );
+}
+
+TEST( PoolAllocator, RawAllocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    PoolAllocator<std::string> alloc;
+
+    std::string* value = alloc.getRaw( 1 );
+    new ( value ) std::string( "raw" );
+    EXPECT_EQ( "raw", *value );
+    value->~basic_string();
+    alloc.releaseRaw( value, 1 );
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+
+    alloc.reserve( 100 );
+    EXPECT_LE( 100, alloc.capacity() );
+}
+
+TEST( PoolAllocator, Fallback )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    CountingAllocator<uint32> fallback;
+    PoolAllocator<uint32> alloc( &fallback );
+
+    uint32* array = alloc.get( 10 );
+    EXPECT_EQ( 10, fallback.getAllocationCount() );
+    EXPECT_EQ( 10, alloc.getAllocationCount() );
+    EXPECT_EQ( 0, alloc.capacity() );
+
+    uint32* raw = alloc.getRaw( 3 );
+    EXPECT_EQ( 13, fallback.getAllocationCount() );
+
+    alloc.releaseRaw( raw, 3 );
+    alloc.release( array, 10 );
+    EXPECT_EQ( 0, fallback.getAllocationCount() );
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+}
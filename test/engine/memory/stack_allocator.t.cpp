@@ -0,0 +1,71 @@
+// stack_allocator.t.cpp
+#include <engine/memory/stack_allocator.h>
+#include <gtest/gtest.h>
+
+TEST( StackAllocator, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    StackAllocator stack( 256 );
+    EXPECT_EQ( 256, stack.capacity() );
+    EXPECT_EQ( 0, stack.bytesUsed() );
+    EXPECT_EQ( 0, stack.peakBytesUsed() );
+    EXPECT_EQ( 0, stack.mark() );
+
+    EXPECT_DEATH( StackAllocator( 0 ), ".*" );
+}
+
+TEST( StackAllocator, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    StackAllocator stack( 256 );
+
+    uint8* bytes = static_cast<uint8*>( stack.allocate( 3, 1 ) );
+    ASSERT_NE( nullptr, bytes );
+    EXPECT_EQ( 3, stack.bytesUsed() );
+
+    // allocations are contiguous and padded to their alignment
+    uint8* next = static_cast<uint8*>( stack.allocate( 1, 1 ) );
+    EXPECT_EQ( bytes + 3, next );
+    uint64* aligned = static_cast<uint64*>( stack.allocate( 8, 8 ) );
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( aligned ) % 8 );
+    void* wide = stack.allocate( 4, 64 );
+    EXPECT_EQ( 0, reinterpret_cast<uintptr_t>( wide ) % 64 );
+
+    EXPECT_DEATH( stack.allocate( 0, 1 ), ".*" );
+    EXPECT_DEATH( stack.allocate( 1, 3 ), ".*" );
+    EXPECT_DEATH( stack.allocate( 256, 1 ), ".*" );
+}
+
+TEST( StackAllocator, Rewind )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    StackAllocator stack( 256 );
+
+    stack.allocate( 16, 4 );
+    const StackAllocator::Marker outer = stack.mark();
+    EXPECT_EQ( 16, outer );
+
+    void* first = stack.allocate( 32, 4 );
+    const StackAllocator::Marker inner = stack.mark();
+    stack.allocate( 64, 4 );
+    EXPECT_EQ( 112, stack.bytesUsed() );
+
+    // rewinding frees everything after the marker and reuses its memory
+    stack.rewindTo( inner );
+    EXPECT_EQ( 48, stack.bytesUsed() );
+    stack.rewindTo( outer );
+    EXPECT_EQ( first, stack.allocate( 32, 4 ) );
+    EXPECT_EQ( 112, stack.peakBytesUsed() );
+
+    EXPECT_DEATH( stack.rewindTo( 200 ), ".*" );
+
+    stack.reset();
+    EXPECT_EQ( 0, stack.bytesUsed() );
+    EXPECT_EQ( 112, stack.peakBytesUsed() );
+}
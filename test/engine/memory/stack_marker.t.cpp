@@ -0,0 +1,53 @@
+// stack_marker.t.cpp
+#include <engine/memory/stack_marker.h>
+#include <gtest/gtest.h>
+#include <utility>
+
+TEST( StackMarker, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    StackAllocator stack( 256 );
+    stack.allocate( 8, 1 );
+
+    StackMarker marker( &stack );
+    EXPECT_EQ( &stack, marker.stack() );
+    EXPECT_EQ( 8, marker.marker() );
+
+    StackMarker moved( std::move( marker ) );
+    EXPECT_EQ( nullptr, marker.stack() );
+    EXPECT_EQ( &stack, moved.stack() );
+    EXPECT_EQ( 8, moved.marker() );
+
+    EXPECT_DEATH( StackMarker( nullptr ), ".*" );
+}
+
+TEST( StackMarker, Scopes )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    StackAllocator stack( 1024 );
+    {
+        StackMarker outer( &stack );
+        float* values = static_cast<float*>(
+            outer.allocate( 16 * sizeof( float ), alignof( float ) ) );
+        values[15] = 1.0f;
+        {
+            StackMarker inner( &stack );
+            inner.allocate( 256, 16 );
+            EXPECT_LE( 256 + 16 * sizeof( float ), stack.bytesUsed() );
+        }
+
+        // the inner scope is freed but the outer allocation is not
+        EXPECT_EQ( 16 * sizeof( float ), stack.bytesUsed() );
+        EXPECT_EQ( 1.0f, values[15] );
+
+        outer.rewind();
+        EXPECT_EQ( 0, stack.bytesUsed() );
+        outer.allocate( 4, 4 );
+    }
+
+    EXPECT_EQ( 0, stack.bytesUsed() );
+}
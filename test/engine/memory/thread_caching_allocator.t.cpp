@@ -0,0 +1,104 @@
+// thread_caching_allocator.t.cpp
+#include <engine/containers/dynamic_array.h>
+#include <engine/memory/thread_caching_allocator.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+TEST( ThreadCachingAllocator, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    EXPECT_NO_FATAL_FAILURE(
+        ThreadCachingAllocator<uint32> alloc;
+        ThreadCachingAllocator<uint32> copy( alloc );
+    );
+}
+
+TEST( ThreadCachingAllocator, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    ThreadCachingAllocator<std::string> alloc;
+
+    std::string* values = alloc.get( 3 );
+    ASSERT_NE( nullptr, values );
+    EXPECT_TRUE( values[2].empty() );
+    values[0] = "value";
+    EXPECT_EQ( 3, alloc.getAllocationCount() );
+
+    // blocks of the same size class are reused by the thread
+    alloc.release( values, 3 );
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+    std::string* reused = alloc.get( 4 );
+    EXPECT_EQ( values, reused );
+    alloc.release( reused, 4 );
+
+    // requests past the largest size class skip the caches
+    uint32 count = ThreadCachingAllocator<std::string>::MAX_CACHED_COUNT + 1;
+    std::string* large = alloc.getRaw( count );
+    new ( large + count - 1 ) std::string( "last" );
+    EXPECT_EQ( "last", large[count - 1] );
+    large[count - 1].~basic_string();
+    alloc.releaseRaw( large, count );
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+
+    EXPECT_DEATH( alloc.release( nullptr, 1 ), ".*" );
+    EXPECT_DEATH( alloc.get( 0 ), ".*" );
+}
+
+TEST( ThreadCachingAllocator, Threads )
+{
+    using namespace nge;
+    using namespace nge::mem;
+    using namespace nge::cntr;
+
+    const uint32 THREAD_COUNT = 4;
+    const uint32 ROUNDS = 50;
+    const uint32 LIVE = 100;
+
+    ThreadCachingAllocator<uint64> alloc;
+    std::thread threads[THREAD_COUNT];
+    bool valid[THREAD_COUNT];
+    uint32 t;
+    for ( t = 0; t < THREAD_COUNT; ++t )
+    {
+        valid[t] = true;
+        threads[t] = std::thread( [&alloc, &valid, t]() {
+            uint64* blocks[LIVE];
+            uint32 round;
+            uint32 i;
+            for ( round = 0; round < ROUNDS; ++round )
+            {
+                for ( i = 0; i < LIVE; ++i )
+                {
+                    blocks[i] = alloc.getRaw( i % 8 + 1 );
+                    blocks[i][0] = t * LIVE + i;
+                }
+                for ( i = 0; i < LIVE; ++i )
+                {
+                    valid[t] = valid[t] && blocks[i][0] == t * LIVE + i;
+                    alloc.releaseRaw( blocks[i], i % 8 + 1 );
+                }
+            }
+        } );
+    }
+
+    for ( t = 0; t < THREAD_COUNT; ++t )
+    {
+        threads[t].join();
+        EXPECT_TRUE( valid[t] );
+    }
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+
+    // blocks freed by exited threads are handed to new ones
+    DynamicArray<uint64> array( &alloc );
+    uint32 i;
+    for ( i = 0; i < 1000; ++i )
+    {
+        array.push( i );
+    }
+    EXPECT_EQ( 999, array[999] );
+}
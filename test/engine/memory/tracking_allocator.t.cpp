@@ -0,0 +1,116 @@
+// tracking_allocator.t.cpp
+#include <engine/containers/dynamic_array.h>
+#include <engine/memory/counting_allocator.h>
+#include <engine/memory/tracking_allocator.h>
+#include <gtest/gtest.h>
+#include <new>
+#include <string>
+
+namespace
+{
+
+struct FailingAllocator : public nge::mem::IAllocator<nge::uint32>
+{
+    virtual nge::uint32* getRaw( nge::uint32 )
+    {
+        throw std::bad_alloc();
+    }
+
+    virtual nge::uint32* getAligned( nge::uint32, nge::uint32 )
+    {
+        throw std::bad_alloc();
+    }
+};
+
+} // End nspc anonymous
+
+TEST( TrackingAllocator, Construction )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    AllocationTracker tracker;
+    TrackingAllocator<uint32> def( "default" );
+    EXPECT_STREQ( "default", def.tag() );
+    EXPECT_EQ( &AllocationTracker::global(), def.tracker() );
+
+    TrackingAllocator<uint32> alloc( "local", nullptr, &tracker );
+    TrackingAllocator<uint32> copy( alloc );
+    EXPECT_STREQ( "local", copy.tag() );
+    EXPECT_EQ( &tracker, copy.tracker() );
+
+    EXPECT_DEATH( TrackingAllocator<uint32>( nullptr ), ".*" );
+    EXPECT_DEATH( TrackingAllocator<uint32>( "tag", nullptr, nullptr ),
+                  ".*" );
+}
+
+TEST( TrackingAllocator, Allocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    AllocationTracker tracker;
+    CountingAllocator<std::string> counter;
+    TrackingAllocator<std::string> alloc( "strings", &counter, &tracker );
+
+    std::string* values = alloc.get( 4 );
+    EXPECT_EQ( 4, counter.getAllocationCount() );
+    EXPECT_EQ( 4 * sizeof( std::string ), tracker.bytesLive() );
+    alloc.release( values, 4 );
+
+    std::string* raw = alloc.getRaw( 2 );
+    EXPECT_EQ( 2 * sizeof( std::string ), tracker.bytesLive() );
+    alloc.releaseRaw( raw, 2 );
+
+    raw = alloc.getAligned( 1, 64 );
+    EXPECT_EQ( sizeof( std::string ), tracker.bytesLive() );
+    alloc.releaseAligned( raw, 1, 64 );
+
+    EXPECT_EQ( 0, tracker.bytesLive() );
+    EXPECT_EQ( 4 * sizeof( std::string ), tracker.peakBytesLive() );
+    EXPECT_EQ( 0, counter.getAllocationCount() );
+}
+
+TEST( TrackingAllocator, FailedAllocation )
+{
+    using namespace nge;
+    using namespace nge::mem;
+
+    AllocationTracker tracker;
+    FailingAllocator failing;
+    TrackingAllocator<uint32> alloc( "failing", &failing, &tracker );
+
+    // failed allocations are not recorded
+    EXPECT_THROW( alloc.getRaw( 4 ), std::bad_alloc );
+    EXPECT_THROW( alloc.getAligned( 4, 64 ), std::bad_alloc );
+    EXPECT_THROW( alloc.get( 4 ), std::bad_alloc );
+    EXPECT_EQ( 0, tracker.bytesLive() );
+    EXPECT_EQ( 0, tracker.peakBytesLive() );
+}
+
+TEST( TrackingAllocator, Container )
+{
+    using namespace nge;
+    using namespace nge::mem;
+    using namespace nge::cntr;
+
+    AllocationTracker tracker;
+    TrackingAllocator<uint32> alloc( "array", nullptr, &tracker );
+    {
+        DynamicArray<uint32> array( &alloc );
+        uint32 i;
+        for ( i = 0; i < 100; ++i )
+        {
+            array.push( i );
+        }
+        tracker.endFrame();
+        EXPECT_EQ( array.capacity() * sizeof( uint32 ), tracker.bytesLive() );
+    }
+
+    DynamicArray<AllocationTracker::FrameStats> frames;
+    tracker.timeline( &frames );
+    ASSERT_EQ( 1, frames.size() );
+    EXPECT_LT( 1, frames[0].allocationCount );
+    EXPECT_EQ( frames[0].allocationCount - 1, frames[0].releaseCount );
+    EXPECT_EQ( 0, tracker.bytesLive() );
+}
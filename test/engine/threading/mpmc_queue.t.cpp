@@ -0,0 +1,117 @@
+// mpmc_queue.t.cpp
+#include <engine/threading/mpmc_queue.h>
+#include <engine/memory/counting_allocator.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST( MpmcQueue, PushAndPop )
+{
+    using namespace nge;
+    using namespace nge::mem;
+    using namespace nge::thrd;
+
+    CountingAllocator<MpmcQueue<std::string>::Cell> alloc;
+    std::string value;
+    uint32 i;
+
+    {
+        MpmcQueue<std::string> queue( &alloc, 5 );
+
+        EXPECT_EQ( 8, queue.capacity() );
+        EXPECT_EQ( 2, MpmcQueue<std::string>( 1 ).capacity() );
+        EXPECT_TRUE( queue.isEmpty() );
+        EXPECT_FALSE( queue.tryPop( value ) );
+
+        // wrap around the ring a few times
+        for ( i = 0; i < 20; ++i )
+        {
+            ASSERT_TRUE( queue.tryPush( std::to_string( i ) ) );
+            ASSERT_TRUE( queue.tryEmplace( 3, 'a' ) );
+            ASSERT_TRUE( queue.tryPop( value ) );
+            ASSERT_EQ( std::to_string( i ), value );
+            ASSERT_TRUE( queue.tryPop( value ) );
+            ASSERT_EQ( "aaa", value );
+        }
+
+        for ( i = 0; i < queue.capacity(); ++i )
+        {
+            ASSERT_TRUE( queue.tryPush( value ) );
+        }
+
+        EXPECT_FALSE( queue.tryPush( value ) );
+        EXPECT_EQ( queue.capacity(), queue.size() );
+
+        // the remaining items are destroyed with the queue
+        EXPECT_LT( 0, alloc.getAllocationCount() );
+    }
+
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+}
+
+TEST( MpmcQueue, HandsItemsBetweenThreads )
+{
+    using namespace nge;
+    using namespace nge::thrd;
+
+    constexpr uint32 THREADS = 4;
+    constexpr uint32 COUNT = 20000;
+
+    MpmcQueue<uint32> queue( 64 );
+    std::atomic<uint32> seen[THREADS * COUNT];
+    std::atomic<uint32> popped( 0 );
+    std::vector<std::thread> threads;
+    uint32 i;
+
+    for ( i = 0; i < THREADS * COUNT; ++i )
+    {
+        seen[i] = 0;
+    }
+
+    for ( i = 0; i < THREADS; ++i )
+    {
+        threads.emplace_back( [&queue, i]() {
+            uint32 j;
+            for ( j = 0; j < COUNT; )
+            {
+                if ( queue.tryPush( i * COUNT + j ) )
+                {
+                    ++j;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        } );
+
+        threads.emplace_back( [&queue, &seen, &popped]() {
+            uint32 value;
+            while ( popped.load() < THREADS * COUNT )
+            {
+                if ( queue.tryPop( value ) )
+                {
+                    seen[value].fetch_add( 1 );
+                    popped.fetch_add( 1 );
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        } );
+    }
+
+    for ( std::thread& thread : threads )
+    {
+        thread.join();
+    }
+
+    // every item is popped exactly once
+    EXPECT_TRUE( queue.isEmpty() );
+    for ( i = 0; i < THREADS * COUNT; ++i )
+    {
+        ASSERT_EQ( 1, seen[i].load() );
+    }
+}
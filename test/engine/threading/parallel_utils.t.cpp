@@ -0,0 +1,103 @@
+// parallel_utils.t.cpp
+#include <engine/containers/dynamic_array.h>
+#include <engine/containers/fixed_array.h>
+#include <engine/threading/parallel_utils.h>
+#include <gtest/gtest.h>
+#include <string>
+
+TEST( ParallelUtils, ForEachAndTransform )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::thrd;
+
+    constexpr uint32 COUNT = 100000;
+
+    ThreadPool pool( 3 );
+    DynamicArray<uint32> array;
+    FixedArray<uint64> squares( COUNT );
+    uint32 i;
+
+    // start past the front so the array wraps around its block
+    array.push( 0 );
+    array.popFront();
+    for ( i = 0; i < COUNT; ++i )
+    {
+        array.pushFront( COUNT - 1 - i );
+        squares.push( 0 );
+    }
+
+    ParallelUtils::forEach( pool, array, []( uint32& value ) { value *= 2; } );
+    ParallelUtils::transform( pool, array, squares, []( uint32 value ) {
+        return static_cast<uint64>( value ) * value;
+    } );
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        ASSERT_EQ( i * 2, array[i] );
+        ASSERT_EQ( static_cast<uint64>( i * 2 ) * ( i * 2 ), squares[i] );
+    }
+}
+
+TEST( ParallelUtils, Reduce )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::thrd;
+
+    constexpr uint32 COUNT = 100000;
+
+    ThreadPool pool( 3 );
+    DynamicArray<uint64> array;
+    uint32 i;
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        array.push( i );
+    }
+
+    auto add = []( uint64 a, uint64 b ) { return a + b; };
+    auto maximum = []( uint64 a, uint64 b ) { return std::max( a, b ); };
+
+    EXPECT_EQ( static_cast<uint64>( COUNT ) * ( COUNT - 1 ) / 2,
+               ParallelUtils::reduce( pool, array, uint64( 0 ), add ) );
+    EXPECT_EQ( COUNT - 1,
+               ParallelUtils::reduce( pool, array, uint64( 0 ), maximum ) );
+
+    DynamicArray<uint64> empty;
+    EXPECT_EQ( 0, ParallelUtils::reduce( pool, empty, uint64( 0 ), add ) );
+}
+
+TEST( ParallelUtils, Sort )
+{
+    using namespace nge;
+    using namespace nge::cntr;
+    using namespace nge::thrd;
+
+    constexpr uint32 COUNT = 50000;
+
+    ThreadPool pool( 3 );
+    DynamicArray<uint32> numbers;
+    FixedArray<std::string> strings( COUNT );
+    uint32 i;
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        numbers.pushFront( i * 2654435761u );
+        strings.push( std::to_string( ( i * 7919 ) % COUNT ) );
+    }
+
+    ParallelUtils::sort( pool, numbers );
+    ParallelUtils::sort( pool, strings,
+                         []( const std::string& a, const std::string& b ) {
+        return a > b;
+    } );
+
+    ASSERT_EQ( COUNT, numbers.size() );
+    ASSERT_EQ( COUNT, strings.size() );
+    for ( i = 1; i < COUNT; ++i )
+    {
+        ASSERT_LE( numbers[i - 1], numbers[i] );
+        ASSERT_GE( strings[i - 1], strings[i] );
+    }
+}
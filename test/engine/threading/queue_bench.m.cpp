@@ -0,0 +1,186 @@
+// queue_bench.m.cpp
+//
+// Measures the producer to consumer throughput of the lock free queues
+// against a DynamicArray guarded by a mutex.
+//
+// Every run pushes the same number of integers through a queue of the same
+// capacity, split evenly between the producer threads, and checks that the
+// consumers popped every one of them exactly once by their sum. Build with
+// optimizations for meaningful numbers. The number of items can be passed
+// as the only argument.
+//
+#include <engine/containers/dynamic_array.h>
+#include <engine/threading/mpmc_queue.h>
+#include <engine/threading/spsc_queue.h>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+const nge::uint32 CAPACITY = 1024;
+const nge::uint64 DEFAULT_ITEMS = 1 << 22;
+
+/**
+ * Defines a bounded queue that guards a DynamicArray with a mutex, with the
+ * same interface as the lock free queues.
+ */
+class LockedQueue
+{
+  private:
+    std::mutex _mutex;
+    nge::cntr::DynamicArray<nge::uint64> _values;
+    nge::uint32 _capacity;
+
+  public:
+    LockedQueue( nge::uint32 capacity )
+        : _mutex(), _values( capacity ), _capacity( capacity )
+    {
+    }
+
+    bool tryPush( nge::uint64 value )
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        if ( _values.size() >= _capacity )
+        {
+            return false;
+        }
+
+        _values.push( value );
+        return true;
+    }
+
+    bool tryPop( nge::uint64& value )
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        if ( _values.isEmpty() )
+        {
+            return false;
+        }
+
+        value = _values.popFront();
+        return true;
+    }
+};
+
+/**
+ * Pushes the given number of items through the queue with the given number
+ * of producer and consumer threads and prints the throughput.
+ */
+template <typename Q>
+void run( const char* name, Q& queue, nge::uint32 producers,
+          nge::uint32 consumers, nge::uint64 items )
+{
+    using namespace nge;
+
+    // round down so every producer pushes the same number of items
+    const uint64 perProducer = items / producers;
+    const uint64 total = perProducer * producers;
+
+    std::atomic<uint64> popped( 0 );
+    std::atomic<uint64> sum( 0 );
+    std::vector<std::thread> threads;
+    uint32 i;
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    for ( i = 0; i < producers; ++i )
+    {
+        threads.emplace_back( [&queue, perProducer, i]() {
+            const uint64 first = perProducer * i + 1;
+            uint64 value;
+            for ( value = first; value < first + perProducer; ++value )
+            {
+                while ( !queue.tryPush( value ) )
+                {
+                    std::this_thread::yield();
+                }
+            }
+        } );
+    }
+
+    for ( i = 0; i < consumers; ++i )
+    {
+        threads.emplace_back( [&queue, &popped, &sum, total]() {
+            uint64 local = 0;
+            uint64 value;
+            while ( popped.load( std::memory_order_relaxed ) < total )
+            {
+                if ( queue.tryPop( value ) )
+                {
+                    local += value;
+                    popped.fetch_add( 1, std::memory_order_relaxed );
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+            sum.fetch_add( local );
+        } );
+    }
+
+    for ( i = 0; i < threads.size(); ++i )
+    {
+        threads[i].join();
+    }
+
+    const double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start ).count();
+    const bool isCorrect = sum.load() == total * ( total + 1 ) / 2;
+
+    std::cout << std::left << std::setw( 16 ) << name << std::right
+              << std::setw( 4 ) << producers << 'x' << std::left
+              << std::setw( 4 ) << consumers << std::right << std::fixed
+              << std::setprecision( 1 ) << std::setw( 10 )
+              << seconds * 1000.0 << " ms" << std::setw( 10 )
+              << total / seconds / 1000000.0 << " M items/s"
+              << ( isCorrect ? "" : "  LOST ITEMS" ) << std::endl;
+}
+
+} // End nspc anonymous
+
+int main( int argc, char* argv[] )
+{
+    using namespace nge;
+    using namespace nge::thrd;
+
+    const uint64 items = argc > 1 ? strtoull( argv[1], nullptr, 10 )
+                                  : DEFAULT_ITEMS;
+    if ( items <= 0 )
+    {
+        std::cerr << "usage: " << argv[0] << " [items]" << std::endl;
+        return 1;
+    }
+
+    std::cout << items << " items through a capacity of " << CAPACITY
+              << ", " << std::thread::hardware_concurrency()
+              << " hardware threads" << std::endl;
+
+    {
+        SpscQueue<uint64> queue( CAPACITY );
+        run( "SpscQueue", queue, 1, 1, items );
+    }
+
+    uint32 threads;
+    for ( threads = 1; threads <= 4; threads <<= 1 )
+    {
+        {
+            MpmcQueue<uint64> queue( CAPACITY );
+            run( "MpmcQueue", queue, threads, threads, items );
+        }
+        {
+            LockedQueue queue( CAPACITY );
+            run( "mutex+array", queue, threads, threads, items );
+        }
+    }
+
+    return 0;
+}
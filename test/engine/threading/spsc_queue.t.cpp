@@ -0,0 +1,92 @@
+// spsc_queue.t.cpp
+#include <engine/threading/spsc_queue.h>
+#include <engine/memory/counting_allocator.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST( SpscQueue, PushAndPop )
+{
+    using namespace nge;
+    using namespace nge::mem;
+    using namespace nge::thrd;
+
+    CountingAllocator<std::string> alloc;
+    std::string value;
+    uint32 i;
+
+    {
+        SpscQueue<std::string> queue( &alloc, 5 );
+
+        EXPECT_EQ( 8, queue.capacity() );
+        EXPECT_TRUE( queue.isEmpty() );
+        EXPECT_FALSE( queue.tryPop( value ) );
+
+        // wrap around the ring a few times
+        for ( i = 0; i < 20; ++i )
+        {
+            ASSERT_TRUE( queue.tryPush( std::to_string( i ) ) );
+            ASSERT_TRUE( queue.tryEmplace( 3, 'a' ) );
+            ASSERT_TRUE( queue.tryPop( value ) );
+            ASSERT_EQ( std::to_string( i ), value );
+            ASSERT_TRUE( queue.tryPop( value ) );
+            ASSERT_EQ( "aaa", value );
+        }
+
+        for ( i = 0; i < queue.capacity(); ++i )
+        {
+            ASSERT_TRUE( queue.tryPush( value ) );
+        }
+
+        EXPECT_FALSE( queue.tryPush( value ) );
+        EXPECT_EQ( queue.capacity(), queue.size() );
+
+        // the remaining items are destroyed with the queue
+        EXPECT_LT( 0, alloc.getAllocationCount() );
+    }
+
+    EXPECT_EQ( 0, alloc.getAllocationCount() );
+}
+
+TEST( SpscQueue, HandsItemsBetweenThreads )
+{
+    using namespace nge;
+    using namespace nge::thrd;
+
+    constexpr uint32 COUNT = 100000;
+
+    SpscQueue<uint32> queue( 64 );
+
+    std::thread producer( [&queue]() {
+        uint32 i;
+        for ( i = 0; i < COUNT; )
+        {
+            if ( queue.tryPush( i ) )
+            {
+                ++i;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    } );
+
+    // the items arrive in order
+    uint32 value;
+    uint32 i;
+    for ( i = 0; i < COUNT; )
+    {
+        if ( queue.tryPop( value ) )
+        {
+            ASSERT_EQ( i, value );
+            ++i;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    EXPECT_TRUE( queue.isEmpty() );
+}
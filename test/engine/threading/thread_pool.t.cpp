@@ -0,0 +1,62 @@
+// thread_pool.t.cpp
+#include <engine/threading/thread_pool.h>
+#include <gtest/gtest.h>
+#include <atomic>
+
+TEST( ThreadPool, Construction )
+{
+    using namespace nge;
+    using namespace nge::thrd;
+
+    ThreadPool def;
+    ThreadPool none( 0 );
+    ThreadPool some( 3 );
+
+    EXPECT_EQ( def.workerCount() + 1, def.concurrency() );
+    EXPECT_EQ( 0, none.workerCount() );
+    EXPECT_EQ( 1, none.concurrency() );
+    EXPECT_EQ( 3, some.workerCount() );
+    EXPECT_EQ( 4, some.concurrency() );
+}
+
+TEST( ThreadPool, RunsEveryTaskOnce )
+{
+    using namespace nge;
+    using namespace nge::thrd;
+
+    constexpr uint32 COUNT = 1000;
+
+    ThreadPool pool( 3 );
+    std::atomic<uint32> runs[COUNT];
+    uint32 i;
+    uint32 job;
+
+    // the pool is reused for many jobs of different sizes
+    for ( job = 0; job < 50; ++job )
+    {
+        const uint32 count = ( job * 37 ) % COUNT;
+        for ( i = 0; i < COUNT; ++i )
+        {
+            runs[i] = 0;
+        }
+
+        pool.run( count, [&runs]( uint32 task ) { ++runs[task]; } );
+
+        for ( i = 0; i < COUNT; ++i )
+        {
+            ASSERT_EQ( i < count ? 1 : 0, runs[i].load() );
+        }
+    }
+}
+
+TEST( ThreadPool, RunsWithoutWorkers )
+{
+    using namespace nge;
+    using namespace nge::thrd;
+
+    ThreadPool pool( 0 );
+    uint32 sum = 0;
+
+    pool.run( 10, [&sum]( uint32 task ) { sum += task; } );
+    EXPECT_EQ( 45, sum );
+}
@@ -14,4 +14,12 @@ TEST( HashUtils, CompileTimeHash )
     using namespace nge::util;
     ASSERT_EQ( HashUtils::fnv1a( "hisNameIsRobertPaulson" ),
                chash( "hisNameIsRobertPaulson" ) );
-}
\ No newline at end of file
+}
+
+TEST( HashUtils, Fnv1aCharacterRange )
+{
+    using namespace nge::util;
+    ASSERT_EQ( HashUtils::fnv1a( "hisNameIs" ),
+               HashUtils::fnv1a( "hisNameIsRobertPaulson", 9 ) );
+    ASSERT_EQ( chash( "" ), HashUtils::fnv1a( "", 0 ) );
+}